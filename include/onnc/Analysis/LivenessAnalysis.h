@@ -30,7 +30,7 @@ public:
 
   SlotIndex getEnd() const { return m_End; }
 
-  const xValue& getValue() const { return m_Value; }
+  const xValue& getValue() const { return *m_Value; }
 
   /// return true if two live intervals have intersection
   bool intersect(const LiveInterval& pLive) const;
@@ -39,17 +39,21 @@ protected:
   // Live interval = [start, end]
   SlotIndex m_Start;
   SlotIndex m_End;
-  const xValue& m_Value;
+  const xValue* m_Value;
 };
 
 /** \class GraphLivenessAnalysis
+ *  Compute the live interval of every value in a graph in one linear pass.
+ *  The state of a value is kept in a side table indexed by its unique id,
+ *  and the table is reused between runs, so re-running the analysis after
+ *  a graph is split or rescheduled doesn't rebuild any hash table.
  */
 class GraphLivenessAnalysis : public ModulePass
 {
 public:
   static char ID;
 
-  typedef std::vector<LiveInterval*> LiveIntervalList;
+  typedef std::vector<LiveInterval> LiveIntervalList;
 
 public:
   GraphLivenessAnalysis();
@@ -58,6 +62,8 @@ public:
 
   ReturnType runOnGraph(xGraph &pGraph);
 
+  bool isAnalysis() const override { return true; }
+
   const LiveIntervalList& getLiveIntervals() const { return m_LiveIntervals; }
 
   void print(std::ostream& pOS) const;
@@ -65,11 +71,30 @@ public:
 private:
   void calculateLiveness(xGraph &pGraph);
 
-  /// delete LiveIntervals in m_LiveIntervals
   void clear();
 
+private:
+  /// The state of a value in the current run.
+  struct ValueSlot
+  {
+    /// The run the state belongs to. States of older runs are stale.
+    unsigned run;
+    LiveInterval::SlotIndex start;
+    LiveInterval::SlotIndex end;
+    /// The number of uses by the visited nodes.
+    unsigned uses;
+    /// True if a visited node defines the value.
+    bool defined;
+  };
+
+  ValueSlot& getSlot(const xValue& pValue);
+
 private:
   LiveIntervalList m_LiveIntervals;
+  std::vector<ValueSlot> m_ValueSlots;
+  std::vector<xValue*> m_Outputs;
+  std::vector<xValue*> m_Inputs;
+  unsigned m_Run;
 };
 
 GraphLivenessAnalysis *CreateLivenessAnalysisPass();
@@ -0,0 +1,111 @@
+//===- MemAllocStrategy.h -------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef ONNC_ANALYSIS_MEM_ALLOC_STRATEGY_H
+#define ONNC_ANALYSIS_MEM_ALLOC_STRATEGY_H
+#include <onnc/ADT/StringRef.h>
+#include <cstddef>
+#include <vector>
+
+namespace onnc {
+
+/** \struct MemAllocRequest
+ *  A value occupying @ref size bytes in the time slots [start, end].
+ *  @ref address is the result of the allocation.
+ */
+struct MemAllocRequest
+{
+  unsigned start, end;
+  size_t size;
+  size_t address;
+};
+
+typedef std::vector<MemAllocRequest> MemAllocRequestList;
+
+/// Place the requests in the order of their start slots. Each request goes
+/// to the lowest address that doesn't overlap the requests live at the same
+/// time (first fit). Requests with the same start keep their order.
+/// Runs in O(n log n).
+/// @return the peak memory size.
+size_t AllocByLiveness(MemAllocRequestList& pRequests);
+
+/** \class MemAllocStrategy
+ *  \brief The policy placing live values in a memory space.
+ *
+ *  A strategy fills the address of every request so that requests live at
+ *  the same time never overlap. Strategies are stateless and shared.
+ */
+class MemAllocStrategy
+{
+public:
+  virtual ~MemAllocStrategy() { }
+
+  /// The name used on the command line.
+  virtual StringRef name() const = 0;
+
+  /// Place all requests.
+  /// @return the peak memory size.
+  virtual size_t allocate(MemAllocRequestList& pRequests) const = 0;
+
+  /// @return the strategy named @ref pName, or nullptr if there is none.
+  static const MemAllocStrategy* Lookup(StringRef pName);
+
+  /// @return the placement strategies, the composite ones excluded.
+  static const std::vector<const MemAllocStrategy*>& GetPlacements();
+};
+
+/** \class FirstFitStrategy
+ *  Visit the values by start slot and place each at the lowest free address.
+ */
+class FirstFitStrategy : public MemAllocStrategy
+{
+public:
+  StringRef name() const override { return "first-fit"; }
+
+  size_t allocate(MemAllocRequestList& pRequests) const override;
+};
+
+/** \class BestFitBySizeStrategy
+ *  Visit the values from the largest to the smallest and place each in the
+ *  smallest gap it fits, among the values live at the same time. Large
+ *  values are placed while the space is still unfragmented.
+ */
+class BestFitBySizeStrategy : public MemAllocStrategy
+{
+public:
+  StringRef name() const override { return "best-fit-by-size"; }
+
+  size_t allocate(MemAllocRequestList& pRequests) const override;
+};
+
+/** \class GreedyByBreadthStrategy
+ *  Visit the time slots from the one with the most live bytes, and place the
+ *  values live there by size with best fit. The slots bounding the peak are
+ *  packed first.
+ */
+class GreedyByBreadthStrategy : public MemAllocStrategy
+{
+public:
+  StringRef name() const override { return "greedy-by-breadth"; }
+
+  size_t allocate(MemAllocRequestList& pRequests) const override;
+};
+
+/** \class MinPeakStrategy
+ *  Run every placement strategy and keep the smallest peak.
+ */
+class MinPeakStrategy : public MemAllocStrategy
+{
+public:
+  StringRef name() const override { return "min-peak"; }
+
+  size_t allocate(MemAllocRequestList& pRequests) const override;
+};
+
+} // namespace of onnc
+
+#endif
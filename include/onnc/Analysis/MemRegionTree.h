@@ -0,0 +1,96 @@
+//===- MemRegionTree.h ----------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef ONNC_ANALYSIS_MEM_REGION_TREE_H
+#define ONNC_ANALYSIS_MEM_REGION_TREE_H
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace onnc {
+
+/** \class MemRegionTree
+ *  \brief A balanced tree of disjoint memory regions ordered by address.
+ *
+ *  Every node keeps the largest gap between the regions in its subtree, so
+ *  the lowest address where a new region fits is found in logarithmic time.
+ *  Insertion and removal are logarithmic as well. The tree is a treap with
+ *  deterministic priorities.
+ */
+class MemRegionTree
+{
+public:
+  typedef unsigned int Handle;
+
+public:
+  MemRegionTree();
+
+  /// Add the region [pStart, pStart + pSize). It must not overlap the
+  /// regions in the tree.
+  /// @return the handle to remove the region.
+  Handle insert(size_t pStart, size_t pSize);
+
+  /// Remove the region returned by insert().
+  void erase(Handle pHandle);
+
+  /// @return the lowest address where @ref pSize bytes don't overlap any
+  ///         region in the tree.
+  size_t findFirstFit(size_t pSize) const;
+
+  /// @return the end of the highest region, or zero if the tree is empty.
+  size_t getEnd() const;
+
+  unsigned int size() const { return m_Size; }
+
+  bool empty() const { return (0 == m_Size); }
+
+  void clear();
+
+private:
+  static constexpr int kNil = -1;
+
+  struct Node
+  {
+    size_t start;
+    size_t end;
+    uint32_t priority;
+    int left;
+    int right;
+
+    // summary of the subtree
+    size_t minStart;
+    size_t maxEnd;
+    size_t maxGap;
+  };
+
+private:
+  /// Order nodes by address. Zero-sized regions may share the address of
+  /// another region, so ties are broken by the end and the handle.
+  bool less(int pA, int pB) const;
+
+  void update(int pNode);
+
+  /// Split @ref pRoot into the nodes before @ref pKey and the others.
+  void split(int pRoot, int pKey, int& pLeft, int& pRight);
+
+  int merge(int pLeft, int pRight);
+
+  /// @return the lowest fitting address in the subtree @ref pNode, whose
+  ///         preceding region ends at @ref pPrevEnd, or false.
+  bool find(int pNode, size_t pPrevEnd, size_t pSize, size_t& pAddr) const;
+
+private:
+  std::vector<Node> m_Nodes;
+  std::vector<Handle> m_FreeList;
+  int m_Root;
+  unsigned int m_Size;
+  uint32_t m_Seed;
+};
+
+} // namespace of onnc
+
+#endif
@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 #ifndef ONNC_MEMORY_ALLOCATION_H
 #define ONNC_MEMORY_ALLOCATION_H
+#include <onnc/Analysis/MemAllocStrategy.h>
 #include <onnc/Core/ModulePass.h>
 #include <onnc/Core/PassSupport.h>
 #include <onnc/Target/TargetMemInfo.h>
@@ -17,6 +18,7 @@ namespace onnc {
 
 class LiveInterval;
 class DLATargetBackend;
+class SplitGraph;
 
 struct MemAllocEntry
 {
@@ -45,7 +47,10 @@ public:
   virtual ~MemoryAllocation();
 
 public:
-  MemoryAllocation(DLATargetBackend* pDLATB = nullptr);
+  /// @param pStrategy the placement of values. If it is nullptr, the one
+  ///        given by option `--mem-alloc-strategy` is used.
+  MemoryAllocation(DLATargetBackend* pDLATB = nullptr,
+                   const MemAllocStrategy* pStrategy = nullptr);
 
   ReturnType runOnModule(Module& pModule) override;
 
@@ -55,12 +60,25 @@ public:
 
   void print(OStream& pOS) const;
 
+  void setStrategy(const MemAllocStrategy& pStrategy) {
+    m_pStrategy = &pStrategy;
+  }
+
+  const MemAllocStrategy& getStrategy() const { return *m_pStrategy; }
+
 private:
   /// Return total size of this allocation.
   uint64_t allocByLiveness(xGraph &pGraph,
                            ValMemSizeMap &pValMemSizeMap,
                            GraphLivenessAnalysis &pLiveAnaly);
 
+  /// Allocate @ref pSpGraph under its current split.
+  /// @param pValMemSizeMap the memory usage of the previous try, only the
+  ///        values whose sizes changed are updated.
+  /// @return total size of this allocation.
+  uint64_t allocBySplit(SplitGraph &pSpGraph, ValMemSizeMap &pValMemSizeMap,
+                        GraphLivenessAnalysis &pLiveAnaly);
+
   /// delete MemAllocEntries of graph.
   void clearGraphAlloc(xGraph *pGraph);
 
@@ -69,6 +87,7 @@ private:
 private:
   GraphMemAllocList m_GraphMemAllocList;
   DLATargetBackend* m_DLATB;
+  const MemAllocStrategy* m_pStrategy;
 };
 
 MemoryAllocation* CreateMemoryAllocationPass(DLATargetBackend* pDLATB);
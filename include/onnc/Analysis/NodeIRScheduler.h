@@ -27,17 +27,21 @@ typedef std::vector<xNode *> Nodes;
 /** \class NodeIRScheduler
  *  \brief onnx Graph IR scheduler. Reorder IR, especially load/store for
  *         better, even maximum performance.
+ *
+ *  A list scheduler. Ready nodes wait in a priority queue and are issued
+ *  while their execution resources have free units. Completions come from
+ *  a min-heap of the end cycles. The policy ranks the ready nodes:
+ *    - kMinLatency: the longest path to the end of the graph first, and the
+ *      fewest live bytes added if tied.
+ *    - kMinMemory: the fewest live bytes added first, and the longest path
+ *      if tied, so the memory allocation afterward needs fewer splits.
  */
 class NodeIRScheduler : public ModulePass
 {
 public:
-  struct ExeResUser
-  {
-    xNode *user;
-    uint64_t remainCycles;  /// Remaining cycles to finish executing the user.
-
-    ExeResUser(xNode *user, uint64_t rcycles)
-      : user(user), remainCycles(rcycles) {}
+  enum Policy {
+    kMinLatency,
+    kMinMemory
   };
 
   struct ExeCycle
@@ -49,17 +53,41 @@ public:
       : node(pNode), begin(pBegin), end(pEnd) {}
   };
 
-  // <execution resource, list of <user, remaining cycles>>
-  using ExeResUserMap = std::unordered_map<const ExeResource*,
-                                           std::vector<ExeResUser>>;
+  /// A ready node and its priority.
+  struct Candidate
+  {
+    xNode *node;
+    uint64_t pathCycles;  /// Cycles of the longest path to the end.
+    int64_t liveDelta;    /// Bytes of live values added by the node.
+    unsigned order;       /// Position in the graph.
+    unsigned version;     /// Candidates of old versions are discarded.
+  };
+
+  /// The completion of an issued node.
+  struct Event
+  {
+    uint64_t end;
+    unsigned order;       /// Issue order.
+    xNode *node;
+    const ExeResource *res;
+  };
+
 public:
   static char ID;
 
   virtual ~NodeIRScheduler();
 
 public:
+  /// The policy is given by the option -sched-policy.
   NodeIRScheduler(DLATargetBackend* pDLATB = nullptr);
 
+  NodeIRScheduler(DLATargetBackend* pDLATB, Policy pPolicy);
+
+  Policy getPolicy() const { return m_Policy; }
+
+  /// @retval true @ref pA is issued before @ref pB by the policy.
+  bool isBefore(const Candidate& pA, const Candidate& pB) const;
+
   ReturnType runOnModule(Module& pModule) override;
 
   ReturnType runOnGraph(xGraph &pGraph);
@@ -71,28 +99,46 @@ public:
   void print(OStream& pOS) const;
 
 private:
-  Nodes greedyPickNextNodes(Nodes &pCands);
-
-  bool isExeResAvailable(const ExeResource *pExeRes) const;
+  typedef std::unordered_map<const xNode *, uint64_t> CycleMap;
+  typedef std::unordered_map<const xValue *, uint64_t> ByteMap;
+  typedef std::unordered_map<const xValue *, unsigned> UseMap;
+  typedef std::unordered_map<const xNode *, unsigned> IndexMap;
 
-  bool isAllExeResEmpty() const;
-
-  void addExeResUser(const ExeResource *pExeRes, xNode *pUser);
+private:
+  /// Compute the cycles, the longest paths and the bytes of the values.
+  void prepare(xGraph &pGraph);
 
-  Nodes issue();
+  /// A new candidate of @ref pNode, whose priority reflects the values
+  /// released so far.
+  Candidate getCandidate(xNode *pNode);
 
   void clear()
   {
     m_SchedTimeLine.clear();
-    m_ExeResUsers.clear();
+    m_Cycles.clear();
+    m_PathCycles.clear();
+    m_Bytes.clear();
+    m_Orders.clear();
+    m_RemainUses.clear();
+    m_Ready.clear();
     m_CurCycle = 0;
   }
 
 private:
   DLATargetBackend* m_DLATB;
+  Policy m_Policy;
   std::vector<ExeCycle> m_SchedTimeLine;
   uint64_t m_CurCycle;
-  ExeResUserMap m_ExeResUsers;
+  CycleMap m_Cycles;
+  CycleMap m_PathCycles;
+  ByteMap m_Bytes;
+  IndexMap m_Orders;
+
+  /// The users of a value not issued yet.
+  UseMap m_RemainUses;
+
+  /// The ready nodes and the versions of their latest candidates.
+  IndexMap m_Ready;
 };
 
 NodeIRScheduler *CreateNodeIRSchedulerPass(DLATargetBackend *pDLATB);
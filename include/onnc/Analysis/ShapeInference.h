@@ -0,0 +1,67 @@
+//===- ShapeInference.h ---------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef ONNC_ANALYSIS_SHAPE_INFERENCE_H
+#define ONNC_ANALYSIS_SHAPE_INFERENCE_H
+#include <onnc/Config/ONNX.h>
+#include <unordered_map>
+
+namespace onnc {
+
+class Module;
+
+/** \class ShapeInference
+ *  \brief Infer the element types and the sizes of the values in a tensor
+ *  graph in place.
+ *
+ *  Every operator kind has a shape function computing the outputs from the
+ *  inputs and the attributes. Weights are never read, except small shape
+ *  tensors such as the one of Reshape. Values with known sizes are kept, as
+ *  onnx::shape_inference does.
+ */
+class ShapeInference
+{
+public:
+  /// Set the unknown outputs of @ref pNode.
+  /// @retval false the inputs or the attributes aren't enough.
+  typedef bool (*ShapeFunction)(xNode& pNode);
+
+public:
+  /// Register the shape functions of the standard operators.
+  /// @param pOpsetVersion The opset version of the default domain; 0 means
+  ///                      the latest one.
+  explicit ShapeInference(int64_t pOpsetVersion = 0);
+
+  /// Add or replace the shape function of @ref pKind.
+  void addShapeFunction(xNodeKind pKind, ShapeFunction pFunction);
+
+  bool hasShapeFunction(xNodeKind pKind) const;
+
+  /// @retval false some output of @ref pNode is still unknown.
+  bool infer(xNode& pNode) const;
+
+  /// Infer the nodes of @ref pGraph in topological order.
+  /// @retval false some output in @ref pGraph is still unknown.
+  bool infer(xGraph& pGraph) const;
+
+private:
+  typedef std::unordered_map<xNodeKind, ShapeFunction> FunctionMap;
+
+private:
+  FunctionMap m_Functions;
+};
+
+/// Infer the shapes of the root tensor graph of @ref pModule natively. If
+/// some values are left unknown, e.g., an operator has no shape function,
+/// fall back to onnx::shape_inference, which exports and reimports the whole
+/// module.
+/// @retval false the fallback failed.
+bool InferShapes(Module& pModule);
+
+} // namespace of onnc
+
+#endif
@@ -38,7 +38,12 @@ public:
 
   xNodeKind kind() const { return m_Node.kind(); }
 
-  void resetSize() { m_NewOutSizes = m_OutSizes; }
+  void resetSize();
+
+  /// @return true if the new output size changed since clearChanged().
+  bool isChanged() const { return m_Changed; }
+
+  void clearChanged() { m_Changed = false; }
 
   const xNode &getNode() const { return m_Node; }
 
@@ -60,6 +65,8 @@ protected:
   /// The input and output size is calculated by other nodes.
   bool m_SizeCalByOtherNode;
   xNode& m_Node;
+
+  bool m_Changed;
 };
 
 class SplitGraphManager;
@@ -76,8 +83,25 @@ public:
 
   void getMemUsage(ValMemSizeMap &pVMSMap) const;
 
-  /// Reduce size of all values in a group to meet memory size constraint.
-  void shrinkSize();
+  /// Recompute the memory usage of the values whose sizes changed since the
+  /// last update. Values not in @ref pVMSMap are always computed.
+  void updateMemUsage(ValMemSizeMap &pVMSMap);
+
+  /// Tile every output value of the group. The i-th axis of an output is
+  /// split into @ref pFactors[i] pieces; the rest axes are kept. Factors are
+  /// clipped to the sizes of the axes.
+  void setSplitFactors(const std::vector<unsigned>& pFactors);
+
+  const std::vector<unsigned>& getSplitFactors() const {
+    return m_SplitFactors;
+  }
+
+  /// @return the number of tiles of the largest output under the current
+  /// split factors.
+  uint64_t getNumOfTiles() const;
+
+  /// The Store nodes writing the outputs of the group.
+  const std::vector<xNode *>& getStores() const { return m_Stores; }
 
   xGraph & getGraph() { return m_Graph; }
 
@@ -98,12 +122,26 @@ private:
 
   /// @param pN Split from node pN.
   /// @param pUpdateUpper Propagate new size to upper levels.
-  void splitNodeByFactor(xNode* pN, unsigned pAxis, unsigned pFactor,
-                         bool pUpdateUpper = true);
-
   bool splitNodeBySize(xNode* pN, const LongInts& pNewOutSize,
                        bool pUpdateUpper = true);
 
+  /// Find the node deciding the memory usage of each value.
+  void buildMemUsers();
+
+  MemSize getMemUsage(unsigned pUser) const;
+
+private:
+  /// The @ref index -th input or output of @ref node decides the memory
+  /// usage of @ref value.
+  struct MemUser
+  {
+    const xValue *value;
+    xNode *node;
+    SplitNode *splitNode;
+    unsigned index;
+    bool isInput;
+  };
+
 private:
   SplitGraphManager &m_SgMgr;
 
@@ -111,10 +149,11 @@ private:
 
   SplitNodeHash m_SplitNodes;
 
-  /// split parameters for each output value.
+  std::vector<MemUser> m_MemUsers;
+
+  /// the outputs of the group and their split factor of every axis.
   std::vector<xNode *> m_Stores;
-  std::vector<unsigned> m_CurSplitAxis;
-  std::vector<unsigned> m_CurSplitFactor;
+  std::vector<unsigned> m_SplitFactors;
 
   /// Allocation status
   bool m_AllocSuccess;
@@ -0,0 +1,93 @@
+//===- TilingPlanner.h ----------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef ONNC_ANALYSIS_TILING_PLANNER_H
+#define ONNC_ANALYSIS_TILING_PLANNER_H
+#include <onnc/Support/OStream.h>
+#include <onnc/Target/TargetTransformInfo.h>
+#include <functional>
+#include <vector>
+
+namespace onnc {
+
+class SplitGraph;
+
+/** \class TilingPlanner
+ *  \brief picks the tile shape of a fused group from a cost model.
+ *
+ *  Candidate shapes split the N, C and H axes of the outputs of a group.
+ *  Every tile is loaded, computed and stored once, so the predicted cycles
+ *  of a tile are
+ *    - the compute cycles of its nodes: the TargetTransformInfo cycle count
+ *      of the whole node, scaled by the tile volume and by the lanes and
+ *      processing units the tile leaves idle, and
+ *    - the transfer cycles of its loads and stores, which also count the
+ *      data reloaded by every tile, e.g., the halo of a convolution split
+ *      along H and the input of one split along C.
+ *
+ *  The planner takes the fitting shape with the fewest predicted cycles in
+ *  total, and the larger footprint of two equal ones.
+ */
+class TilingPlanner
+{
+public:
+  /// The split factors of the N, C and H axes.
+  typedef std::vector<unsigned> Factors;
+
+  /// The local memory a group takes under its current split.
+  typedef std::function<uint64_t(SplitGraph&)> FootprintFn;
+
+  struct Plan
+  {
+    Factors factors;
+    uint64_t numOfTiles;
+    uint64_t footprint;
+
+    /// predicted cycles of a tile.
+    uint64_t computeCycles;
+    uint64_t transferCycles;
+
+    uint64_t getTileCycles() const { return computeCycles + transferCycles; }
+
+    uint64_t getTotalCycles() const { return numOfTiles * getTileCycles(); }
+
+    void print(OStream& pOS) const;
+  };
+
+public:
+  static constexpr unsigned kNumOfAxes = 3;
+
+public:
+  TilingPlanner(const TargetTransformInfo& pTTI, uint64_t pLocalMemSize);
+
+  /// Find the best tile shape of @ref pSpGraph whose footprint is less than
+  /// the local memory. @ref pSpGraph is left split by the returned plan.
+  /// @retval false Even the smallest tiles don't fit.
+  bool plan(SplitGraph& pSpGraph, const FootprintFn& pFootprint,
+            Plan& pResult) const;
+
+  /// Split @ref pSpGraph by @ref pFactors and predict its cycles.
+  Plan evaluate(SplitGraph& pSpGraph, const Factors& pFactors,
+                const FootprintFn& pFootprint) const;
+
+  /// The distinct split factors of an axis of @ref pSize elements, which
+  /// give different tile sizes, in increasing order.
+  static std::vector<unsigned> GetCandidateFactors(int64_t pSize);
+
+private:
+  uint64_t getComputeCycles(SplitGraph& pSpGraph) const;
+
+  uint64_t getTransferCycles(SplitGraph& pSpGraph) const;
+
+private:
+  const TargetTransformInfo& m_TTI;
+  uint64_t m_LocalMemSize;
+};
+
+} // namespace of onnc
+
+#endif
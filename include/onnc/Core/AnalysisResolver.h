@@ -29,6 +29,9 @@ public:
 
   void add(Pass::AnalysisID pID, Pass& pPass);
 
+  /// @retval true The analysis @ref pID ran and no pass invalidated it since.
+  bool isValid(Pass::AnalysisID pID) const;
+
   unsigned int getNumOfPasses() const { return m_DepPasses.size(); }
 
 private:
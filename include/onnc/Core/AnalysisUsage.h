@@ -16,7 +16,8 @@ namespace onnc {
  *  \brief AnalysisUsage represents the analysis usage information of a pass.
  *
  *  An AnalysisUsage object analyses that the pass REQUIRES (must ran before the
- *  pass runs).
+ *  pass runs) and analyses that the pass PRESERVES (still valid after the pass
+ *  changes the module).
  */
 class AnalysisUsage
 {
@@ -28,7 +29,7 @@ public:
   typedef IDList::const_iterator const_iterator;
 
 public:
-  AnalysisUsage() { }
+  AnalysisUsage() : m_Required(), m_Preserved(), m_bPreservesAll(false) { }
 
   AnalysisUsage& addRequiredID(Pass::AnalysisID pID);
 
@@ -39,6 +40,26 @@ public:
     return addRequiredID(PassClass::ID);
   }
 
+  AnalysisUsage& addPreservedID(Pass::AnalysisID pID);
+
+  AnalysisUsage& addPreservedID(char& pID);
+
+  template<class PassClass>
+  AnalysisUsage& addPreserved() {
+    return addPreservedID(PassClass::ID);
+  }
+
+  /// The pass keeps all analyses valid, e.g., it only changes attributes
+  /// no analysis reads.
+  AnalysisUsage& setPreservesAll() {
+    m_bPreservesAll = true;
+    return *this;
+  }
+
+  bool getPreservesAll() const { return m_bPreservesAll; }
+
+  bool isPreserved(Pass::AnalysisID pID) const;
+
   iterator begin() { return m_Required.begin(); }
 
   iterator end()   { return m_Required.end(); }
@@ -51,6 +72,8 @@ public:
 
 private:
   IDList m_Required;
+  IDList m_Preserved;
+  bool m_bPreservesAll;
 };
 
 } // namespace of onnc
@@ -0,0 +1,60 @@
+//===- CompileCache.h -----------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef ONNC_CORE_COMPILE_CACHE_H
+#define ONNC_CORE_COMPILE_CACHE_H
+#include <onnc/ADT/StringRef.h>
+#include <onnc/Support/Path.h>
+#include <string>
+#include <vector>
+
+namespace onnc {
+
+/** \class onnc::CompileCache
+ *  \brief keeps the output files of compilations in a directory, addressed
+ *  by a key.
+ *
+ *  The key is the digest of everything the outputs depend on, e.g., the
+ *  model, the target and the options. An entry is the directory
+ *  <cache>/<key[0:2]>/<key> holding a copy of every output file. Entries are
+ *  written in a temporary directory and renamed into place, so readers never
+ *  see a partial entry, and a FileLock keeps concurrent compilers from
+ *  writing the same entry twice.
+ */
+class CompileCache
+{
+public:
+  typedef std::vector<Path> FileList;
+
+public:
+  CompileCache(const Path& pDirectory);
+
+  const Path& directory() const { return m_Directory; }
+
+  /// The entry directory of @ref pKey.
+  Path entry(StringRef pKey) const;
+
+  /// @retval true If the entry of @ref pKey has all of @ref pFiles.
+  bool contains(StringRef pKey, const FileList& pFiles) const;
+
+  /// Copy the cached @ref pFiles of @ref pKey to their places. Every file is
+  /// copied to a temporary file and renamed over the destination.
+  /// @retval false A miss. Some files may have been restored.
+  bool retrieve(StringRef pKey, const FileList& pFiles) const;
+
+  /// Copy @ref pFiles into the entry of @ref pKey. Files are kept by their
+  /// file names, which must be unique.
+  /// @retval false Fails to write the entry. The cache is left unchanged.
+  bool store(StringRef pKey, const FileList& pFiles) const;
+
+private:
+  Path m_Directory;
+};
+
+} // namespace of onnc
+
+#endif
@@ -26,7 +26,9 @@ void* InitializeMemoryAllocationPass(PassRegistry&);
 void* InitializeUpdateGraphOutputSizePass(PassRegistry&);
 void* InitializeNodeIRSchedulerPass(PassRegistry&);
 
+void InitializeMemoryAllocationPassOptions();
 void InitializeUpdateGraphOutputSizePassOptions();
+void InitializeNodeIRSchedulerPassOptions();
 
 } // namespace of onnc
 
@@ -78,6 +78,11 @@ public:
   /// This function should be overriden by passes that need analysis information.
   virtual void getAnalysisUsage(AnalysisUsage& pUsage) const { }
 
+  /// The result of an analysis stays valid until a pass changes the module
+  /// without preserving it. PassManager skips a valid analysis and reruns a
+  /// stale one before the passes requiring it.
+  virtual bool isAnalysis() const { return false; }
+
   void setResolver(AnalysisResolver& pResolver) { m_pResolver = &pResolver; }
 
   AnalysisResolver* getResolver() const { return m_pResolver; }
@@ -86,6 +91,9 @@ public:
 
   template<class AnalysisType> AnalysisType* getAnalysis() const;
 
+  /// @retval true The result of the required analysis is up to date.
+  template<class AnalysisType> bool isValidAnalysis() const;
+
   /// the 1st bit is set
   static bool IsRevised(ReturnType pR) { return (0x0 != (pR & kModuleChanged)); }
 
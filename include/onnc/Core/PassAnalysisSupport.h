@@ -8,6 +8,7 @@
 #ifndef ONNC_CORE_PASS_ANALYSIS_SUPPORT_H
 #define ONNC_CORE_PASS_ANALYSIS_SUPPORT_H
 #include <onnc/Core/Pass.h>
+#include <onnc/Core/AnalysisResolver.h>
 
 
 //===----------------------------------------------------------------------===//
@@ -20,4 +21,11 @@ AnalysisType* onnc::Pass::getAnalysis() const
   return (AnalysisType*)getResolver()->find(&AnalysisType::ID);
 }
 
+template<class AnalysisType>
+bool onnc::Pass::isValidAnalysis() const
+{
+  assert(hasResolver() && "Pass not reside a PassManager object!");
+  return getResolver()->isValid(&AnalysisType::ID);
+}
+
 #endif
@@ -14,13 +14,20 @@
 #include <onnc/IR/Module.h>
 #include <onnc/ADT/Digraph.h>
 #include <map>
+#include <set>
 
 namespace onnc {
 
+class PassTimingInfo;
 class TargetBackend;
 
 /** \class onnc::PassManager
  *  \brief stores a set of passes and run them.
+ *
+ *  PassManager caches the results of analyses (@see Pass::isAnalysis). A
+ *  valid analysis is skipped, and a pass that changes the module invalidates
+ *  every analysis it doesn't preserve (@see AnalysisUsage::addPreserved).
+ *  Stale analyses are rerun right before the passes requiring them.
  */
 class PassManager
 {
@@ -78,6 +85,18 @@ public:
 
   Pass* lookup(Pass::AnalysisID pID);
 
+  /// @retval true The analysis @ref pID ran and no pass invalidated it since.
+  bool isValid(Pass::AnalysisID pID) const;
+
+  /// Force the analysis @ref pID to run again, e.g., after changing the
+  /// module outside of passes.
+  void invalidate(Pass::AnalysisID pID);
+
+  /// Measure every pass run in @ref pInfo. nullptr stops measuring.
+  void setTimingInfo(PassTimingInfo* pInfo) { m_pTimingInfo = pInfo; }
+
+  PassTimingInfo* getTimingInfo() { return m_pTimingInfo; }
+
 private:
   struct DepNode : public DigraphNode<DepNode>
   {
@@ -109,6 +128,8 @@ private:
 
   typedef std::map<Pass::AnalysisID, DepNode*> AvailableAnalysisMap;
 
+  typedef std::set<Pass::AnalysisID> AnalysisSet;
+
 private:
   PassRegistry* getPassRegistry() { return m_pPassRegistry; }
 
@@ -129,6 +150,15 @@ private:
 
   void UpdateExecutionOrder(ExecutionOrder& pOrder);
 
+  /// Put the stale analyses the front pass of @ref pOrder requires in front
+  /// of it.
+  /// @retval true Some analysis is stale.
+  bool ScheduleStaleAnalyses(ExecutionOrder& pOrder);
+
+  /// Invalidate the analyses @ref pPass doesn't preserve if it changed the
+  /// module, and validate @ref pPass if it's an analysis.
+  void UpdateValidAnalyses(Pass& pPass, Pass::ReturnType pResult);
+
 private:
   PassRegistry* m_pPassRegistry;
 
@@ -141,6 +171,13 @@ private:
   State m_RunState;
 
   DepNode *m_pStart;
+
+  PassTimingInfo* m_pTimingInfo;
+
+  // the analyses whose results are up to date for m_pModule.
+  AnalysisSet m_ValidAnalyses;
+
+  const Module* m_pModule;
 };
 
 } // namespace of onnc
@@ -12,16 +12,20 @@
 #include <onnc/Support/ManagedStatic.h>
 #include <onnc/ADT/Uncopyable.h>
 #include <map>
+#include <mutex>
 
 namespace onnc {
 
 /** \class onnc::PassRegistry
  *  \brief stores a set of pass ID and its information.
+ *
+ *  PassRegistry is thread-safe. PassManagers in different threads may share
+ *  the global registry.
  */
 class PassRegistry : private Uncopyable
 {
 public:
-  PassRegistry() { }
+  PassRegistry() : m_Map(), m_Mutex() { }
 
   /// Delete all registered passes. All passes are delegated from
   /// INITIALIZE_PASS macro, PassRegistry is required to delete all PassInfo
@@ -49,6 +53,7 @@ private:
 
 private:
   MapType m_Map;
+  mutable std::mutex m_Mutex;
 };
 
 /// Get the singleton of the PassRegistry
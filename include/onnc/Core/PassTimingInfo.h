@@ -0,0 +1,92 @@
+//===- PassTimingInfo.h ---------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef ONNC_CORE_PASS_TIMING_INFO_H
+#define ONNC_CORE_PASS_TIMING_INFO_H
+#include <onnc/Core/Pass.h>
+#include <onnc/Support/OStream.h>
+#include <onnc/Support/Timer.h>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace onnc {
+
+/** \class onnc::PassTimingInfo
+ *  \brief collects the time and the memory every pass takes in a
+ *  PassManager.
+ *
+ *  print() shows a report like --time-passes and printTrace() writes the
+ *  runs in the Chrome trace event format, which chrome://tracing and
+ *  Perfetto load.
+ */
+class PassTimingInfo
+{
+public:
+  /// The sum of all runs of a pass.
+  struct Record
+  {
+    std::string name;
+    unsigned int runs;
+    unsigned int retries;
+    Timer::Interval wall;
+    Timer::Interval cpu;
+
+    /// The growth of the peak resident set size in bytes.
+    uint64_t rss;
+  };
+
+  typedef std::vector<Record> RecordList;
+
+public:
+  PassTimingInfo();
+
+  /// Start measuring @ref pPass. Runs don't nest.
+  void start(const Pass& pPass);
+
+  /// Stop measuring the pass started last.
+  /// @param pResult the result of the run. Retries are counted.
+  void stop(Pass::ReturnType pResult);
+
+  /// The records in the order the passes run first.
+  const RecordList& records() const { return m_Records; }
+
+  void clear();
+
+  /// Print the records from the slowest pass.
+  /// @param pTitle names the report in its header if it isn't empty.
+  void print(OStream& pOS, const std::string& pTitle = std::string()) const;
+
+  /// Print every run in the Chrome trace event format.
+  void printTrace(OStream& pOS) const;
+
+private:
+  /// A run of a pass.
+  struct Event
+  {
+    unsigned int record;
+    Timer::Interval start;
+    Timer::Interval wall;
+    Timer::Interval cpu;
+    uint64_t rss;
+    bool retry;
+  };
+
+  typedef std::map<Pass::AnalysisID, unsigned int> RecordMap;
+
+private:
+  RecordList m_Records;
+  RecordMap m_RecordMap;
+  std::vector<Event> m_Events;
+  Timer m_Timer;
+  Timer::Interval m_Origin;
+  uint64_t m_PeakRSS;
+};
+
+} // namespace of onnc
+
+#endif
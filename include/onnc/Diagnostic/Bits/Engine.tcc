@@ -16,13 +16,14 @@ namespace diagnostic {
 template<typename PolicyType>
 bool Engine::emit()
 {
-  Diagnostic info(m_State, m_InfoMap);
+  Diagnostic info(state(), m_InfoMap);
 
   // Change the severity. If --fatal-warnings turns on, then all warnings
   // is changed as fatal errors.
   bool emitted = PolicyType::process(m_Options, info);
 
   // Print out the message in Diagnostic.
+  std::lock_guard<std::mutex> guard(m_LoggerMutex);
   m_pLogger->handle(info);
   return emitted;
 }
@@ -15,6 +15,7 @@
 #include <onnc/Diagnostic/Diagnostic.h>
 #include <onnc/Support/DataTypes.h>
 #include <onnc/ADT/StringRef.h>
+#include <mutex>
 #include <string>
 
 namespace onnc {
@@ -24,6 +25,8 @@ class MsgHandler;
 
 /** \class Engine
  *  \brief Engine drives the diagnostic system to display information.
+ *
+ *  Threads can report at the same time.
  */
 class Engine
 {
@@ -59,13 +62,14 @@ private:
   friend class MsgHandler;
   friend class Diagnostic;
 
-  const State& state() const  { return m_State; }
-  State&       state()        { return m_State; }
+  /// Every thread fills its own report, so threads can report at the same
+  /// time.
+  State& state() const;
 
 private:
   GeneralOptions m_Options;
   Logger* m_pLogger;
-  State m_State;
+  mutable std::mutex m_LoggerMutex; ///< serializes the reports in the logger
   InfoMap m_InfoMap;
 };
 
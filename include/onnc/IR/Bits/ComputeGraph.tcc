@@ -52,21 +52,13 @@ ValueType* ComputeGraph::addValue(ValueCtorParams&& ... pParams)
 template<typename ValueType>
 ValueType* ComputeGraph::getValue(StringRef pName)
 {
-  ValueList::iterator entry = m_ValueList.find(pName);
-  if (m_ValueList.end() == entry)
-    return nullptr;
-
-  return static_cast<ValueType*>(entry->value());
+  return static_cast<ValueType*>(findValue(pName));
 }
 
 template<typename ValueType>
 const ValueType* ComputeGraph::getValue(StringRef pName) const
 {
-  ValueList::iterator entry = m_ValueList.find(pName);
-  if (m_ValueList.end() == entry)
-    return nullptr;
-
-  return static_cast<const ValueType*>(entry->value());
+  return static_cast<const ValueType*>(findValue(pName));
 }
 
 template<typename OpndType, typename ... ArcCtorParams>
@@ -74,7 +66,7 @@ OpndType* ComputeGraph::addOperand(Node& pU, Node& pV, ArcCtorParams&& ... pPara
 {
   // 1. create operand and insert into arc list
   OpndType* result = new OpndType(pParams...);
-  m_ArcList.insert(result);
+  this->addArc(result);
 
   // 2. set up arc
   result->source = &pU;
@@ -9,6 +9,7 @@
 #define ONNC_IR_COMPUTE_TENSOR_H
 #include <onnc/IR/Compute/Value.h>
 #include <onnc/Config/ONNX.h>
+#include <memory>
 #include <vector>
 
 namespace onnc {
@@ -43,6 +44,11 @@ protected:
 
 /** \class TensorT
  *  \brief TensorT is a placeholder of tensor in a network
+ *
+ *  The values are either owned by the tensor or borrowed from a buffer that
+ *  outlives it, e.g., the raw data of an initializer or a mapped file region.
+ *  Borrowed values are copied the first time they are accessed through
+ *  getValues(). Use getNumOfValues() and getValue() to read them in place.
  */
 template<typename ValueType, Value::Type Kind>
 class TensorT : public onnc::Tensor
@@ -52,25 +58,61 @@ public:
 
 public:
   TensorT()
-    : onnc::Tensor(Kind), m_Values() {
+    : onnc::Tensor(Kind), m_Values(), m_pView(nullptr), m_ViewSize(0) {
   }
 
   TensorT(const std::string& pName)
-    : onnc::Tensor(pName, Kind), m_Values() {
+    : onnc::Tensor(pName, Kind), m_Values(), m_pView(nullptr), m_ViewSize(0) {
   }
 
   TensorT(xTensor& pAdaptee)
-    : onnc::Tensor(Kind, pAdaptee), m_Values() {
+    : onnc::Tensor(Kind, pAdaptee), m_Values(), m_pView(nullptr),
+      m_ViewSize(0) {
   }
 
   virtual ~TensorT() { }
 
-  ValueList& getValues() { return m_Values; }
+  /// Borrow @ref pSize values at @ref pData without copying them.
+  /// @param pStorage keeps @ref pData alive if the caller doesn't.
+  void setValues(const ValueType* pData, size_t pSize,
+                 std::shared_ptr<const void> pStorage = nullptr) {
+    m_Values.clear();
+    m_pView = pData;
+    m_ViewSize = pSize;
+    m_Storage = std::move(pStorage);
+  }
+
+  /// @retval true the values are borrowed.
+  bool isView() const { return nullptr != m_pView; }
+
+  size_t getNumOfValues() const {
+    return isView() ? m_ViewSize : m_Values.size();
+  }
+
+  ValueType getValue(size_t pIdx) const {
+    return isView() ? m_pView[pIdx] : m_Values[pIdx];
+  }
+
+  /// Copy-on-write: borrowed values are copied before they can be mutated.
+  ValueList& getValues() { detach(); return m_Values; }
+
+  const ValueList& getValues() const { detach(); return m_Values; }
 
-  const ValueList& getValues() const { return m_Values; }
+private:
+  void detach() const {
+    if (!isView())
+      return;
+    m_Values.assign(m_pView, m_pView + m_ViewSize);
+    m_pView = nullptr;
+    m_ViewSize = 0;
+    m_Storage.reset();
+  }
 
 private:
-  ValueList m_Values;
+  mutable ValueList m_Values;
+  mutable const ValueType* m_pView;
+  mutable size_t m_ViewSize;
+  mutable std::shared_ptr<const void> m_Storage;
 };
 
 typedef TensorT<float,       onnc::Value::kFloat>   FloatTensor;
@@ -19,6 +19,7 @@
 #include <onnc/JSON/Value.h>
 #include <iosfwd>
 #include <set>
+#include <vector>
 
 namespace onnc {
 
@@ -91,6 +92,17 @@ public:
 
   void clear();
 
+  /// Keep the values and the operands added from now on in this graph
+  /// instead of the module. The values of the module are only read while
+  /// staging, so that graphs of one module can be built concurrently.
+  void stage();
+
+  /// Move the staged values and operands to the module in the order they
+  /// were added, and stop staging.
+  void commit();
+
+  bool isStaging() const { return m_bStaging; }
+
   void getRear(Node*& pNode) const { pNode = m_pNodeRear; }
 
   void getHead(Node*& pNode) const { pNode = m_pNodeHead; }
@@ -141,6 +153,12 @@ private:
 private:
   void addValueToModule(Value* pValue);
 
+  /// @return the value named @ref pName in the module or in the staged
+  ///         values, or nullptr.
+  Value* findValue(StringRef pName) const;
+
+  void addArc(Arc* pArc);
+
 private:
   Module& m_Module;
   std::string m_Name;
@@ -149,6 +167,11 @@ private:
   NodeList m_NodeList;
   ArcList& m_ArcList;
   ValueList& m_ValueList;
+
+  bool m_bStaging;
+  ValueList m_StagedValueList;
+  std::vector<Value*> m_StagedValues;
+  std::vector<Arc*> m_StagedArcs;
 };
 
 #include "Bits/ComputeGraph.tcc"
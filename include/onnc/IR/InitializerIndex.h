@@ -0,0 +1,54 @@
+//===- InitializerIndex.h -------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef ONNC_IR_INITIALIZER_INDEX_H
+#define ONNC_IR_INITIALIZER_INDEX_H
+#include <onnc/Config/ONNX.h>
+#include <string>
+#include <unordered_set>
+
+namespace onnc {
+
+/** \class InitializerIndex
+ *  \brief tells whether an input of a tensor graph is an initializer.
+ *
+ *  xGraph keeps the initializers as a list of names. The index hashes the
+ *  input values of those names once, and is kept up to date by adding and
+ *  erasing initializers through it. Initializers added to the graph
+ *  directly are not seen until the index is rebuilt.
+ */
+class InitializerIndex
+{
+public:
+  explicit InitializerIndex(xGraph& pGraph);
+
+  xGraph& graph() { return m_Graph; }
+
+  /// Index the initializers of the graph again.
+  void rebuild();
+
+  bool isInitializer(const xValue* pValue) const {
+    return (0 != m_Values.count(pValue));
+  }
+
+  /// Add an initializer to the graph and index its input value.
+  xValue* addInitializerAndInput(const xTensor& pTensor);
+
+  xValue* addInitializerAndInput(const xTensor& pTensor,
+                                 const std::string& pName);
+
+  /// Drop @ref pValue from the index and erase it from the graph.
+  void eraseInitializerAndInput(xValue* pValue);
+
+private:
+  xGraph& m_Graph;
+  std::unordered_set<const xValue*> m_Values;
+};
+
+} // namespace onnc
+
+#endif
@@ -27,7 +27,10 @@ public:
 
   virtual ~Reader();
 
-  /// parse ONNX file
+  /// parse ONNX file. The raw data of initializers are read from their
+  /// offsets after the graph is built, and external data are read from
+  /// files relative to @ref pFileName. The total bytes limit applies to
+  /// every other field, so the file may exceed 2 GB.
   /// @return error occurred in the parsing.
   SystemError parse(const Path& pFileName, Module& pModule);
 
@@ -38,6 +41,7 @@ public:
   /// parse ONNX file with file decriptor.
   /// @note It doesn't close the file descriptor. Users is responsible for
   /// closing the file.
+  /// @note External data are relative to the working directory.
   /// @return error occurred in the parsing.
   SystemError parse(int pFD, Module& pModule);
 
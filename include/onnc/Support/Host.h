@@ -18,6 +18,7 @@
 #endif
 #endif
 
+#include <onnc/Support/DataTypes.h>
 #include <string>
 
 namespace onnc {
@@ -34,6 +35,10 @@ namespace sys {
   /// Get the host quadruple.
   std::string GetHostQuadruple();
 
+  /// Get the peak resident set size of the process in bytes.
+  /// @retval 0 unknown.
+  uint64_t GetPeakRSS();
+
 } // namespace of sys
 } // namespace of onnc
 
@@ -9,6 +9,7 @@
 #define ONNC_SUPPORT_MANAGED_STATIC_H
 #include <onnc/ADT/Uncopyable.h>
 #include <onnc/Support/DataTypes.h>
+#include <atomic>
 
 namespace onnc {
 
@@ -25,7 +26,7 @@ template<typename T> struct object_deleter {
 class ManagedStaticBase
 {
 public:
-  bool isConstructed() const { return (NULL != m_Ptr); }
+  bool isConstructed() const { return (NULL != m_Ptr.load()); }
 
   void destroy() const;
 
@@ -35,10 +36,11 @@ protected:
 protected:
   // This should only be used as a static variable, which guarantees that this
   // will be zero initialized.
-  mutable void* m_Ptr;
+  mutable std::atomic<void*> m_Ptr;
   mutable DeleterFuncType m_pDeleter;
   mutable const ManagedStaticBase* m_pNext;
 
+  /// Construct the object once even if threads race for it.
   void RegisterManagedStatic(void *(*creator)(), void (*deleter)(void*)) const;
 
 };
@@ -47,6 +49,9 @@ protected:
  *  \brief ManagedStatic changes the behavior of global static variables to
  *  be lazily constructed on demand and explicitly destructed by Shutdown()
  *  function call.
+ *
+ *  The construction is thread-safe. Accesses to the object itself are
+ *  guarded by the object.
  */
 template<class C>
 class ManagedStatic : public ManagedStaticBase
@@ -55,47 +60,47 @@ public:
 
   // Accessors.
   C* operator&() {
-    void* tmp = m_Ptr;
+    void* tmp = m_Ptr.load(std::memory_order_acquire);
     if (NULL == tmp)
       RegisterManagedStatic(object_creator<C>, object_deleter<C>::call);
-    return static_cast<C*>(m_Ptr);
+    return static_cast<C*>(m_Ptr.load(std::memory_order_relaxed));
   }
 
   const C* operator&() const {
-    void* tmp = m_Ptr;
+    void* tmp = m_Ptr.load(std::memory_order_acquire);
     if (NULL == tmp)
       RegisterManagedStatic(object_creator<C>, object_deleter<C>::call);
-    return static_cast<C*>(m_Ptr);
+    return static_cast<C*>(m_Ptr.load(std::memory_order_relaxed));
   }
 
   C &operator*() {
-    void* tmp = m_Ptr;
+    void* tmp = m_Ptr.load(std::memory_order_acquire);
     if (NULL == tmp)
       RegisterManagedStatic(object_creator<C>, object_deleter<C>::call);
-    return *static_cast<C*>(m_Ptr);
+    return *static_cast<C*>(m_Ptr.load(std::memory_order_relaxed));
   }
 
   const C &operator*() const {
-    void* tmp = m_Ptr;
+    void* tmp = m_Ptr.load(std::memory_order_acquire);
     if (NULL == tmp)
       RegisterManagedStatic(object_creator<C>, object_deleter<C>::call);
-    return *static_cast<C*>(m_Ptr);
+    return *static_cast<C*>(m_Ptr.load(std::memory_order_relaxed));
   }
 
   C *operator->() {
-    void* tmp = m_Ptr;
+    void* tmp = m_Ptr.load(std::memory_order_acquire);
     if (NULL == tmp)
       RegisterManagedStatic(object_creator<C>, object_deleter<C>::call);
 
-    return static_cast<C*>(m_Ptr);
+    return static_cast<C*>(m_Ptr.load(std::memory_order_relaxed));
   }
 
   const C *operator->() const {
-    void* tmp = m_Ptr;
+    void* tmp = m_Ptr.load(std::memory_order_acquire);
     if (NULL == tmp)
       RegisterManagedStatic(object_creator<C>, object_deleter<C>::call);
 
-    return static_cast<C*>(m_Ptr);
+    return static_cast<C*>(m_Ptr.load(std::memory_order_relaxed));
   }
 };
 
@@ -0,0 +1,59 @@
+//===- SHA256.h -----------------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef ONNC_SUPPORT_SHA256_H
+#define ONNC_SUPPORT_SHA256_H
+#include <onnc/ADT/StringRef.h>
+#include <onnc/Support/DataTypes.h>
+#include <onnc/Support/Path.h>
+#include <string>
+
+namespace onnc {
+
+/** \class onnc::SHA256
+ *  \brief computes the SHA-256 digest (FIPS 180-4) of a stream of bytes.
+ *
+ *  The digest identifies contents, e.g., the key of a compile cache entry.
+ *  StringHasher hashes are too short for that.
+ */
+class SHA256
+{
+public:
+  static constexpr unsigned int kDigestSize = 32;
+
+public:
+  SHA256();
+
+  /// Append @ref pLength bytes at @ref pData to the message.
+  SHA256& update(const void* pData, size_t pLength);
+
+  SHA256& update(StringRef pData) { return update(pData.data(), pData.size()); }
+
+  /// Append the contents of the file @ref pFile to the message.
+  /// @retval false The file can not be read.
+  bool updateFile(const Path& pFile);
+
+  /// Finish the message. Can't update after it.
+  /// @return The digest in lower-case hexadecimal.
+  std::string final();
+
+  /// The digest of @ref pData in lower-case hexadecimal.
+  static std::string Hash(StringRef pData);
+
+private:
+  void transform(const uint8_t* pBlock);
+
+private:
+  uint32_t m_State[8];
+  uint8_t m_Block[64];
+  uint64_t m_Length;
+  unsigned int m_BlockSize;
+};
+
+} // namespace of onnc
+
+#endif
@@ -13,7 +13,8 @@
 namespace onnc {
 
 /** \class onnc::Timer
- *  \brief provides time-out signal.
+ *  \brief measures the wall-clock time and the CPU time of the process
+ *  between start() and stop().
  */
 class Timer
 {
@@ -27,16 +28,30 @@ public:
 
   bool isActive() const { return m_bIsActive; }
 
+  /// The wall-clock time of the last measurement.
   Interval interval() const { return m_Interval; }
 
+  /// The CPU time of the last measurement.
+  Interval cpuInterval() const { return m_CPUInterval; }
+
   void start();
 
   void stop();
 
   static std::string unit();
 
+  /// @return the wall-clock time from an arbitrary point in the past.
+  static Interval Now();
+
+  /// @return the CPU time the calling thread has used, or the process where
+  /// the time of a thread is not available.
+  static Interval ProcessTime();
+
 private:
+  Interval m_Start;
+  Interval m_CPUStart;
   Interval m_Interval;
+  Interval m_CPUInterval;
   bool m_bIsActive;
 };
 
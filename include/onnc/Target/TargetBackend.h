@@ -10,6 +10,7 @@
 #include <onnc/Core/PassManager.h>
 #include <onnc/Target/TargetOptions.h>
 #include <onnc/Support/Path.h>
+#include <vector>
 
 namespace onnc {
 
@@ -35,6 +36,11 @@ public:
 
   virtual void addCodeEmit(PassManager& pPM, const Path& pOutput) { return; }
 
+  /// The files the passes of addCodeEmit write for @ref pOutput. Compilations
+  /// without output files, e.g., printing to stdout, are never cached.
+  virtual void getOutputFiles(const Path& pOutput,
+                              std::vector<Path>& pFiles) const { return; }
+
   virtual const TargetTransformInfo* getTTI() const { return nullptr; }
 
   /// For the backend using standard TensorSel pass.
@@ -48,11 +48,33 @@ public:
 
   void useDummyWeight(bool pEnable = true) { m_AddDummyWeight = pEnable; }
 
+  /// This property holds whether writing the instructions as text, too
+  bool shouldPrintTextAsm() const { return m_PrintTextAsm; }
+
+  void printTextAsm(bool pEnable = true) { m_PrintTextAsm = pEnable; }
+
+  /// This property holds whether overlapping the loads and the stores of
+  /// sliced convolutions with their compute
+  bool shouldPipelineTiles() const { return m_PipelineTiles; }
+
+  void pipelineTiles(bool pEnable = true) { m_PipelineTiles = pEnable; }
+
+  /// This property holds the number of threads a pass may start. Zero is
+  /// the number of hardware threads.
+  unsigned int getNumOfThreads() const { return m_NumOfThreads; }
+
+  void setNumOfThreads(unsigned int pNumOfThreads) {
+    m_NumOfThreads = pNumOfThreads;
+  }
+
 private:
   bool m_PrintModuleBeforeSel;
   bool m_IgnoreCalibrationStep;
   bool m_AddDummyCTable;
   bool m_AddDummyWeight;
+  bool m_PrintTextAsm;
+  bool m_PipelineTiles;
+  unsigned int m_NumOfThreads;
 };
 
 } // namespace onnc
@@ -15,6 +15,9 @@ namespace onnc {
 
 /** \class TargetRegistry
  *  \brief TargetRegistry bookkeeps Target objects.
+ *
+ *  Registration and Lookup() are thread-safe. Iterators aren't, so iterate
+ *  the targets after all targets are registered.
  */
 class TargetRegistry
 {
@@ -75,6 +75,12 @@ public:
     return MemSize();
   }
 
+  /// Get the cycles moving data between the global memory and the local
+  /// memory.
+  /// @param pSize The memory usage of the data, as getOperatorInputMemUsage
+  ///        and getOperatorOutputMemUsage report.
+  virtual uint64_t getTransferCost(uint64_t pSize) const { return 0; }
+
   /// Expose coarse grained execution units infomation, so scheduler can use
   /// it to scheduling graph IR.
   virtual const ExeResource *queryExeResType(const xNode *pNode) const {
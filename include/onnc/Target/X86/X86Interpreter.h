@@ -0,0 +1,120 @@
+//===- X86Interpreter.h ---------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef ONNC_TARGET_X86_X86_INTERPRETER_H
+#define ONNC_TARGET_X86_X86_INTERPRETER_H
+#include <onnc/IR/ComputeGraph.h>
+#include <onnc/IR/ComputeOperator.h>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace onnc {
+
+class X86Scheduler;
+
+/** \class X86Interpreter
+ *  \brief Execute a compute graph on the host with the X86 kernel library.
+ *
+ *  The interpreter binds every value to the region recorded on its
+ *  ComputeMemOperand by the memory allocation pass, copies the initializers
+ *  into the weight space, and runs the operators in the order of the compute
+ *  graph. Every operator is dispatched through a table keyed by the
+ *  operator's type ID.
+ *
+ *  With more than one thread, a step starts as soon as all the steps it
+ *  depends on are done. A step depends on the earlier steps that write the
+ *  memory it reads, and on the earlier steps that access the memory it
+ *  writes, since the memory plan reuses regions in the serial order.
+ */
+class X86Interpreter
+{
+public:
+  typedef void (*Kernel)(X86Interpreter& pInterpreter,
+                         const ComputeOperator& pOperator);
+
+  struct Step
+  {
+    const ComputeOperator* op;
+    Kernel kernel;
+
+    /// The indices of the steps depending on this one.
+    std::vector<unsigned int> successors;
+
+    /// The number of steps this one depends on.
+    unsigned int degree;
+  };
+
+  typedef std::vector<Step> Plan;
+
+  typedef std::vector<const onnc::Value*> ValueList;
+
+  static constexpr uint64_t kAlignment = 64;
+
+public:
+  X86Interpreter();
+
+  ~X86Interpreter();
+
+  /// Bind the values of @ref pCG to memory and build the execution plan.
+  /// @retval false An operator has no kernel or a value has no memory.
+  bool prepare(const ComputeGraph& pCG);
+
+  /// Run the plan once.
+  /// @param pStepTimes If not null, the time of step i in nanoseconds is
+  ///                   added to the i-th element.
+  void run(std::vector<uint64_t>* pStepTimes = nullptr);
+
+  /// Run the independent steps on @ref pNumOfThreads threads, including the
+  /// calling one. One thread runs the plan serially.
+  void setNumOfThreads(unsigned int pNumOfThreads);
+
+  unsigned int getNumOfThreads() const;
+
+  const Plan& plan() const { return m_Plan; }
+
+  /// The values produced by the input operators.
+  const ValueList& inputs() const { return m_Inputs; }
+
+  /// The values consumed by the output operators.
+  const ValueList& outputs() const { return m_Outputs; }
+
+  /// @return the memory of @ref pValue, or nullptr if @ref pValue is never
+  ///         read and therefore not allocated.
+  void* getMemory(const onnc::Value& pValue) const;
+
+  uint64_t getWeightMemSize() const { return m_WeightSize; }
+
+  uint64_t getNeuronMemSize() const { return m_NeuronSize; }
+
+  /// @return the kernel of the operator type @ref pID, or nullptr.
+  static Kernel Lookup(ComputeOperator::OperatorTypeID pID);
+
+private:
+  typedef std::unordered_map<const onnc::Value*, void*> MemoryMap;
+
+private:
+  void clear();
+
+  void runSerially(std::vector<uint64_t>* pStepTimes);
+
+private:
+  std::vector<char> m_WeightSpace;
+  std::vector<char> m_NeuronSpace;
+  uint64_t m_WeightSize;
+  uint64_t m_NeuronSize;
+  MemoryMap m_Memory;
+  Plan m_Plan;
+  ValueList m_Inputs;
+  ValueList m_Outputs;
+  std::unique_ptr<X86Scheduler> m_pScheduler;
+};
+
+} // namespace onnc
+
+#endif
@@ -10,12 +10,18 @@
 #include <onnc/Transforms/GraphBuildingPass.h>
 #include <onnc/Target/TargetBackend.h>
 #include <onnc/Transforms/TensorSel/LowerRegistry.h>
+#include <vector>
 
 namespace onnc {
 
 /** \class TensorSel
  *  \brief TensorSel converts ONNX node to ComputeOperator and creates
  *  ComputeGraph objects for subgraph in ONNX.
+ *
+ *  Graphs whose value names don't appear in any other graph are lowered
+ *  concurrently. Each of them stages its values in its ComputeGraph, and the
+ *  staged values are committed to the module in the order of the graphs, so
+ *  the module is the same as lowering the graphs one by one.
  */
 class TensorSel : public GraphBuildingPass
 {
@@ -33,11 +39,47 @@ public:
 
   StringRef getPassName() const override { return "TensorSel"; }
 
+  /// The maximum number of threads lowering graphs. One lowers the graphs
+  /// sequentially. Default is TargetOptions::getNumOfThreads() of the
+  /// backend, or the number of hardware threads if it is zero.
+  void setNumOfThreads(unsigned int pNumOfThreads);
+
+  unsigned int getNumOfThreads() const { return m_NumOfThreads; }
+
+  Pass::ReturnType runOnModule(::onnc::Module& pModule) override;
+
   Pass::ReturnType runOnGraphs(xGraph& pTG, ComputeGraph& pCG) override;
 
+private:
+  typedef std::vector<Lower*> LowerList;
+
+  struct GraphJob
+  {
+    GraphJob(xGraph& pTG, ComputeGraph& pCG)
+      : tg(&pTG), cg(&pCG), lowers(), independent(true) {
+    }
+
+    xGraph* tg;
+    ComputeGraph* cg;
+    LowerList lowers;
+    bool independent;
+  };
+
+  typedef std::vector<GraphJob> GraphJobList;
+
+private:
+  /// Find the lower of every node, and mark the graphs sharing value names
+  /// with other graphs.
+  /// @retval false some node has no lower.
+  bool prepare(GraphJobList& pJobs);
+
+  /// Activate the lowers of @ref pJob in the order of the nodes.
+  static void activate(GraphJob& pJob);
+
 protected:
   const TargetBackend* m_pBackend;
   LowerRegistry m_LowerRegistry;
+  unsigned int m_NumOfThreads;
 };
 
 ModulePass *CreateTensorSel(const TargetBackend* pBackend);
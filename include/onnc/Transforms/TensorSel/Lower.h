@@ -11,6 +11,7 @@
 #include <onnc/IR/ComputeGraph.h>
 #include <onnc/Config/ONNX.h>
 #include <string>
+#include <vector>
 
 namespace onnc {
 
@@ -22,6 +23,8 @@ class Lower
 public:
   typedef int (*QualityMatchFnTy)(const xNode&);
 
+  typedef std::vector<xNodeKind> KindList;
+
   enum Score : int {
     kUndefined = -1,
     kNotMe = 0,
@@ -32,6 +35,13 @@ public:
   };
 
 public:
+  /// A lower which may match nodes of any kind.
+  Lower();
+
+  /// A lower which only matches nodes of @ref pKind. LowerRegistry asks
+  /// isMe() only for the nodes of the declared kinds.
+  explicit Lower(xNodeKind pKind);
+
   virtual ~Lower() = 0;
 
   /// If a backend doesn't want to use single quailty-match function, then
@@ -55,9 +65,16 @@ public:
 
   void setName(const std::string& pName) { m_Name = pName; }
 
+  /// The kinds of nodes this lower matches. Empty if it may match any kind.
+  const KindList& getKinds() const { return m_Kinds; }
+
+protected:
+  void addKind(xNodeKind pKind) { m_Kinds.push_back(pKind); }
+
 protected:
   std::string m_Name;
   QualityMatchFnTy m_MatchFn;
+  KindList m_Kinds;
 };
 
 } // namespace of onnc
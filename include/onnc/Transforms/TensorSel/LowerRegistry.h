@@ -9,10 +9,14 @@
 #define ONNC_TRANSFORM_LOWER_REGISTRY_H
 #include <onnc/Transforms/TensorSel/Lower.h>
 #include <onnc/ADT/StringRef.h>
+#include <unordered_map>
 
 namespace onnc {
 
 /** \class LowerRegistry
+ *  The registry buckets lowers by the node kinds they declare. lookup()
+ *  only scores the lowers declaring the kind of the node and the lowers
+ *  declaring no kind.
  */
 class LowerRegistry
 {
@@ -46,19 +50,39 @@ public:
 
   void clear();
 
+  /// @return the lower with the highest score. Among lowers with the same
+  ///         score, the last registered one.
+  /// @retval nullptr no lower matches @ref pNode.
   Lower* lookup(const xNode& pNode);
 
   const Lower* lookup(const xNode& pNode) const;
 
+private:
+  /// Indices to m_LowerList, in registration order.
+  typedef std::vector<unsigned int> IndexList;
+
+  typedef std::unordered_map<xNodeKind, IndexList> KindLowerMap;
+
+private:
+  /// Take the ownership of @ref pLower and bucket it by kinds.
+  void add(Lower* pLower);
+
+  /// @return the index of the selected lower, or -1.
+  int select(const xNode& pNode) const;
+
 private:
   LowerList m_LowerList;
+  KindLowerMap m_KindLowers;
+
+  /// Lowers which may match nodes of any kind.
+  IndexList m_AnyKindLowers;
 };
 
 template<typename LowerType, typename ... LowerParams>
 Lower* LowerRegistry::emplace(LowerParams&& ... pParams)
 {
   LowerType* lower = new LowerType(pParams...);
-  m_LowerList.push_back(lower);
+  add(lower);
   return lower;
 }
 
@@ -67,7 +91,7 @@ LowerRegistry::emplace(Lower::QualityMatchFnTy pMatchFn, LowerParams&& ... pPara
 {
   LowerType* lower = new LowerType(pParams...);
   lower->setQualityMatchFn(pMatchFn);
-  m_LowerList.push_back(lower);
+  add(lower);
   return lower;
 }
 
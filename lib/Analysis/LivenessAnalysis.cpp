@@ -9,55 +9,18 @@
 #include <onnc/Core/InitializePasses.h>
 #include <onnc/Core/ModulePass.h>
 #include <onnc/Core/PassSupport.h>
-#include <unordered_map>
 #include <iosfwd>
 #include <cassert>
 #include <algorithm>
-#include <unordered_map>
-#include <unordered_set>
 
 using namespace onnc;
 
-typedef std::unordered_map<xValue *, unsigned> ValueIdxMap;
-typedef std::unordered_map<xNode *, unsigned> NodeIdxMap;
-
-//===----------------------------------------------------------------------===//
-// Non-member functions
-//===----------------------------------------------------------------------===//
-static void BuildVirtualIndex(xGraph &pGraph,
-                              ValueIdxMap &pValueVirIdxMap,
-                              NodeIdxMap &pNodeVirIdxMap)
-{
-  // Given:
-  //    %1     = f(%d0, %d1)
-  //    %2     = g(%1)
-  //    %3, %4 = h(%2)
-  // Result:
-  //    VirIdx
-  //    0       %1     = f(%d0, %d1)
-  //    1       %2     = g(%1)
-  //    2       %3, %4 = h(%2)
-  //
-  // Virtual index start from 'zero', the first node has index 0.
-  unsigned virIdx = 0;
-
-  // assign virtual index to each node's output.
-  for (xNode *n : pGraph.nodes()) {
-    if (n->kind() == xBuiltinSymbol::kUndefined)
-      continue;
-
-    for (xValue *v : n->outputs())
-      pValueVirIdxMap[v] = virIdx;
-    pNodeVirIdxMap[n] = virIdx++;
-  }
-}
-
 //===----------------------------------------------------------------------===//
 // LiveInterval
 //===----------------------------------------------------------------------===//
 LiveInterval::LiveInterval(SlotIndex pStart, SlotIndex pEnd,
                            const xValue &pValue)
-    : m_Start(pStart), m_End(pEnd), m_Value(pValue) {
+    : m_Start(pStart), m_End(pEnd), m_Value(&pValue) {
   assert(m_Start <= m_End && "Invalid live interval.");
 }
 
@@ -70,7 +33,8 @@ bool LiveInterval::intersect(const LiveInterval& pLive) const
 // GraphLivenessAnalysis
 //===----------------------------------------------------------------------===//
 GraphLivenessAnalysis::GraphLivenessAnalysis()
-  : ModulePass(ID), m_LiveIntervals() {
+  : ModulePass(ID), m_LiveIntervals(), m_ValueSlots(), m_Outputs(),
+    m_Inputs(), m_Run(0) {
 }
 
 Pass::ReturnType GraphLivenessAnalysis::runOnModule(Module &pModule)
@@ -87,81 +51,93 @@ Pass::ReturnType GraphLivenessAnalysis::runOnGraph(xGraph &pGraph)
 
 void GraphLivenessAnalysis::print(std::ostream& pOS) const
 {
-  for (const LiveInterval *li : m_LiveIntervals) {
-    pOS << li->getValue().uniqueName()
-        << " [" << li->getStart() << ", " << li->getEnd() << "]"
+  for (const LiveInterval& li : m_LiveIntervals) {
+    pOS << li.getValue().uniqueName()
+        << " [" << li.getStart() << ", " << li.getEnd() << "]"
         << "\n";
   }
 }
 
+GraphLivenessAnalysis::ValueSlot&
+GraphLivenessAnalysis::getSlot(const xValue& pValue)
+{
+  if (pValue.unique() >= m_ValueSlots.size())
+    m_ValueSlots.resize(pValue.unique() + 1, ValueSlot{ 0, 0, 0, 0, false });
+  return m_ValueSlots[pValue.unique()];
+}
+
 void GraphLivenessAnalysis::calculateLiveness(xGraph &pGraph)
 {
+  // Given:
+  //    %1     = f(%d0, %d1)
+  //    %2     = g(%1)
+  //    %3, %4 = h(%2)
+  // Result:
+  //    VirIdx
+  //    0       %1     = f(%d0, %d1)
+  //    1       %2     = g(%1)
+  //    2       %3, %4 = h(%2)
+  //
+  // Virtual index start from 'zero', the first node has index 0. Nodes are
+  // visited in order, so the last visiting use of a value is its end.
   clear();
+  ++m_Run;
 
-  // Basically, node's virtual index value can be calculated from it's output
-  // value (onnx::Value), but some of nodes may not have output, so use
-  // nodeVirIdxMap to record each node's index.
-  std::unordered_map<xValue *, unsigned> valueVirIdxMap;
-  std::unordered_map<xNode *, unsigned> nodeVirIdxMap;
-  BuildVirtualIndex(pGraph, valueVirIdxMap, nodeVirIdxMap);
-
-  // Values that have been visited.
-  std::unordered_set<xValue *> visited;
-
-  // calculate live range for each output of a node
+  unsigned virIdx = 0;
   for (xNode *n : pGraph.nodes()) {
     if (n->kind() == xBuiltinSymbol::kUndefined)
       continue;
 
-    for (xValue *v : n->outputs()) {
-      unsigned start = valueVirIdxMap[v];
-      unsigned end = start;
-      for(auto u : v->uses())
-        end = std::max(end, nodeVirIdxMap[u.user]);
+    for (xValue *v : n->inputs()) {
+      ValueSlot& slot = getSlot(*v);
+      if (slot.run != m_Run) {
+        // graph's input parameters live from the first use.
+        slot = ValueSlot{ m_Run, virIdx, virIdx, 0, false };
+        m_Inputs.push_back(v);
+      }
+      slot.end = virIdx;
+      ++slot.uses;
+    }
 
-      visited.insert(v);
-      m_LiveIntervals.push_back(new LiveInterval(start, end, *v));
+    for (xValue *v : n->outputs()) {
+      ValueSlot& slot = getSlot(*v);
+      slot = ValueSlot{ m_Run, virIdx, virIdx, 0, true };
+      m_Outputs.push_back(v);
     }
+    ++virIdx;
   } // for each node
 
-  // calculate live range graph's input parameters.
+  // calculate live range for each output of a node
+  m_LiveIntervals.reserve(m_Outputs.size() + m_Inputs.size());
+  for (xValue *v : m_Outputs) {
+    const ValueSlot& slot = getSlot(*v);
+    m_LiveIntervals.emplace_back(slot.start, slot.end, *v);
+  }
+
   // input parameters' live range dependent on the first and last node which
-  // use this input.
-  for (xNode *n : pGraph.nodes()) {
-    if (n->kind() == xBuiltinSymbol::kUndefined)
+  // use this input. A use out of the visited nodes (e.g. the return node)
+  // counts as index 0.
+  for (xValue *v : m_Inputs) {
+    const ValueSlot& slot = getSlot(*v);
+    if (slot.defined)
       continue;
 
-    unsigned nVid = nodeVirIdxMap[n];
-    for (xValue *v : n->inputs()) {
-      if (visited.count(v))
-        continue;
-
-      unsigned start = nVid;
-      unsigned end = nVid;
-      for(auto u : v->uses()) {
-        unsigned uVid = nodeVirIdxMap[u.user];
-        start = std::min(start, uVid);
-        end = std::max(end, uVid);
-      }
-
-      visited.insert(v);
-      m_LiveIntervals.push_back(new LiveInterval(start, end, *v));
-    }
-  } // for each node
+    unsigned start = (slot.uses < v->uses().size()) ? 0 : slot.start;
+    m_LiveIntervals.emplace_back(start, slot.end, *v);
+  }
 
   // Sort live intervals by start slot.
   std::sort(m_LiveIntervals.begin(), m_LiveIntervals.end(),
-            [](const LiveInterval* lia, const LiveInterval* lib) {
-              return lia->getStart() < lib->getStart();
+            [](const LiveInterval& lia, const LiveInterval& lib) {
+              return lia.getStart() < lib.getStart();
             });
 }
 
 void GraphLivenessAnalysis::clear()
 {
-  for (LiveInterval* live: m_LiveIntervals) {
-    delete live;
-  }
   m_LiveIntervals.clear();
+  m_Outputs.clear();
+  m_Inputs.clear();
 }
 
 //===----------------------------------------------------------------------===//
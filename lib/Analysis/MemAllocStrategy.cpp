@@ -0,0 +1,238 @@
+//===- MemAllocStrategy.cpp -----------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <onnc/Analysis/MemAllocStrategy.h>
+#include <onnc/Analysis/MemRegionTree.h>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <queue>
+
+using namespace onnc;
+
+//===----------------------------------------------------------------------===//
+// Non-member functions
+//===----------------------------------------------------------------------===//
+static inline bool IsLiveTogether(const MemAllocRequest& pA,
+                                  const MemAllocRequest& pB)
+{
+  return !(pA.end < pB.start || pB.end < pA.start);
+}
+
+/// Place request @ref pIdx in the smallest gap between the placed requests
+/// live at the same time, or above all of them if no gap is large enough.
+/// @param pPlaced the placed requests, sorted by address.
+/// @return the end address of the request.
+static size_t PlaceBestFit(MemAllocRequestList& pRequests,
+                           std::vector<unsigned>& pPlaced, unsigned pIdx)
+{
+  MemAllocRequest& request = pRequests[pIdx];
+  size_t prevEnd = 0;
+  size_t bestAddr = 0, bestGap = std::numeric_limits<size_t>::max();
+  bool found = false;
+  for (unsigned idx : pPlaced) {
+    const MemAllocRequest& placed = pRequests[idx];
+    if (!IsLiveTogether(placed, request))
+      continue;
+
+    if (placed.address > prevEnd) {
+      size_t gap = placed.address - prevEnd;
+      if (gap >= request.size && gap < bestGap) {
+        bestAddr = prevEnd;
+        bestGap = gap;
+        found = true;
+      }
+    }
+    prevEnd = std::max(prevEnd, placed.address + placed.size);
+  }
+  request.address = found ? bestAddr : prevEnd;
+
+  std::vector<unsigned>::iterator pos = std::upper_bound(
+      pPlaced.begin(), pPlaced.end(), request.address,
+      [&pRequests] (size_t pAddr, unsigned pB) {
+        return pAddr < pRequests[pB].address;
+      });
+  pPlaced.insert(pos, pIdx);
+  return request.address + request.size;
+}
+
+/// Place the requests with best fit in the given order.
+/// @return the peak memory size.
+static size_t PlaceBestFit(MemAllocRequestList& pRequests,
+                           const std::vector<unsigned>& pOrder)
+{
+  std::vector<unsigned> placed;
+  placed.reserve(pRequests.size());
+  size_t minSize = 0;
+  for (unsigned idx : pOrder)
+    minSize = std::max(minSize, PlaceBestFit(pRequests, placed, idx));
+  return minSize;
+}
+
+size_t onnc::AllocByLiveness(MemAllocRequestList& pRequests)
+{
+  // visit the requests by start slot.
+  std::vector<unsigned> order(pRequests.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&pRequests] (unsigned pA, unsigned pB) {
+                     return pRequests[pA].start < pRequests[pB].start;
+                   });
+
+  // the regions live at the current slot, and the order they expire in.
+  typedef std::pair<unsigned, MemRegionTree::Handle> Expiry;
+  std::priority_queue<Expiry, std::vector<Expiry>,
+                      std::greater<Expiry> > expiries;
+  MemRegionTree active;
+
+  size_t minSize = 0;
+  for (unsigned idx : order) {
+    MemAllocRequest& request = pRequests[idx];
+    while (!expiries.empty() && expiries.top().first < request.start) {
+      active.erase(expiries.top().second);
+      expiries.pop();
+    }
+
+    request.address = active.findFirstFit(request.size);
+    expiries.emplace(request.end,
+                     active.insert(request.address, request.size));
+    minSize = std::max(minSize, request.address + request.size);
+  }
+  return minSize;
+}
+
+//===----------------------------------------------------------------------===//
+// MemAllocStrategy
+//===----------------------------------------------------------------------===//
+const std::vector<const MemAllocStrategy*>& MemAllocStrategy::GetPlacements()
+{
+  static const FirstFitStrategy first_fit;
+  static const BestFitBySizeStrategy best_fit_by_size;
+  static const GreedyByBreadthStrategy greedy_by_breadth;
+  static const std::vector<const MemAllocStrategy*> placements = {
+    &first_fit, &best_fit_by_size, &greedy_by_breadth
+  };
+  return placements;
+}
+
+const MemAllocStrategy* MemAllocStrategy::Lookup(StringRef pName)
+{
+  static const MinPeakStrategy min_peak;
+  if (pName == min_peak.name())
+    return &min_peak;
+
+  for (const MemAllocStrategy* strategy : GetPlacements())
+    if (pName == strategy->name())
+      return strategy;
+  return nullptr;
+}
+
+//===----------------------------------------------------------------------===//
+// FirstFitStrategy
+//===----------------------------------------------------------------------===//
+size_t FirstFitStrategy::allocate(MemAllocRequestList& pRequests) const
+{
+  return AllocByLiveness(pRequests);
+}
+
+//===----------------------------------------------------------------------===//
+// BestFitBySizeStrategy
+//===----------------------------------------------------------------------===//
+size_t BestFitBySizeStrategy::allocate(MemAllocRequestList& pRequests) const
+{
+  std::vector<unsigned> order(pRequests.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&pRequests] (unsigned pA, unsigned pB) {
+                     return pRequests[pA].size > pRequests[pB].size;
+                   });
+  return PlaceBestFit(pRequests, order);
+}
+
+//===----------------------------------------------------------------------===//
+// GreedyByBreadthStrategy
+//===----------------------------------------------------------------------===//
+size_t GreedyByBreadthStrategy::allocate(MemAllocRequestList& pRequests) const
+{
+  if (pRequests.empty())
+    return 0;
+
+  // the number of live bytes at every slot.
+  unsigned numOfSlots = 0;
+  for (const MemAllocRequest& request : pRequests)
+    numOfSlots = std::max(numOfSlots, request.end + 1);
+
+  std::vector<size_t> breadth(numOfSlots + 1, 0);
+  for (const MemAllocRequest& request : pRequests) {
+    breadth[request.start] += request.size;
+    breadth[request.end + 1] -= request.size;
+  }
+  std::partial_sum(breadth.begin(), breadth.end(), breadth.begin());
+  breadth.pop_back();
+
+  // rank the slots from the broadest one.
+  std::vector<unsigned> slots(numOfSlots);
+  std::iota(slots.begin(), slots.end(), 0);
+  std::stable_sort(slots.begin(), slots.end(),
+                   [&breadth] (unsigned pA, unsigned pB) {
+                     return breadth[pA] > breadth[pB];
+                   });
+
+  // a value is placed when its broadest slot is visited. Find the best rank
+  // in its live range with a sparse table of range minimums.
+  std::vector<std::vector<unsigned> > minRank(1,
+                                              std::vector<unsigned>(numOfSlots));
+  for (unsigned i = 0; i < numOfSlots; ++i)
+    minRank[0][slots[i]] = i;
+  for (unsigned k = 1; (1u << k) <= numOfSlots; ++k) {
+    const std::vector<unsigned>& prev = minRank[k - 1];
+    std::vector<unsigned> level(numOfSlots - (1u << k) + 1);
+    for (unsigned i = 0; i < level.size(); ++i)
+      level[i] = std::min(prev[i], prev[i + (1u << (k - 1))]);
+    minRank.push_back(std::move(level));
+  }
+
+  std::vector<unsigned> rank(pRequests.size());
+  for (unsigned i = 0; i < pRequests.size(); ++i) {
+    const MemAllocRequest& request = pRequests[i];
+    unsigned k = 0;
+    while ((2u << k) <= request.end - request.start + 1)
+      ++k;
+    rank[i] = std::min(minRank[k][request.start],
+                       minRank[k][request.end + 1 - (1u << k)]);
+  }
+
+  std::vector<unsigned> order(pRequests.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&pRequests, &rank] (unsigned pA, unsigned pB) {
+                     if (rank[pA] != rank[pB])
+                       return rank[pA] < rank[pB];
+                     return pRequests[pA].size > pRequests[pB].size;
+                   });
+  return PlaceBestFit(pRequests, order);
+}
+
+//===----------------------------------------------------------------------===//
+// MinPeakStrategy
+//===----------------------------------------------------------------------===//
+size_t MinPeakStrategy::allocate(MemAllocRequestList& pRequests) const
+{
+  MemAllocRequestList best;
+  size_t minSize = std::numeric_limits<size_t>::max();
+  for (const MemAllocStrategy* strategy : GetPlacements()) {
+    MemAllocRequestList requests(pRequests);
+    size_t size = strategy->allocate(requests);
+    if (size < minSize) {
+      minSize = size;
+      best.swap(requests);
+    }
+  }
+  pRequests.swap(best);
+  return minSize;
+}
@@ -0,0 +1,208 @@
+//===- MemRegionTree.cpp --------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <onnc/Analysis/MemRegionTree.h>
+#include <algorithm>
+#include <cassert>
+
+using namespace onnc;
+
+//===----------------------------------------------------------------------===//
+// Non-member functions
+//===----------------------------------------------------------------------===//
+/// The free space between an end address and the next start address.
+static inline size_t Gap(size_t pEnd, size_t pStart)
+{
+  return (pStart > pEnd) ? pStart - pEnd : 0;
+}
+
+//===----------------------------------------------------------------------===//
+// MemRegionTree
+//===----------------------------------------------------------------------===//
+MemRegionTree::MemRegionTree()
+  : m_Nodes(), m_FreeList(), m_Root(kNil), m_Size(0), m_Seed(2463534242u) {
+}
+
+MemRegionTree::Handle MemRegionTree::insert(size_t pStart, size_t pSize)
+{
+  Handle handle;
+  if (m_FreeList.empty()) {
+    handle = m_Nodes.size();
+    m_Nodes.emplace_back();
+  }
+  else {
+    handle = m_FreeList.back();
+    m_FreeList.pop_back();
+  }
+
+  // xorshift32
+  m_Seed ^= m_Seed << 13;
+  m_Seed ^= m_Seed >> 17;
+  m_Seed ^= m_Seed << 5;
+
+  Node& node = m_Nodes[handle];
+  node.start = pStart;
+  node.end = pStart + pSize;
+  node.priority = m_Seed;
+  node.left = kNil;
+  node.right = kNil;
+  update(handle);
+
+  int left, right;
+  split(m_Root, handle, left, right);
+  m_Root = merge(merge(left, handle), right);
+  ++m_Size;
+  return handle;
+}
+
+void MemRegionTree::erase(Handle pHandle)
+{
+  assert(pHandle < m_Nodes.size() && "invalid handle");
+
+  // the node is the first one in the right part of the split.
+  int left, right;
+  split(m_Root, pHandle, left, right);
+
+  int parent = kNil, node = right;
+  while (m_Nodes[node].left != kNil) {
+    parent = node;
+    node = m_Nodes[node].left;
+  }
+  assert(node == (int)pHandle && "the handle isn't in the tree");
+
+  if (kNil == parent)
+    right = m_Nodes[node].right;
+  else {
+    // rebuild the summaries on the leftmost path.
+    m_Nodes[parent].left = m_Nodes[node].right;
+    std::vector<int> path;
+    for (int n = right; n != parent; n = m_Nodes[n].left)
+      path.push_back(n);
+    path.push_back(parent);
+    for (auto n = path.rbegin(); n != path.rend(); ++n)
+      update(*n);
+  }
+
+  m_Root = merge(left, right);
+  m_FreeList.push_back(pHandle);
+  --m_Size;
+}
+
+size_t MemRegionTree::findFirstFit(size_t pSize) const
+{
+  size_t addr;
+  if (find(m_Root, 0, pSize, addr))
+    return addr;
+  return getEnd();
+}
+
+size_t MemRegionTree::getEnd() const
+{
+  return (kNil == m_Root) ? 0 : m_Nodes[m_Root].maxEnd;
+}
+
+void MemRegionTree::clear()
+{
+  m_Nodes.clear();
+  m_FreeList.clear();
+  m_Root = kNil;
+  m_Size = 0;
+}
+
+bool MemRegionTree::less(int pA, int pB) const
+{
+  const Node& a = m_Nodes[pA];
+  const Node& b = m_Nodes[pB];
+  if (a.start != b.start)
+    return a.start < b.start;
+  if (a.end != b.end)
+    return a.end < b.end;
+  return pA < pB;
+}
+
+void MemRegionTree::update(int pNode)
+{
+  Node& node = m_Nodes[pNode];
+  node.minStart = node.start;
+  node.maxEnd = node.end;
+  node.maxGap = 0;
+
+  if (kNil != node.left) {
+    const Node& left = m_Nodes[node.left];
+    node.minStart = left.minStart;
+    node.maxGap = std::max(left.maxGap, Gap(left.maxEnd, node.start));
+    node.maxEnd = std::max(node.maxEnd, left.maxEnd);
+  }
+  if (kNil != node.right) {
+    const Node& right = m_Nodes[node.right];
+    node.maxGap = std::max(node.maxGap, right.maxGap);
+    node.maxGap = std::max(node.maxGap, Gap(node.maxEnd, right.minStart));
+    node.maxEnd = std::max(node.maxEnd, right.maxEnd);
+  }
+}
+
+void MemRegionTree::split(int pRoot, int pKey, int& pLeft, int& pRight)
+{
+  if (kNil == pRoot) {
+    pLeft = pRight = kNil;
+    return;
+  }
+
+  if (less(pRoot, pKey)) {
+    split(m_Nodes[pRoot].right, pKey, m_Nodes[pRoot].right, pRight);
+    pLeft = pRoot;
+  }
+  else {
+    split(m_Nodes[pRoot].left, pKey, pLeft, m_Nodes[pRoot].left);
+    pRight = pRoot;
+  }
+  update(pRoot);
+}
+
+int MemRegionTree::merge(int pLeft, int pRight)
+{
+  if (kNil == pLeft)
+    return pRight;
+  if (kNil == pRight)
+    return pLeft;
+
+  if (m_Nodes[pLeft].priority > m_Nodes[pRight].priority) {
+    m_Nodes[pLeft].right = merge(m_Nodes[pLeft].right, pRight);
+    update(pLeft);
+    return pLeft;
+  }
+  m_Nodes[pRight].left = merge(pLeft, m_Nodes[pRight].left);
+  update(pRight);
+  return pRight;
+}
+
+bool MemRegionTree::find(int pNode, size_t pPrevEnd, size_t pSize,
+                         size_t& pAddr) const
+{
+  while (kNil != pNode) {
+    const Node& node = m_Nodes[pNode];
+
+    // the left subtree has a gap large enough, it must hold the answer.
+    if (kNil != node.left) {
+      const Node& left = m_Nodes[node.left];
+      if (Gap(pPrevEnd, left.minStart) >= pSize || left.maxGap >= pSize) {
+        pNode = node.left;
+        continue;
+      }
+      pPrevEnd = std::max(pPrevEnd, left.maxEnd);
+    }
+
+    if (Gap(pPrevEnd, node.start) >= pSize) {
+      pAddr = pPrevEnd;
+      return true;
+    }
+
+    pPrevEnd = std::max(pPrevEnd, node.end);
+    pNode = node.right;
+  }
+  return false;
+}
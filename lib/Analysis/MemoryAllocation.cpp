@@ -9,11 +9,13 @@
 #include <onnc/Analysis/MemoryAllocation.h>
 #include <onnc/Analysis/NodeIRScheduler.h>
 #include <onnc/Analysis/SplitNode.h>
+#include <onnc/Analysis/TilingPlanner.h>
 #include <onnc/Analysis/UpdateGraphOutputSize.h>
 #include <onnc/Core/InitializePasses.h>
 #include <onnc/Core/AnalysisResolver.h>
 #include <onnc/Core/AnalysisUsage.h>
 #include <onnc/Core/PassAnalysisSupport.h>
+#include <onnc/Option/CommandLine.h>
 #include <onnc/Support/IOStream.h>
 #include <onnc/Target/TargetTransformInfo.h>
 #include <iomanip>
@@ -21,95 +23,101 @@
 using namespace onnc;
 
 //===----------------------------------------------------------------------===//
-// MemoryAllocation
+// Options
 //===----------------------------------------------------------------------===//
-MemoryAllocation::MemoryAllocation(DLATargetBackend* pDLATB)
-  : ModulePass(ID), m_GraphMemAllocList(), m_DLATB(pDLATB) {
-}
-
-MemoryAllocation::~MemoryAllocation()
+static std::string getStrategyName()
 {
-  clear();
+  static cl::opt<std::string> strategy(
+      "mem-alloc-strategy", cl::kLong, cl::kOptional, cl::kValueRequired,
+      cl::kEqualSeparated, cl::init("first-fit"),
+      cl::desc("placement of local memory [first-fit|best-fit-by-size|"
+               "greedy-by-breadth|min-peak]"));
+  return strategy;
 }
 
-struct MemRegion {
-  size_t start, size;
-  MemRegion(size_t pStart, size_t pSize)
-    : start(pStart), size(pSize) {
-  }
-  MemRegion() {}
-};
-
-using MemRegionList = std::vector<MemRegion>;
-
-static MemRegionList GetUsedMemRegions(const MemAllocList& pAllocs,
-                                       const LiveInterval &pIntrvl)
+static bool getPrintStrategyPeaks()
 {
-  MemRegionList regions;
-  for (const MemAllocEntry *entry : pAllocs) {
-    const LiveInterval& liveIntrvl = entry->liveIntrvl;
-
-    if (!liveIntrvl.intersect(pIntrvl))
-      continue;
+  static cl::opt<bool> print_peaks(
+      "print-mem-alloc-peaks", cl::kLong, cl::kOptional, cl::kValueDisallowed,
+      cl::init(false),
+      cl::desc("print the peak local memory of every placement strategy"));
+  return print_peaks;
+}
 
-    regions.emplace_back(entry->startAddr, entry->size);
+//===----------------------------------------------------------------------===//
+// MemoryAllocation
+//===----------------------------------------------------------------------===//
+MemoryAllocation::MemoryAllocation(DLATargetBackend* pDLATB,
+                                   const MemAllocStrategy* pStrategy)
+  : ModulePass(ID), m_GraphMemAllocList(), m_DLATB(pDLATB),
+    m_pStrategy(pStrategy) {
+  if (nullptr != m_pStrategy)
+    return;
+
+  std::string name = getStrategyName();
+  m_pStrategy = MemAllocStrategy::Lookup(name);
+  if (nullptr == m_pStrategy) {
+    errs() << "Unknown memory allocation strategy: " << name
+           << ", use first-fit.\n";
+    m_pStrategy = MemAllocStrategy::Lookup("first-fit");
   }
-
-  // sort by starting address
-  std::sort(regions.begin(), regions.end(),
-            [] (const MemRegion& ra, const MemRegion& rb) {
-              return ra.start < rb.start;
-            });
-  return regions;
 }
 
-static bool HasConflict(size_t pStartA, size_t pSizeA,
-                        size_t pStartB, size_t pSizeB)
+MemoryAllocation::~MemoryAllocation()
 {
-  size_t endA = pStartA + pSizeA,
-         endB = pStartB + pSizeB;
-
-  return !(endA <= pStartB || endB <= pStartA);
+  clear();
 }
 
 uint64_t MemoryAllocation::allocByLiveness(xGraph &pGraph,
                                            ValMemSizeMap &pValMemSizeMap,
                                            GraphLivenessAnalysis &pLiveAnaly)
 {
-  MemAllocList memAllocList;
+  MemAllocRequestList requests;
+  std::vector<const LiveInterval*> intervals;
 
   // by liverange analysis, we can get minimun requirement memory size.
-  size_t minSize = 0;
-
-  // allocate memory considering liveness.
   auto &livesInfo = pLiveAnaly.getLiveIntervals();
-  for (const LiveInterval* li : livesInfo) {
-    const xValue *v = &li->getValue();
-    if (!pValMemSizeMap.count(v))
+  for (const LiveInterval& li : livesInfo) {
+    ValMemSizeMap::const_iterator it = pValMemSizeMap.find(&li.getValue());
+    if (it == pValMemSizeMap.end())
       continue;
 
-    size_t required = pValMemSizeMap[v].size,
-           startAddr = 0;
-
-    MemRegionList conflicts = GetUsedMemRegions(memAllocList, *li);
+    requests.push_back(MemAllocRequest{ li.getStart(), li.getEnd(),
+                                        (size_t)it->second.size, 0 });
+    intervals.push_back(&li);
+  }
 
-    // Note: conflicts has been sorted by starting address in GetUsedMemRegions.
-    for (const MemRegion &reg : conflicts) {
-      if (!HasConflict(reg.start, reg.size, startAddr, required))
-        break;
-      startAddr = reg.start + reg.size;
+  // compare the peaks of all placements on the same requests.
+  if (getPrintStrategyPeaks()) {
+    for (const MemAllocStrategy* strategy : MemAllocStrategy::GetPlacements()) {
+      MemAllocRequestList trial(requests);
+      outs() << "    " << std::setw(18) << std::left << strategy->name()
+             << (float)strategy->allocate(trial) / 1024.f << " kb\n";
     }
-
-    // Allocate new memory region.
-    memAllocList.push_back(new MemAllocEntry(startAddr, required, *li));
-    minSize = std::max(minSize, startAddr + required);
   }
 
+  // allocate memory considering liveness.
+  size_t minSize = m_pStrategy->allocate(requests);
+
+  MemAllocList memAllocList;
+  for (size_t i = 0; i < requests.size(); ++i)
+    memAllocList.push_back(new MemAllocEntry(requests[i].address,
+                                             requests[i].size,
+                                             *intervals[i]));
+
   clearGraphAlloc(&pGraph);
   m_GraphMemAllocList[&pGraph] = std::move(memAllocList);
   return minSize;
 }
 
+uint64_t MemoryAllocation::allocBySplit(SplitGraph &pSpGraph,
+                                        ValMemSizeMap &pValMemSizeMap,
+                                        GraphLivenessAnalysis &pLiveAnaly)
+{
+  pSpGraph.updateMemUsage(pValMemSizeMap);
+  return allocByLiveness(pSpGraph.getGraph(), pValMemSizeMap, pLiveAnaly);
+}
+
 Pass::ReturnType MemoryAllocation::runOnModule(Module& pModule)
 {
   if (!m_DLATB) {
@@ -126,37 +134,46 @@ Pass::ReturnType MemoryAllocation::runOnModule(Module& pModule)
 
   const uint64_t localMemSize = m_DLATB->getMemInfo()
                                        ->getLocalMemSize();
+  // The first split graph is the graph of the module. PassManager has
+  // scheduled it, and its liveness stays valid until a pass changes it.
+  bool reuse = isValidAnalysis<GraphLivenessAnalysis>();
+
   std::vector<SplitGraph*> worklist(sgMgr.getSplitGraphs());
   while (!worklist.empty()) {
     SplitGraph *spGraph = worklist.back();
     worklist.pop_back();
 
-    scheduler->runOnGraph(spGraph->getGraph());
-    liveAnaly->runOnGraph(spGraph->getGraph());
-
-    // per graph
-    int64_t prevMinSize = 0;
-    const float threshold = 0.9f; // 90% splitting threshold.
+    if (!reuse) {
+      scheduler->runOnGraph(spGraph->getGraph());
+      liveAnaly->runOnGraph(spGraph->getGraph());
+    }
+    reuse = false;
 
-    outs() << "Allocate graph: " << spGraph->getGraph().name() << "\n";
+    outs() << "Allocate graph: " << spGraph->getGraph().name()
+           << " (" << m_pStrategy->name() << ")\n";
     while (true) {
+      // sizes of values are recomputed only for the nodes whose split
+      // changed between tries.
       ValMemSizeMap valMemSMap;
-      spGraph->getMemUsage(valMemSMap);
 
-      // Try to allocate.
-      uint64_t minSize = allocByLiveness(spGraph->getGraph(),
-                                         valMemSMap, *liveAnaly);
+      // Try to allocate without splitting.
+      spGraph->resetToOrigSize();
+      uint64_t minSize = allocBySplit(*spGraph, valMemSMap, *liveAnaly);
       outs() << " -> " << (float)minSize / 1024.f << " kb\n";
       if (minSize < localMemSize) {
         spGraph->setAllocStatus(true, minSize);
         break;
       }
 
-      // If new allocation is not smaller enough than previous allocation, then
-      // create new sub graph
-      if (prevMinSize && (float)minSize / prevMinSize > threshold) {
-        prevMinSize = 0;
+      // Tile the outputs by the cost model. If even the smallest tiles don't
+      // fit, then create new sub graph.
+      TilingPlanner::Plan plan;
+      TilingPlanner planner(*m_DLATB->getTTI(), localMemSize);
+      auto footprint = [&] (SplitGraph& pGraph) {
+        return allocBySplit(pGraph, valMemSMap, *liveAnaly);
+      };
 
+      if (!planner.plan(*spGraph, footprint, plan)) {
         SplitGraph *newSpGraph = sgMgr.splitNewSubGraph(*spGraph);
 
         if (newSpGraph) {
@@ -173,9 +190,12 @@ Pass::ReturnType MemoryAllocation::runOnModule(Module& pModule)
           break;
         }
       }
-      prevMinSize = minSize;
 
-      spGraph->shrinkSize();
+      outs() << " -> ";
+      plan.print(outs());
+      outs() << "\n";
+      spGraph->setAllocStatus(true, plan.footprint);
+      break;
     }
   }
   return kModuleChanged;
@@ -238,6 +258,13 @@ char MemoryAllocation::ID = 0;
 namespace onnc
 {
   INITIALIZE_DLA_PASS(MemoryAllocation, "MemoryAllocation")
+} // namespace onnc
+
+void onnc::InitializeMemoryAllocationPassOptions()
+{
+  // initialize all options of MemoryAllocation pass.
+  getStrategyName();
+  getPrintStrategyPeaks();
 }
 
 MemoryAllocation* onnc::CreateMemoryAllocationPass(DLATargetBackend* pDLATB)
@@ -10,10 +10,12 @@
 #include <onnc/Core/AnalysisUsage.h>
 #include <onnc/Core/InitializePasses.h>
 #include <onnc/IR/Dump.h>
+#include <onnc/Option/CommandLine.h>
 #include <onnc/Support/IOStream.h>
 #include <onnc/Target/TargetTransformInfo.h>
+#include <algorithm>
 #include <iomanip> // for setw
-#include <limits>
+#include <queue>
 
 using namespace onnc;
 
@@ -78,14 +80,21 @@ static void InsertLoadStoreNode(xGraph &pGraph)
 }
 
 //===----------------------------------------------------------------------===//
-// NodeIRScheduler
+// Options
 //===----------------------------------------------------------------------===//
-NodeIRScheduler::NodeIRScheduler(DLATargetBackend* pDLATB)
-  : ModulePass(ID), m_DLATB(pDLATB), m_CurCycle(0) {
-}
-
-NodeIRScheduler::~NodeIRScheduler()
+static NodeIRScheduler::Policy GetSchedulePolicy()
 {
+  static cl::opt<std::string> policy(
+      "sched-policy", cl::kLong, cl::kOptional, cl::kValueRequired,
+      cl::kEqualSeparated, cl::init("latency"),
+      cl::desc("priority of the node IR scheduler [latency|memory]"));
+
+  std::string name = policy;
+  if ("memory" == name)
+    return NodeIRScheduler::kMinMemory;
+  if ("latency" != name)
+    errs() << "Unknown schedule policy: " << name << ", use latency.\n";
+  return NodeIRScheduler::kMinLatency;
 }
 
 using DegreeMap = std::unordered_map<xNode *, unsigned>;
@@ -110,86 +119,119 @@ static DegreeMap BuildDegreeMap(xGraph &pGraph)
   return dmap;
 }
 
-bool NodeIRScheduler::isExeResAvailable(const ExeResource *pExeRes) const
+namespace {
+
+/// std::priority_queue pops the greatest element, so the order is reversed.
+struct CandidateOrder
 {
-  return m_ExeResUsers.find(pExeRes)->second.size() < pExeRes->numUnits;
-}
+  const NodeIRScheduler* scheduler;
 
-void NodeIRScheduler::addExeResUser(const ExeResource *pExeRes,
-                                    xNode *pUser)
+  bool operator()(const NodeIRScheduler::Candidate& pA,
+                  const NodeIRScheduler::Candidate& pB) const {
+    return scheduler->isBefore(pB, pA);
+  }
+};
+
+struct EventOrder
 {
-  uint64_t c = m_DLATB->getTTI()
-                     ->getOperatorCost(pUser, TargetTransformInfo::kCycleCount);
+  bool operator()(const NodeIRScheduler::Event& pA,
+                  const NodeIRScheduler::Event& pB) const {
+    if (pA.end != pB.end)
+      return pA.end > pB.end;
+    return pA.order > pB.order;
+  }
+};
 
-  m_ExeResUsers[pExeRes].emplace_back(pUser, c);
-  m_SchedTimeLine.emplace_back(pUser, m_CurCycle, m_CurCycle + c);
+} // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// NodeIRScheduler
+//===----------------------------------------------------------------------===//
+NodeIRScheduler::NodeIRScheduler(DLATargetBackend* pDLATB)
+  : ModulePass(ID), m_DLATB(pDLATB), m_Policy(GetSchedulePolicy()),
+    m_CurCycle(0) {
+}
+
+NodeIRScheduler::NodeIRScheduler(DLATargetBackend* pDLATB, Policy pPolicy)
+  : ModulePass(ID), m_DLATB(pDLATB), m_Policy(pPolicy), m_CurCycle(0) {
 }
 
-Nodes NodeIRScheduler::issue()
+NodeIRScheduler::~NodeIRScheduler()
 {
-  // find min cycle count
-  uint64_t minCycle = std::numeric_limits<uint64_t>::max();
-  for (auto &it : m_ExeResUsers)
-    for (auto &user : it.second)
-      minCycle = std::min(minCycle, user.remainCycles);
-
-  m_CurCycle += minCycle;
-
-  // update cycle count based on min cycle count.
-  Nodes complete;
-  for (auto &it : m_ExeResUsers) {
-    std::vector<unsigned> rmList;
-    auto &userList = it.second;
-    for (unsigned i = 0; i < userList.size(); ++i) {
-      userList[i].remainCycles -= minCycle;
-      if (userList[i].remainCycles == 0) {
-        rmList.push_back(i);
-        complete.push_back(userList[i].user);
-      }
+}
+
+void NodeIRScheduler::prepare(xGraph &pGraph)
+{
+  const TargetTransformInfo *tti = m_DLATB->getTTI();
+  TargetMemInfo *memInfo = m_DLATB->getMemInfo();
+
+  unsigned order = 0;
+  for (xNode *n : pGraph.nodes()) {
+    if (n->kind() == xBuiltinSymbol::kUndefined)
+      continue;
+
+    m_Orders[n] = order++;
+    m_Cycles[n] = tti->getOperatorCost(n, TargetTransformInfo::kCycleCount);
+    for (xValue *v : n->outputs()) {
+      m_Bytes[v] = (nullptr == memInfo) ? 0
+                                        : memInfo->getValueMemorySize(v).size;
+      unsigned uses = 0;
+      for (auto u : v->uses())
+        if (u.user->kind() != xBuiltinSymbol::kReturn)
+          ++uses;
+      m_RemainUses[v] = uses;
     }
+  }
 
-    // release exe resource.
-    for (int i = rmList.size() - 1; i >= 0; --i)
-      userList.erase(userList.begin() + i);
+  // the longest path from a node to the end, in reverse topological order.
+  for (auto it = pGraph.nodes().rbegin(); it != pGraph.nodes().rend(); ++it) {
+    xNode *n = *it;
+    if (m_Cycles.end() == m_Cycles.find(n))
+      continue;
+
+    uint64_t longest = 0;
+    for (xValue *v : n->outputs()) {
+      for (auto u : v->uses()) {
+        auto path = m_PathCycles.find(u.user);
+        if (m_PathCycles.end() != path)
+          longest = std::max(longest, path->second);
+      }
+    }
+    m_PathCycles[n] = m_Cycles[n] + longest;
   }
-  return complete;
 }
 
-Nodes NodeIRScheduler::greedyPickNextNodes(Nodes &pCands)
+NodeIRScheduler::Candidate NodeIRScheduler::getCandidate(xNode *pNode)
 {
-  Nodes next;
-  std::vector<int> rmList;
-
-  // Greedy pick from beginning of the list.
-  for (unsigned i = 0; i < pCands.size(); ++i) {
-    xNode *n = pCands[i];
-    const ExeResource *res = m_DLATB->getTTI()->queryExeResType(n);
-    // initialize entry with empty user.
-    if (m_ExeResUsers.find(res) == m_ExeResUsers.end())
-      m_ExeResUsers[res] = {};
-
-    if (isExeResAvailable(res)) {
-      addExeResUser(res, n);
-      next.push_back(n);
-      rmList.push_back(i);
-    }
+  // outputs become live, and inputs whose last user is the node die.
+  int64_t delta = 0;
+  for (xValue *v : pNode->outputs())
+    delta += m_Bytes[v];
+  for (xValue *v : pNode->inputs()) {
+    auto uses = m_RemainUses.find(v);
+    if (m_RemainUses.end() != uses && 1 == uses->second)
+      delta -= m_Bytes[v];
   }
 
-  // Remove picked node in backward direction.
-  for (auto it = rmList.rbegin(); it != rmList.rend(); ++it)
-    pCands.erase(pCands.begin() + *it);
-
-  return next;
+  unsigned version = ++m_Ready[pNode];
+  return { pNode, m_PathCycles[pNode], delta, m_Orders[pNode], version };
 }
 
-bool NodeIRScheduler::isAllExeResEmpty() const
+bool NodeIRScheduler::isBefore(const Candidate& pA, const Candidate& pB) const
 {
-  for (auto &it : m_ExeResUsers) {
-    auto &userList = it.second;
-    if (!userList.empty())
-      return false;
+  if (kMinMemory == m_Policy) {
+    if (pA.liveDelta != pB.liveDelta)
+      return pA.liveDelta < pB.liveDelta;
+    if (pA.pathCycles != pB.pathCycles)
+      return pA.pathCycles > pB.pathCycles;
   }
-  return true;
+  else {
+    if (pA.pathCycles != pB.pathCycles)
+      return pA.pathCycles > pB.pathCycles;
+    if (pA.liveDelta != pB.liveDelta)
+      return pA.liveDelta < pB.liveDelta;
+  }
+  return pA.order < pB.order;
 }
 
 Pass::ReturnType NodeIRScheduler::runOnModule(Module& pModule)
@@ -211,26 +253,74 @@ Pass::ReturnType NodeIRScheduler::runOnGraph(xGraph &pGraph)
     InsertLoadStoreNode(graph);
 
   DegreeMap dmap = BuildDegreeMap(graph);
-  Nodes worklist;
+  prepare(graph);
+
+  std::priority_queue<Candidate, std::vector<Candidate>, CandidateOrder>
+      ready(CandidateOrder{ this });
+  std::priority_queue<Event, std::vector<Event>, EventOrder> events;
+  std::unordered_map<const ExeResource*, unsigned> busy;
+  unsigned numOfIssued = 0;
 
-  // add degree = 0 to worklist in graph order.
   for (xNode *n : graph.nodes()) {
     if (n->kind() == xBuiltinSymbol::kUndefined)
       continue;
 
     if (dmap[n] == 0)
-      worklist.push_back(n);
+      ready.push(getCandidate(n));
   }
 
-  while (!worklist.empty() || !isAllExeResEmpty()) {
-    // worklist is modified in greedyPickNextNodes
-    greedyPickNextNodes(worklist);
-    Nodes completes = issue();
+  while (!ready.empty() || !events.empty()) {
+    // issue ready nodes by priority while their resources have free units.
+    std::vector<Candidate> blocked;
+    while (!ready.empty()) {
+      Candidate cand = ready.top();
+      ready.pop();
+      auto version = m_Ready.find(cand.node);
+      if (m_Ready.end() == version || version->second != cand.version)
+        continue;
+
+      const ExeResource *res = m_DLATB->getTTI()->queryExeResType(cand.node);
+      if (busy[res] >= res->numUnits) {
+        blocked.push_back(cand);
+        continue;
+      }
+
+      ++busy[res];
+      m_Ready.erase(version);
+      uint64_t end = m_CurCycle + m_Cycles[cand.node];
+      m_SchedTimeLine.emplace_back(cand.node, m_CurCycle, end);
+      events.push({ end, numOfIssued++, cand.node, res });
+
+      // the other ready users of the inputs may release them now.
+      for (xValue *v : cand.node->inputs()) {
+        auto uses = m_RemainUses.find(v);
+        if (m_RemainUses.end() == uses)
+          continue;
+        --uses->second;
+        for (auto u : v->uses()) {
+          if (m_Ready.end() != m_Ready.find(u.user))
+            ready.push(getCandidate(u.user));
+        }
+      }
+    }
+    for (const Candidate& cand : blocked)
+      ready.push(cand);
+
+    if (events.empty()) {
+      errs() << "Some nodes use an execution resource without units.\n";
+      return kPassFailure;
+    }
+
+    // complete the earliest nodes and release their resources.
+    m_CurCycle = events.top().end;
+    while (!events.empty() && events.top().end == m_CurCycle) {
+      Event event = events.top();
+      events.pop();
+      --busy[event.res];
 
-    for (xNode *n : completes) {
-      for (xValue *v : n->outputs()) {
+      for (xValue *v : event.node->outputs()) {
         // Update degree map.
-        for(auto u : v->uses()) {
+        for (auto u : v->uses()) {
           if (u.user->kind() == xBuiltinSymbol::kReturn)
             continue;
           auto it = dmap.find(u.user);
@@ -239,11 +329,11 @@ Pass::ReturnType NodeIRScheduler::runOnGraph(xGraph &pGraph)
           // --Degree
           it->second -= 1;
           if (it->second == 0)
-            worklist.push_back(it->first);
+            ready.push(getCandidate(it->first));
         } // for each user of this value.
       } // for each output value.
-    } // for each picked node.
-  } // while !worklist.empty() || !isAllExeResEmpty()
+    } // for each completed node.
+  } // while !ready.empty() || !events.empty()
 
   // Reorder the IR position based on scheduling result.
   auto it = graph.begin();
@@ -312,6 +402,12 @@ namespace onnc
   INITIALIZE_DLA_PASS(NodeIRScheduler, "NodeIRScheduler")
 }
 
+void onnc::InitializeNodeIRSchedulerPassOptions()
+{
+  // register -sched-policy before the command line is parsed.
+  GetSchedulePolicy();
+}
+
 NodeIRScheduler *onnc::CreateNodeIRSchedulerPass(DLATargetBackend *pDLATB)
 {
   return new NodeIRScheduler(pDLATB);
@@ -0,0 +1,719 @@
+//===- ShapeInference.cpp -------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <onnc/Analysis/ShapeInference.h>
+#include <onnc/IR/Compute/Value.h>
+#include <onnc/IR/Module.h>
+#include <onnc/IR/ONNXUtils.h>
+#include <onnc/ONNXWrapper/ONNXWrapper.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+using namespace onnc;
+
+//===----------------------------------------------------------------------===//
+// Non-member functions
+//===----------------------------------------------------------------------===//
+static inline xTensorProtoDataType ToProtoType(onnc::Value::Type pType)
+{
+  return (xTensorProtoDataType)pType;
+}
+
+static inline bool HasSizes(const xValue& pValue)
+{
+  return !pValue.sizes().empty();
+}
+
+/// @retval false the sizes are unknown or symbolic.
+static bool GetDims(const xValue& pValue, LongInts& pDims)
+{
+  if (!HasSizes(pValue))
+    return false;
+
+  pDims.clear();
+  for (const xDimension& dim : pValue.sizes()) {
+    if (!dim.is_int || dim.dim < 0)
+      return false;
+    pDims.push_back(dim.dim);
+  }
+  return true;
+}
+
+static TensorSizes ToSizes(const LongInts& pDims)
+{
+  TensorSizes sizes;
+  for (int64_t dim : pDims)
+    sizes.push_back(xDimension(dim));
+  return sizes;
+}
+
+static int64_t Product(LongInts::const_iterator pBegin,
+                       LongInts::const_iterator pEnd)
+{
+  int64_t result = 1;
+  for (; pBegin != pEnd; ++pBegin)
+    result *= *pBegin;
+  return result;
+}
+
+static int64_t GetInt(const xNode& pNode, const char* pAttr, int64_t pDefault)
+{
+  xSymbol attr(pAttr);
+  if (!pNode.hasAttribute(attr))
+    return pDefault;
+  return pNode.i(attr);
+}
+
+static LongInts GetInts(const xNode& pNode, const char* pAttr,
+                        const LongInts& pDefault)
+{
+  xSymbol attr(pAttr);
+  if (!pNode.hasAttribute(attr))
+    return pDefault;
+  const std::vector<int64_t>& values = pNode.is(attr);
+  return LongInts(values.begin(), values.end());
+}
+
+/// Normalize a negative axis of a tensor of rank @ref pRank.
+/// @retval false the axis is out of range.
+static bool NormalizeAxis(int64_t& pAxis, size_t pRank)
+{
+  if (pAxis < 0)
+    pAxis += pRank;
+  return (0 <= pAxis && pAxis < (int64_t)pRank);
+}
+
+/// Set an output unless its sizes or its element type are known.
+static void SetOutput(xNode& pNode, unsigned int pIdx,
+                      const TensorSizes& pSizes, xTensorProtoDataType pType)
+{
+  if (pNode.outputs().size() <= pIdx)
+    return;
+
+  xValue* out = pNode.outputs()[pIdx];
+  if (!HasSizes(*out))
+    out->setSizes(pSizes);
+  if (ToProtoType(onnc::Value::kUndefined) == out->elemType())
+    out->setElemType(pType);
+}
+
+static void SetOutput(xNode& pNode, unsigned int pIdx, const LongInts& pDims,
+                      xTensorProtoDataType pType)
+{
+  SetOutput(pNode, pIdx, ToSizes(pDims), pType);
+}
+
+/// Multidirectional broadcasting of numpy.
+static bool Broadcast(const LongInts& pA, const LongInts& pB,
+                      LongInts& pResult)
+{
+  size_t rank = std::max(pA.size(), pB.size());
+  pResult.assign(rank, 1);
+  for (size_t i = 0; i < rank; ++i) {
+    int64_t a = (i < pA.size()) ? pA[pA.size() - 1 - i] : 1;
+    int64_t b = (i < pB.size()) ? pB[pB.size() - 1 - i] : 1;
+    if (a != b && 1 != a && 1 != b)
+      return false;
+    pResult[rank - 1 - i] = (1 == a) ? b : a;
+  }
+  return true;
+}
+
+/// Read a small int64 initializer, such as the shape of Reshape.
+static bool GetInitializerInts(const xNode& pNode, const xValue& pValue,
+                               LongInts& pInts)
+{
+  const xGraph& graph = *pNode.owningGraph();
+  const std::vector<std::string>& names = graph.initializer_names();
+  std::vector<std::string>::const_iterator name =
+      std::find(names.begin(), names.end(), pValue.uniqueName());
+  if (names.end() == name)
+    return false;
+
+  const xTensor& tensor = graph.initializers()[name - names.begin()];
+  if (ToProtoType(onnc::Value::kInt64) != tensor.elem_type())
+    return false;
+
+  if (tensor.is_raw_data()) {
+    pInts.resize(tensor.raw().size() / sizeof(int64_t));
+    std::memcpy(pInts.data(), tensor.raw().data(),
+                pInts.size() * sizeof(int64_t));
+  }
+  else
+    pInts.assign(tensor.int64s().begin(), tensor.int64s().end());
+  return true;
+}
+
+/// The spatial sizes of sliding window operators, such as Conv and MaxPool.
+static bool InferWindow(const xNode& pNode, const LongInts& pX,
+                        const LongInts& pKernel, bool pCeil, LongInts& pOut)
+{
+  const size_t numAxes = pX.size() - 2;
+  LongInts strides = GetInts(pNode, "strides", LongInts(numAxes, 1));
+  LongInts dilations = GetInts(pNode, "dilations", LongInts(numAxes, 1));
+  LongInts pads = GetInts(pNode, "pads", LongInts(2 * numAxes, 0));
+  if (pKernel.size() != numAxes || strides.size() != numAxes ||
+      dilations.size() != numAxes || pads.size() != 2 * numAxes)
+    return false;
+
+  std::string auto_pad = "NOTSET";
+  if (pNode.hasAttribute(xSymbol("auto_pad")))
+    auto_pad = pNode.s(xSymbol("auto_pad"));
+
+  for (size_t i = 0; i < numAxes; ++i) {
+    if (strides[i] <= 0)
+      return false;
+
+    int64_t in = pX[i + 2];
+    if ("SAME_UPPER" == auto_pad || "SAME_LOWER" == auto_pad) {
+      pOut.push_back((in + strides[i] - 1) / strides[i]);
+      continue;
+    }
+
+    int64_t room = in - ((pKernel[i] - 1) * dilations[i] + 1);
+    if ("VALID" != auto_pad)
+      room += pads[i] + pads[i + numAxes];
+    if (room < 0)
+      return false;
+    if (pCeil)
+      pOut.push_back((room + strides[i] - 1) / strides[i] + 1);
+    else
+      pOut.push_back(room / strides[i] + 1);
+  }
+  return true;
+}
+
+//===----------------------------------------------------------------------===//
+// Shape functions
+//===----------------------------------------------------------------------===//
+/// Element-wise operators with one data input.
+static bool InferSameAsInput(xNode& pNode)
+{
+  const xValue& x = *pNode.inputs()[0];
+  if (!HasSizes(x))
+    return false;
+  SetOutput(pNode, 0, x.sizes(), x.elemType());
+  return true;
+}
+
+/// Element-wise operators broadcasting their inputs.
+static bool InferBroadcast(xNode& pNode, xTensorProtoDataType pType)
+{
+  // the legacy broadcast of opset 6 follows the first input.
+  if (0 != GetInt(pNode, "broadcast", 0)) {
+    const xValue& a = *pNode.inputs()[0];
+    if (!HasSizes(a))
+      return false;
+    SetOutput(pNode, 0, a.sizes(), pType);
+    return true;
+  }
+
+  LongInts result;
+  for (const xValue* input : pNode.inputs()) {
+    LongInts dims, broadcast;
+    if (!GetDims(*input, dims) || !Broadcast(result, dims, broadcast))
+      return false;
+    result.swap(broadcast);
+  }
+  SetOutput(pNode, 0, result, pType);
+  return true;
+}
+
+static bool InferArithmetic(xNode& pNode)
+{
+  return InferBroadcast(pNode, pNode.inputs()[0]->elemType());
+}
+
+static bool InferLogical(xNode& pNode)
+{
+  return InferBroadcast(pNode, ToProtoType(onnc::Value::kBoolean));
+}
+
+static bool InferNot(xNode& pNode)
+{
+  const xValue& x = *pNode.inputs()[0];
+  if (!HasSizes(x))
+    return false;
+  SetOutput(pNode, 0, x.sizes(), ToProtoType(onnc::Value::kBoolean));
+  return true;
+}
+
+static bool InferBatchNormalization(xNode& pNode)
+{
+  const xValue& x = *pNode.inputs()[0];
+  const xValue& scale = *pNode.inputs()[1];
+  if (!HasSizes(x) || !HasSizes(scale))
+    return false;
+
+  // the optional outputs are running and saved means and variances.
+  SetOutput(pNode, 0, x.sizes(), x.elemType());
+  for (unsigned int i = 1; i < pNode.outputs().size(); ++i)
+    SetOutput(pNode, i, scale.sizes(), x.elemType());
+  return true;
+}
+
+static bool InferDropout(xNode& pNode)
+{
+  const xValue& x = *pNode.inputs()[0];
+  if (!HasSizes(x))
+    return false;
+  SetOutput(pNode, 0, x.sizes(), x.elemType());
+  SetOutput(pNode, 1, x.sizes(), ToProtoType(onnc::Value::kBoolean));
+  return true;
+}
+
+/// The mask of Dropout has the type of the data before opset 10.
+static bool InferLegacyDropout(xNode& pNode)
+{
+  const xValue& x = *pNode.inputs()[0];
+  if (!HasSizes(x))
+    return false;
+  SetOutput(pNode, 0, x.sizes(), x.elemType());
+  SetOutput(pNode, 1, x.sizes(), x.elemType());
+  return true;
+}
+
+static bool InferCast(xNode& pNode)
+{
+  const xValue& x = *pNode.inputs()[0];
+  if (!HasSizes(x) || !pNode.hasAttribute(xSymbol("to")))
+    return false;
+  SetOutput(pNode, 0, x.sizes(),
+            (xTensorProtoDataType)pNode.i(xSymbol("to")));
+  return true;
+}
+
+static bool InferConv(xNode& pNode)
+{
+  LongInts x, w;
+  if (!GetDims(*pNode.inputs()[0], x) || !GetDims(*pNode.inputs()[1], w) ||
+      x.size() < 3 || w.size() != x.size())
+    return false;
+
+  LongInts kernel = GetInts(pNode, "kernel_shape",
+                            LongInts(w.begin() + 2, w.end()));
+  LongInts out = { x[0], w[0] };
+  if (!InferWindow(pNode, x, kernel, false, out))
+    return false;
+  SetOutput(pNode, 0, out, pNode.inputs()[0]->elemType());
+  return true;
+}
+
+static bool InferPool(xNode& pNode)
+{
+  LongInts x;
+  if (!GetDims(*pNode.inputs()[0], x) || x.size() < 3 ||
+      !pNode.hasAttribute(xSymbol("kernel_shape")))
+    return false;
+
+  LongInts kernel = GetInts(pNode, "kernel_shape", LongInts());
+  bool ceil = (0 != GetInt(pNode, "ceil_mode", 0));
+  LongInts out = { x[0], x[1] };
+  if (!InferWindow(pNode, x, kernel, ceil, out))
+    return false;
+
+  // MaxPool may output the indices as well.
+  SetOutput(pNode, 0, out, pNode.inputs()[0]->elemType());
+  SetOutput(pNode, 1, out, ToProtoType(onnc::Value::kInt64));
+  return true;
+}
+
+static bool InferGlobalPool(xNode& pNode)
+{
+  LongInts x;
+  if (!GetDims(*pNode.inputs()[0], x) || x.size() < 3)
+    return false;
+
+  LongInts out(x.size(), 1);
+  out[0] = x[0];
+  out[1] = x[1];
+  SetOutput(pNode, 0, out, pNode.inputs()[0]->elemType());
+  return true;
+}
+
+static bool InferGemm(xNode& pNode)
+{
+  LongInts a, b;
+  if (!GetDims(*pNode.inputs()[0], a) || !GetDims(*pNode.inputs()[1], b) ||
+      2 != a.size() || 2 != b.size())
+    return false;
+
+  int64_t m = IsTranspose(pNode, xBuiltinSymbol::ktransA) ? a[1] : a[0];
+  int64_t n = IsTranspose(pNode, xBuiltinSymbol::ktransB) ? b[0] : b[1];
+  SetOutput(pNode, 0, LongInts{ m, n }, pNode.inputs()[0]->elemType());
+  return true;
+}
+
+static bool InferMatMul(xNode& pNode)
+{
+  LongInts a, b;
+  if (!GetDims(*pNode.inputs()[0], a) || !GetDims(*pNode.inputs()[1], b))
+    return false;
+
+  // a vector is promoted to a matrix and the new axis is removed later.
+  const bool vecA = (1 == a.size()), vecB = (1 == b.size());
+  if (vecA)
+    a.insert(a.begin(), 1);
+  if (vecB)
+    b.push_back(1);
+  if (a.back() != b[b.size() - 2])
+    return false;
+
+  LongInts out;
+  if (!Broadcast(LongInts(a.begin(), a.end() - 2),
+                 LongInts(b.begin(), b.end() - 2), out))
+    return false;
+  if (!vecA)
+    out.push_back(a[a.size() - 2]);
+  if (!vecB)
+    out.push_back(b.back());
+  SetOutput(pNode, 0, out, pNode.inputs()[0]->elemType());
+  return true;
+}
+
+static bool InferFlatten(xNode& pNode)
+{
+  LongInts x;
+  if (!GetDims(*pNode.inputs()[0], x))
+    return false;
+
+  int64_t axis = GetInt(pNode, "axis", 1);
+  if (axis < 0)
+    axis += x.size();
+  if (axis < 0 || axis > (int64_t)x.size())
+    return false;
+
+  LongInts out = { Product(x.begin(), x.begin() + axis),
+                   Product(x.begin() + axis, x.end()) };
+  SetOutput(pNode, 0, out, pNode.inputs()[0]->elemType());
+  return true;
+}
+
+static bool InferReshape(xNode& pNode)
+{
+  LongInts x;
+  if (!GetDims(*pNode.inputs()[0], x))
+    return false;
+
+  // the shape is an attribute before opset 5.
+  LongInts shape;
+  if (1 < pNode.inputs().size()) {
+    if (!GetInitializerInts(pNode, *pNode.inputs()[1], shape))
+      return false;
+  }
+  else if (pNode.hasAttribute(xSymbol("shape")))
+    shape = GetInts(pNode, "shape", LongInts());
+  else
+    return false;
+
+  // 0 copies the input dimension and -1 takes the rest.
+  int unknown = -1;
+  int64_t known = 1;
+  for (size_t i = 0; i < shape.size(); ++i) {
+    if (0 == shape[i]) {
+      if (x.size() <= i)
+        return false;
+      shape[i] = x[i];
+    }
+    else if (-1 == shape[i]) {
+      if (-1 != unknown)
+        return false;
+      unknown = i;
+      continue;
+    }
+    else if (shape[i] < 0)
+      return false;
+    known *= shape[i];
+  }
+
+  if (-1 != unknown) {
+    int64_t total = Product(x.begin(), x.end());
+    if (0 == known || 0 != total % known)
+      return false;
+    shape[unknown] = total / known;
+  }
+  SetOutput(pNode, 0, shape, pNode.inputs()[0]->elemType());
+  return true;
+}
+
+static bool InferConcat(xNode& pNode)
+{
+  LongInts out;
+  if (!GetDims(*pNode.inputs()[0], out))
+    return false;
+
+  int64_t axis = GetInt(pNode, "axis", 1);
+  if (!NormalizeAxis(axis, out.size()))
+    return false;
+
+  for (unsigned int i = 1; i < pNode.inputs().size(); ++i) {
+    LongInts dims;
+    if (!GetDims(*pNode.inputs()[i], dims) || dims.size() != out.size())
+      return false;
+    out[axis] += dims[axis];
+  }
+  SetOutput(pNode, 0, out, pNode.inputs()[0]->elemType());
+  return true;
+}
+
+static bool InferSplit(xNode& pNode)
+{
+  LongInts x;
+  if (!GetDims(*pNode.inputs()[0], x))
+    return false;
+
+  int64_t axis = GetInt(pNode, "axis", 0);
+  if (!NormalizeAxis(axis, x.size()))
+    return false;
+
+  // split equally if the lengths aren't given.
+  const unsigned int numOfOutputs = pNode.outputs().size();
+  LongInts split = GetInts(pNode, "split", LongInts());
+  if (split.empty()) {
+    if (0 != x[axis] % numOfOutputs)
+      return false;
+    split.assign(numOfOutputs, x[axis] / numOfOutputs);
+  }
+  if (split.size() != numOfOutputs)
+    return false;
+
+  for (unsigned int i = 0; i < numOfOutputs; ++i) {
+    LongInts out = x;
+    out[axis] = split[i];
+    SetOutput(pNode, i, out, pNode.inputs()[0]->elemType());
+  }
+  return true;
+}
+
+static bool InferTranspose(xNode& pNode)
+{
+  LongInts x;
+  if (!GetDims(*pNode.inputs()[0], x))
+    return false;
+
+  // reverse the axes by default.
+  LongInts perm;
+  for (size_t i = x.size(); i > 0; --i)
+    perm.push_back(i - 1);
+  perm = GetInts(pNode, "perm", perm);
+  if (perm.size() != x.size())
+    return false;
+
+  LongInts out;
+  for (int64_t axis : perm) {
+    if (axis < 0 || axis >= (int64_t)x.size())
+      return false;
+    out.push_back(x[axis]);
+  }
+  SetOutput(pNode, 0, out, pNode.inputs()[0]->elemType());
+  return true;
+}
+
+static bool InferSqueeze(xNode& pNode)
+{
+  LongInts x;
+  if (!GetDims(*pNode.inputs()[0], x))
+    return false;
+
+  // remove all single dimensions if the axes aren't given.
+  LongInts axes = GetInts(pNode, "axes", LongInts());
+  std::vector<bool> squeezed(x.size(), false);
+  for (int64_t axis : axes) {
+    if (!NormalizeAxis(axis, x.size()) || 1 != x[axis])
+      return false;
+    squeezed[axis] = true;
+  }
+
+  LongInts out;
+  for (size_t i = 0; i < x.size(); ++i) {
+    if (squeezed[i] || (axes.empty() && 1 == x[i]))
+      continue;
+    out.push_back(x[i]);
+  }
+  SetOutput(pNode, 0, out, pNode.inputs()[0]->elemType());
+  return true;
+}
+
+static bool InferUnsqueeze(xNode& pNode)
+{
+  LongInts x;
+  if (!GetDims(*pNode.inputs()[0], x) ||
+      !pNode.hasAttribute(xSymbol("axes")))
+    return false;
+
+  // the axes are positions in the output.
+  LongInts axes = GetInts(pNode, "axes", LongInts());
+  const size_t rank = x.size() + axes.size();
+  for (int64_t& axis : axes) {
+    if (!NormalizeAxis(axis, rank))
+      return false;
+  }
+  std::sort(axes.begin(), axes.end());
+
+  LongInts out = x;
+  for (int64_t axis : axes)
+    out.insert(out.begin() + axis, 1);
+  SetOutput(pNode, 0, out, pNode.inputs()[0]->elemType());
+  return true;
+}
+
+static bool InferUpsample(xNode& pNode)
+{
+  LongInts x;
+  if (!GetDims(*pNode.inputs()[0], x) ||
+      !pNode.hasAttribute(xSymbol("scales")))
+    return false;
+
+  const std::vector<double>& scales = pNode.fs(xSymbol("scales"));
+  if (scales.size() != x.size())
+    return false;
+
+  LongInts out;
+  for (size_t i = 0; i < x.size(); ++i)
+    out.push_back((int64_t)(x[i] * scales[i]));
+  SetOutput(pNode, 0, out, pNode.inputs()[0]->elemType());
+  return true;
+}
+
+static bool InferPad(xNode& pNode)
+{
+  LongInts x;
+  if (!GetDims(*pNode.inputs()[0], x))
+    return false;
+
+  // the pads are named paddings before opset 2.
+  LongInts pads = GetInts(pNode, "pads", GetInts(pNode, "paddings",
+                                                 LongInts()));
+  if (pads.size() != 2 * x.size())
+    return false;
+
+  LongInts out;
+  for (size_t i = 0; i < x.size(); ++i)
+    out.push_back(x[i] + pads[i] + pads[i + x.size()]);
+  SetOutput(pNode, 0, out, pNode.inputs()[0]->elemType());
+  return true;
+}
+
+static bool InferShape(xNode& pNode)
+{
+  const xValue& x = *pNode.inputs()[0];
+  if (!HasSizes(x))
+    return false;
+  SetOutput(pNode, 0, LongInts{ (int64_t)x.sizes().size() },
+            ToProtoType(onnc::Value::kInt64));
+  return true;
+}
+
+//===----------------------------------------------------------------------===//
+// ShapeInference
+//===----------------------------------------------------------------------===//
+ShapeInference::ShapeInference(int64_t pOpsetVersion)
+  : m_Functions() {
+  for (const char* kind : { "Abs", "Ceil", "Clip", "Elu", "Exp", "Floor",
+                            "HardSigmoid", "Identity", "InstanceNormalization",
+                            "LRN", "LeakyRelu", "Log", "LogSoftmax",
+                            "LpNormalization", "Neg", "PRelu", "Reciprocal",
+                            "Relu", "Selu", "Sigmoid", "Softmax", "Softplus",
+                            "Softsign", "Sqrt", "Tanh", "ThresholdedRelu" })
+    addShapeFunction(xSymbol(kind), InferSameAsInput);
+
+  for (const char* kind : { "Add", "Div", "Max", "Mean", "Min", "Mul", "Pow",
+                            "Sub", "Sum" })
+    addShapeFunction(xSymbol(kind), InferArithmetic);
+
+  for (const char* kind : { "And", "Equal", "Greater", "Less", "Or", "Xor" })
+    addShapeFunction(xSymbol(kind), InferLogical);
+
+  for (const char* kind : { "AveragePool", "LpPool", "MaxPool" })
+    addShapeFunction(xSymbol(kind), InferPool);
+
+  for (const char* kind : { "GlobalAveragePool", "GlobalLpPool",
+                            "GlobalMaxPool" })
+    addShapeFunction(xSymbol(kind), InferGlobalPool);
+
+  addShapeFunction(xSymbol("BatchNormalization"), InferBatchNormalization);
+  addShapeFunction(xSymbol("Cast"), InferCast);
+  addShapeFunction(xSymbol("Concat"), InferConcat);
+  addShapeFunction(xSymbol("Conv"), InferConv);
+  if (0 < pOpsetVersion && pOpsetVersion < 10)
+    addShapeFunction(xSymbol("Dropout"), InferLegacyDropout);
+  else
+    addShapeFunction(xSymbol("Dropout"), InferDropout);
+  addShapeFunction(xSymbol("Flatten"), InferFlatten);
+  addShapeFunction(xSymbol("Gemm"), InferGemm);
+  addShapeFunction(xSymbol("MatMul"), InferMatMul);
+  addShapeFunction(xSymbol("Not"), InferNot);
+  addShapeFunction(xSymbol("Pad"), InferPad);
+  addShapeFunction(xSymbol("Reshape"), InferReshape);
+  addShapeFunction(xSymbol("Shape"), InferShape);
+  addShapeFunction(xSymbol("Split"), InferSplit);
+  addShapeFunction(xSymbol("Squeeze"), InferSqueeze);
+  addShapeFunction(xSymbol("Transpose"), InferTranspose);
+  addShapeFunction(xSymbol("Unsqueeze"), InferUnsqueeze);
+  addShapeFunction(xSymbol("Upsample"), InferUpsample);
+}
+
+void ShapeInference::addShapeFunction(xNodeKind pKind,
+                                      ShapeFunction pFunction)
+{
+  m_Functions[pKind] = pFunction;
+}
+
+bool ShapeInference::hasShapeFunction(xNodeKind pKind) const
+{
+  return (m_Functions.end() != m_Functions.find(pKind));
+}
+
+bool ShapeInference::infer(xNode& pNode) const
+{
+  FunctionMap::const_iterator function = m_Functions.find(pNode.kind());
+  if (m_Functions.end() == function || pNode.inputs().empty())
+    return false;
+
+  if (!function->second(pNode))
+    return false;
+
+  for (const xValue* out : pNode.outputs()) {
+    if (!HasSizes(*out))
+      return false;
+  }
+  return true;
+}
+
+bool ShapeInference::infer(xGraph& pGraph) const
+{
+  // keep going, so that the fallback has less to do.
+  bool result = true;
+  for (xNode* node : pGraph.nodes()) {
+    if (!infer(*node))
+      result = false;
+  }
+  return result;
+}
+
+//===----------------------------------------------------------------------===//
+// Non-member functions
+//===----------------------------------------------------------------------===//
+bool onnc::InferShapes(Module& pModule)
+{
+  if (!pModule.hasRootTensorGraph())
+    return true;
+
+  // the version of the default domain decides the legacy shape functions.
+  int64_t version = 0;
+  for (const auto& opset : pModule.getSetId()) {
+    if (opset.first.empty() || "ai.onnx" == opset.first)
+      version = opset.second;
+  }
+  const ShapeInference shape_inference(version);
+
+  if (shape_inference.infer(*pModule.getRootTensorGraph()))
+    return true;
+
+  return onnxInferShape(pModule);
+}
@@ -8,7 +8,7 @@
 #include <onnc/Analysis/SplitNode.h>
 #include <onnc/IR/ONNXUtils.h>
 #include <onnc/Support/IOStream.h>
-#include <limits>
+#include <algorithm>
 #include <iomanip> // for setw
 #include <tuple>
 #include <onnc/IR/Dump.h>
@@ -42,13 +42,25 @@ static LongInts GetOutputValueSizes(const xNode& pN)
 //===----------------------------------------------------------------------===//
 SplitNode::SplitNode(xNode& pN, bool pSizeDecideByOtherNode)
   : m_OutSizes(GetOutputValueSizes(pN)),
-    m_SizeCalByOtherNode(pSizeDecideByOtherNode), m_Node(pN) {
+    m_SizeCalByOtherNode(pSizeDecideByOtherNode), m_Node(pN),
+    m_Changed(true) {
   m_NewOutSizes = m_OutSizes;
 }
 
+void SplitNode::resetSize()
+{
+  if (m_NewOutSizes != m_OutSizes) {
+    m_NewOutSizes = m_OutSizes;
+    m_Changed = true;
+  }
+}
+
 bool SplitNode::useNewOutSize(const LongInts& pNewOutSize)
 {
-  m_NewOutSizes = pNewOutSize;
+  if (m_NewOutSizes != pNewOutSize) {
+    m_NewOutSizes = pNewOutSize;
+    m_Changed = true;
+  }
   return true;
 }
 
@@ -332,12 +344,40 @@ void SplitGraph::rebuildSplitNodes()
     SplitNode *sn = SplitNodeCreator(*n);
     m_SplitNodes[n] = sn;
 
-    if (IsType("Store", n)) {
-      m_CurSplitAxis.push_back(0);
-      m_CurSplitFactor.push_back(1);
+    if (IsType("Store", n))
       m_Stores.push_back(n);
+  }
+  buildMemUsers();
+}
+
+void SplitGraph::buildMemUsers()
+{
+  // the last node visiting a value decides its memory usage.
+  std::unordered_map<const xValue *, unsigned> lastUser;
+  std::vector<MemUser> users;
+  for (const auto &snIt: m_SplitNodes) {
+    xNode *n = snIt.first;
+    SplitNode *sn = snIt.second;
+
+    // user node will calculate its memory size.
+    if (sn->skipWhenCalMemSize())
+      continue;
+
+    for (unsigned i = 0; i < n->inputs().size(); ++i) {
+      lastUser[n->inputs()[i]] = users.size();
+      users.push_back(MemUser{ n->inputs()[i], n, sn, i, true });
+    }
+
+    for (unsigned i = 0; i < n->outputs().size(); ++i) {
+      lastUser[n->outputs()[i]] = users.size();
+      users.push_back(MemUser{ n->outputs()[i], n, sn, i, false });
     }
   }
+
+  m_MemUsers.clear();
+  for (unsigned i = 0; i < users.size(); ++i)
+    if (lastUser[users[i].value] == i)
+      m_MemUsers.push_back(users[i]);
 }
 
 SplitGraph::~SplitGraph()
@@ -347,9 +387,9 @@ SplitGraph::~SplitGraph()
 
 void SplitGraph::clear()
 {
+  m_MemUsers.clear();
   m_Stores.clear();
-  m_CurSplitAxis.clear();
-  m_CurSplitFactor.clear();
+  m_SplitFactors.clear();
   for (auto snIt : m_SplitNodes)
     delete snIt.second;
   m_SplitNodes.clear();
@@ -359,62 +399,70 @@ void SplitGraph::resetToOrigSize()
 {
   for (auto it : m_SplitNodes)
     it.second->resetSize();
+  m_SplitFactors.clear();
+}
 
-  for (unsigned i = 0; i < m_Stores.size(); ++i) {
-    m_CurSplitAxis[i] = 0;
-    m_CurSplitFactor[i] = 1;
-  }
+MemSize SplitGraph::getMemUsage(unsigned pUser) const
+{
+  const MemUser &user = m_MemUsers[pUser];
+  const TargetTransformInfo &tti = m_SgMgr.getTTI();
+  if (user.isInput)
+    return tti.getOperatorInputMemUsage(
+        user.node, user.index, user.splitNode->calNewInputSize(user.index));
+  return tti.getOperatorOutputMemUsage(
+      user.node, user.index, user.splitNode->getNewOutputSize(user.index));
 }
 
-// TODO: getMemUsage: use a graph, and traverse graph
 void SplitGraph::getMemUsage(ValMemSizeMap &pVMSMap) const
 {
-  for (const auto &snIt: m_SplitNodes) {
-    const xNode *n = snIt.first;
-    const SplitNode *sn = snIt.second;
+  for (unsigned i = 0; i < m_MemUsers.size(); ++i)
+    pVMSMap[m_MemUsers[i].value] = getMemUsage(i);
+}
 
-    // user node will calculate its memory size.
-    if (sn->skipWhenCalMemSize())
+void SplitGraph::updateMemUsage(ValMemSizeMap &pVMSMap)
+{
+  for (unsigned i = 0; i < m_MemUsers.size(); ++i) {
+    const MemUser &user = m_MemUsers[i];
+    if (!user.splitNode->isChanged() && pVMSMap.count(user.value))
       continue;
+    pVMSMap[user.value] = getMemUsage(i);
+  }
 
-    // get required memory size of each input.
-    for (unsigned i = 0; i < n->inputs().size(); ++i) {
-      const xValue *v = n->inputs()[i];
-      pVMSMap[v] = m_SgMgr.getTTI().getOperatorInputMemUsage(n, i,
-                                                        sn->calNewInputSize(i));
-    }
+  for (auto &snIt : m_SplitNodes)
+    snIt.second->clearChanged();
+}
 
-    // get required memory size of each output.
-    for (unsigned i = 0; i < n->outputs().size(); ++i) {
-      const xValue *v = n->outputs()[i];
-      pVMSMap[v] = m_SgMgr.getTTI().getOperatorOutputMemUsage(n, i,
-                                                        sn->calNewInputSize(i));
+void SplitGraph::setSplitFactors(const std::vector<unsigned>& pFactors)
+{
+  resetToOrigSize();
+  m_SplitFactors = pFactors;
+  for (xNode *n : m_Stores) {
+    LongInts newS = getSplitNode(n)->getNewOutputSize(0);
+    for (unsigned axis = 0; axis < newS.size() && axis < pFactors.size();
+         ++axis) {
+      int64_t factor = std::min<int64_t>(std::max(pFactors[axis], 1u),
+                                         newS[axis]);
+      if (1 < factor)
+        newS[axis] = (newS[axis] + factor - 1) / factor;
     }
+    splitNodeBySize(n, newS, true);
   }
 }
 
-void SplitGraph::shrinkSize()
+uint64_t SplitGraph::getNumOfTiles() const
 {
-  // Shrink size, and propogate backward.
-  for (unsigned i = 0; i < m_Stores.size(); ++i) {
-    xNode *n = m_Stores[i];
-
-    const TensorSizes &origSizes = n->inputs()[0]->sizes();
-    unsigned &factor = m_CurSplitFactor[i],
-             &splitAxis = m_CurSplitAxis[i];
-    ++factor;
-    // Can't divide this axis further, try next axis.
-    if (origSizes[splitAxis].dim < factor) {
-      ++splitAxis;
-      factor = 1;
+  uint64_t maxTiles = 1;
+  for (xNode *n : m_Stores) {
+    LongInts origS = GetOutputValueSizes(*n);
+    LongInts newS = getSplitNode(n)->getNewOutputSize(0);
+    uint64_t tiles = 1;
+    for (unsigned axis = 0; axis < newS.size(); ++axis) {
+      int64_t tile = std::max<int64_t>(newS[axis], 1);
+      tiles *= (origS[axis] + tile - 1) / tile;
     }
-
-    // Unable divide further, give up shrink this output value.
-    if (origSizes.size() == splitAxis)
-      continue;
-
-    splitNodeByFactor(n, splitAxis, factor, true);
+    maxTiles = std::max(maxTiles, tiles);
   }
+  return maxTiles;
 }
 
 SplitNode* SplitGraph::getSplitNode(xNode* pN)
@@ -432,16 +480,6 @@ const SplitNode* SplitGraph::getSplitNode(xNode* pN) const
   return it->second;
 }
 
-void SplitGraph::splitNodeByFactor(xNode* pN, unsigned pAxis,
-                                   unsigned pFactor, bool pUpdateUpper)
-{
-  SplitNode* ns = getSplitNode(pN);
-  // FIXME: If the node has multiple outputs?
-  LongInts newS = ns->getNewOutputSize(0);
-  newS[pAxis] = (newS[pAxis] + pFactor - 1)/ pFactor;
-  splitNodeBySize(pN, newS, pUpdateUpper);
-}
-
 bool SplitGraph::hasSplitNode(xNode *pN) const
 {
   return m_SplitNodes.find(pN) != m_SplitNodes.end();
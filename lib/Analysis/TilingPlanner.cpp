@@ -0,0 +1,239 @@
+//===- TilingPlanner.cpp --------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <onnc/Analysis/TilingPlanner.h>
+#include <onnc/Analysis/SplitNode.h>
+#include <onnc/IR/ONNXUtils.h>
+#include <algorithm>
+#include <unordered_set>
+
+using namespace onnc;
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+static bool IsType(const char *pKind, const xNode *pNode)
+{
+  return pNode->kind() == xSymbol(pKind);
+}
+
+/// @retval true The value comes from the global memory.
+static bool IsGlobalValue(const xValue *pValue)
+{
+  const xNode *producer = pValue->node();
+  return nullptr == producer || producer->kind() == xBuiltinSymbol::kParam ||
+         IsType("Load", producer);
+}
+
+static double GetVolume(const LongInts& pSizes)
+{
+  double volume = 1.0;
+  for (int64_t dim : pSizes)
+    volume *= std::max<int64_t>(dim, 1);
+  return volume;
+}
+
+/// The ratio of the lanes and the processing units a tensor of @ref pSizes
+/// keeps busy. Channels (N C H W) spread over @ref pLanes lanes and the
+/// elements of a channel over @ref pUnits processing units.
+static double GetUtilization(const LongInts& pSizes, int pLanes, int pUnits)
+{
+  double result = 1.0;
+  if (1 < pSizes.size() && 0 < pLanes) {
+    int64_t channels = std::max<int64_t>(pSizes[1], 1);
+    result *= (double)channels / (((channels + pLanes - 1) / pLanes) * pLanes);
+  }
+
+  if (2 < pSizes.size() && 0 < pUnits) {
+    int64_t elems = 1;
+    for (unsigned i = 2; i < pSizes.size(); ++i)
+      elems *= std::max<int64_t>(pSizes[i], 1);
+    result *= (double)elems / (((elems + pUnits - 1) / pUnits) * pUnits);
+  }
+  return result;
+}
+
+//===----------------------------------------------------------------------===//
+// TilingPlanner::Plan
+//===----------------------------------------------------------------------===//
+void TilingPlanner::Plan::print(OStream& pOS) const
+{
+  pOS << "tile N x C x H / ";
+  for (unsigned i = 0; i < factors.size(); ++i)
+    pOS << ((0 == i) ? "" : " x ") << factors[i];
+  pOS << ": " << numOfTiles << " tiles of " << (float)footprint / 1024.f
+      << " kb, " << getTileCycles() << " cycles per tile (compute "
+      << computeCycles << ", transfer " << transferCycles << "), "
+      << getTotalCycles() << " cycles";
+}
+
+//===----------------------------------------------------------------------===//
+// TilingPlanner
+//===----------------------------------------------------------------------===//
+TilingPlanner::TilingPlanner(const TargetTransformInfo& pTTI,
+                             uint64_t pLocalMemSize)
+  : m_TTI(pTTI), m_LocalMemSize(pLocalMemSize) {
+}
+
+std::vector<unsigned> TilingPlanner::GetCandidateFactors(int64_t pSize)
+{
+  // the tile size ceil(size / factor) takes O(sqrt(size)) distinct values.
+  // Keep the smallest factor of each.
+  std::vector<unsigned> result;
+  int64_t lastTile = 0;
+  for (int64_t factor = 1; factor <= std::max<int64_t>(pSize, 1); ++factor) {
+    int64_t tile = (pSize + factor - 1) / factor;
+    if (tile == lastTile)
+      continue;
+    lastTile = tile;
+    result.push_back(factor);
+
+    // jump to the last factor of this tile size.
+    if (1 < tile)
+      factor = std::max(factor, (pSize + tile - 2) / (tile - 1) - 1);
+  }
+  return result;
+}
+
+bool TilingPlanner::plan(SplitGraph& pSpGraph, const FootprintFn& pFootprint,
+                         Plan& pResult) const
+{
+  // the largest size of every axis among the outputs.
+  LongInts sizes(kNumOfAxes, 1);
+  for (xNode *store : pSpGraph.getStores()) {
+    LongInts outS = GetValueSizes(*store->outputs()[0]);
+    for (unsigned axis = 0; axis < kNumOfAxes && axis < outS.size(); ++axis)
+      sizes[axis] = std::max(sizes[axis], outS[axis]);
+  }
+
+  std::vector<unsigned> candN = GetCandidateFactors(sizes[0]);
+  std::vector<unsigned> candC = GetCandidateFactors(sizes[1]);
+  std::vector<unsigned> candH = GetCandidateFactors(sizes[2]);
+
+  bool found = false;
+  Plan best;
+  for (unsigned fN : candN) {
+    for (unsigned fC : candC) {
+      // more H pieces only add tiles and halos. Binary search the fewest
+      // which fit; the footprint doesn't grow with the factor.
+      Plan fit = evaluate(pSpGraph, { fN, fC, candH.back() }, pFootprint);
+      if (m_LocalMemSize <= fit.footprint)
+        continue;
+
+      unsigned fail = 0, pass = candH.size() - 1;
+      if (0 < pass) {
+        Plan first = evaluate(pSpGraph, { fN, fC, candH[0] }, pFootprint);
+        if (first.footprint < m_LocalMemSize) {
+          fit = first;
+          pass = 0;
+        }
+      }
+      while (1 < pass - fail) {
+        unsigned mid = fail + (pass - fail) / 2;
+        Plan trial = evaluate(pSpGraph, { fN, fC, candH[mid] }, pFootprint);
+        if (trial.footprint < m_LocalMemSize) {
+          fit = trial;
+          pass = mid;
+        }
+        else
+          fail = mid;
+      }
+
+      if (!found || fit.getTotalCycles() < best.getTotalCycles() ||
+          (fit.getTotalCycles() == best.getTotalCycles() &&
+           best.footprint < fit.footprint)) {
+        best = fit;
+        found = true;
+      }
+    }
+  }
+
+  if (!found)
+    return false;
+
+  // leave the graph split by the plan.
+  pResult = evaluate(pSpGraph, best.factors, pFootprint);
+  return true;
+}
+
+TilingPlanner::Plan TilingPlanner::evaluate(SplitGraph& pSpGraph,
+                                            const Factors& pFactors,
+                                            const FootprintFn& pFootprint) const
+{
+  pSpGraph.setSplitFactors(pFactors);
+
+  Plan result;
+  result.factors = pFactors;
+  result.footprint = pFootprint(pSpGraph);
+  result.numOfTiles = pSpGraph.getNumOfTiles();
+  result.computeCycles = getComputeCycles(pSpGraph);
+  result.transferCycles = getTransferCycles(pSpGraph);
+  return result;
+}
+
+uint64_t TilingPlanner::getComputeCycles(SplitGraph& pSpGraph) const
+{
+  const int lanes = m_TTI.getWarpSize();
+  const int units = m_TTI.getProcessingUnitCount();
+
+  double cycles = 0.0;
+  for (xNode *n : pSpGraph.getGraph().nodes()) {
+    if (!pSpGraph.hasSplitNode(n) || n->outputs().empty())
+      continue;
+    const SplitNode *sn = pSpGraph.getSplitNode(n);
+    if (sn->skipWhenCalMemSize())
+      continue;
+
+    LongInts origS = GetValueSizes(*n->outputs()[0]);
+    LongInts newS = sn->getNewOutputSize(0);
+    double volume = GetVolume(origS);
+    double utilization = GetUtilization(newS, lanes, units);
+    if (0.0 == volume || 0.0 == utilization)
+      continue;
+
+    // a tile costs its share of the node, more if it leaves units idle.
+    double whole = m_TTI.getOperatorCost(n, TargetTransformInfo::kCycleCount);
+    cycles += whole * (GetVolume(newS) / volume) *
+              (GetUtilization(origS, lanes, units) / utilization);
+  }
+  return (uint64_t)cycles;
+}
+
+uint64_t TilingPlanner::getTransferCycles(SplitGraph& pSpGraph) const
+{
+  uint64_t bytes = 0;
+
+  // loads. Inputs not split with the outputs, e.g., weights and halos, are
+  // reloaded by every tile.
+  std::unordered_set<const xValue *> loaded;
+  for (xNode *n : pSpGraph.getGraph().nodes()) {
+    if (!pSpGraph.hasSplitNode(n))
+      continue;
+    const SplitNode *sn = pSpGraph.getSplitNode(n);
+    if (sn->skipWhenCalMemSize())
+      continue;
+
+    for (unsigned i = 0; i < n->inputs().size(); ++i) {
+      const xValue *v = n->inputs()[i];
+      if (!IsGlobalValue(v) || !loaded.insert(v).second)
+        continue;
+      bytes += m_TTI.getOperatorInputMemUsage(n, i,
+                                              sn->calNewInputSize(i)).size;
+    }
+  }
+
+  // stores.
+  for (xNode *store : pSpGraph.getStores()) {
+    xNode *producer = store->inputs()[0]->node();
+    if (nullptr == producer || !pSpGraph.hasSplitNode(producer))
+      continue;
+    const SplitNode *sn = pSpGraph.getSplitNode(producer);
+    bytes += m_TTI.getOperatorOutputMemUsage(producer, 0,
+                                             sn->getNewOutputSize(0)).size;
+  }
+  return m_TTI.getTransferCost(bytes);
+}
@@ -5,10 +5,11 @@
 // See LICENSE.TXT for details.
 //
 //===----------------------------------------------------------------------===//
+#include <onnc/Analysis/ShapeInference.h>
 #include <onnc/Analysis/UpdateGraphOutputSize.h>
 #include <onnc/Core/ModulePass.h>
+#include <onnc/IR/InitializerIndex.h>
 #include <onnc/IR/ONNXUtils.h>
-#include <onnc/ONNXWrapper/ONNXWrapper.h>
 #include <onnc/Option/CommandLine.h>
 #include <onnc/Support/IOStream.h>
 
@@ -178,12 +179,11 @@ UpdateGraphOutputSize::UpdateGraphOutputSize()
 void UpdateGraphOutputSize::updateInputBatchSize(xGraph *pGraph)
 {
   // update input batch size
-  std::unordered_set<std::string> initializer_names(
-      pGraph->initializer_names().begin(), pGraph->initializer_names().end());
+  InitializerIndex initializers(*pGraph);
   for (int i = 0; i < pGraph->inputs().size(); ++i) {
     xValue *v = pGraph->inputs()[i];
     // ignore weight
-    if (0 != initializer_names.count(v->uniqueName()))
+    if (initializers.isInitializer(v))
       continue;
     // update valueInfo
     auto sizes = v->sizes();
@@ -231,13 +231,13 @@ Pass::ReturnType UpdateGraphOutputSize::runOnModule(Module &pModule)
   do {
     run_onnxInferShape = updateReshapeOutputInfo(graph);
     if (run_onnxInferShape) {
-      // onnx inference will create the new module
-      onnxInferShape(pModule);
+      // the fallback to onnx inference will create the new module
+      InferShapes(pModule);
       graph = pModule.getGraphIR().get();
     }
   } while (run_onnxInferShape);
 
-  onnxInferShape(pModule);
+  InferShapes(pModule);
 
   return Pass::kModuleChanged;
 }
@@ -6,6 +6,7 @@
 //
 //===----------------------------------------------------------------------===//
 #include <onnc/Core/AnalysisResolver.h>
+#include <onnc/Core/PassManager.h>
 
 using namespace onnc;
 
@@ -30,3 +31,8 @@ void AnalysisResolver::add(Pass::AnalysisID pID, Pass& pPass)
 
   m_DepPasses.push_back(std::make_pair(pID, &pPass));
 }
+
+bool AnalysisResolver::isValid(Pass::AnalysisID pID) const
+{
+  return m_PM.isValid(pID);
+}
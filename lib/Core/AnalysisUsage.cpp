@@ -6,6 +6,7 @@
 //
 //===----------------------------------------------------------------------===//
 #include <onnc/Core/AnalysisUsage.h>
+#include <algorithm>
 
 using namespace onnc;
 
@@ -23,3 +24,23 @@ AnalysisUsage& AnalysisUsage::addRequiredID(char& pID)
   m_Required.push_back(&pID);
   return *this;
 }
+
+AnalysisUsage& AnalysisUsage::addPreservedID(Pass::AnalysisID pID)
+{
+  m_Preserved.push_back(pID);
+  return *this;
+}
+
+AnalysisUsage& AnalysisUsage::addPreservedID(char& pID)
+{
+  m_Preserved.push_back(&pID);
+  return *this;
+}
+
+bool AnalysisUsage::isPreserved(Pass::AnalysisID pID) const
+{
+  if (m_bPreservesAll)
+    return true;
+  return (m_Preserved.end() !=
+          std::find(m_Preserved.begin(), m_Preserved.end(), pID));
+}
@@ -0,0 +1,121 @@
+//===- CompileCache.cpp ---------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <onnc/Core/CompileCache.h>
+#include <onnc/Support/FileLock.h>
+#include <onnc/Support/FileSystem.h>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <unistd.h>
+
+using namespace onnc;
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+/// A file name next to @ref pPath no other compiler uses. The process, the
+/// thread and a counter tell apart the writers of --batch -j jobs.
+static Path TemporaryName(const Path& pPath)
+{
+  static std::atomic<unsigned long> counter(0);
+  size_t thread = std::hash<std::thread::id>()(std::this_thread::get_id());
+  return Path(pPath.native() + ".tmp" + std::to_string(::getpid()) + "." +
+              std::to_string(thread) + "." + std::to_string(++counter));
+}
+
+/// Make the directory @ref pDir if it doesn't exist.
+static bool MakeDirectory(const Path& pDir)
+{
+  if (is_directory(pDir))
+    return true;
+  SystemError err = mkdir(pDir, 0755);
+  return err.isGood() || is_directory(pDir);
+}
+
+//===----------------------------------------------------------------------===//
+// CompileCache
+//===----------------------------------------------------------------------===//
+CompileCache::CompileCache(const Path& pDirectory)
+  : m_Directory(pDirectory) {
+}
+
+Path CompileCache::entry(StringRef pKey) const
+{
+  Path result(m_Directory);
+  result.append(Path(pKey.substr(0, 2).str()));
+  result.append(Path(pKey.str()));
+  return result;
+}
+
+bool CompileCache::contains(StringRef pKey, const FileList& pFiles) const
+{
+  Path dir = entry(pKey);
+  if (!is_directory(dir))
+    return false;
+
+  for (const Path& file : pFiles) {
+    Path cached(dir);
+    cached.append(file.filename());
+    if (!exists(cached))
+      return false;
+  }
+  return true;
+}
+
+bool CompileCache::retrieve(StringRef pKey, const FileList& pFiles) const
+{
+  if (!contains(pKey, pFiles))
+    return false;
+
+  Path dir = entry(pKey);
+  for (const Path& file : pFiles) {
+    Path cached(dir);
+    cached.append(file.filename());
+
+    Path temp = TemporaryName(file);
+    if (!copy_file(cached, temp, kOverwriteIfExists).isGood() ||
+        !rename(temp, file).isGood()) {
+      remove(temp);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CompileCache::store(StringRef pKey, const FileList& pFiles) const
+{
+  Path dir = entry(pKey);
+  if (!MakeDirectory(m_Directory) || !MakeDirectory(dir.parent()))
+    return false;
+
+  // only one compiler writes an entry.
+  FileLock lock(Path(dir.native() + ".lock"));
+  lock.lock();
+
+  bool success = is_directory(dir);
+  if (!success) {
+    Path temp = TemporaryName(dir);
+    success = MakeDirectory(temp);
+    for (const Path& file : pFiles) {
+      if (!success)
+        break;
+      Path cached(temp);
+      cached.append(file.filename());
+      success = copy_file(file, cached).isGood();
+    }
+
+    // an entry appears with all of its files or not at all.
+    if (success)
+      success = rename(temp, dir).isGood();
+    if (!success)
+      clean(temp);
+  }
+
+  lock.unlock();
+  return success;
+}
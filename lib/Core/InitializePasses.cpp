@@ -21,5 +21,7 @@ void onnc::InitializeAnalysis(PassRegistry& pRegistry)
 
 void onnc::InitializeAnalysisPassOptions()
 {
+  InitializeMemoryAllocationPassOptions();
   InitializeUpdateGraphOutputSizePassOptions();
+  InitializeNodeIRSchedulerPassOptions();
 }
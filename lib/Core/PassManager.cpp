@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 #include <onnc/Core/PassManager.h>
 #include <onnc/Core/PassRegistry.h>
+#include <onnc/Core/PassTimingInfo.h>
 #include <onnc/Core/AnalysisUsage.h>
 #include <onnc/Core/AnalysisResolver.h>
 #include <onnc/Diagnostic/MsgHandling.h>
@@ -17,6 +18,29 @@
 using namespace onnc;
 
 char PassManager::StartPass::ID = 0;
+
+//===----------------------------------------------------------------------===//
+// Non-member functions
+//===----------------------------------------------------------------------===//
+static Pass::ReturnType RunPass(Pass& pPass, Module& pModule)
+{
+  // initialize the pass
+  Pass::ReturnType result = pPass.doInitialization(pModule);
+
+  if (Pass::IsRetry(result) || Pass::IsFailed(result))
+    return result;
+
+  // run the pass
+  result |= pPass.run(pModule);
+
+  if (Pass::IsRetry(result) || Pass::IsFailed(result))
+    return result;
+
+  // finalize the pass
+  result |= pPass.doFinalization(pModule);
+  return result;
+}
+
 //===----------------------------------------------------------------------===//
 // PassManager
 //===----------------------------------------------------------------------===//
@@ -24,14 +48,18 @@ PassManager::PassManager()
   : m_pPassRegistry(onnc::GetPassRegistry()),
     m_Dependencies(), m_AvailableAnalysis(),
     m_RunState(),
-    m_pStart(m_Dependencies.addNode(new StartPass())) {
+    m_pStart(m_Dependencies.addNode(new StartPass())),
+    m_pTimingInfo(nullptr),
+    m_ValidAnalyses(), m_pModule(nullptr) {
 }
 
 PassManager::PassManager(PassRegistry& pRegistry)
   : m_pPassRegistry(&pRegistry),
     m_Dependencies(), m_AvailableAnalysis(),
     m_RunState(),
-    m_pStart(m_Dependencies.addNode(new StartPass())) {
+    m_pStart(m_Dependencies.addNode(new StartPass())),
+    m_pTimingInfo(nullptr),
+    m_ValidAnalyses(), m_pModule(nullptr) {
 }
 
 PassManager::~PassManager()
@@ -143,15 +171,33 @@ bool PassManager::run(Module& pModule)
 
 bool PassManager::step(Module& pModule, State& pState)
 {
+  // analysis results belong to one module.
+  if (&pModule != m_pModule) {
+    m_ValidAnalyses.clear();
+    m_pModule = &pModule;
+  }
+
+  // rerun the stale analyses before the pass requiring them.
+  while (ScheduleStaleAnalyses(pState.execution))
+    ;
+
   DepNode* node = findNode(pState.execution.front());
   if (nullptr == node)
     return Pass::kPassFailure;
   pState.pass = node->pass;
 
+  // reuse the valid result.
+  if (isValid(pState.pass->getPassID())) {
+    pState.execution.pop_front();
+    return true;
+  }
+
   Pass::ReturnType result = doRun(*pState.pass, pModule);
   if (Pass::IsFailed(result))
     return false;
 
+  UpdateValidAnalyses(*pState.pass, result);
+
   if (Pass::IsRetry(result)) {
     if (Pass::IsRevised(result)) {
       UpdateExecutionOrder(pState.execution);
@@ -174,21 +220,23 @@ bool PassManager::step(Module& pModule)
 
 Pass::ReturnType PassManager::doRun(Pass& pPass, Module& pModule)
 {
-  // initialize the pass
-  Pass::ReturnType result = pPass.doInitialization(pModule);
-
-  if (Pass::IsRetry(result) || Pass::IsFailed(result))
-    return result;
+  if (nullptr == m_pTimingInfo)
+    return RunPass(pPass, pModule);
 
-  // run the pass
-  result |= pPass.run(pModule);
+  m_pTimingInfo->start(pPass);
+  Pass::ReturnType result = RunPass(pPass, pModule);
+  m_pTimingInfo->stop(result);
+  return result;
+}
 
-  if (Pass::IsRetry(result) || Pass::IsFailed(result))
-    return result;
+bool PassManager::isValid(Pass::AnalysisID pID) const
+{
+  return (m_ValidAnalyses.end() != m_ValidAnalyses.find(pID));
+}
 
-  // finalize the pass
-  result |= pPass.doFinalization(pModule);
-  return result;
+void PassManager::invalidate(Pass::AnalysisID pID)
+{
+  m_ValidAnalyses.erase(pID);
 }
 
 PassManager::DepNode* PassManager::findNode(Pass::AnalysisID pID)
@@ -271,3 +319,46 @@ void PassManager::UpdateExecutionOrder(ExecutionOrder& pOrder)
     ++ele;
   }
 }
+
+bool PassManager::ScheduleStaleAnalyses(ExecutionOrder& pOrder)
+{
+  DepNode* node = findNode(pOrder.front());
+  if (nullptr == node)
+    return false;
+
+  AnalysisUsage usage;
+  node->pass->getAnalysisUsage(usage);
+
+  std::vector<Pass::AnalysisID> stale;
+  for (Pass::AnalysisID use : usage) {
+    DepNode* dep_node = findNode(use);
+    if (nullptr != dep_node && dep_node->pass->isAnalysis() && !isValid(use))
+      stale.push_back(use);
+  }
+
+  // keep the order of requirements.
+  std::vector<Pass::AnalysisID>::reverse_iterator use, uEnd = stale.rend();
+  for (use = stale.rbegin(); use != uEnd; ++use)
+    pOrder.push_front(*use);
+
+  return !stale.empty();
+}
+
+void PassManager::UpdateValidAnalyses(Pass& pPass, Pass::ReturnType pResult)
+{
+  if (Pass::IsRevised(pResult)) {
+    AnalysisUsage usage;
+    pPass.getAnalysisUsage(usage);
+    AnalysisSet::iterator analysis = m_ValidAnalyses.begin();
+    while (m_ValidAnalyses.end() != analysis) {
+      if (usage.isPreserved(*analysis))
+        ++analysis;
+      else
+        analysis = m_ValidAnalyses.erase(analysis);
+    }
+  }
+
+  // a retried analysis isn't complete.
+  if (pPass.isAnalysis() && !Pass::IsRetry(pResult))
+    m_ValidAnalyses.insert(pPass.getPassID());
+}
@@ -31,6 +31,7 @@ PassRegistry::~PassRegistry()
 
 const PassInfo* PassRegistry::getPassInfo(Pass::AnalysisID pID) const
 {
+  std::lock_guard<std::mutex> guard(m_Mutex);
   MapType::const_iterator entry = m_Map.find(pID);
   if (m_Map.end() == entry) // not found
     return nullptr;
@@ -40,14 +41,19 @@ const PassInfo* PassRegistry::getPassInfo(Pass::AnalysisID pID) const
 void PassRegistry::registerPass(const PassInfo& pInfo)
 {
   std::pair<Pass::AnalysisID, const PassInfo*> value(pInfo.getPassID(), &pInfo);
-  std::pair<MapType::iterator,bool> result = m_Map.insert(value);
-  if (false == result.second) { // not inserted
+  bool inserted = false;
+  {
+    std::lock_guard<std::mutex> guard(m_Mutex);
+    inserted = m_Map.insert(value).second;
+  }
+  if (!inserted) {
     error(pass_registered) << pInfo.getPassName();
   }
 }
 
 void PassRegistry::clear()
 {
+  std::lock_guard<std::mutex> guard(m_Mutex);
   MapType::iterator entry, eEnd = m_Map.end();
   for (entry = m_Map.begin(); entry != eEnd; ++entry) {
     delete entry->second;
@@ -57,10 +63,12 @@ void PassRegistry::clear()
 
 bool PassRegistry::isEmpty() const
 {
+  std::lock_guard<std::mutex> guard(m_Mutex);
   return m_Map.empty();
 }
 
 unsigned int PassRegistry::numOfPasses() const
 {
+  std::lock_guard<std::mutex> guard(m_Mutex);
   return m_Map.size();
 }
@@ -0,0 +1,187 @@
+//===- PassTimingInfo.cpp -------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <onnc/Core/PassTimingInfo.h>
+#include <onnc/JSON/Array.h>
+#include <onnc/JSON/Object.h>
+#include <onnc/JSON/Value.h>
+#include <onnc/Support/Host.h>
+#include <onnc/Support/IndentOStream.h>
+#include <algorithm>
+#include <cassert>
+#include <iomanip> // for setw
+#include <numeric>
+
+using namespace onnc;
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+static inline double ToSeconds(Timer::Interval pNS)
+{
+  return pNS / 1e9;
+}
+
+static inline double ToMB(uint64_t pBytes)
+{
+  return pBytes / (1024.0 * 1024.0);
+}
+
+static inline double Percent(Timer::Interval pPart, Timer::Interval pTotal)
+{
+  return (0 == pTotal) ? 0.0 : (100.0 * pPart / pTotal);
+}
+
+/// microseconds, the unit of the trace event format.
+static inline long long int ToUS(Timer::Interval pNS)
+{
+  return pNS / 1000;
+}
+
+//===----------------------------------------------------------------------===//
+// PassTimingInfo
+//===----------------------------------------------------------------------===//
+PassTimingInfo::PassTimingInfo()
+  : m_Records(), m_RecordMap(), m_Events(), m_Timer(),
+    m_Origin(Timer::Now()), m_PeakRSS(0) {
+}
+
+void PassTimingInfo::start(const Pass& pPass)
+{
+  assert(!m_Timer.isActive() && "passes don't nest");
+
+  RecordMap::iterator entry = m_RecordMap.find(pPass.getPassID());
+  unsigned int idx = m_Records.size();
+  if (m_RecordMap.end() == entry) {
+    m_RecordMap[pPass.getPassID()] = idx;
+    m_Records.push_back(Record{ pPass.getPassName().str(), 0, 0, 0, 0, 0 });
+  }
+  else
+    idx = entry->second;
+
+  Event event;
+  event.record = idx;
+  event.start = Timer::Now() - m_Origin;
+  m_Events.push_back(event);
+
+  m_PeakRSS = sys::GetPeakRSS();
+  m_Timer.start();
+}
+
+void PassTimingInfo::stop(Pass::ReturnType pResult)
+{
+  m_Timer.stop();
+  uint64_t peak = sys::GetPeakRSS();
+
+  Event& event = m_Events.back();
+  event.wall = m_Timer.interval();
+  event.cpu = m_Timer.cpuInterval();
+  event.rss = (peak > m_PeakRSS) ? (peak - m_PeakRSS) : 0;
+  event.retry = Pass::IsRetry(pResult);
+
+  Record& record = m_Records[event.record];
+  ++record.runs;
+  if (event.retry)
+    ++record.retries;
+  record.wall += event.wall;
+  record.cpu += event.cpu;
+  record.rss += event.rss;
+}
+
+void PassTimingInfo::clear()
+{
+  m_Records.clear();
+  m_RecordMap.clear();
+  m_Events.clear();
+  m_Origin = Timer::Now();
+}
+
+void PassTimingInfo::print(OStream& pOS, const std::string& pTitle) const
+{
+  Timer::Interval wall = 0, cpu = 0;
+  uint64_t rss = 0;
+  for (const Record& record : m_Records) {
+    wall += record.wall;
+    cpu += record.cpu;
+    rss += record.rss;
+  }
+
+  std::vector<unsigned int> order(m_Records.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [this] (unsigned int pA, unsigned int pB) {
+                     return m_Records[pA].wall > m_Records[pB].wall;
+                   });
+
+  std::ios::fmtflags flags = pOS.flags();
+  std::streamsize precision = pOS.precision();
+  pOS << std::fixed << std::setprecision(4);
+
+  pOS << "===" << std::string(73, '-') << "===\n"
+      << "                      Pass execution timing report\n";
+  if (!pTitle.empty())
+    pOS << "  " << pTitle << "\n";
+  pOS << "===" << std::string(73, '-') << "===\n"
+      << "  Total Execution Time: " << ToSeconds(cpu) << " seconds ("
+      << ToSeconds(wall) << " wall clock)\n\n"
+      << "   ---Wall Time---    ---CPU Time--- --Peak RSS--  Runs  Retries"
+      << "  --- Name ---\n";
+
+  for (unsigned int idx : order) {
+    const Record& record = m_Records[idx];
+    pOS << std::setw(9) << ToSeconds(record.wall) << " ("
+        << std::setw(5) << std::setprecision(1)
+        << Percent(record.wall, wall) << "%)"
+        << std::setprecision(4)
+        << std::setw(9) << ToSeconds(record.cpu) << " ("
+        << std::setw(5) << std::setprecision(1)
+        << Percent(record.cpu, cpu) << "%)"
+        << std::setw(10) << ToMB(record.rss) << " MB"
+        << std::setprecision(4)
+        << std::setw(6) << record.runs
+        << std::setw(9) << record.retries
+        << "  " << record.name << "\n";
+  }
+
+  pOS << std::setw(9) << ToSeconds(wall) << " (100.0%)"
+      << std::setw(9) << ToSeconds(cpu) << " (100.0%)"
+      << std::setw(10) << std::setprecision(1) << ToMB(rss) << " MB"
+      << std::setw(6) << m_Events.size()
+      << "           Total\n";
+
+  pOS.flags(flags);
+  pOS.precision(precision);
+}
+
+void PassTimingInfo::printTrace(OStream& pOS) const
+{
+  json::Array events;
+  for (const Event& event : m_Events) {
+    json::Object args;
+    args.insert("cpu_us", json::Value(ToUS(event.cpu)));
+    args.insert("peak_rss_delta", json::Value((unsigned long long)event.rss));
+    args.insert("retry", json::Value(event.retry));
+
+    json::Object trace;
+    trace.insert("name", m_Records[event.record].name);
+    trace.insert("cat", "pass");
+    trace.insert("ph", "X");
+    trace.insert("ts", json::Value(ToUS(event.start)));
+    trace.insert("dur", json::Value(ToUS(event.wall)));
+    trace.insert("pid", json::Value(1));
+    trace.insert("tid", json::Value(1));
+    trace.insert("args", args);
+    events.push_back(json::Value(trace));
+  }
+
+  json::Object document;
+  document.insert("traceEvents", events);
+  document.insert("displayTimeUnit", "ms");
+
+  IndentOStream oss(pOS);
+  document.print(oss);
+}
@@ -33,6 +33,7 @@ Engine::~Engine()
 void Engine::delegate(Logger* pLogger)
 {
   if (nullptr != pLogger) {
+    std::lock_guard<std::mutex> guard(m_LoggerMutex);
     m_pLogger->stop();
     delete m_pLogger;
     m_pLogger = pLogger;
@@ -42,9 +43,16 @@ void Engine::delegate(Logger* pLogger)
 
 bool Engine::hasError() const
 {
+  std::lock_guard<std::mutex> guard(m_LoggerMutex);
   return (m_pLogger->getNumErrors() > 0);
 }
 
+diagnostic::State& diagnostic::Engine::state() const
+{
+  static thread_local State state;
+  return state;
+}
+
 diagnostic::MsgHandler
 diagnostic::Engine::report(unsigned int pID, Severity pSeverity)
 {
@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 #include <onnc/IR/ComputeGraph.h>
 #include <onnc/IR/Module.h>
+#include <algorithm>
 
 using namespace onnc;
 
@@ -22,7 +23,11 @@ ComputeGraph::ComputeGraph(const std::string& pName,
     m_pNodeRear(nullptr),
     m_NodeList(),
     m_ArcList(pArcList),
-    m_ValueList(pModule.getValueList()) {
+    m_ValueList(pModule.getValueList()),
+    m_bStaging(false),
+    m_StagedValueList(),
+    m_StagedValues(),
+    m_StagedArcs() {
 }
 
 ComputeGraph::~ComputeGraph()
@@ -32,7 +37,61 @@ ComputeGraph::~ComputeGraph()
 
 void ComputeGraph::addValueToModule(Value* pValue)
 {
-  m_Module.addValue(pValue);
+  if (!m_bStaging) {
+    m_Module.addValue(pValue);
+    return;
+  }
+
+  // like Module::addValue, the first value of a name wins.
+  if (m_ValueList.end() != m_ValueList.find(pValue->getName()))
+    return;
+  bool exist = false;
+  auto* entry = m_StagedValueList.insert(pValue->getName(), exist);
+  if (exist)
+    return;
+  entry->setValue(pValue);
+  m_StagedValues.push_back(pValue);
+}
+
+Value* ComputeGraph::findValue(StringRef pName) const
+{
+  ValueList::iterator entry = m_ValueList.find(pName);
+  if (m_ValueList.end() != entry)
+    return entry->value();
+
+  if (!m_bStaging)
+    return nullptr;
+
+  ValueList::const_iterator staged = m_StagedValueList.find(pName);
+  if (m_StagedValueList.end() == staged)
+    return nullptr;
+  return staged->value();
+}
+
+void ComputeGraph::addArc(Arc* pArc)
+{
+  if (m_bStaging)
+    m_StagedArcs.push_back(pArc);
+  else
+    m_ArcList.insert(pArc);
+}
+
+void ComputeGraph::stage()
+{
+  m_bStaging = true;
+}
+
+void ComputeGraph::commit()
+{
+  for (Value* value : m_StagedValues)
+    m_Module.addValue(value);
+  for (Arc* arc : m_StagedArcs)
+    m_ArcList.insert(arc);
+
+  m_StagedValueList.clear();
+  m_StagedValues.clear();
+  m_StagedArcs.clear();
+  m_bStaging = false;
 }
 
 void ComputeGraph::erase(ComputeOperator& pNode)
@@ -102,6 +161,12 @@ void ComputeGraph::erase(ComputeOperand& pArc)
   }
 
   // 3. remove from the arc list
+  if (m_bStaging) {
+    std::vector<Arc*>::iterator staged =
+        std::find(m_StagedArcs.begin(), m_StagedArcs.end(), &pArc);
+    if (m_StagedArcs.end() != staged)
+      m_StagedArcs.erase(staged);
+  }
   m_ArcList.erase(&pArc);
 
   // 4. remove the memory space since it is delegated.
@@ -124,6 +189,16 @@ void ComputeGraph::clear()
   for (arc = m_ArcList.begin(); arc != aEnd; ++arc)
     delete *arc;
   m_ArcList.clear();
+
+  // the staged values and operands aren't owned by the module yet.
+  for (Arc* staged : m_StagedArcs)
+    delete staged;
+  for (Value* staged : m_StagedValues)
+    delete staged;
+  m_StagedValueList.clear();
+  m_StagedValues.clear();
+  m_StagedArcs.clear();
+  m_bStaging = false;
 }
 
 ComputeGraph::iterator ComputeGraph::begin()
@@ -8,9 +8,44 @@
 #include <onnc/IR/Compute/Tensor.h>
 #include <onnc/IR/IRBuilder.h>
 #include <onnc/Config/ONNX.h>
+#include <type_traits>
 
 using namespace onnc;
 
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+/// Smaller initializers are copied. Their raw data may be kept inline by
+/// std::string and move when the initializer list grows.
+static const size_t kMinBorrowedSize = 4096;
+
+/// Let @ref pTensor borrow the raw data of an initializer if the raw layout
+/// is the layout of its values.
+/// @retval false the values must be copied.
+template<typename TensorType, typename NativeType>
+static typename std::enable_if<
+    std::is_arithmetic<NativeType>::value &&
+    std::is_same<typename TensorType::ValueList::value_type, NativeType>::value,
+    bool>::type
+BorrowRawData(TensorType& pTensor, const NativeType* pData, size_t pNumOfElems)
+{
+  if (pNumOfElems * sizeof(NativeType) < kMinBorrowedSize)
+    return false;
+  // the initializer lives as long as the tensor graph of the module.
+  pTensor.setValues(pData, pNumOfElems);
+  return true;
+}
+
+template<typename TensorType, typename NativeType>
+static typename std::enable_if<
+    !std::is_arithmetic<NativeType>::value ||
+    !std::is_same<typename TensorType::ValueList::value_type, NativeType>::value,
+    bool>::type
+BorrowRawData(TensorType& pTensor, const NativeType* pData, size_t pNumOfElems)
+{
+  return false;
+}
+
 //===----------------------------------------------------------------------===//
 // IRBuilder
 //===----------------------------------------------------------------------===//
@@ -250,13 +285,15 @@ bool IRBuilder::FinalizeTensorGraph(const StringList& pOutputs)
 #define CREATE_VAL_DATA(result, CG, tensor, ONNCType, NativeType, accessor) \
 { \
   auto t = CG.addValue<ONNCType>(name); \
-  /* copy tensor init data. */ \
+  /* borrow or copy tensor init data. */ \
   if (tensor.is_raw_data()) { \
     const size_t numElems = tensor.raw().size() / sizeof(NativeType); \
-    NativeType* d = (NativeType*)tensor.raw().c_str(); \
-    t->getValues().resize(numElems); \
-    for (size_t i = 0; i < numElems; ++i) \
-      t->getValues()[i] = d[i]; \
+    const NativeType* d = (const NativeType*)tensor.raw().data(); \
+    if (!BorrowRawData(*t, d, numElems)) { \
+      t->getValues().resize(numElems); \
+      for (size_t i = 0; i < numElems; ++i) \
+        t->getValues()[i] = d[i]; \
+    } \
   } \
   else { \
     const size_t numElems = tensor.accessor().size(); \
@@ -275,11 +312,11 @@ Tensor* IRBuilder::CreateComputeTensor(ComputeGraph& pCG,
   Tensor* result = nullptr;
   switch (pValue.elemType()) {
   case onnc::Value::kInt8: {
-    CREATE_VAL_DATA(result, pCG, pTensor, Int8Tensor, int32_t, int32s);
+    CREATE_VAL_DATA(result, pCG, pTensor, Int8Tensor, int8_t, int32s);
     break;
   }
   case onnc::Value::kInt16: {
-    CREATE_VAL_DATA(result, pCG, pTensor, Int16Tensor, int32_t, int32s);
+    CREATE_VAL_DATA(result, pCG, pTensor, Int16Tensor, int16_t, int32s);
     break;
   }
   case onnc::Value::kInt32: {
@@ -291,15 +328,15 @@ Tensor* IRBuilder::CreateComputeTensor(ComputeGraph& pCG,
     break;
   }
   case onnc::Value::kUint8: {
-    CREATE_VAL_DATA(result, pCG, pTensor, Uint8Tensor, int32_t, int32s);
+    CREATE_VAL_DATA(result, pCG, pTensor, Uint8Tensor, uint8_t, int32s);
     break;
   }
   case onnc::Value::kUint16: {
-    CREATE_VAL_DATA(result, pCG, pTensor, Uint16Tensor, int32_t, int32s);
+    CREATE_VAL_DATA(result, pCG, pTensor, Uint16Tensor, uint16_t, int32s);
     break;
   }
   case onnc::Value::kUint32: {
-    CREATE_VAL_DATA(result, pCG, pTensor, Uint32Tensor, uint64_t, uint64s);
+    CREATE_VAL_DATA(result, pCG, pTensor, Uint32Tensor, uint32_t, uint64s);
     break;
   }
   case onnc::Value::kUint64: {
@@ -319,7 +356,7 @@ Tensor* IRBuilder::CreateComputeTensor(ComputeGraph& pCG,
     break;
   }
   case onnc::Value::kBoolean: {
-    CREATE_VAL_DATA(result, pCG, pTensor, BooleanTensor, int32_t, int32s);
+    CREATE_VAL_DATA(result, pCG, pTensor, BooleanTensor, uint8_t, int32s);
     break;
   }
   case onnc::Value::kDouble: {
@@ -0,0 +1,50 @@
+//===- InitializerIndex.cpp -----------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <onnc/IR/InitializerIndex.h>
+
+using namespace onnc;
+
+//===----------------------------------------------------------------------===//
+// InitializerIndex
+//===----------------------------------------------------------------------===//
+InitializerIndex::InitializerIndex(xGraph& pGraph)
+  : m_Graph(pGraph), m_Values() {
+  rebuild();
+}
+
+void InitializerIndex::rebuild()
+{
+  m_Values.clear();
+  std::unordered_set<std::string> names(m_Graph.initializer_names().begin(),
+                                        m_Graph.initializer_names().end());
+  for (const xValue* input : m_Graph.inputs()) {
+    if (0 != names.count(input->uniqueName()))
+      m_Values.insert(input);
+  }
+}
+
+xValue* InitializerIndex::addInitializerAndInput(const xTensor& pTensor)
+{
+  xValue* value = m_Graph.addInitializerAndInput(pTensor);
+  m_Values.insert(value);
+  return value;
+}
+
+xValue* InitializerIndex::addInitializerAndInput(const xTensor& pTensor,
+                                                 const std::string& pName)
+{
+  xValue* value = m_Graph.addInitializerAndInput(pTensor, pName);
+  m_Values.insert(value);
+  return value;
+}
+
+void InitializerIndex::eraseInitializerAndInput(xValue* pValue)
+{
+  m_Values.erase(pValue);
+  m_Graph.eraseInitializerAndInput(pValue);
+}
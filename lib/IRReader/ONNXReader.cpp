@@ -13,12 +13,408 @@
 #include <onnc/Config/ONNX.h>
 #include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/wire_format_lite.h>
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <map>
+#include <unistd.h>
 
 using namespace onnc;
 
+namespace {
+
+using ::google::protobuf::io::CodedInputStream;
+using ::google::protobuf::io::CodedOutputStream;
+using ::google::protobuf::io::StringOutputStream;
+using ::google::protobuf::io::ZeroCopyInputStream;
+typedef ::google::protobuf::internal::WireFormatLite WireFormat;
+
+// field numbers in onnx.proto
+const int kModelGraph = 7;
+const int kGraphInitializer = 5;
+const int kTensorRawData = 9;
+const int kTensorExternalData = 13;
+const int kTensorDataLocation = 14;
+const int kEntryKey = 1;
+const int kEntryValue = 2;
+
+// TensorProto::EXTERNAL
+const uint32_t kExternalLocation = 1;
+
+/// Where the raw data of an initializer is stored.
+struct Payload
+{
+  enum Kind {
+    kNone,     ///< no raw data
+    kInline,   ///< in the model file
+    kExternal  ///< in the file @ref location, relative to the model file
+  };
+
+  Payload() : kind(kNone), location(), offset(0), length(ULLONG_MAX) { }
+
+  Kind kind;
+  std::string location;
+  uint64_t offset;
+
+  /// ULLONG_MAX: to the end of the file.
+  uint64_t length;
+};
+
+typedef std::map<std::string, Payload> PayloadMap;
+
+typedef std::vector<xTensorProto> TensorProtoList;
+
+/** \class StreamParser
+ *  \brief Walk the wire format of a ModelProto without reading the raw data
+ *  of the initializers.
+ *
+ *  The raw data are skipped and only their offsets are recorded, so the
+ *  parsed messages stay small. Every field is read by its own
+ *  CodedInputStream, so the model may be larger than the 2 GB a single
+ *  CodedInputStream can read.
+ */
+class StreamParser
+{
+public:
+  StreamParser(ZeroCopyInputStream& pStream,
+               int pTotalBytesLimit, int pWarningThreshold)
+    : m_Stream(pStream), m_TotalBytesLimit(pTotalBytesLimit),
+      m_WarningThreshold(pWarningThreshold) {
+  }
+
+  bool parse(xProto& pModel, PayloadMap& pPayloads);
+
+private:
+  bool parseGraph(uint64_t pEnd, std::string& pBytes,
+                  TensorProtoList& pInitializers, PayloadMap& pPayloads);
+
+  bool parseTensor(uint64_t pEnd, std::string& pBytes, Payload& pPayload);
+
+  /// Skip @ref pLength bytes of the underlying stream.
+  bool skip(uint64_t pLength);
+
+  /// The number of bytes read. Valid only if no CodedInputStream is alive.
+  uint64_t position() const { return m_Stream.ByteCount(); }
+
+  void setLimit(CodedInputStream& pInput) const {
+    pInput.SetTotalBytesLimit(m_TotalBytesLimit, m_WarningThreshold);
+  }
+
+private:
+  ZeroCopyInputStream& m_Stream;
+  int m_TotalBytesLimit;
+  int m_WarningThreshold;
+};
+
+inline bool IsField(uint32_t pTag, int pNumber,
+                    WireFormat::WireType pWireType)
+{
+  return (pNumber == WireFormat::GetTagFieldNumber(pTag) &&
+          pWireType == WireFormat::GetTagWireType(pTag));
+}
+
+inline bool IsMessage(uint32_t pTag, int pNumber)
+{
+  return IsField(pTag, pNumber, WireFormat::WIRETYPE_LENGTH_DELIMITED);
+}
+
+/// Append the field of @ref pTag to @ref pBytes.
+bool CopyField(CodedInputStream& pInput, uint32_t pTag, std::string& pBytes)
+{
+  StringOutputStream stream(&pBytes);
+  CodedOutputStream output(&stream);
+  return WireFormat::SkipField(&pInput, pTag, &output);
+}
+
+/// Read a StringStringEntryProto.
+bool ReadEntry(CodedInputStream& pInput, std::string& pKey,
+               std::string& pValue)
+{
+  uint32_t length = 0;
+  if (!pInput.ReadVarint32(&length))
+    return false;
+
+  CodedInputStream::Limit limit = pInput.PushLimit(length);
+  while (uint32_t tag = pInput.ReadTag()) {
+    bool good = true;
+    if (IsMessage(tag, kEntryKey))
+      good = WireFormat::ReadString(&pInput, &pKey);
+    else if (IsMessage(tag, kEntryValue))
+      good = WireFormat::ReadString(&pInput, &pValue);
+    else
+      good = WireFormat::SkipField(&pInput, tag);
+    if (!good)
+      return false;
+  }
+  bool consumed = pInput.ConsumedEntireMessage();
+  pInput.PopLimit(limit);
+  return consumed;
+}
+
+//===----------------------------------------------------------------------===//
+// StreamParser
+//===----------------------------------------------------------------------===//
+bool StreamParser::parse(xProto& pModel, PayloadMap& pPayloads)
+{
+  std::string modelBytes, graphBytes;
+  TensorProtoList initializers;
+  bool hasGraph = false;
+  while (true) {
+    uint64_t graphEnd = 0;
+    {
+      const uint64_t base = position();
+      CodedInputStream input(&m_Stream);
+      setLimit(input);
+      uint32_t tag = input.ReadTag();
+      if (0 == tag) {
+        if (!input.ConsumedEntireMessage())
+          return false;
+        break;
+      }
+
+      if (IsMessage(tag, kModelGraph)) {
+        uint64_t length = 0;
+        if (!input.ReadVarint64(&length))
+          return false;
+        graphEnd = base + input.CurrentPosition() + length;
+      }
+      else if (!CopyField(input, tag, modelBytes))
+        return false;
+    }
+
+    // a message field appearing twice is merged.
+    if (0 != graphEnd) {
+      if (!parseGraph(graphEnd, graphBytes, initializers, pPayloads))
+        return false;
+      hasGraph = true;
+    }
+  }
+
+  if (!pModel.ParseFromString(modelBytes))
+    return false;
+
+  if (hasGraph) {
+    xGraphProto* graph = pModel.mutable_graph();
+    if (!graph->ParseFromString(graphBytes))
+      return false;
+    for (xTensorProto& initializer : initializers)
+      graph->add_initializer()->Swap(&initializer);
+  }
+  return true;
+}
+
+bool StreamParser::parseGraph(uint64_t pEnd, std::string& pBytes,
+                              TensorProtoList& pInitializers,
+                              PayloadMap& pPayloads)
+{
+  while (position() < pEnd) {
+    uint64_t tensorEnd = 0;
+    {
+      const uint64_t base = position();
+      CodedInputStream input(&m_Stream);
+      setLimit(input);
+      uint32_t tag = input.ReadTag();
+      if (0 == tag)
+        return false;
+
+      if (IsMessage(tag, kGraphInitializer)) {
+        uint64_t length = 0;
+        if (!input.ReadVarint64(&length))
+          return false;
+        tensorEnd = base + input.CurrentPosition() + length;
+      }
+      else if (!CopyField(input, tag, pBytes))
+        return false;
+    }
+
+    if (0 != tensorEnd) {
+      std::string bytes;
+      Payload payload;
+      if (!parseTensor(tensorEnd, bytes, payload))
+        return false;
+
+      pInitializers.emplace_back();
+      if (!pInitializers.back().ParseFromString(bytes))
+        return false;
+      if (Payload::kNone != payload.kind)
+        pPayloads[pInitializers.back().name()] = payload;
+    }
+  }
+  return (position() == pEnd);
+}
+
+bool StreamParser::parseTensor(uint64_t pEnd, std::string& pBytes,
+                               Payload& pPayload)
+{
+  Payload external;
+  external.kind = Payload::kExternal;
+  bool isExternal = false;
+  while (position() < pEnd) {
+    uint64_t rawLength = 0;
+    {
+      const uint64_t base = position();
+      CodedInputStream input(&m_Stream);
+      setLimit(input);
+      uint32_t tag = input.ReadTag();
+      if (0 == tag)
+        return false;
+
+      if (IsMessage(tag, kTensorRawData)) {
+        if (!input.ReadVarint64(&rawLength))
+          return false;
+        pPayload.kind = Payload::kInline;
+        pPayload.offset = base + input.CurrentPosition();
+        pPayload.length = rawLength;
+      }
+      else if (IsMessage(tag, kTensorExternalData)) {
+        std::string key, value;
+        if (!ReadEntry(input, key, value))
+          return false;
+        if ("location" == key)
+          external.location = value;
+        else if ("offset" == key)
+          external.offset = std::strtoull(value.c_str(), nullptr, 10);
+        else if ("length" == key)
+          external.length = std::strtoull(value.c_str(), nullptr, 10);
+      }
+      else if (IsField(tag, kTensorDataLocation,
+                       WireFormat::WIRETYPE_VARINT)) {
+        uint32_t location = 0;
+        if (!input.ReadVarint32(&location))
+          return false;
+        isExternal = (kExternalLocation == location);
+      }
+      else if (!CopyField(input, tag, pBytes))
+        return false;
+    }
+
+    // skip the raw data after the CodedInputStream backs up its buffer.
+    if (!skip(rawLength))
+      return false;
+  }
+
+  if (isExternal)
+    pPayload = external;
+  return (position() == pEnd);
+}
+
+bool StreamParser::skip(uint64_t pLength)
+{
+  while (0 < pLength) {
+    int count = std::min<uint64_t>(pLength, INT_MAX);
+    if (!m_Stream.Skip(count))
+      return false;
+    pLength -= count;
+  }
+  return true;
+}
+
+} // anonymous namespace
+
 //===----------------------------------------------------------------------===//
 // Non-member functions
 //===----------------------------------------------------------------------===//
+/// Read [@ref pOffset, @ref pOffset + @ref pLength) of @ref pFD.
+static SystemError
+ReadPayload(int pFD, uint64_t pOffset, uint64_t pLength, std::string& pData)
+{
+  pData.resize(pLength);
+  uint64_t done = 0;
+  while (done < pLength) {
+    ssize_t count = ::pread(pFD, &pData[done], pLength - done,
+                            pOffset + done);
+    if (-1 == count)
+      return SystemError(errno);
+    if (0 == count)
+      return SystemError::kIoError;
+    done += count;
+  }
+  return SystemError::kSuccess;
+}
+
+/// External data must stay inside the directory of the model, so
+/// @ref pLocation can neither be absolute nor have a ".." component.
+static bool IsInsideModelDir(const Path& pLocation)
+{
+  const std::string& name = pLocation.native();
+  if (name.empty() || pLocation.isFromRoot())
+    return false;
+
+  std::string::size_type begin = 0;
+  while (begin <= name.size()) {
+    std::string::size_type end = name.find(Path::separator, begin);
+    if (std::string::npos == end)
+      end = name.size();
+    if (0 == name.compare(begin, end - begin, ".."))
+      return false;
+    begin = end + 1;
+  }
+  return true;
+}
+
+static SystemError ReadPayload(const Path& pDir, const Payload& pPayload,
+                               std::string& pData)
+{
+  Path path(pPayload.location);
+  if (!IsInsideModelDir(path))
+    return SystemError::kOperationNotPermitted;
+
+  if (!pDir.empty()) {
+    path = pDir;
+    path.append(Path(pPayload.location));
+  }
+
+  FileHandle file;
+  SystemError err = file.open(path, FileHandle::kReadOnly);
+  if (!err.isGood())
+    return err;
+
+  uint64_t length = pPayload.length;
+  if (ULLONG_MAX == length) {
+    if (pPayload.offset > file.size())
+      return SystemError::kIoError;
+    length = file.size() - pPayload.offset;
+  }
+
+  err = ReadPayload(file.handler(), pPayload.offset, length, pData);
+  if (!err.isGood())
+    return err;
+  return file.close();
+}
+
+/// Read the raw data of the initializers right into the tensor graph.
+/// @param pBase the offset where the model starts in @ref pFD.
+static SystemError LoadPayloads(xGraph& pGraph, int pFD, uint64_t pBase,
+                                const Path& pDir, const PayloadMap& pPayloads)
+{
+  if (pPayloads.empty())
+    return SystemError::kSuccess;
+
+  // xGraph gives no mutable access to the initializers. They hold no raw
+  // data yet and are cheap to re-add.
+  std::vector<xTensor> tensors(pGraph.initializers());
+  std::vector<std::string> names(pGraph.initializer_names());
+  pGraph.clearInitializers();
+
+  SystemError result = SystemError::kSuccess;
+  for (unsigned i = 0; i < tensors.size(); ++i) {
+    PayloadMap::const_iterator payload = pPayloads.find(names[i]);
+    if (pPayloads.end() != payload && result.isGood()) {
+      std::string data;
+      if (Payload::kInline == payload->second.kind)
+        result = ReadPayload(pFD, pBase + payload->second.offset,
+                             payload->second.length, data);
+      else
+        result = ReadPayload(pDir, payload->second, data);
+      tensors[i].set_raw_data(std::move(data));
+    }
+    pGraph.addInitializer(std::move(tensors[i]), names[i]);
+  }
+  return result;
+}
+
 static inline bool
 DoParse(Module& pModule, ::google::protobuf::io::ZeroCopyInputStream& pStream,
         int pTotalBytesLimit, int pWarningThreshold)
@@ -35,6 +431,39 @@ DoParse(Module& pModule, ::google::protobuf::io::ZeroCopyInputStream& pStream,
   return true;
 }
 
+/// Parse the model in @ref pFD without loading the raw data of initializers
+/// into the ModelProto. They are read from their offsets after the tensor
+/// graph is built, so every weight is held once.
+/// @param pDir the directory of the external data.
+static SystemError StreamParse(int pFD, const Path& pDir, Module& pModule,
+                               int pTotalBytesLimit, int pWarningThreshold)
+{
+  ::google::protobuf::io::FileInputStream input(pFD);
+
+  // pipes can't be read at offsets, parse them as a whole.
+  off_t base = ::lseek(pFD, 0, SEEK_CUR);
+  if (-1 == base) {
+    if (!DoParse(pModule, input, pTotalBytesLimit, pWarningThreshold))
+      return SystemError::kUnknownError;
+    return SystemError::kSuccess;
+  }
+
+  PayloadMap payloads;
+  {
+    xProto model;
+    StreamParser parser(input, pTotalBytesLimit, pWarningThreshold);
+    if (!parser.parse(model, payloads))
+      return SystemError::kUnknownError;
+    IRBuilder builder(pModule);
+    builder.update(model);
+  }
+
+  if (!pModule.hasRootTensorGraph())
+    return SystemError::kSuccess;
+  return LoadPayloads(*pModule.getRootTensorGraph(), pFD, base, pDir,
+                      payloads);
+}
+
 //===----------------------------------------------------------------------===//
 // onnx::Reader
 //===----------------------------------------------------------------------===//
@@ -63,7 +492,9 @@ SystemError onnc::onnx::Reader::parse(const Path& pFileName, Module& pModule)
   if (!err.isGood())
     return err;
 
-  err = parse(file.handler(), pModule);
+  // external data are relative to the model file.
+  err = StreamParse(file.handler(), pFileName.parent(), pModule,
+                    m_TotalBytesLimit, m_WarningThreshold);
   if (!err.isGood()) {
     error(onnx_cannot_parsed) << pFileName;
     return err;
@@ -87,10 +518,8 @@ SystemError onnc::onnx::Reader::parse(ConstBuffer pContent, Module& pModule)
 
 SystemError onnc::onnx::Reader::parse(int pFD, Module& pModule)
 {
-  ::google::protobuf::io::FileInputStream input(pFD);
-  if (!DoParse(pModule, input, m_TotalBytesLimit, m_WarningThreshold))
-    return SystemError::kUnknownError;
-  return SystemError::kSuccess;
+  return StreamParse(pFD, Path(), pModule,
+                     m_TotalBytesLimit, m_WarningThreshold);
 }
 
 void onnc::onnx::Reader::setTotalBytesLimit(int pTotalBytesLimit, int pWarningThreshold)
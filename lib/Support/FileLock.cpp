@@ -58,11 +58,13 @@ void FileLock::lock()
 
 void FileLock::unlock()
 {
-  if (m_FilePath.empty())
+  if (m_FilePath.empty() || -1 == m_FD)
     return;
 
   unlink(m_FilePath.c_str());
   flock(m_FD, LOCK_UN);
+  close(m_FD);
+  m_FD = -1;
 }
 
 bool FileLock::isDirty(int pFD) const
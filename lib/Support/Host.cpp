@@ -9,6 +9,10 @@
 #include <onnc/Config/Config.h>
 #include <onnc/IR/Quadruple.h>
 
+#if defined(ONNC_ON_UNIX)
+#include <sys/resource.h>
+#endif
+
 using namespace onnc;
 
 //===----------------------------------------------------------------------===//
@@ -21,3 +25,20 @@ std::string onnc::sys::GetHostQuadruple()
   quadruple.canonical(result);
   return result;
 }
+
+uint64_t onnc::sys::GetPeakRSS()
+{
+#if defined(ONNC_ON_UNIX)
+  struct rusage usage;
+  if (0 != getrusage(RUSAGE_SELF, &usage))
+    return 0;
+#if defined(__APPLE__)
+  return usage.ru_maxrss;
+#else
+  // in kilobytes
+  return usage.ru_maxrss * 1024ULL;
+#endif
+#else
+  return 0;
+#endif
+}
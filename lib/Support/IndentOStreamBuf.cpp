@@ -9,9 +9,20 @@
 
 namespace {
 
-static unsigned int g_Level = 0;
-static unsigned int g_Indent = 4;
-static char g_Fill = ' ';
+/// The indentation of the streams of a thread. Every thread of onnc --batch
+/// writes its own outputs, and must not change the indentation of others.
+struct State
+{
+  unsigned int level = 0;
+  unsigned int indent = 4;
+  char fill = ' ';
+};
+
+State& GetState()
+{
+  static thread_local State state;
+  return state;
+}
 
 } // anonymous namespace
 
@@ -20,38 +31,38 @@ static char g_Fill = ' ';
 //===----------------------------------------------------------------------===//
 void onnc::indentbuf::Indent()
 {
-  ++g_Level;
+  ++GetState().level;
 }
 
 void onnc::indentbuf::Deindent()
 {
-  if (g_Level > 0)
-    --g_Level;
+  State& state = GetState();
+  if (state.level > 0)
+    --state.level;
 }
 
 void onnc::indentbuf::SetIndent(unsigned int pIndent)
 {
-  g_Indent = pIndent;
+  GetState().indent = pIndent;
 }
 
 unsigned int onnc::indentbuf::GetIndent()
 {
-  return (g_Indent * g_Level);
+  const State& state = GetState();
+  return (state.indent * state.level);
 }
 
 void onnc::indentbuf::ClearIndent()
 {
-  g_Level = 0;
-  g_Indent = 4;
-  g_Fill = ' ';
+  GetState() = State();
 }
 
 void onnc::indentbuf::SetFill(char pFill)
 {
-  g_Fill = pFill;
+  GetState().fill = pFill;
 }
 
 char onnc::indentbuf::GetFill()
 {
-  return g_Fill;
+  return GetState().fill;
 }
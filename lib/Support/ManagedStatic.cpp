@@ -7,25 +7,44 @@
 //===----------------------------------------------------------------------===//
 #include <onnc/Support/ManagedStatic.h>
 #include <cassert>
+#include <mutex>
 
 using namespace onnc;
 
 static const ManagedStaticBase *StaticList = NULL;
 
+/// Guards StaticList. The creator of a ManagedStatic may use other
+/// ManagedStatics, so the lock is recursive. A function-local static is
+/// constructed on first use, before any ManagedStatic is.
+static std::recursive_mutex& GetManagedStaticMutex()
+{
+  static std::recursive_mutex mutex;
+  return mutex;
+}
+
 //===----------------------------------------------------------------------===//
 // ManagedStaticBase
 //===----------------------------------------------------------------------===//
 void ManagedStaticBase::RegisterManagedStatic(void *(*pCreator)(),
                                               void (*pDeleter)(void*)) const
 {
-  assert(NULL == m_Ptr && NULL == m_pDeleter && m_pNext == 0 &&
+  std::lock_guard<std::recursive_mutex> guard(GetManagedStaticMutex());
+
+  // another thread has constructed it.
+  if (NULL != m_Ptr.load(std::memory_order_relaxed))
+    return;
+
+  assert(NULL == m_pDeleter && m_pNext == 0 &&
          "Partially initialized ManagedStatic!?");
-  m_Ptr = pCreator ? pCreator() : NULL;
+  void* tmp = pCreator ? pCreator() : NULL;
   m_pDeleter = pDeleter;
 
   // Add to list of managed statics.
   m_pNext = StaticList;
   StaticList = this;
+
+  // publish the object after it is fully constructed.
+  m_Ptr.store(tmp, std::memory_order_release);
 }
 
 void ManagedStaticBase::destroy() const
@@ -38,10 +57,10 @@ void ManagedStaticBase::destroy() const
   m_pNext = NULL;
 
   // Destroy memory.
-  m_pDeleter(m_Ptr);
+  m_pDeleter(m_Ptr.load(std::memory_order_relaxed));
 
   // Cleanup.
-  m_Ptr = NULL;
+  m_Ptr.store(NULL, std::memory_order_relaxed);
   m_pDeleter = NULL;
 }
 
@@ -50,6 +69,7 @@ void ManagedStaticBase::destroy() const
 //===----------------------------------------------------------------------===//
 void onnc::shutdown()
 {
+  std::lock_guard<std::recursive_mutex> guard(GetManagedStaticMutex());
   while (StaticList)
     StaticList->destroy();
 }
@@ -0,0 +1,170 @@
+//===- SHA256.cpp ---------------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <onnc/Support/SHA256.h>
+#include <onnc/Support/IFStream.h>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+using namespace onnc;
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+static const uint32_t g_RoundConstants[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+  0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+  0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+  0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+  0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+  0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+  0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+  0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+  0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static inline uint32_t RotateRight(uint32_t pValue, unsigned int pBits)
+{
+  return (pValue >> pBits) | (pValue << (32 - pBits));
+}
+
+//===----------------------------------------------------------------------===//
+// SHA256
+//===----------------------------------------------------------------------===//
+SHA256::SHA256()
+  : m_Length(0), m_BlockSize(0) {
+  m_State[0] = 0x6a09e667;
+  m_State[1] = 0xbb67ae85;
+  m_State[2] = 0x3c6ef372;
+  m_State[3] = 0xa54ff53a;
+  m_State[4] = 0x510e527f;
+  m_State[5] = 0x9b05688c;
+  m_State[6] = 0x1f83d9ab;
+  m_State[7] = 0x5be0cd19;
+}
+
+SHA256& SHA256::update(const void* pData, size_t pLength)
+{
+  const uint8_t* data = static_cast<const uint8_t*>(pData);
+  m_Length += pLength;
+
+  // fill the pending block first.
+  if (0 != m_BlockSize) {
+    size_t size = std::min<size_t>(pLength, sizeof(m_Block) - m_BlockSize);
+    memcpy(m_Block + m_BlockSize, data, size);
+    m_BlockSize += size;
+    data += size;
+    pLength -= size;
+    if (sizeof(m_Block) != m_BlockSize)
+      return *this;
+    transform(m_Block);
+    m_BlockSize = 0;
+  }
+
+  for (; pLength >= sizeof(m_Block); pLength -= sizeof(m_Block)) {
+    transform(data);
+    data += sizeof(m_Block);
+  }
+
+  memcpy(m_Block, data, pLength);
+  m_BlockSize = pLength;
+  return *this;
+}
+
+bool SHA256::updateFile(const Path& pFile)
+{
+  IFStream file(pFile, std::ios::in | std::ios::binary);
+  if (!file.is_open())
+    return false;
+
+  std::vector<char> buffer(1 << 16);
+  while (file) {
+    file.read(buffer.data(), buffer.size());
+    update(buffer.data(), file.gcount());
+  }
+  return file.eof();
+}
+
+std::string SHA256::final()
+{
+  uint64_t bits = m_Length * 8;
+
+  // padding: 0x80, zeros and the length in bits, big-endian.
+  uint8_t padding[72] = { 0x80 };
+  size_t size = (m_BlockSize < 56) ? (56 - m_BlockSize) : (120 - m_BlockSize);
+  for (unsigned int i = 0; i < 8; ++i)
+    padding[size + i] = static_cast<uint8_t>(bits >> (56 - 8 * i));
+  update(padding, size + 8);
+  assert(0 == m_BlockSize && "the padding ends a block");
+
+  static const char digits[] = "0123456789abcdef";
+  std::string result;
+  result.reserve(2 * kDigestSize);
+  for (uint32_t word : m_State) {
+    for (int shift = 28; shift >= 0; shift -= 4)
+      result.push_back(digits[(word >> shift) & 0xf]);
+  }
+  return result;
+}
+
+std::string SHA256::Hash(StringRef pData)
+{
+  SHA256 sha;
+  return sha.update(pData).final();
+}
+
+void SHA256::transform(const uint8_t* pBlock)
+{
+  uint32_t w[64];
+  for (unsigned int i = 0; i < 16; ++i) {
+    w[i] = (uint32_t(pBlock[4 * i]) << 24) |
+           (uint32_t(pBlock[4 * i + 1]) << 16) |
+           (uint32_t(pBlock[4 * i + 2]) << 8) |
+           uint32_t(pBlock[4 * i + 3]);
+  }
+
+  for (unsigned int i = 16; i < 64; ++i) {
+    uint32_t s0 = RotateRight(w[i - 15], 7) ^ RotateRight(w[i - 15], 18) ^
+                  (w[i - 15] >> 3);
+    uint32_t s1 = RotateRight(w[i - 2], 17) ^ RotateRight(w[i - 2], 19) ^
+                  (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  uint32_t a = m_State[0], b = m_State[1], c = m_State[2], d = m_State[3];
+  uint32_t e = m_State[4], f = m_State[5], g = m_State[6], h = m_State[7];
+  for (unsigned int i = 0; i < 64; ++i) {
+    uint32_t s1 = RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25);
+    uint32_t choose = (e & f) ^ (~e & g);
+    uint32_t t1 = h + s1 + choose + g_RoundConstants[i] + w[i];
+    uint32_t s0 = RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22);
+    uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+    uint32_t t2 = s0 + majority;
+
+    h = g;
+    g = f;
+    f = e;
+    e = d + t1;
+    d = c;
+    c = b;
+    b = a;
+    a = t1 + t2;
+  }
+
+  m_State[0] += a;
+  m_State[1] += b;
+  m_State[2] += c;
+  m_State[3] += d;
+  m_State[4] += e;
+  m_State[5] += f;
+  m_State[6] += g;
+  m_State[7] += h;
+}
@@ -23,7 +23,8 @@ BM168xCodeEmitter::BM168xCodeEmitter(TGBackend *pBackend)
 {
 }
 
-void BM168xCodeEmitter::encodeInstructions(std::ostream &pOS)
+void BM168xCodeEmitter::encodeInstructions(std::ostream *pBinary,
+                                           std::ostream *pText)
 {
   // TODO refactor
   if (dynamic_cast<BM1680Backend *>(m_pBackend)) {
@@ -35,7 +35,8 @@ public:
 
   ~BM168xCodeEmitter() override = default;
 
-  void encodeInstructions(std::ostream &pOS) override;
+  void encodeInstructions(std::ostream *pBinary,
+                          std::ostream *pText) override;
 
   void genRuntimeInfo(const xGraph *pOnnxGraph,
                       std::ostream &pOS) override;
@@ -62,6 +62,13 @@ BM1880Backend::BM1880Backend(Instructions& pInsn, const TargetOptions &pOptions)
 {
   m_pMemInfo = new BM188xTargetMemInfo(this);
   m_pTTI = new BM188xTargetTransformInfo(this);
+  m_pCEVisitor = new BM188X::CodeEmitVisitor(this);
+}
+
+BM1880Backend::~BM1880Backend()
+{
+  delete m_pCEVisitor;
+  delete m_pTTI;
 }
 
 void BM1880Backend::addTensorSel(PassManager &pPM)
@@ -102,8 +109,7 @@ void BM1880Backend::addTensorSel(PassManager &pPM)
 
 void BM1880Backend::addCodeEmit(PassManager &pPM, const Path &pOutputFile)
 {
-  static BM188X::CodeEmitVisitor ceVisitor(this);
-  pPM.add(CreateEncodeInstructionsPass(&ceVisitor));
+  pPM.add(CreateEncodeInstructionsPass(m_pCEVisitor));
   TGBackend::addCodeEmit(pPM, pOutputFile);
 }
 
@@ -122,34 +128,49 @@ void BM1880Backend::setCtableProto(const std::string &pTextString)
 {
   ::google::protobuf::TextFormat::ParseFromString(pTextString,
                                                   &m_NetCtableParam);
+  buildCtableIndex();
 }
 
-BM1880Backend::LayerCtable *
-BM1880Backend::getMutableLayerCtable(const std::string &pName)
+void BM1880Backend::buildCtableIndex()
 {
+  // elements of repeated fields don't move when others are added.
+  m_LayerIndex.clear();
+  m_BlobIndex.clear();
   for (int i = 0; i < m_NetCtableParam.layer_size(); i++) {
-    tg::bm1880::LayerCalibrationParameter *layer =
-        m_NetCtableParam.mutable_layer(i);
-    if (layer->name() == pName) {
-      return layer;
+    LayerCtable *layer = m_NetCtableParam.mutable_layer(i);
+    m_LayerIndex.emplace(layer->name(), layer);
+    for (int j = 0; j < layer->blob_param_size(); j++) {
+      BlobCtable *blob = layer->mutable_blob_param(j);
+      m_BlobIndex.emplace(blob->name(), BlobEntry{ layer, blob });
     }
   }
-  return nullptr;
+}
+
+BM1880Backend::LayerCtable *
+BM1880Backend::getMutableLayerCtable(const std::string &pName)
+{
+  LayerIndex::iterator layer = m_LayerIndex.find(pName);
+  if (m_LayerIndex.end() == layer)
+    return nullptr;
+  return layer->second;
 }
 
 const BM1880Backend::LayerCtable *
 BM1880Backend::getLayerCtable(const std::string &pName)
 {
-  for (int i = 0; i < m_NetCtableParam.layer_size(); i++) {
-    const tg::bm1880::LayerCalibrationParameter &layer =
-        m_NetCtableParam.layer(i);
-    for (int j = 0; j < layer.blob_param_size(); j++) {
-      if (layer.blob_param(j).name() == pName) {
-        return &layer;
-      }
-    }
-  }
-  return nullptr;
+  BlobIndex::iterator blob = m_BlobIndex.find(pName);
+  if (m_BlobIndex.end() == blob)
+    return nullptr;
+  return blob->second.layer;
+}
+
+const BM1880Backend::BlobCtable *
+BM1880Backend::getBlobCtable(const std::string &pName)
+{
+  BlobIndex::iterator blob = m_BlobIndex.find(pName);
+  if (m_BlobIndex.end() == blob)
+    return nullptr;
+  return blob->second.blob;
 }
 
 std::unique_ptr<TGFuseOptimizer> BM1880Backend::getFuseOptimizr()
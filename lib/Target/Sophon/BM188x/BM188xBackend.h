@@ -17,22 +17,28 @@
 #include <onnc/Target/Sophon/BM188x/common_calibration2.pb.h>
 #include <onnc/Config/ONNX.h>
 #include <string>
+#include <unordered_map>
 
 namespace onnc {
 
 class TGCodeEmitter;
 class TargetTransformInfo;
 
+namespace BM188X {
+class CodeEmitVisitor;
+} // namespace BM188X
+
 class BM1880Backend : public TGBackend
 {
 public:
   using LayerCtable = tg::bm1880::LayerCalibrationParameter;
+  using BlobCtable = tg::bm1880::BlobParameter;
 
 public:
   BM1880Backend(TGBackend::Instructions& pInsns,
                 const TargetOptions &pOptions);
 
-  ~BM1880Backend() override = default;
+  ~BM1880Backend() override;
 
   /// override TensorSel stage.
   void addTensorSel(PassManager &pPM) override;
@@ -50,10 +56,18 @@ public:
 
   void setCtableProto(const std::string &pTextString) override;
 
+  /// Find a layer of the ctable by its name.
+  /// @return nullptr if there is no such layer.
   LayerCtable* getMutableLayerCtable(const std::string &pName);
 
+  /// Find the first layer of the ctable having a blob named @ref pName.
+  /// @return nullptr if there is no such blob.
   const LayerCtable* getLayerCtable(const std::string &pName);
 
+  /// Find the first blob of the ctable named @ref pName.
+  /// @return nullptr if there is no such blob.
+  const BlobCtable* getBlobCtable(const std::string &pName);
+
   const TargetTransformInfo *getTTI() const override { return m_pTTI; }
 
   std::unique_ptr<TGFuseOptimizer> getFuseOptimizr() override;
@@ -61,9 +75,26 @@ public:
   /// register lowers for TensorSel.
   void RegisterLowers(LowerRegistry& pRegistry) const override;
 
+private:
+  struct BlobEntry
+  {
+    LayerCtable *layer;
+    BlobCtable *blob;
+  };
+
+  typedef std::unordered_map<std::string, LayerCtable *> LayerIndex;
+  typedef std::unordered_map<std::string, BlobEntry> BlobIndex;
+
+private:
+  /// Index the layers and the blobs of the ctable by their names.
+  void buildCtableIndex();
+
 private:
   tg::bm1880::NetCalibrationParameter m_NetCtableParam;
+  LayerIndex m_LayerIndex;
+  BlobIndex m_BlobIndex;
   TargetTransformInfo *m_pTTI; // NOLINT
+  BM188X::CodeEmitVisitor *m_pCEVisitor; // NOLINT
 };
 
 //===----------------------------------------------------------------------===//
@@ -14,6 +14,7 @@
 #include "BM188xCodeEmitter.h"
 #include "TGConv.h"
 #include "TLConv.h"
+#include "TLPipeline.h"
 #include <cstdint>
 #include <fstream>
 #include <onnc/IR/ONNXUtils.h>
@@ -36,17 +37,10 @@ BM188xCodeEmitter::BM188xCodeEmitter(BM1880Backend *pBackend,
 
 float BM188xCodeEmitter::getThreshold(const std::string &pOnncLayerName)
 {
-
-  const tg::bm1880::LayerCalibrationParameter &ctable =
-      *m_Backend->getLayerCtable(pOnncLayerName);
-  float threshold = 0.0;
-  for (int j = 0; j < ctable.blob_param_size(); j++) {
-    if (ctable.blob_param(j).name() == pOnncLayerName) {
-      threshold = ctable.blob_param(j).threshold_y();
-      break;
-    }
-  }
-  return threshold;
+  const BM1880Backend::BlobCtable *blob = m_Backend->getBlobCtable(pOnncLayerName);
+  if (nullptr == blob)
+    return 0.0;
+  return blob->threshold_y();
 }
 
 std::string BM188xCodeEmitter::findOnncLayerName(const xGraph *pOnnxGraph,
@@ -245,16 +239,49 @@ void BM188xCodeEmitter::genWeightBin(const std::string &pOutputFilename)
                       m_Backend->getMemOperands());
 }
 
-void BM188xCodeEmitter::encodeInstructions(std::ostream &pOS)
+void BM188xCodeEmitter::encodeInstructions(std::ostream *pBinary,
+                                           std::ostream *pText)
 {
   if (m_Instructions.empty())
     return;
 
-  ::bmnet::bmnet_asm::asm_context::get_context().set_fp(pOS);
-  for (auto const &i : m_Instructions) {
-    ::bmnet::bmnet_asm::asm_context::get_context().name = i->getLayerName();
-    i->emit();
+  // overlap the loads and the stores of sliced convolutions with compute.
+  BM188X::TLPipeline::Schedule schedule;
+  if (m_Backend->options().shouldPipelineTiles()) {
+    BM188X::TLPipeline pipeline(*m_Backend->getTTI(),
+                                m_Backend->getMemInfo()->getLocalMemSize());
+    unsigned numOfGroups = pipeline.run(m_Instructions, schedule);
+    DEBUG(dbgs() << "pipelined " << numOfGroups << " groups of tiles\n");
+  }
+  else {
+    for (auto const &inst : m_Instructions)
+      schedule.push_back({ BM188X::TLPipeline::Step::kInst, inst.get() });
+  }
+
+  ::bmnet::bmnet_asm::asm_context &context =
+      ::bmnet::bmnet_asm::asm_context::get_context();
+  if (nullptr != pBinary)
+    context.set_binary_fp(*pBinary);
+  if (nullptr != pText)
+    context.set_fp(*pText);
+  for (auto const &step : schedule) {
+    switch (step.kind) {
+    case BM188X::TLPipeline::Step::kParallelBegin:
+      ::bmnet::bmnet_asm::bmnet_tl_parallel_bmkernel(true);
+      break;
+    case BM188X::TLPipeline::Step::kParallelEnd:
+      ::bmnet::bmnet_asm::bmnet_tl_parallel_bmkernel(false);
+      break;
+    case BM188X::TLPipeline::Step::kInst:
+      context.name = step.inst->getLayerName();
+      step.inst->emit();
+      break;
+    }
   }
+
+  // flush, and the next module compiled by this thread doesn't write to the
+  // streams.
+  context.reset_fp();
 }
 
 void BM188xCodeEmitter::genRuntimeInfo(const xGraph *pOnnxGraph,
@@ -41,7 +41,8 @@ public:
   void genRuntimeInfo(const xGraph *pOnnxGraph,
                       std::ostream &pOS) override;
 
-  void encodeInstructions(std::ostream &pOS) override;
+  void encodeInstructions(std::ostream *pBinary,
+                          std::ostream *pText) override;
 
   void genWeightBin(const std::string &pOutputFilename) override;
 
@@ -17,21 +17,16 @@
 
 namespace onnc {
 
-static bool
-getTensorThreshold(const tg::bm1880::LayerCalibrationParameter *pLayerCtable,
-                   std::string pName, float *pThres)
+static bool getTensorThreshold(BM1880Backend *pBackend,
+                               const std::string &pName, float *pThres)
 {
-  bool is_find_thres = false;
-  for (int i = 0; i < pLayerCtable->blob_param_size(); i++) {
-    DEBUG(dbgs() << "pName = " << pName << ", blob_name = "
-                 << pLayerCtable->blob_param(i).name() << "\n";);
-    if (pName == pLayerCtable->blob_param(i).name()) {
-      *pThres = pLayerCtable->blob_param(i).threshold_y();
-      is_find_thres = true;
-      break;
-    }
-  }
-  return is_find_thres;
+  const BM1880Backend::BlobCtable *blob = pBackend->getBlobCtable(pName);
+  DEBUG(dbgs() << "pName = " << pName << ", found = " << (nullptr != blob)
+               << "\n";);
+  if (nullptr == blob)
+    return false;
+  *pThres = blob->threshold_y();
+  return true;
 }
 
 xNode *BM188xFuseOptimizer::FuseConvScale(xGraph *pGraph,
@@ -41,10 +36,8 @@ xNode *BM188xFuseOptimizer::FuseConvScale(xGraph *pGraph,
   // keep conv layer's output threshold because FuseConvScale will change output
   // name
   const std::string conv_output_name = pConvNode->output()->uniqueName();
-  const auto *conv_output_ctable =
-      m_p1880backend->getLayerCtable(conv_output_name);
   float conv_output_threshold;
-  if (!getTensorThreshold(conv_output_ctable, conv_output_name,
+  if (!getTensorThreshold(m_p1880backend, conv_output_name,
                           &conv_output_threshold)) {
     errs() << "count not find threshold in: " << conv_output_name << "\n";
     assert(0);
@@ -0,0 +1,972 @@
+//===- BM188xSimulator.cpp ------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "BM188xSimulator.h"
+#include <onnc/Support/IOStream.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/text_format.h>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+using namespace onnc;
+using namespace onnc::BM188X;
+
+namespace {
+
+struct ConvParams
+{
+  int n, ic, ih, iw, oc, oh, ow, groups, kh, kw, dh, dw;
+  int padTop, padLeft, strideH, strideW, rshift;
+  bool doBias, doRelu, resultAdd;
+};
+
+struct PoolParams
+{
+  int n, c, ih, iw, oh, ow, kh, kw;
+  int padTop, padLeft, strideH, strideW, rshift, quant;
+  bool isAvg, doRelu;
+};
+
+enum EltwiseOp {
+  kProd = 0,
+  kSum = 1,
+  kMax = 2
+};
+
+} // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+static uint64_t DivCeil(uint64_t pA, uint64_t pB)
+{
+  return (pA + pB - 1) / pB;
+}
+
+static int Saturate(int64_t pValue)
+{
+  return (int)std::min<int64_t>(std::max<int64_t>(pValue, -128), 127);
+}
+
+/// Shift right and round half up.
+static int64_t RShift(int64_t pValue, int pShift)
+{
+  if (pShift <= 0)
+    return pValue;
+  return (pValue + ((int64_t)1 << (pShift - 1))) >> pShift;
+}
+
+static int Relu(int64_t pValue, float pSlope)
+{
+  if (0 <= pValue)
+    return Saturate(pValue);
+  return Saturate((int64_t)std::lround(pValue * pSlope));
+}
+
+/// The 16-bit values of (2, count): the low bytes, then the high bytes.
+static std::vector<int> GetInt16(const std::vector<int>& pPlanes)
+{
+  unsigned count = pPlanes.size() / 2;
+  std::vector<int> result(count);
+  for (unsigned i = 0; i < count; ++i)
+    result[i] = (int16_t)((pPlanes[i] & 0xff) | (pPlanes[count + i] << 8));
+  return result;
+}
+
+/// @param pWeight (oc, kh*kw, ic / groups)
+/// @param pResult holds the partial sums when @ref pP.resultAdd.
+static void Convolve(const ConvParams& pP, const std::vector<int>& pInput,
+                     const std::vector<int>& pWeight,
+                     const std::vector<int>& pBias, std::vector<int>& pResult)
+{
+  int icg = pP.ic / std::max(pP.groups, 1);
+  int ocg = pP.oc / std::max(pP.groups, 1);
+  pResult.resize((size_t)pP.n * pP.oc * pP.oh * pP.ow, 0);
+
+  for (int n = 0; n < pP.n; ++n) {
+    for (int o = 0; o < pP.oc; ++o) {
+      int g = o / std::max(ocg, 1);
+      for (int y = 0; y < pP.oh; ++y) {
+        for (int x = 0; x < pP.ow; ++x) {
+          int64_t acc = 0;
+          for (int ky = 0; ky < pP.kh; ++ky) {
+            int iy = y * pP.strideH - pP.padTop + ky * pP.dh;
+            if (iy < 0 || pP.ih <= iy)
+              continue;
+            for (int kx = 0; kx < pP.kw; ++kx) {
+              int ix = x * pP.strideW - pP.padLeft + kx * pP.dw;
+              if (ix < 0 || pP.iw <= ix)
+                continue;
+              const int *w = &pWeight[((size_t)o * pP.kh * pP.kw +
+                                       ky * pP.kw + kx) * icg];
+              for (int i = 0; i < icg; ++i) {
+                size_t from = (((size_t)n * pP.ic + g * icg + i) * pP.ih +
+                               iy) * pP.iw + ix;
+                acc += (int64_t)pInput[from] * w[i];
+              }
+            }
+          }
+
+          // the bias is added before the shift.
+          if (pP.doBias)
+            acc += pBias[o];
+          size_t to = (((size_t)n * pP.oc + o) * pP.oh + y) * pP.ow + x;
+          int64_t value = RShift(acc, pP.rshift);
+          if (pP.resultAdd)
+            value += pResult[to];
+          if (pP.doRelu)
+            value = std::max<int64_t>(value, 0);
+          pResult[to] = Saturate(value);
+        }
+      }
+    }
+  }
+}
+
+static void Pool(const PoolParams& pP, const std::vector<int>& pInput,
+                 std::vector<int>& pResult)
+{
+  pResult.assign((size_t)pP.n * pP.c * pP.oh * pP.ow, 0);
+  for (int nc = 0; nc < pP.n * pP.c; ++nc) {
+    for (int y = 0; y < pP.oh; ++y) {
+      for (int x = 0; x < pP.ow; ++x) {
+        int64_t sum = 0;
+        int64_t max = -128;
+        for (int ky = 0; ky < pP.kh; ++ky) {
+          int iy = y * pP.strideH - pP.padTop + ky;
+          if (iy < 0 || pP.ih <= iy)
+            continue;
+          for (int kx = 0; kx < pP.kw; ++kx) {
+            int ix = x * pP.strideW - pP.padLeft + kx;
+            if (ix < 0 || pP.iw <= ix)
+              continue;
+            int value = pInput[((size_t)nc * pP.ih + iy) * pP.iw + ix];
+            sum += value;
+            max = std::max<int64_t>(max, value);
+          }
+        }
+
+        int64_t value = max;
+        if (pP.isAvg) {
+          // the quantized 1 / (kh * kw), or the rounded mean without it.
+          int64_t size = std::max(pP.kh * pP.kw, 1);
+          if (0 != pP.quant)
+            value = RShift(sum * pP.quant, pP.rshift);
+          else if (0 <= sum)
+            value = (sum + size / 2) / size;
+          else
+            value = -((-sum + size / 2) / size);
+        }
+        if (pP.doRelu)
+          value = std::max<int64_t>(value, 0);
+        pResult[((size_t)nc * pP.oh + y) * pP.ow + x] = Saturate(value);
+      }
+    }
+  }
+}
+
+static void Eltwise(int pOp, const std::vector<std::vector<int> >& pInputs,
+                    const std::vector<int>& pQuant, int pRShift, bool pDoRelu,
+                    float pSlope, std::vector<int>& pResult)
+{
+  size_t size = pInputs.empty() ? 0 : pInputs[0].size();
+  pResult.assign(size, 0);
+  for (size_t e = 0; e < size; ++e) {
+    int64_t value = (kProd == pOp) ? 1 : (kMax == pOp) ? -128 : 0;
+    for (unsigned i = 0; i < pInputs.size(); ++i) {
+      int64_t x = pInputs[i][e];
+      if (kProd == pOp)
+        value *= x;
+      else if (kMax == pOp)
+        value = std::max(value, x);
+      else
+        value += x * ((i < pQuant.size()) ? pQuant[i] : 1);
+    }
+    if (kMax != pOp)
+      value = RShift(value, pRShift);
+    pResult[e] = pDoRelu ? Relu(value, pSlope) : Saturate(value);
+  }
+}
+
+/// The output size of a window sliding over @ref pSize.
+static int GetOutputSize(int pSize, int pPad, int pWindow, int pStride,
+                         bool pCeil)
+{
+  int span = pSize + pPad - pWindow;
+  pStride = std::max(pStride, 1);
+  return (pCeil ? (int)DivCeil(std::max(span, 0), pStride) : span / pStride) +
+         1;
+}
+
+//===----------------------------------------------------------------------===//
+// Simulator::Config
+//===----------------------------------------------------------------------===//
+Simulator::Config::Config()
+  : numOfLanes(32), numOfUnits(16), laneSize(64 * 1024), numOfBanks(8),
+    busBitWidth(128), dmaLatency(0) {
+}
+
+//===----------------------------------------------------------------------===//
+// Simulator::Report
+//===----------------------------------------------------------------------===//
+uint64_t Simulator::Report::getDMACycles() const
+{
+  uint64_t result = 0;
+  for (const Record& record : records)
+    result += record.dmaCycles;
+  return result;
+}
+
+uint64_t Simulator::Report::getNPUCycles() const
+{
+  uint64_t result = 0;
+  for (const Record& record : records)
+    result += record.npuCycles;
+  return result;
+}
+
+uint64_t Simulator::Report::getDMABytes() const
+{
+  uint64_t result = 0;
+  for (const Record& record : records)
+    result += record.dmaBytes;
+  return result;
+}
+
+uint64_t Simulator::Report::getStallCycles() const
+{
+  uint64_t result = 0;
+  for (const Record& record : records)
+    result += record.stall;
+  return result;
+}
+
+unsigned Simulator::Report::getNumOfSkipped() const
+{
+  unsigned result = 0;
+  for (const Record& record : records) {
+    if (!record.simulated)
+      ++result;
+  }
+  return result;
+}
+
+void Simulator::Report::print(OStream& pOS, unsigned pBusBitWidth) const
+{
+  const double peak = pBusBitWidth / 8.0;
+  for (unsigned i = 0; i < records.size(); ++i) {
+    const Record& record = records[i];
+    pOS << "[" << i << "] " << record.type;
+    if (!record.name.empty())
+      pOS << " " << record.name;
+    pOS << ": start " << record.start << ", " << record.cycles
+        << " cycles (DMA " << record.dmaCycles << ", NPU " << record.npuCycles
+        << ", stall " << record.stall << ")";
+    if (0 != record.dmaCycles) {
+      double bandwidth = (double)record.dmaBytes / record.dmaCycles;
+      pOS << ", " << record.dmaBytes << " bytes, " << bandwidth
+          << " bytes/cycle (" << 100.0 * bandwidth / peak << "%)";
+    }
+    if (!record.simulated)
+      pOS << ", not simulated";
+    pOS << "\n";
+  }
+
+  uint64_t total = std::max<uint64_t>(cycles, 1);
+  uint64_t dma = getDMACycles();
+  uint64_t npu = getNPUCycles();
+  pOS << "total: " << cycles << " cycles, DMA busy " << dma << " ("
+      << 100.0 * dma / total << "%), NPU busy " << npu << " ("
+      << 100.0 * npu / total << "%), stall " << getStallCycles() << "\n";
+  pOS << "DMA: " << getDMABytes() << " bytes, "
+      << (double)getDMABytes() / total << " bytes/cycle of " << peak
+      << " peak\n";
+  if (0 != getNumOfSkipped())
+    pOS << getNumOfSkipped() << " instructions not simulated\n";
+}
+
+//===----------------------------------------------------------------------===//
+// Simulator
+//===----------------------------------------------------------------------===//
+Simulator::Simulator()
+  : m_Config(), m_Time(0), m_Parallel(false), m_DMAFree(0), m_NPUFree(0) {
+  reset();
+}
+
+Simulator::Simulator(const Config& pConfig)
+  : m_Config(pConfig), m_Time(0), m_Parallel(false), m_DMAFree(0),
+    m_NPUFree(0) {
+  reset();
+}
+
+void Simulator::reset()
+{
+  for (unsigned space = 0; space < kNumOfMemSpaces; ++space)
+    m_Global[space].clear();
+  m_Local.assign(m_Config.numOfLanes * m_Config.laneSize, 0);
+}
+
+void Simulator::write(MemSpace pSpace, uint64_t pAddr, const int8_t* pData,
+                      uint64_t pSize)
+{
+  std::vector<int8_t>& memory = m_Global[pSpace];
+  if (memory.size() < pAddr + pSize)
+    memory.resize(pAddr + pSize, 0);
+  std::copy(pData, pData + pSize, memory.begin() + pAddr);
+}
+
+void Simulator::read(MemSpace pSpace, uint64_t pAddr, int8_t* pData,
+                     uint64_t pSize) const
+{
+  const std::vector<int8_t>& memory = m_Global[pSpace];
+  for (uint64_t i = 0; i < pSize; ++i)
+    pData[i] = (pAddr + i < memory.size()) ? memory[pAddr + i] : 0;
+}
+
+bool Simulator::Parse(const std::string& pText, CommandBuffer& pBuffer)
+{
+  // the buffers of a .s file merge into one.
+  return ::google::protobuf::TextFormat::ParseFromString(pText, &pBuffer);
+}
+
+bool Simulator::ParseBinary(const std::string& pData, CommandBuffer& pBuffer)
+{
+  // large models have more instructions than the default limit of the bytes.
+  ::google::protobuf::io::CodedInputStream input(
+      (const uint8_t*)pData.data(), pData.size());
+  input.SetTotalBytesLimit(INT_MAX);
+  return pBuffer.ParseFromCodedStream(&input) && input.ConsumedEntireMessage();
+}
+
+bool Simulator::run(const CommandBuffer& pBuffer, Report& pReport)
+{
+  m_Time = m_DMAFree = m_NPUFree = 0;
+  m_Parallel = false;
+  m_Section.clear();
+  pReport.records.clear();
+
+  for (const Inst& inst : pBuffer.inst()) {
+    Record record;
+    record.name = inst.name();
+    record.type = inst.type();
+    record.engine = kNone;
+    record.simulated = true;
+    record.start = record.cycles = record.stall = 0;
+    record.dmaCycles = record.npuCycles = record.dmaBytes = 0;
+
+    if (inst.has_tl_parallel()) {
+      // a section ends by waiting for both engines.
+      m_Time = std::max(m_Time, std::max(m_DMAFree, m_NPUFree));
+      m_Parallel = inst.tl_parallel().enable();
+      m_DMAFree = m_NPUFree = m_Time;
+      m_Section.clear();
+      record.start = m_Time;
+      pReport.records.push_back(record);
+      continue;
+    }
+
+    BankMask banks = 0;
+    if (!execute(inst, record, banks)) {
+      errs() << "error: " << record.type;
+      if (!record.name.empty())
+        errs() << " " << record.name;
+      errs() << " accesses memory out of the local memory\n";
+      return false;
+    }
+    record.cycles = record.dmaCycles + record.npuCycles;
+    schedule(record, banks);
+    pReport.records.push_back(record);
+  }
+
+  pReport.cycles = std::max(m_Time, std::max(m_DMAFree, m_NPUFree));
+  return true;
+}
+
+bool Simulator::execute(const Inst& pInst, Record& pRecord, BankMask& pBanks)
+{
+  if (pInst.has_tl_layer_load())
+    return execTLLoad(pInst.tl_layer_load(), pRecord, pBanks);
+  if (pInst.has_tl_layer_load_stride())
+    return execTLLoad(pInst.tl_layer_load_stride(), pRecord, pBanks);
+  if (pInst.has_tl_layer_store())
+    return execTLStore(pInst.tl_layer_store(), pRecord, pBanks);
+  if (pInst.has_tl_layer_store_stride())
+    return execTLStore(pInst.tl_layer_store_stride(), pRecord, pBanks);
+  if (pInst.has_bm_tl_conv())
+    return execTLConv(pInst, pRecord, pBanks);
+  if (pInst.has_tl_pool())
+    return execTLPool(pInst, pRecord, pBanks);
+  if (pInst.has_tl_eltwise())
+    return execTLEltwise(pInst, pRecord, pBanks);
+
+  pRecord.engine = kBoth;
+  if (pInst.has_conv())
+    execConv(pInst.conv(), pRecord);
+  else if (pInst.has_conv_p())
+    execConv(pInst.conv_p(), pRecord);
+  else if (pInst.has_fc())
+    execFC(pInst, pRecord);
+  else if (pInst.has_pooling())
+    execPool(pInst, pRecord);
+  else if (pInst.has_eltwise())
+    execEltwise(pInst, pRecord);
+  else if (pInst.has_relu())
+    execRelu(pInst, pRecord);
+  else if (pInst.has_leakyrelu())
+    execLeakyRelu(pInst, pRecord);
+  else {
+    pRecord.engine = kNone;
+    pRecord.simulated = false;
+  }
+  return true;
+}
+
+void Simulator::schedule(Record& pRecord, BankMask pBanks)
+{
+  if (!m_Parallel || (kDMA != pRecord.engine && kNPU != pRecord.engine)) {
+    // wait for both engines.
+    pRecord.start = std::max(m_Time, std::max(m_DMAFree, m_NPUFree));
+    m_Time = m_DMAFree = m_NPUFree = pRecord.getEnd();
+    m_Section.clear();
+    return;
+  }
+
+  // an instruction runs after the ones of its engine, and doesn't share a
+  // bank with the other engine at the same time.
+  uint64_t& free = (kDMA == pRecord.engine) ? m_DMAFree : m_NPUFree;
+  uint64_t start = free;
+  bool moved = true;
+  while (moved) {
+    moved = false;
+    for (const Busy& busy : m_Section) {
+      if (busy.engine == pRecord.engine || 0 == (busy.banks & pBanks))
+        continue;
+      if (busy.start < start + pRecord.cycles && start < busy.end) {
+        start = busy.end;
+        moved = true;
+      }
+    }
+  }
+
+  pRecord.start = start;
+  pRecord.stall = start - free;
+  free = pRecord.getEnd();
+  m_Section.push_back({ pRecord.engine, pRecord.start, pRecord.getEnd(),
+                        pBanks });
+}
+
+//===----------------------------------------------------------------------===//
+// Local memory
+//===----------------------------------------------------------------------===//
+uint64_t Simulator::getChannelSize(const LocalTensor& pTensor) const
+{
+  uint64_t size = (uint64_t)pTensor.h * pTensor.w;
+  if (!pTensor.aligned)
+    return size;
+  return DivCeil(size, m_Config.numOfUnits) * m_Config.numOfUnits;
+}
+
+uint64_t Simulator::getLaneBytes(const LocalTensor& pTensor) const
+{
+  return (uint64_t)pTensor.n * DivCeil(pTensor.c, m_Config.numOfLanes) *
+         getChannelSize(pTensor);
+}
+
+bool Simulator::access(const LocalTensor& pTensor, BankMask& pBanks) const
+{
+  uint64_t bytes = getLaneBytes(pTensor);
+  if (m_Config.laneSize < pTensor.addr + bytes)
+    return false;
+  if (0 == bytes)
+    return true;
+
+  uint64_t bankSize = DivCeil(m_Config.laneSize,
+                              std::max(m_Config.numOfBanks, 1u));
+  uint64_t first = pTensor.addr / bankSize;
+  uint64_t last = (pTensor.addr + bytes - 1) / bankSize;
+  for (uint64_t bank = first; bank <= last && bank < 64; ++bank)
+    pBanks |= (BankMask)1 << bank;
+  return true;
+}
+
+int8_t& Simulator::at(const LocalTensor& pTensor, int pN, int pC, int pH,
+                      int pW)
+{
+  uint64_t lanes = m_Config.numOfLanes;
+  uint64_t channel = (uint64_t)pN * DivCeil(pTensor.c, lanes) + pC / lanes;
+  uint64_t offset = pTensor.addr + channel * getChannelSize(pTensor) +
+                    (uint64_t)pH * pTensor.w + pW;
+  return m_Local[(pC % lanes) * m_Config.laneSize + offset];
+}
+
+void Simulator::gather(const LocalTensor& pTensor, Dense& pResult)
+{
+  pResult.resize((size_t)pTensor.n * pTensor.c * pTensor.h * pTensor.w);
+  size_t idx = 0;
+  for (int n = 0; n < pTensor.n; ++n)
+    for (int c = 0; c < pTensor.c; ++c)
+      for (int h = 0; h < pTensor.h; ++h)
+        for (int w = 0; w < pTensor.w; ++w)
+          pResult[idx++] = at(pTensor, n, c, h, w);
+}
+
+void Simulator::scatter(const LocalTensor& pTensor, const Dense& pData)
+{
+  size_t idx = 0;
+  for (int n = 0; n < pTensor.n; ++n)
+    for (int c = 0; c < pTensor.c; ++c)
+      for (int h = 0; h < pTensor.h; ++h)
+        for (int w = 0; w < pTensor.w; ++w)
+          at(pTensor, n, c, h, w) = (int8_t)pData[idx++];
+}
+
+//===----------------------------------------------------------------------===//
+// Global memory
+//===----------------------------------------------------------------------===//
+void Simulator::readGlobal(MemSpace pSpace, uint64_t pAddr, uint64_t pCount,
+                           Dense& pResult) const
+{
+  std::vector<int8_t> bytes(pCount);
+  read(pSpace, pAddr, bytes.data(), pCount);
+  pResult.assign(bytes.begin(), bytes.end());
+}
+
+void Simulator::writeGlobal(MemSpace pSpace, uint64_t pAddr,
+                            const Dense& pData)
+{
+  std::vector<int8_t> bytes(pData.begin(), pData.end());
+  write(pSpace, pAddr, bytes.data(), bytes.size());
+}
+
+uint64_t Simulator::getDMACycles(uint64_t pBytes, uint64_t pRun) const
+{
+  if (0 == pBytes)
+    return 0;
+  uint64_t busBytes = std::max(m_Config.busBitWidth / 8, 1u);
+  pRun = std::max<uint64_t>(std::min(pRun, pBytes), 1);
+  return m_Config.dmaLatency + DivCeil(pBytes, pRun) * DivCeil(pRun, busBytes);
+}
+
+uint64_t Simulator::getSteps(int pN, int pC, int pH, int pW) const
+{
+  return (uint64_t)pN * DivCeil(pC, m_Config.numOfLanes) *
+         DivCeil((uint64_t)pH * pW, m_Config.numOfUnits);
+}
+
+//===----------------------------------------------------------------------===//
+// TL kernels
+//===----------------------------------------------------------------------===//
+template<class LoadType>
+bool Simulator::execTLLoad(const LoadType& pLoad, Record& pRecord,
+                           BankMask& pBanks)
+{
+  LocalTensor dst = { pLoad.la_dst(), pLoad.local_n(), pLoad.local_c(),
+                      pLoad.local_h(), pLoad.local_w(), pLoad.doaligned() };
+  pRecord.engine = kDMA;
+  if (!access(dst, pBanks))
+    return false;
+
+  // a transposed load swaps N and C of the global tensor.
+  MemSpace space = pLoad.isneuron() ? kNeuron : kWeight;
+  uint64_t gc = pLoad.global_c(), gh = pLoad.global_h(),
+           gw = pLoad.global_w();
+  uint64_t run = dst.w;
+  for (int n = 0; n < dst.n; ++n) {
+    for (int c = 0; c < dst.c; ++c) {
+      uint64_t channel = pLoad.dotranspose() ? (uint64_t)c * gc + n
+                                             : (uint64_t)n * gc + c;
+      for (int h = 0; h < dst.h; ++h) {
+        int8_t *row = &at(dst, n, c, h, 0);
+        read(space, pLoad.ga_src() + (channel * gh + h) * gw, row, dst.w);
+      }
+    }
+  }
+
+  // contiguous rows merge into a run.
+  if (!pLoad.dotranspose() && gw == (uint64_t)dst.w) {
+    run *= dst.h;
+    if (gh == (uint64_t)dst.h && gc == (uint64_t)dst.c)
+      run *= dst.c * dst.n;
+  }
+  pRecord.dmaBytes = (uint64_t)dst.n * dst.c * dst.h * dst.w;
+  pRecord.dmaCycles = getDMACycles(pRecord.dmaBytes, run);
+  return true;
+}
+
+template<class StoreType>
+bool Simulator::execTLStore(const StoreType& pStore, Record& pRecord,
+                            BankMask& pBanks)
+{
+  LocalTensor src = { pStore.la_src(), pStore.local_n(), pStore.local_c(),
+                      pStore.local_h(), pStore.local_w(),
+                      pStore.doaligned() };
+  pRecord.engine = kDMA;
+  if (!access(src, pBanks))
+    return false;
+
+  MemSpace space = pStore.isneuron() ? kNeuron : kWeight;
+  uint64_t gc = pStore.global_c(), gh = pStore.global_h(),
+           gw = pStore.global_w();
+  uint64_t run = src.w;
+  for (int n = 0; n < src.n; ++n) {
+    for (int c = 0; c < src.c; ++c) {
+      uint64_t channel = pStore.dotranspose() ? (uint64_t)c * gc + n
+                                              : (uint64_t)n * gc + c;
+      for (int h = 0; h < src.h; ++h) {
+        const int8_t *row = &at(src, n, c, h, 0);
+        write(space, pStore.ga_dst() + (channel * gh + h) * gw, row, src.w);
+      }
+    }
+  }
+
+  if (!pStore.dotranspose() && gw == (uint64_t)src.w) {
+    run *= src.h;
+    if (gh == (uint64_t)src.h && gc == (uint64_t)src.c)
+      run *= src.c * src.n;
+  }
+  pRecord.dmaBytes = (uint64_t)src.n * src.c * src.h * src.w;
+  pRecord.dmaCycles = getDMACycles(pRecord.dmaBytes, run);
+  return true;
+}
+
+bool Simulator::execTLConv(const Inst& pInst, Record& pRecord,
+                           BankMask& pBanks)
+{
+  const Inst::bmnet_tl_conv_forward_bmkernel& conv = pInst.bm_tl_conv();
+  ConvParams p;
+  p.n = conv.input_n();
+  p.ic = conv.input_c();
+  p.ih = conv.input_h();
+  p.iw = conv.input_w();
+  p.oc = conv.output_c();
+  p.oh = conv.output_h();
+  p.ow = conv.output_w();
+  p.groups = std::max(conv.group(), 1);
+  p.kh = conv.kh();
+  p.kw = conv.kw();
+  p.dh = std::max(conv.dh(), 1u);
+  p.dw = std::max(conv.dw(), 1u);
+  p.padTop = conv.pad_h_top();
+  p.padLeft = conv.pad_w_left();
+  p.strideH = std::max(conv.stride_h(), 1u);
+  p.strideW = std::max(conv.stride_w(), 1u);
+  p.rshift = conv.rshift();
+  p.doBias = conv.do_bias();
+  p.doRelu = conv.do_relu();
+  p.resultAdd = (0 != conv.result_add());
+
+  int icg = p.ic / p.groups;
+  LocalTensor ifmap = { conv.la_ifmap(), p.n, p.ic, p.ih, p.iw, true };
+  LocalTensor ofmap = { conv.la_ofmap(), p.n, p.oc, p.oh, p.ow, true };
+  LocalTensor weight = { conv.la_weight(), 1, p.oc, p.kh * p.kw, icg,
+                         false };
+  LocalTensor bias = { conv.la_bias(), 2, p.oc, 1, 1, false };
+
+  pRecord.engine = kNPU;
+  if (!access(ifmap, pBanks) || !access(ofmap, pBanks) ||
+      !access(weight, pBanks) || (p.doBias && !access(bias, pBanks)))
+    return false;
+
+  Dense input, weights, biases, result;
+  gather(ifmap, input);
+  gather(weight, weights);
+  if (p.doBias)
+    gather(bias, biases);
+  if (p.resultAdd)
+    gather(ofmap, result);
+  Convolve(p, input, weights, GetInt16(biases), result);
+  scatter(ofmap, result);
+
+  // the formula of ConvOpCost.
+  pRecord.npuCycles = getSteps(p.n, p.oc, p.oh, p.ow) *
+                      ((uint64_t)p.kh * p.kw * icg + (p.doBias ? 2 : 0) + 3);
+  return true;
+}
+
+bool Simulator::execTLPool(const Inst& pInst, Record& pRecord,
+                           BankMask& pBanks)
+{
+  const Inst::bmnet_tl_pooling_forward_bmkernel& pool = pInst.tl_pool();
+  PoolParams p;
+  p.n = pool.input_n();
+  p.c = pool.input_c();
+  p.ih = pool.input_h();
+  p.iw = pool.input_w();
+  p.oh = pool.output_h();
+  p.ow = pool.output_w();
+  p.kh = pool.kh();
+  p.kw = pool.kw();
+  p.padTop = pool.pad_h_top();
+  p.padLeft = pool.pad_w_left();
+  p.strideH = std::max(pool.stride_h(), 1u);
+  p.strideW = std::max(pool.stride_w(), 1u);
+  p.rshift = pool.right_shift_width();
+  p.quant = pool.threshold_x_quantized();
+  p.isAvg = pool.is_avg_pooling();
+  p.doRelu = false;
+
+  LocalTensor ifmap = { pool.ifmap_laddr(), p.n, p.c, p.ih, p.iw, true };
+  LocalTensor ofmap = { pool.ofmap_laddr(), p.n, p.c, p.oh, p.ow, true };
+  pRecord.engine = kNPU;
+  if (!access(ifmap, pBanks) || !access(ofmap, pBanks))
+    return false;
+
+  Dense input, result;
+  gather(ifmap, input);
+  Pool(p, input, result);
+  scatter(ofmap, result);
+
+  // the formula of MaxPoolOpCost.
+  uint64_t units = DivCeil(m_Config.numOfUnits, p.strideW);
+  pRecord.npuCycles = DivCeil((uint64_t)p.oh * p.ow, units) *
+                      ((uint64_t)p.n * DivCeil(p.c, m_Config.numOfLanes) *
+                       p.kh * p.kw + 6);
+  return true;
+}
+
+bool Simulator::execTLEltwise(const Inst& pInst, Record& pRecord,
+                              BankMask& pBanks)
+{
+  const Inst::bmnet_tl_eltwise_forward_bmkernel& elt = pInst.tl_eltwise();
+  int n = elt.input_n(), c = elt.input_c(), h = elt.input_h(),
+      w = elt.input_w();
+  LocalTensor output = { elt.la_output(), n, c, h, w, true };
+  pRecord.engine = kNPU;
+  if (!access(output, pBanks))
+    return false;
+
+  std::vector<Dense> inputs(elt.la_input_size());
+  for (int i = 0; i < elt.la_input_size(); ++i) {
+    LocalTensor input = { elt.la_input(i), n, c, h, w, true };
+    if (!access(input, pBanks))
+      return false;
+    gather(input, inputs[i]);
+  }
+
+  std::vector<int> quant;
+  if (!elt.use_default_coeff())
+    quant.assign(elt.threshold_x_quantized().begin(),
+                 elt.threshold_x_quantized().end());
+  Dense result;
+  Eltwise(elt.op(), inputs, quant, elt.right_shift_width(), elt.do_relu(),
+          elt.relu_slope(), result);
+  scatter(output, result);
+
+  // the factors of TensorOpCost.
+  uint64_t factor = (kProd == elt.op()) ? 5 : (kMax == elt.op()) ? 2 : 6;
+  pRecord.npuCycles = getSteps(n, c, h, w) * factor *
+                      std::max(elt.la_input_size() - 1, 1);
+  return true;
+}
+
+//===----------------------------------------------------------------------===//
+// TG kernels
+//===----------------------------------------------------------------------===//
+template<class ConvType>
+void Simulator::execConv(const ConvType& pConv, Record& pRecord)
+{
+  ConvParams p;
+  p.n = pConv.input_n();
+  p.ic = pConv.input_c();
+  p.ih = pConv.input_h();
+  p.iw = pConv.input_w();
+  p.oc = pConv.output_c();
+  p.groups = std::max(pConv.groups(), 1);
+  p.kh = pConv.kh();
+  p.kw = pConv.kw();
+  p.dh = std::max(pConv.dilation_h(), 1u);
+  p.dw = std::max(pConv.dilation_w(), 1u);
+  p.padTop = pConv.pad_h();
+  p.padLeft = pConv.pad_w();
+  p.strideH = std::max(pConv.stride_h(), 1u);
+  p.strideW = std::max(pConv.stride_w(), 1u);
+  p.oh = GetOutputSize(p.ih, 2 * p.padTop, p.dh * (p.kh - 1) + 1, p.strideH,
+                       false);
+  p.ow = GetOutputSize(p.iw, 2 * p.padLeft, p.dw * (p.kw - 1) + 1,
+                       p.strideW, false);
+  p.rshift = pConv.right_shift_width();
+  p.doBias = (0 != pConv.do_bias());
+  p.doRelu = (0 != pConv.do_activation()) &&
+             (Inst::RELU == pConv.activation_method());
+  p.resultAdd = (0 != pConv.result_add());
+
+  uint64_t icg = p.ic / p.groups;
+  uint64_t inSize = (uint64_t)p.n * p.ic * p.ih * p.iw;
+  uint64_t outSize = (uint64_t)p.n * p.oc * p.oh * p.ow;
+  uint64_t weightSize = (uint64_t)p.oc * p.kh * p.kw * icg;
+
+  Dense input, weights, biases, result;
+  readGlobal(kNeuron, pConv.ga_ifmap(), inSize, input);
+  readGlobal(kWeight, pConv.ga_weight(), weightSize, weights);
+  if (p.doBias)
+    readGlobal(kWeight, pConv.ga_bias(), 2 * p.oc, biases);
+  if (p.resultAdd)
+    readGlobal(kNeuron, pConv.ga_ofmap(), outSize, result);
+  Convolve(p, input, weights, GetInt16(biases), result);
+  writeGlobal(kNeuron, pConv.ga_ofmap(), result);
+
+  uint64_t biasSize = p.doBias ? 2 * p.oc : 0;
+  pRecord.dmaBytes = inSize + weightSize + biasSize + outSize;
+  pRecord.dmaCycles = getDMACycles(inSize, inSize) +
+                      getDMACycles(weightSize, weightSize) +
+                      getDMACycles(biasSize, biasSize) +
+                      getDMACycles(outSize, outSize);
+  pRecord.npuCycles = getSteps(p.n, p.oc, p.oh, p.ow) *
+                      (p.kh * p.kw * icg + (p.doBias ? 2 : 0) + 3);
+}
+
+void Simulator::execFC(const Inst& pInst, Record& pRecord)
+{
+  const Inst::bmnet_fc_fixed_forward_bmkernel& fc = pInst.fc();
+  uint64_t m = fc.input_row_num(), k = fc.input_col_num(),
+           n = fc.weight_col_num();
+
+  Dense input, weights, biases;
+  readGlobal(kNeuron, fc.bottom_data_gaddr(), m * k, input);
+  readGlobal(kWeight, fc.weight_data_gaddr(), k * n, weights);
+  if (fc.have_bias())
+    readGlobal(kWeight, fc.bias_data_gaddr(), 2 * n, biases);
+  std::vector<int> bias = GetInt16(biases);
+
+  Dense result(m * n);
+  bool doRelu = fc.do_activation() && Inst::RELU == fc.activation_method();
+  for (uint64_t row = 0; row < m; ++row) {
+    for (uint64_t col = 0; col < n; ++col) {
+      int64_t acc = 0;
+      for (uint64_t i = 0; i < k; ++i) {
+        // a transposed weight is (n, k).
+        uint64_t w = fc.weight_transpose() ? col * k + i : i * n + col;
+        acc += (int64_t)input[row * k + i] * weights[w];
+      }
+      if (fc.have_bias())
+        acc += bias[col];
+      acc = RShift(acc * ((int64_t)1 << fc.left_shift_width()),
+                   fc.right_shift_width());
+      result[row * n + col] = doRelu ? Relu(acc, 0.f) : Saturate(acc);
+    }
+  }
+  writeGlobal(kNeuron, fc.top_data_gaddr(), result);
+
+  uint64_t biasSize = fc.have_bias() ? 2 * n : 0;
+  pRecord.dmaBytes = m * k + k * n + biasSize + m * n;
+  pRecord.dmaCycles = getDMACycles(m * k, m * k) + getDMACycles(k * n, k * n) +
+                      getDMACycles(biasSize, biasSize) +
+                      getDMACycles(m * n, m * n);
+
+  // the formula of GemmOpCost.
+  pRecord.npuCycles = DivCeil(m, m_Config.numOfLanes) *
+                      DivCeil(n, m_Config.numOfUnits) *
+                      (k * (std::max<uint64_t>(m, 1) - 1) + n + 6);
+}
+
+void Simulator::execPool(const Inst& pInst, Record& pRecord)
+{
+  const Inst::bmnet_pooling_fixed_forward_bmkernel& pool = pInst.pooling();
+  PoolParams p;
+  p.n = pool.n();
+  p.c = pool.c();
+  p.ih = pool.h();
+  p.iw = pool.w();
+  p.kh = pool.kh();
+  p.kw = pool.kw();
+  p.padTop = pool.pad_top();
+  p.padLeft = pool.pad_left();
+  p.strideH = std::max(pool.stride_h(), 1);
+  p.strideW = std::max(pool.stride_w(), 1);
+  p.oh = GetOutputSize(p.ih, pool.pad_top() + pool.pad_bot(), p.kh, p.strideH,
+                       pool.ceil_mode());
+  p.ow = GetOutputSize(p.iw, pool.pad_left() + pool.pad_right(), p.kw,
+                       p.strideW, pool.ceil_mode());
+  p.rshift = pool.right_shift_width();
+  p.quant = pool.threshold_x_quantized_size() ? pool.threshold_x_quantized(0)
+                                              : 0;
+  p.isAvg = (0 != pool.is_avg_pooling());
+  p.doRelu = (0 != pool.do_relu());
+
+  uint64_t inSize = (uint64_t)p.n * p.c * p.ih * p.iw;
+  uint64_t outSize = (uint64_t)p.n * p.c * p.oh * p.ow;
+  Dense input, result;
+  readGlobal(kNeuron, pool.ifmap_gaddr(), inSize, input);
+  Pool(p, input, result);
+  writeGlobal(kNeuron, pool.ofmap_gaddr(), result);
+
+  pRecord.dmaBytes = inSize + outSize;
+  pRecord.dmaCycles = getDMACycles(inSize, inSize) +
+                      getDMACycles(outSize, outSize);
+  uint64_t units = DivCeil(m_Config.numOfUnits, p.strideW);
+  pRecord.npuCycles = DivCeil((uint64_t)p.oh * p.ow, units) *
+                      ((uint64_t)p.n * DivCeil(p.c, m_Config.numOfLanes) *
+                       p.kh * p.kw + 6);
+}
+
+void Simulator::execEltwise(const Inst& pInst, Record& pRecord)
+{
+  const Inst::bmnet_eltwise_fixed_forward_bmkernel& elt = pInst.eltwise();
+  int n = elt.input_n(), c = elt.input_c(), h = elt.input_h(),
+      w = elt.input_w();
+  uint64_t size = (uint64_t)n * c * h * w;
+
+  std::vector<Dense> inputs(elt.ga_input_size());
+  for (int i = 0; i < elt.ga_input_size(); ++i)
+    readGlobal(kNeuron, elt.ga_input(i), size, inputs[i]);
+  std::vector<int> quant(elt.threshold_x_quantized().begin(),
+                         elt.threshold_x_quantized().end());
+  Dense result;
+  Eltwise(elt.op(), inputs, quant, elt.right_shift_width(), elt.do_relu(),
+          elt.relu_slope(), result);
+  writeGlobal(kNeuron, elt.ga_output(), result);
+
+  pRecord.dmaBytes = size * (inputs.size() + 1);
+  pRecord.dmaCycles = getDMACycles(size, size) * (inputs.size() + 1);
+  uint64_t factor = (kProd == elt.op()) ? 5 : (kMax == elt.op()) ? 2 : 6;
+  pRecord.npuCycles = getSteps(n, c, h, w) * factor *
+                      std::max(elt.ga_input_size() - 1, 1);
+}
+
+void Simulator::execRelu(const Inst& pInst, Record& pRecord)
+{
+  const Inst::bmnet_relu_fixed_forward_bmkernel& relu = pInst.relu();
+  int n = relu.input_n(), c = relu.input_c(), h = relu.input_h(),
+      w = relu.input_w();
+  uint64_t size = (uint64_t)n * c * h * w;
+
+  Dense data;
+  readGlobal(kNeuron, relu.bottom_gaddr(), size, data);
+  for (int& value : data)
+    value = Relu(value, relu.negative_slope());
+  writeGlobal(kNeuron, relu.top_gaddr(), data);
+
+  pRecord.dmaBytes = 2 * size;
+  pRecord.dmaCycles = 2 * getDMACycles(size, size);
+  pRecord.npuCycles = getSteps(n, c, h, w) * 2;
+}
+
+void Simulator::execLeakyRelu(const Inst& pInst, Record& pRecord)
+{
+  const Inst::bmnet_leakyrelu_fixed_forward_bmkernel& relu =
+      pInst.leakyrelu();
+  int n = relu.input_n(), c = relu.input_c(), h = relu.input_h(),
+      w = relu.input_w();
+  uint64_t size = (uint64_t)n * c * h * w;
+
+  Dense data;
+  readGlobal(kNeuron, relu.input_gaddr(), size, data);
+  for (int& value : data) {
+    int64_t x = value;
+    if (0 < x)
+      x = RShift(x * relu.gt_scale(), relu.gt_right_shift_width());
+    else
+      x = RShift(x * relu.le_scale(), relu.le_right_shift_width());
+    value = Saturate(x);
+  }
+  writeGlobal(kNeuron, relu.output_gaddr(), data);
+
+  pRecord.dmaBytes = 2 * size;
+  pRecord.dmaCycles = 2 * getDMACycles(size, size);
+  pRecord.npuCycles = getSteps(n, c, h, w) * 2;
+}
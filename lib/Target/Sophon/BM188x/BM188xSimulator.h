@@ -0,0 +1,240 @@
+//===- BM188xSimulator.h --------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef ONNC_TARGET_BM188X_SIMULATOR_H
+#define ONNC_TARGET_BM188X_SIMULATOR_H
+#include <onnc/Support/OStream.h>
+#include <onnc/Target/Sophon/BM188x/asm/bm188x_asm.pb.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace onnc {
+namespace BM188X {
+
+/** \class Simulator
+ *  \brief runs a BM188x command buffer on the host and times it.
+ *
+ *  The simulator executes the int8 instructions of the TG and the TL
+ *  kernels: convolutions, fully connected layers, poolings, elementwise
+ *  operations, activations, and the loads and the stores of the local
+ *  memory. The other instructions are timed as free and reported as not
+ *  simulated.
+ *
+ *  The global memory has two spaces, neurons and weights, both starting at
+ *  zero. The local memory has a lane per NPU. A local tensor (N C H W)
+ *  puts channel c in lane c % lanes; the channels of a lane are laid out
+ *  in order and aligned to the EUs if the tensor is. Neurons are aligned.
+ *  Weights are not: a convolution reads (1, oc, kh*kw, ic) and its 16-bit
+ *  bias (2, oc, 1, 1), the low bytes first.
+ *
+ *  Timing follows the cost model of BM188xTargetTransformInfo:
+ *    - the NPU takes the cycles of the formulas in the cost model, computed
+ *      from the geometry of the instruction;
+ *    - the DMA moves every contiguous run of bytes in bursts of the bus
+ *      width, after a latency;
+ *    - a TG kernel transfers its tensors and then computes them.
+ *  Instructions run one after another, except between tl_parallel(true)
+ *  and tl_parallel(false), where the DMA and the NPU run in parallel and
+ *  an instruction waits for the other engine only when their local memory
+ *  shares a bank.
+ */
+class Simulator
+{
+public:
+  typedef bmnet::bm1880::Inst Inst;
+  typedef bmnet::bm1880::CommandBuffer CommandBuffer;
+
+  enum MemSpace {
+    kNeuron,
+    kWeight,
+    kNumOfMemSpaces
+  };
+
+  enum Engine {
+    kNone, ///< markers, e.g., tl_parallel.
+    kDMA,
+    kNPU,
+    kBoth  ///< TG kernels.
+  };
+
+  struct Config
+  {
+    unsigned numOfLanes;  ///< NPU_NUM
+    unsigned numOfUnits;  ///< EU_NUM
+    uint64_t laneSize;    ///< bytes of local memory of a lane.
+    unsigned numOfBanks;  ///< banks of a lane.
+    unsigned busBitWidth; ///< the DMA bus.
+    uint64_t dmaLatency;  ///< cycles before a transfer starts.
+
+    Config();
+  };
+
+  struct Record
+  {
+    std::string name;
+    std::string type;
+    Engine engine;
+    bool simulated;
+
+    uint64_t start;
+    uint64_t cycles;
+    uint64_t stall;     ///< cycles waiting for a bank.
+    uint64_t dmaCycles;
+    uint64_t npuCycles;
+    uint64_t dmaBytes;
+
+    uint64_t getEnd() const { return start + cycles; }
+  };
+
+  struct Report
+  {
+    std::vector<Record> records;
+    uint64_t cycles;
+
+    uint64_t getDMACycles() const;
+
+    uint64_t getNPUCycles() const;
+
+    uint64_t getDMABytes() const;
+
+    uint64_t getStallCycles() const;
+
+    unsigned getNumOfSkipped() const;
+
+    void print(OStream& pOS, unsigned pBusBitWidth) const;
+  };
+
+public:
+  Simulator();
+
+  explicit Simulator(const Config& pConfig);
+
+  const Config& config() const { return m_Config; }
+
+  /// Clear the memory.
+  void reset();
+
+  void write(MemSpace pSpace, uint64_t pAddr, const int8_t* pData,
+             uint64_t pSize);
+
+  /// Bytes never written read as zero.
+  void read(MemSpace pSpace, uint64_t pAddr, int8_t* pData,
+            uint64_t pSize) const;
+
+  /// The end of the last byte written to @ref pSpace.
+  uint64_t size(MemSpace pSpace) const { return m_Global[pSpace].size(); }
+
+  /// Run @ref pBuffer from cycle zero.
+  /// @retval false An instruction accesses memory out of the local memory.
+  bool run(const CommandBuffer& pBuffer, Report& pReport);
+
+  /// Parse the text of a .s file, a series of CommandBuffers.
+  static bool Parse(const std::string& pText, CommandBuffer& pBuffer);
+
+  /// Parse a .cmd.bin file, a serialized CommandBuffer.
+  static bool ParseBinary(const std::string& pData, CommandBuffer& pBuffer);
+
+private:
+  /// A tensor in the local memory.
+  struct LocalTensor
+  {
+    uint64_t addr;
+    int n, c, h, w;
+    bool aligned;
+  };
+
+  /// A dense N C H W tensor.
+  typedef std::vector<int> Dense;
+
+  /// The banks an instruction accesses in the local memory.
+  typedef uint64_t BankMask;
+
+  /// Run the function of @ref pInst and count its cycles.
+  /// @retval false @ref pInst accesses memory out of the local memory.
+  bool execute(const Inst& pInst, Record& pRecord, BankMask& pBanks);
+
+  template<class LoadType>
+  bool execTLLoad(const LoadType& pLoad, Record& pRecord, BankMask& pBanks);
+
+  template<class StoreType>
+  bool execTLStore(const StoreType& pStore, Record& pRecord,
+                   BankMask& pBanks);
+
+  bool execTLConv(const Inst& pInst, Record& pRecord, BankMask& pBanks);
+
+  bool execTLPool(const Inst& pInst, Record& pRecord, BankMask& pBanks);
+
+  bool execTLEltwise(const Inst& pInst, Record& pRecord, BankMask& pBanks);
+
+  template<class ConvType>
+  void execConv(const ConvType& pConv, Record& pRecord);
+
+  void execFC(const Inst& pInst, Record& pRecord);
+
+  void execPool(const Inst& pInst, Record& pRecord);
+
+  void execEltwise(const Inst& pInst, Record& pRecord);
+
+  void execRelu(const Inst& pInst, Record& pRecord);
+
+  void execLeakyRelu(const Inst& pInst, Record& pRecord);
+
+  /// Place @ref pRecord on the timeline.
+  void schedule(Record& pRecord, BankMask pBanks);
+
+  /// @retval false @ref pTensor is out of the local memory.
+  bool access(const LocalTensor& pTensor, BankMask& pBanks) const;
+
+  uint64_t getChannelSize(const LocalTensor& pTensor) const;
+
+  uint64_t getLaneBytes(const LocalTensor& pTensor) const;
+
+  int8_t& at(const LocalTensor& pTensor, int pN, int pC, int pH, int pW);
+
+  void gather(const LocalTensor& pTensor, Dense& pResult);
+
+  void scatter(const LocalTensor& pTensor, const Dense& pData);
+
+  void readGlobal(MemSpace pSpace, uint64_t pAddr, uint64_t pCount,
+                  Dense& pResult) const;
+
+  void writeGlobal(MemSpace pSpace, uint64_t pAddr, const Dense& pData);
+
+  /// Cycles to move @ref pBytes in runs of @ref pRun contiguous bytes.
+  uint64_t getDMACycles(uint64_t pBytes, uint64_t pRun) const;
+
+  /// N * ceil(C / lanes) * ceil(H * W / units)
+  uint64_t getSteps(int pN, int pC, int pH, int pW) const;
+
+private:
+  Config m_Config;
+  std::vector<int8_t> m_Global[kNumOfMemSpaces];
+  std::vector<int8_t> m_Local;
+
+  /// the timeline.
+  uint64_t m_Time;
+  bool m_Parallel;
+  uint64_t m_DMAFree;
+  uint64_t m_NPUFree;
+
+  /// instructions of the running parallel section.
+  struct Busy
+  {
+    Engine engine;
+    uint64_t start;
+    uint64_t end;
+    BankMask banks;
+  };
+
+  std::vector<Busy> m_Section;
+};
+
+} // namespace BM188X
+} // namespace onnc
+
+#endif
@@ -14,6 +14,7 @@
 #include "TGBackend.h"
 #include <algorithm>
 #include <iostream>
+#include <onnc/IR/ONNXUtils.h>
 #include <onnc/Target/TargetMemInfo.h>
 #include <unordered_map>
 
@@ -208,6 +209,21 @@ int StoreOpCost(TGBackend *pTGBackend, const xNode *pNode)
   return TotalCycles;
 }
 
+/// Bytes of a tensor of @ref pSizes in a lane of the local memory. Channels
+/// (N C H W) spread over the NPU lanes and every channel is aligned to EU_NUM
+/// bytes.
+MemSize getLaneMemSize(const LongInts &pSizes, uint64_t pElemSize)
+{
+  std::vector<int64_t> NCHW(4, 1);
+  for (unsigned i = 0; i < pSizes.size(); ++i)
+    NCHW[std::min(i, 3u)] *= pSizes[i];
+
+  uint64_t channel = NCHW[2] * NCHW[3] * pElemSize;
+  channel = (channel + EU_NUM - 1) / EU_NUM * EU_NUM;
+  uint64_t channelsPerLane = (NCHW[1] + NPU_NUM - 1) / NPU_NUM;
+  return MemSize(EU_NUM, NCHW[0] * channelsPerLane * channel);
+}
+
 CostModelMap g_NodeCostModels = {
   { xSymbol("Conv"), ConvOpCost },
   { xSymbol("MaxPool"), MaxPoolOpCost },
@@ -246,6 +262,52 @@ uint64_t BM188xTargetTransformInfo::getOperatorCost(const xNode *pNode,
   return -1;
 }
 
+MemSize
+BM188xTargetTransformInfo::getOperatorMemUsage(const xNode *pNode) const
+{
+  std::vector<LongInts> inputSizes, outputSizes;
+  for (const xValue *v : pNode->inputs())
+    inputSizes.push_back(GetValueSizes(*v));
+  for (const xValue *v : pNode->outputs())
+    outputSizes.push_back(GetValueSizes(*v));
+  return getOperatorMemUsage(pNode, inputSizes, outputSizes);
+}
+
+MemSize BM188xTargetTransformInfo::getOperatorMemUsage(
+    const xNode *pNode, const std::vector<LongInts> &pInputSizes,
+    const std::vector<LongInts> &pOutputSizes) const
+{
+  MemSize total(EU_NUM, 0);
+  for (unsigned i = 0; i < pInputSizes.size(); ++i)
+    total.size += getOperatorInputMemUsage(pNode, i, pInputSizes[i]).size;
+  for (unsigned i = 0; i < pOutputSizes.size(); ++i)
+    total.size += getOperatorOutputMemUsage(pNode, i, pOutputSizes[i]).size;
+  return total;
+}
+
+MemSize BM188xTargetTransformInfo::getOperatorInputMemUsage(
+    const xNode *pNode, unsigned pIdx, const LongInts &pNewInputSize) const
+{
+  TargetMemInfo *memInfo = m_pTGBackend->getMemInfo();
+  return getLaneMemSize(
+      pNewInputSize, memInfo->getElemSize(pNode->inputs()[pIdx]->elemType()));
+}
+
+MemSize BM188xTargetTransformInfo::getOperatorOutputMemUsage(
+    const xNode *pNode, unsigned pIdx, const LongInts &pNewOutputSize) const
+{
+  TargetMemInfo *memInfo = m_pTGBackend->getMemInfo();
+  return getLaneMemSize(
+      pNewOutputSize, memInfo->getElemSize(pNode->outputs()[pIdx]->elemType()));
+}
+
+uint64_t BM188xTargetTransformInfo::getTransferCost(uint64_t pSize) const
+{
+  // every lane is filled through the same bus as LoadOpCost.
+  const uint64_t busBytes = BUS_BITWIDTH >> 3;
+  return (pSize * NPU_NUM + busBytes - 1) / busBytes;
+}
+
 int BM188xTargetTransformInfo::getWarpSize() const { return NPU_NUM; }
 
 int BM188xTargetTransformInfo::getProcessingUnitCount() const { return EU_NUM; }
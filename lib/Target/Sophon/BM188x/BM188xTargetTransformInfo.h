@@ -31,6 +31,26 @@ public:
   uint64_t getOperatorCost(const xNode *pNode,
                            unsigned pKind) const override;
 
+  /// The local memory of a tensor is laid out by lanes: channels spread
+  /// over the NPU lanes and every channel is aligned to the EUs. The sizes
+  /// are the bytes a lane takes.
+  MemSize getOperatorMemUsage(const xNode *pNode) const override;
+
+  MemSize
+  getOperatorMemUsage(const xNode *pNode,
+                      const std::vector<LongInts> &pInputSizes,
+                      const std::vector<LongInts> &pOutputSizes) const override;
+
+  MemSize
+  getOperatorInputMemUsage(const xNode *pNode, unsigned pIdx,
+                           const LongInts &pNewInputSize) const override;
+
+  MemSize
+  getOperatorOutputMemUsage(const xNode *pNode, unsigned pIdx,
+                            const LongInts &pNewOutputSize) const override;
+
+  uint64_t getTransferCost(uint64_t pSize) const override;
+
   int getWarpSize() const override;
 
   int getProcessingUnitCount() const override;
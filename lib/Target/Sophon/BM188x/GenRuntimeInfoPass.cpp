@@ -332,16 +332,10 @@ void GenRuntimeInfoPass::GenRest(json::Object& pOutput, const ::onnx::Graph& pG)
 
 float GenRuntimeInfoPass::getThreshold(const std::string &pName)
 {
-  const tg::bm1880::LayerCalibrationParameter &ctable =
-      *backend()->getLayerCtable(pName);
-  float threshold = 0.0;
-  for (int j = 0; j < ctable.blob_param_size(); j++) {
-    if (ctable.blob_param(j).name() == pName) {
-      threshold = ctable.blob_param(j).threshold_y();
-      break;
-    }
-  }
-  return threshold;
+  const BM1880Backend::BlobCtable *blob = backend()->getBlobCtable(pName);
+  if (nullptr == blob)
+    return 0.0;
+  return blob->threshold_y();
 }
 
 //===----------------------------------------------------------------------===//
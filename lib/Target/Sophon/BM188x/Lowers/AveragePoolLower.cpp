@@ -21,7 +21,7 @@ using namespace onnc::BM188X;
 // AveragePoolLower
 //===----------------------------------------------------------------------===//
 BM188X::AveragePoolLower::AveragePoolLower()
-{
+  : Lower(xSymbol("AveragePool")) {
 }
 
 BM188X::AveragePoolLower::~AveragePoolLower()
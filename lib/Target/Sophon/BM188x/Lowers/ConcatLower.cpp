@@ -19,7 +19,7 @@ namespace pm = onnc::PatternMatch;
 // ConcatLower
 //===----------------------------------------------------------------------===//
 BM188X::ConcatLower::ConcatLower()
-{
+  : Lower(xSymbol("Concat")) {
 }
 
 BM188X::ConcatLower::~ConcatLower()
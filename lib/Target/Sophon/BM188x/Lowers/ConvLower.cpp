@@ -19,7 +19,7 @@ namespace pm = onnc::PatternMatch;
 // ConvLower
 //===----------------------------------------------------------------------===//
 BM188X::ConvLower::ConvLower()
-{
+  : Lower(xSymbol("Conv")) {
 }
 
 BM188X::ConvLower::~ConvLower()
@@ -19,7 +19,7 @@ namespace pm = onnc::PatternMatch;
 // GemmLower
 //===----------------------------------------------------------------------===//
 BM188X::GemmLower::GemmLower()
-{
+  : Lower(xSymbol("Gemm")) {
 }
 
 BM188X::GemmLower::~GemmLower()
@@ -16,7 +16,7 @@ using namespace onnc::BM188X;
 // GlobalAveragePoolLower
 //===----------------------------------------------------------------------===//
 BM188X::GlobalAveragePoolLower::GlobalAveragePoolLower()
-{
+  : Lower(xSymbol("GlobalAveragePool")) {
 }
 
 BM188X::GlobalAveragePoolLower::~GlobalAveragePoolLower()
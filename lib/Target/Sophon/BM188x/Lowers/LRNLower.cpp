@@ -16,7 +16,7 @@ using namespace onnc::BM188X;
 // LRNLower
 //===----------------------------------------------------------------------===//
 BM188X::LRNLower::LRNLower()
-{
+  : Lower(xSymbol("LRN")) {
 }
 
 BM188X::LRNLower::~LRNLower()
@@ -16,7 +16,7 @@ using namespace onnc::BM188X;
 // LeakyReluLower
 //===----------------------------------------------------------------------===//
 BM188X::LeakyReluLower::LeakyReluLower()
-{
+  : Lower(xSymbol("LeakyRelu")) {
 }
 
 BM188X::LeakyReluLower::~LeakyReluLower()
@@ -16,7 +16,7 @@ using namespace onnc::BM188X;
 // LoadLower
 //===----------------------------------------------------------------------===//
 BM188X::LoadLower::LoadLower()
-{
+  : Lower(xSymbol("TLLoad")) {
 }
 
 BM188X::LoadLower::~LoadLower()
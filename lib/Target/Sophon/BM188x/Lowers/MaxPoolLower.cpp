@@ -16,7 +16,7 @@ using namespace onnc::BM188X;
 // MaxPoolLower
 //===----------------------------------------------------------------------===//
 BM188X::MaxPoolLower::MaxPoolLower()
-{
+  : Lower(xSymbol("MaxPool")) {
 }
 
 BM188X::MaxPoolLower::~MaxPoolLower()
@@ -16,7 +16,7 @@ using namespace onnc::BM188X;
 // PReluLower
 //===----------------------------------------------------------------------===//
 BM188X::PReluLower::PReluLower()
-{
+  : Lower(xSymbol("PRelu")) {
 }
 
 BM188X::PReluLower::~PReluLower()
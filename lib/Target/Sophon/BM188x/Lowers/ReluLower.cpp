@@ -15,7 +15,7 @@ using namespace onnc;
 // ReluLower
 //===----------------------------------------------------------------------===//
 BM188X::ReluLower::ReluLower()
-{
+  : Lower(xSymbol("Relu")) {
 }
 
 BM188X::ReluLower::~ReluLower()
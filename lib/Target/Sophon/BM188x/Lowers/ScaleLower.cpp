@@ -15,7 +15,7 @@ using namespace onnc;
 // ScaleLower
 //===----------------------------------------------------------------------===//
 BM188X::ScaleLower::ScaleLower()
-{
+  : Lower(xSymbol("Scale")) {
 }
 
 BM188X::ScaleLower::~ScaleLower()
@@ -16,7 +16,7 @@ using namespace onnc::BM188X;
 // StoreLower
 //===----------------------------------------------------------------------===//
 BM188X::StoreLower::StoreLower()
-{
+  : Lower(xSymbol("TLStore")) {
 }
 
 BM188X::StoreLower::~StoreLower()
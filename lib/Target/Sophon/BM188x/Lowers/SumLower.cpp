@@ -16,7 +16,7 @@ using namespace onnc::BM188X;
 // SumLower
 //===----------------------------------------------------------------------===//
 BM188X::SumLower::SumLower()
-{
+  : Lower(xSymbol("Sum")) {
 }
 
 BM188X::SumLower::~SumLower()
@@ -16,7 +16,7 @@ using namespace onnc::BM188X;
 // TransposeLower
 //===----------------------------------------------------------------------===//
 BM188X::TransposeLower::TransposeLower()
-{
+  : Lower(xSymbol("Transpose")) {
 }
 
 BM188X::TransposeLower::~TransposeLower()
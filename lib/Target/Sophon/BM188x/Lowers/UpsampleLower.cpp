@@ -16,7 +16,7 @@ using namespace onnc::BM188X;
 // UpsampleLower
 //===----------------------------------------------------------------------===//
 BM188X::UpsampleLower::UpsampleLower()
-{
+  : Lower(xSymbol("Upsample")) {
 }
 
 BM188X::UpsampleLower::~UpsampleLower()
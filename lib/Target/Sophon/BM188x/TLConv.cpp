@@ -161,6 +161,15 @@ void TLConv::emit() const
       m_RShiftWidth, m_DoBias, m_UseWinograd, m_DoRelu);
 }
 
+void TLConv::relocate(uint64_t pOffset)
+{
+  m_IFmapAddr += pOffset;
+  m_OFmapAddr += pOffset;
+  m_WeightAddr += pOffset;
+  if (m_DoBias)
+    m_BiasAddr += pOffset;
+}
+
 void TLConv::update(const tg::bm1880::LayerCalibrationParameter *pLayerCtable)
 {
   m_RShiftWidth = pLayerCtable->right_shift_width();
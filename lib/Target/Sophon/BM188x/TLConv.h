@@ -48,6 +48,15 @@ public:
 
   bool getDoBias() const { return m_DoBias; }
   int getBiasIdx() const { return m_BiasIdx; }
+  bool getDoResultAdd() const { return m_DoResultAdd; }
+
+  uint64_t getIFmapAddr() const { return m_IFmapAddr; }
+  uint64_t getOFmapAddr() const { return m_OFmapAddr; }
+  uint64_t getWeightAddr() const { return m_WeightAddr; }
+  uint64_t getBiasAddr() const { return m_BiasAddr; }
+
+  /// Move every buffer in the local memory by @ref pOffset bytes.
+  void relocate(uint64_t pOffset);
 
 private:
   uint64_t m_IFmapAddr, m_OFmapAddr, m_WeightAddr, m_BiasAddr;
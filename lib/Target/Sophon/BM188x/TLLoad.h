@@ -28,6 +28,16 @@ public:
   void emit() const override;
   TLLoad *addMemOperands(MemOperand *pInput);
 
+  uint64_t getDstLAddr() const { return m_DstLAddr; }
+
+  /// Move the destination buffer in the local memory by @ref pOffset bytes.
+  void relocate(uint64_t pOffset) { m_DstLAddr += pOffset; }
+
+  int getLocalN() const { return m_LocalN; }
+  int getLocalC() const { return m_LocalC; }
+  int getLocalH() const { return m_LocalH; }
+  int getLocalW() const { return m_LocalW; }
+
 private:
   uint64_t m_SrcGOffset;
   uint64_t m_DstLAddr;
@@ -0,0 +1,265 @@
+//===- TLPipeline.cpp -----------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "TLPipeline.h"
+#include "TLConv.h"
+#include "TLLoad.h"
+#include "TLStore.h"
+#include <algorithm>
+#include <limits>
+
+using namespace onnc;
+using namespace onnc::BM188X;
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+static uint64_t GetElemSize(const ComputeOperator2& pOp)
+{
+  return (xValueType::kInt16 == pOp.getMemOperand(0)->m_Type) ? 2 : 1;
+}
+
+/// @retval true Two operands share global memory.
+static bool IsOverlapped(const MemOperand* pA, const MemOperand* pB)
+{
+  if (pA == pB)
+    return true;
+  return pA->m_Addr < pB->m_Addr + pB->m_Size &&
+         pB->m_Addr < pA->m_Addr + pA->m_Size;
+}
+
+static void AddInst(TLPipeline::Schedule& pResult,
+                    const ComputeOperator2* pInst)
+{
+  pResult.push_back({ TLPipeline::Step::kInst, pInst });
+}
+
+//===----------------------------------------------------------------------===//
+// TLPipeline
+//===----------------------------------------------------------------------===//
+TLPipeline::TLPipeline(const TargetTransformInfo& pTTI,
+                       uint64_t pLocalMemSize)
+  : m_TTI(pTTI), m_LocalMemSize(pLocalMemSize) {
+}
+
+uint64_t TLPipeline::getLaneSize(int pN, int pC, int pH, int pW,
+                                 uint64_t pElemSize) const
+{
+  uint64_t lanes = std::max(m_TTI.getWarpSize(), 1);
+  uint64_t units = std::max(m_TTI.getProcessingUnitCount(), 1);
+
+  // channels spread over the lanes, and every channel is aligned to the EUs.
+  uint64_t channel = (uint64_t)pH * pW * pElemSize;
+  channel = (channel + units - 1) / units * units;
+  return (uint64_t)pN * ((pC + lanes - 1) / lanes) * channel;
+}
+
+template<class TransferType>
+uint64_t TLPipeline::getBufferSize(const TransferType& pOp) const
+{
+  return getLaneSize(pOp.getLocalN(), pOp.getLocalC(), pOp.getLocalH(),
+                     pOp.getLocalW(), GetElemSize(pOp));
+}
+
+unsigned TLPipeline::run(TGBackend::Instructions& pInsns,
+                         Schedule& pResult) const
+{
+  unsigned numOfGroups = 0;
+  Group group;
+  unsigned idx = 0;
+  while (idx < pInsns.size()) {
+    Tile tile;
+    unsigned size = matchTile(pInsns, idx, tile);
+    if (0 < size && isIndependent(group, tile)) {
+      group.push_back(tile);
+      idx += size;
+      continue;
+    }
+
+    // the group ends. Match the instruction again with an empty group.
+    if (!group.empty()) {
+      if (pipeline(group, pResult))
+        ++numOfGroups;
+      group.clear();
+      continue;
+    }
+
+    AddInst(pResult, pInsns[idx].get());
+    ++idx;
+  }
+
+  if (!group.empty() && pipeline(group, pResult))
+    ++numOfGroups;
+  return numOfGroups;
+}
+
+unsigned TLPipeline::matchTile(TGBackend::Instructions& pInsns, unsigned pIdx,
+                               Tile& pTile) const
+{
+  unsigned idx = pIdx;
+  for (; idx < pInsns.size(); ++idx) {
+    TLLoad* load = dynamic_cast<TLLoad*>(pInsns[idx].get());
+    if (nullptr == load)
+      break;
+    pTile.loads.push_back(load);
+  }
+  if (pTile.loads.empty() || pInsns.size() == idx)
+    return 0;
+
+  // results added to the output keep the order of the tiles.
+  pTile.conv = dynamic_cast<TLConv*>(pInsns[idx].get());
+  if (nullptr == pTile.conv || pTile.conv->getDoResultAdd() ||
+      1 != pTile.conv->getGroups())
+    return 0;
+
+  for (++idx; idx < pInsns.size(); ++idx) {
+    TLStore* store = dynamic_cast<TLStore*>(pInsns[idx].get());
+    if (nullptr == store)
+      break;
+    pTile.stores.push_back(store);
+  }
+  if (pTile.stores.empty())
+    return 0;
+
+  // the convolution reads only the loaded buffers, which move with it.
+  pTile.low = std::numeric_limits<uint64_t>::max();
+  pTile.high = 0;
+  std::vector<uint64_t> loaded;
+  for (TLLoad* load : pTile.loads) {
+    loaded.push_back(load->getDstLAddr());
+    pTile.low = std::min(pTile.low, load->getDstLAddr());
+    pTile.high = std::max(pTile.high,
+                          load->getDstLAddr() + getBufferSize(*load));
+  }
+
+  std::vector<uint64_t> operands = { pTile.conv->getIFmapAddr(),
+                                     pTile.conv->getWeightAddr() };
+  if (pTile.conv->getDoBias())
+    operands.push_back(pTile.conv->getBiasAddr());
+  for (uint64_t addr : operands) {
+    if (loaded.end() == std::find(loaded.begin(), loaded.end(), addr))
+      return 0;
+  }
+
+  // the stores read the output of the convolution.
+  uint64_t ofmap = pTile.conv->getOFmapAddr();
+  uint64_t ofmapEnd = ofmap + getLaneSize(pTile.conv->getInN(),
+                                          pTile.conv->getOutC(),
+                                          pTile.conv->getOutH(),
+                                          pTile.conv->getOutW(), 1);
+  pTile.low = std::min(pTile.low, ofmap);
+  pTile.high = std::max(pTile.high, ofmapEnd);
+  for (TLStore* store : pTile.stores) {
+    if (store->getSrcLAddr() < ofmap || ofmapEnd <= store->getSrcLAddr())
+      return 0;
+    pTile.high = std::max(pTile.high,
+                          store->getSrcLAddr() + getBufferSize(*store));
+  }
+  return idx - pIdx;
+}
+
+bool TLPipeline::isIndependent(const Group& pGroup, const Tile& pTile) const
+{
+  // a tile loads while earlier ones store.
+  for (const Tile& tile : pGroup) {
+    for (const TLStore* store : tile.stores) {
+      for (const TLLoad* load : pTile.loads) {
+        if (IsOverlapped(load->getMemOperand(0), store->getMemOperand(0)))
+          return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool TLPipeline::pipeline(Group& pGroup, Schedule& pResult) const
+{
+  uint64_t low = std::numeric_limits<uint64_t>::max();
+  uint64_t high = 0;
+  for (const Tile& tile : pGroup) {
+    low = std::min(low, tile.low);
+    high = std::max(high, tile.high);
+  }
+
+  // the second copy starts after the first, aligned to the EUs.
+  uint64_t align = std::max(m_TTI.getProcessingUnitCount(), 1);
+  uint64_t offset = (high - low + align - 1) / align * align;
+
+  if (pGroup.size() < 2 || m_LocalMemSize < high + offset) {
+    for (const Tile& tile : pGroup) {
+      for (const TLLoad* load : tile.loads)
+        AddInst(pResult, load);
+      AddInst(pResult, tile.conv);
+      for (const TLStore* store : tile.stores)
+        AddInst(pResult, store);
+    }
+    return false;
+  }
+
+  for (unsigned i = 1; i < pGroup.size(); i += 2) {
+    for (TLLoad* load : pGroup[i].loads)
+      load->relocate(offset);
+    pGroup[i].conv->relocate(offset);
+    for (TLStore* store : pGroup[i].stores)
+      store->relocate(offset);
+  }
+
+  schedule(pGroup, pResult);
+  return true;
+}
+
+void TLPipeline::schedule(const Group& pGroup, Schedule& pResult) const
+{
+  for (const TLLoad* load : pGroup[0].loads)
+    AddInst(pResult, load);
+
+  // stage i computes tile i, loads tile i + 1 and stores tile i - 1.
+  for (unsigned i = 0; i <= pGroup.size(); ++i) {
+    const Tile* next = (i + 1 < pGroup.size()) ? &pGroup[i + 1] : nullptr;
+    const Tile* cur = (i < pGroup.size()) ? &pGroup[i] : nullptr;
+    const Tile* prev = (0 < i) ? &pGroup[i - 1] : nullptr;
+
+    // tiles i + 1 and i - 1 use the same copy. Don't overwrite what is
+    // being stored.
+    bool defer = false;
+    if (nullptr != next && nullptr != prev) {
+      for (const TLLoad* load : next->loads) {
+        uint64_t begin = load->getDstLAddr();
+        uint64_t end = begin + getBufferSize(*load);
+        for (const TLStore* store : prev->stores) {
+          uint64_t src = store->getSrcLAddr();
+          if (begin < src + getBufferSize(*store) && src < end)
+            defer = true;
+        }
+      }
+    }
+
+    bool parallel = (nullptr != cur) &&
+                    ((nullptr != next && !defer) || nullptr != prev);
+    if (parallel)
+      pResult.push_back({ Step::kParallelBegin, nullptr });
+
+    if (nullptr != next && !defer) {
+      for (const TLLoad* load : next->loads)
+        AddInst(pResult, load);
+    }
+    if (nullptr != cur)
+      AddInst(pResult, cur->conv);
+    if (nullptr != prev) {
+      for (const TLStore* store : prev->stores)
+        AddInst(pResult, store);
+    }
+
+    if (parallel)
+      pResult.push_back({ Step::kParallelEnd, nullptr });
+
+    if (defer) {
+      for (const TLLoad* load : next->loads)
+        AddInst(pResult, load);
+    }
+  }
+}
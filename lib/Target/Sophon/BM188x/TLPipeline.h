@@ -0,0 +1,108 @@
+//===- TLPipeline.h -------------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef ONNC_TARGET_BM188X_TL_PIPELINE_H
+#define ONNC_TARGET_BM188X_TL_PIPELINE_H
+#include "TGBackend.h"
+#include <onnc/Target/TargetTransformInfo.h>
+#include <vector>
+
+namespace onnc {
+namespace BM188X {
+
+class TLLoad;
+class TLConv;
+class TLStore;
+
+/** \class TLPipeline
+ *  \brief overlaps the loads and the stores of sliced convolutions with
+ *  their compute by double buffering.
+ *
+ *  A tile is a run of TLLoads, a TLConv reading only the loaded buffers and
+ *  the TLStores of its output. Consecutive tiles form a group unless one
+ *  loads what an earlier one stores. If the local memory holds two copies of
+ *  the buffers of a group, the odd tiles move to the second copy (ping-pong
+ *  buffers) and the tiles L, C, S of the group are emitted in stages:
+ *
+ *    L0 | L1 C0 | L2 C1 S0 | ... | Cn-1 Sn-2 | Sn-1
+ *
+ *  The DMA and the NPU engines run the instructions of a stage in parallel,
+ *  and a stage ends by waiting for both engines. A load sharing local memory
+ *  with the store of its stage is deferred after the stage.
+ */
+class TLPipeline
+{
+public:
+  struct Step
+  {
+    enum Kind {
+      kInst,          ///< emit an instruction.
+      kParallelBegin, ///< the engines start running in parallel.
+      kParallelEnd    ///< wait for all engines.
+    };
+
+    Kind kind;
+    const ComputeOperator2 *inst;
+  };
+
+  typedef std::vector<Step> Schedule;
+
+public:
+  TLPipeline(const TargetTransformInfo& pTTI, uint64_t pLocalMemSize);
+
+  /// Schedule @ref pInsns in @ref pResult. The local buffers of the odd
+  /// tiles of pipelined groups are moved.
+  /// @return The number of pipelined groups.
+  unsigned run(TGBackend::Instructions& pInsns, Schedule& pResult) const;
+
+private:
+  struct Tile
+  {
+    std::vector<TLLoad *> loads;
+    TLConv *conv;
+    std::vector<TLStore *> stores;
+
+    /// the local memory of the tile, [low, high).
+    uint64_t low;
+    uint64_t high;
+  };
+
+  typedef std::vector<Tile> Group;
+
+private:
+  /// Match a tile at @ref pIdx of @ref pInsns.
+  /// @return The number of instructions of the tile; 0 if there is none.
+  unsigned matchTile(TGBackend::Instructions& pInsns, unsigned pIdx,
+                     Tile& pTile) const;
+
+  /// @retval true The tile can join @ref pGroup.
+  bool isIndependent(const Group& pGroup, const Tile& pTile) const;
+
+  /// Double buffer @ref pGroup and emit it in stages.
+  /// @retval false The group is left alone, i.e., it has only a tile or its
+  ///               two copies don't fit.
+  bool pipeline(Group& pGroup, Schedule& pResult) const;
+
+  void schedule(const Group& pGroup, Schedule& pResult) const;
+
+  /// Bytes of a buffer of N C H W in a lane of the local memory.
+  uint64_t getLaneSize(int pN, int pC, int pH, int pW,
+                       uint64_t pElemSize) const;
+
+  /// Bytes the local buffer of a TLLoad or a TLStore takes in a lane.
+  template<class TransferType>
+  uint64_t getBufferSize(const TransferType& pOp) const;
+
+private:
+  const TargetTransformInfo& m_TTI;
+  uint64_t m_LocalMemSize;
+};
+
+} // namespace BM188X
+} // namespace onnc
+
+#endif
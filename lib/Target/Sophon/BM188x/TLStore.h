@@ -28,6 +28,16 @@ public:
   void emit() const override;
   TLStore *addMemOperands(MemOperand *pOutput);
 
+  uint64_t getSrcLAddr() const { return m_SrcLAddr; }
+
+  /// Move the source buffer in the local memory by @ref pOffset bytes.
+  void relocate(uint64_t pOffset) { m_SrcLAddr += pOffset; }
+
+  int getLocalN() const { return m_LocalN; }
+  int getLocalC() const { return m_LocalC; }
+  int getLocalH() const { return m_LocalH; }
+  int getLocalW() const { return m_LocalW; }
+
 private:
   uint64_t m_DstGOffset;
   uint64_t m_SrcLAddr;
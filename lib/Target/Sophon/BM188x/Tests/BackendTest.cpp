@@ -300,3 +300,29 @@ SKYPAT_F(BM188xTest, bm188x_single_pass)
   }
 **/
 }
+
+SKYPAT_F(BM188xTest, bm188x_ctable_index)
+{
+  TargetOptions options;
+  TGBackend::Instructions insns;
+  BM1880Backend backend(insns, options);
+  backend.setCtableProto(
+      "layer { name: \"conv1\" blob_param { name: \"conv1\" threshold_y: 2 } }"
+      "layer { name: \"lrn1\" blob_param { name: \"lrn1\" threshold_y: 3 }"
+      " blob_param { name: \"sum_sq\" threshold_y: 4 } }");
+
+  ASSERT_TRUE(nullptr != backend.getMutableLayerCtable("lrn1"));
+  EXPECT_TRUE(backend.getLayerCtable("sum_sq") ==
+              backend.getMutableLayerCtable("lrn1"));
+  EXPECT_EQ(backend.getBlobCtable("conv1")->threshold_y(), 2);
+  EXPECT_TRUE(nullptr == backend.getLayerCtable("relu1"));
+
+  // the first blob of a name wins, as in the linear search it replaced.
+  backend.setCtableProto(
+      "layer { name: \"conv1\" blob_param { name: \"data\" threshold_y: 1 } }"
+      "layer { name: \"conv2\" blob_param { name: \"data\" threshold_y: 6 } }");
+  EXPECT_EQ(backend.getBlobCtable("data")->threshold_y(), 1);
+  EXPECT_TRUE(backend.getLayerCtable("data") ==
+              backend.getMutableLayerCtable("conv1"));
+  EXPECT_TRUE(nullptr == backend.getMutableLayerCtable("lrn1"));
+}
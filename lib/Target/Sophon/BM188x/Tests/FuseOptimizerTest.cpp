@@ -0,0 +1,76 @@
+//===- FuseOptimizerTest.cpp ----------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <skypat/skypat.h>
+#include <onnc/IR/IRBuilder.h>
+#include "../../TGFuseOptimizer.h"
+
+using namespace onnc;
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+static unsigned CountNodes(xGraph &pGraph, const std::string &pKind)
+{
+  unsigned count = 0;
+  for (xNode *node : pGraph.nodes()) {
+    if (node->kind() == xSymbol(pKind))
+      ++count;
+  }
+  return count;
+}
+
+static xNode *BuildConv(IRBuilder &pBuilder)
+{
+  pBuilder.CreateTensorGraph();
+  pBuilder.AddInput("data", {1, 3, 8, 8});
+  pBuilder.AddInput("conv_w", {4, 3, 3, 3});
+  pBuilder.AddInitializer("conv_w");
+  xNode *conv = pBuilder.AddNode("Conv", {"data", "conv_w"});
+  pBuilder.AddOutput("conv", {1, 4, 6, 6});
+  return conv;
+}
+
+//===----------------------------------------------------------------------===//
+// FuseOptimizer Test
+//===----------------------------------------------------------------------===//
+SKYPAT_F(TGFuseOptimizerTest, fuse_single_use_chain)
+{
+  onnc::Module module;
+  IRBuilder builder(module);
+  xNode *conv = BuildConv(builder);
+  builder.AddNode("Relu", {"conv"});
+  builder.AddOutput("relu", {1, 4, 6, 6});
+  ASSERT_TRUE(builder.FinalizeTensorGraph({"relu"}));
+
+  TGFuseOptimizer optimizer(nullptr);
+  xGraph *graph = builder.getTensorGraph();
+  EXPECT_TRUE(optimizer.FuseOptimization(graph, 7));
+  EXPECT_EQ(CountNodes(*graph, "Relu"), 0);
+  ASSERT_TRUE(conv->hasAttribute(xSymbol("do_relu")));
+  EXPECT_EQ(conv->i(xSymbol("do_relu")), 1);
+  EXPECT_TRUE(conv->output() == graph->outputs()[0]);
+}
+
+SKYPAT_F(TGFuseOptimizerTest, keep_fan_out)
+{
+  onnc::Module module;
+  IRBuilder builder(module);
+  xNode *conv = BuildConv(builder);
+  builder.AddNode("Relu", {"conv"});
+  builder.AddOutput("relu", {1, 4, 6, 6});
+  builder.AddNode("Sigmoid", {"conv"});
+  builder.AddOutput("sigmoid", {1, 4, 6, 6});
+  ASSERT_TRUE(builder.FinalizeTensorGraph({"relu", "sigmoid"}));
+
+  // the Sigmoid reads the output of the Conv, so the Relu stays apart.
+  TGFuseOptimizer optimizer(nullptr);
+  xGraph *graph = builder.getTensorGraph();
+  EXPECT_FALSE(optimizer.FuseOptimization(graph, 7));
+  EXPECT_EQ(CountNodes(*graph, "Relu"), 1);
+  EXPECT_FALSE(conv->hasAttribute(xSymbol("do_relu")));
+}
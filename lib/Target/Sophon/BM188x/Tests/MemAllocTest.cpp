@@ -0,0 +1,262 @@
+//===- MemAllocTest.cpp ---------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <skypat/skypat.h>
+#include "../BM188xBackend.h"
+#include "../TGRelu.h"
+#include "../../BuildMemOpndPass.h"
+#include "../../GlobalMemAllocPass.h"
+#include "../../LinearScanAllocPass.h"
+#include "../../TargetLowering.h"
+#include <onnc/Core/PassManager.h>
+#include <onnc/IR/Compute/InputOperator.h>
+#include <onnc/IR/Compute/OutputOperator.h>
+#include <onnc/IR/Compute/Relu.h>
+#include <onnc/IR/Compute/Sum.h>
+#include <onnc/IR/ComputeMemOperand.h>
+#include <onnc/IR/IRBuilder.h>
+#include <onnc/IR/Module.h>
+#include <onnc/Target/TargetOptions.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace onnc;
+using namespace onnc::BM188X;
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+namespace {
+
+/// A neuron placed by an allocation pass, and the steps it is live in.
+struct Neuron
+{
+  std::string name;
+  uint64_t addr;
+  uint64_t size;
+  unsigned int first;
+  unsigned int last;
+  bool boundary;
+};
+
+typedef std::vector<Neuron> NeuronList;
+
+/// Check that neurons live at the same time don't overlap, that inputs and
+/// outputs overlap no other neuron, and that every neuron is aligned.
+void CheckPlacement(const NeuronList& pNeurons)
+{
+  for (const Neuron& n : pNeurons)
+    EXPECT_EQ(n.addr % 16, 0);
+
+  for (unsigned int i = 0; i < pNeurons.size(); ++i) {
+    for (unsigned int j = i + 1; j < pNeurons.size(); ++j) {
+      const Neuron& a = pNeurons[i];
+      const Neuron& b = pNeurons[j];
+      bool inTime = a.boundary || b.boundary ||
+                    (a.first <= b.last && b.first <= a.last);
+      bool inSpace = a.addr < b.addr + b.size && b.addr < a.addr + a.size;
+      EXPECT_FALSE(inTime && inSpace);
+    }
+  }
+}
+
+/// A compute graph of Relus from "x" whose first result "n1" is also read
+/// by the Sum at the end:
+///   x -> n1 -> ... -> n{L-1} -> Sum(n1, n{L-1}) -> y
+class ComputeChain
+{
+public:
+  explicit ComputeChain(int pLength) : m_Module() {
+    ComputeGraph* cg = m_Module.createComputeGraph("main");
+    InputOperator* input = cg->addOperator<InputOperator>();
+    Int8Tensor* prev = tensor(*cg, "x");
+    input->addOutput(*prev);
+
+    Int8Tensor* n1 = nullptr;
+    for (int i = 1; i < pLength; ++i) {
+      Relu* relu = cg->addOperator<Relu>();
+      relu->addInput(*prev);
+      prev = tensor(*cg, "n" + std::to_string(i));
+      relu->addOutput(*prev);
+      if (nullptr == n1)
+        n1 = prev;
+    }
+
+    Sum* sum = cg->addOperator<Sum>();
+    sum->addInput(*n1);
+    sum->addInput(*prev);
+    Int8Tensor* y = tensor(*cg, "y");
+    sum->addOutput(*y);
+    cg->addOperator<OutputOperator>()->addInput(*y);
+  }
+
+  onnc::Module& module() { return m_Module; }
+
+private:
+  /// An int8 tensor of 20 bytes, which isn't a multiple of the alignment.
+  Int8Tensor* tensor(ComputeGraph& pCG, const std::string& pName) {
+    Int8Tensor* value = pCG.addValue<Int8Tensor>(pName);
+    value->setDimensions({ 1, 20 });
+    return value;
+  }
+
+private:
+  onnc::Module m_Module;
+};
+
+} // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// MemAllocTest
+//===----------------------------------------------------------------------===//
+SKYPAT_F(BM188xMemAllocTest, linear_scan_alloc)
+{
+  const int kLength = 6;
+  ComputeChain chain(kLength);
+  TargetOptions options;
+  TGBackend::Instructions insns;
+  BM1880Backend backend(insns, options);
+
+  PassManager pm;
+  pm.add(CreateBuildMemOpndPass());
+  pm.add(CreateLinearScanAllocPass(&backend));
+  ASSERT_TRUE(pm.run(chain.module()));
+
+  // the operators are numbered in order: x is 0, n{i} is i, y is kLength.
+  NeuronList neurons;
+  for (auto& entry : backend.getValMemOpndMap()) {
+    const ComputeMemOperand* opnd = entry.second;
+    std::string name = entry.first->getName();
+    unsigned int def = ("x" == name) ? 0 :
+                       ("y" == name) ? kLength : std::stoi(name.substr(1));
+    unsigned int use = ("n1" == name) ? kLength : def + 1;
+    neurons.push_back(Neuron{ name, opnd->start(), opnd->length(), def, use,
+                              "x" == name || "y" == name });
+  }
+  ASSERT_EQ(neurons.size(), kLength + 1);
+  CheckPlacement(neurons);
+
+  // a dead neuron leaves its space, so the chain needs fewer than one slot
+  // per neuron.
+  uint64_t end = 0;
+  for (const Neuron& n : neurons)
+    end = std::max(end, n.addr + n.size);
+  EXPECT_TRUE(end < 32 * neurons.size());
+}
+
+SKYPAT_F(BM188xMemAllocTest, global_mem_alloc)
+{
+  // x -> n1 -> ... -> n4 -> y with TG Relus, one instruction each.
+  const int kLength = 5;
+  onnc::Module module;
+  IRBuilder builder(module);
+  builder.CreateTensorGraph();
+  builder.AddInput("x", { 1, 20 }, Value::kInt8);
+  std::vector<xNode*> nodes;
+  std::vector<std::string> names = { "x" };
+  for (int i = 1; i <= kLength; ++i) {
+    names.push_back((kLength == i) ? "y" : "n" + std::to_string(i));
+    nodes.push_back(builder.AddNode("Relu", { names[i - 1] }));
+    builder.AddOutput(names[i], { 1, 20 }, Value::kInt8);
+  }
+  builder.FinalizeTensorGraph({ "y" });
+
+  std::vector<std::unique_ptr<MemOperand> > mems;
+  xGraph* graph = builder.getTensorGraph();
+  for (xNode* node : graph->nodes()) {
+    for (xValue* value : node->outputs())
+      mems.emplace_back(new MemOperand(value->uniqueName(), value,
+                                       MemType::NEURON));
+  }
+  for (xValue* value : graph->inputs())
+    mems.emplace_back(new MemOperand(value->uniqueName(), value,
+                                     MemType::NEURON));
+
+  TargetOptions options;
+  TGBackend::Instructions insns;
+  BM1880Backend backend(insns, options);
+  auto memOf = [&mems](const std::string& pName) {
+    for (auto& mem : mems)
+      if (pName == mem->m_Name)
+        return mem.get();
+    return (MemOperand*)nullptr;
+  };
+  for (int i = 0; i < kLength; ++i)
+    insns.emplace_back((new TGRelu(*nodes[i]))->addMemOperands(
+        memOf(names[i]), memOf(names[i + 1])));
+
+  std::unique_ptr<ModulePass> alloc(CreateGlobalMemAllocPass(&backend));
+  alloc->runOnModule(module);
+
+  // instruction i reads names[i] and writes names[i + 1].
+  NeuronList neurons;
+  for (int i = 0; i <= kLength; ++i) {
+    MemOperand* mem = memOf(names[i]);
+    ASSERT_TRUE(nullptr != mem);
+    unsigned int first = (0 == i) ? 0 : i - 1;
+    unsigned int last = (kLength == i) ? kLength - 1 : i;
+    neurons.push_back(Neuron{ names[i], mem->m_Addr, mem->m_Size, first,
+                              last, 0 == i || kLength == i });
+  }
+  CheckPlacement(neurons);
+}
+
+SKYPAT_F(BM188xMemAllocTest, output_through_flatten)
+{
+  // x -> Conv -> c -> Flatten -> y, and x -> Relu -> r1 -> Relu -> r2.
+  // Flatten is lowered to no instruction, so y is placed as c, which must
+  // live as long as the other outputs.
+  onnc::Module module;
+  IRBuilder builder(module);
+  builder.CreateTensorGraph();
+  builder.AddInput("x", { 1, 2, 4, 4 }, Value::kInt8);
+  builder.AddInput("w", { 3, 2, 1, 1 }, Value::kInt8);
+  xNode* conv = builder.AddNode("Conv", { "x", "w" });
+  conv->is_(xSymbol("kernel_shape"), { 1, 1 });
+  builder.AddOutput("c", { 1, 3, 4, 4 }, Value::kInt8);
+  builder.AddNode("Flatten", { "c" });
+  builder.AddOutput("y", { 1, 48 }, Value::kInt8);
+  builder.AddNode("Relu", { "x" });
+  builder.AddOutput("r1", { 1, 2, 4, 4 }, Value::kInt8);
+  builder.AddNode("Relu", { "r1" });
+  builder.AddOutput("r2", { 1, 2, 4, 4 }, Value::kInt8);
+  builder.FinalizeTensorGraph({ "y", "r2" });
+
+  TargetOptions options;
+  TGBackend::Instructions insns;
+  BM1880Backend backend(insns, options);
+  backend.getTargetLowering()->ISelLowering(builder.getTensorGraph(), insns);
+  ASSERT_EQ(insns.size(), 3);
+
+  std::unique_ptr<ModulePass> alloc(CreateGlobalMemAllocPass(&backend));
+  alloc->runOnModule(module);
+
+  // the operands of a value share its space; keep the first of each.
+  NeuronList neurons;
+  for (unsigned int i = 0; i < insns.size(); ++i) {
+    for (MemOperand* mem : insns[i]->getMemOperands()) {
+      if (MemType::NEURON != mem->m_MemType)
+        continue;
+      std::string name = mem->m_Value->uniqueName();
+      auto neuron = std::find_if(neurons.begin(), neurons.end(),
+                                 [&name](const Neuron& pNeuron) {
+                                   return name == pNeuron.name;
+                                 });
+      if (neurons.end() == neuron) {
+        bool boundary = "x" == name || "c" == name || "r2" == name;
+        neurons.push_back(Neuron{ name, mem->m_Addr, mem->m_Size, i, i,
+                                  boundary });
+      }
+      else
+        neuron->last = i;
+    }
+  }
+  ASSERT_EQ(neurons.size(), 4);
+  CheckPlacement(neurons);
+}
@@ -0,0 +1,194 @@
+//===- PipelineTest.cpp ---------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <skypat/skypat.h>
+#include "../BM188xBackend.h"
+#include "../BM188xSimulator.h"
+#include "../TLConv.h"
+#include "../TLLoad.h"
+#include "../TLStore.h"
+#include <onnc/IR/IRBuilder.h>
+#include <onnc/IR/Module.h>
+#include <onnc/Target/TargetOptions.h>
+#include <memory>
+#include <sstream>
+
+using namespace onnc;
+using namespace onnc::BM188X;
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+namespace {
+
+const int kNumOfTiles = 4;
+const int kTileH = 2;
+const int kW = 8;
+const int kH = kTileH * kNumOfTiles;
+
+// global memory: the input and the output are neurons, the weight isn't.
+const uint64_t kInputGAddr = 0;
+const uint64_t kOutputGAddr = 4096;
+
+// local memory: a tile fills the first bank of a lane, so the copy of the
+// odd tiles starts at the second bank.
+const int64_t kIFmapLAddr = 0;
+const int64_t kWeightLAddr = 4096;
+const int64_t kOFmapLAddr = 8192 - 16;
+
+/// The instructions of a 1x1 convolution of a (1, 2, kH, kW) input to an
+/// output channel, sliced along H into kNumOfTiles tiles.
+class SlicedConv
+{
+public:
+  SlicedConv() : m_Builder(m_Module) {
+    m_Builder.CreateTensorGraph();
+    xValue* x = m_Builder.AddInput("x", { 1, 2, kH, kW }, Value::kInt8);
+    xValue* w = m_Builder.AddInput("w", { 1, 2, 1, 1 }, Value::kInt8);
+    xValue* y = m_Builder.AddInput("y", { 1, 1, kH, kW }, Value::kInt8);
+    m_Input = addMemOperand("x", x, MemType::NEURON, kInputGAddr);
+    m_Weight = addMemOperand("w", w, MemType::WEIGHT, 0);
+    m_Output = addMemOperand("y", y, MemType::NEURON, kOutputGAddr);
+  }
+
+  /// Append the instructions of the tiles to @ref pInsns.
+  void lower(TGBackend::Instructions& pInsns) {
+    for (int t = 0; t < kNumOfTiles; ++t) {
+      std::string tile = std::to_string(t);
+      xNode* load = addNode("TLLoad", "x", "x" + tile,
+                            { 1, 2, kTileH, kW });
+      load->i_(xSymbol("src_goffset"), t * kTileH * kW);
+      load->i_(xSymbol("dst_laddr"), kIFmapLAddr);
+      load->is_(xSymbol("local_dim"), { 1, 2, kTileH, kW });
+      load->is_(xSymbol("global_dim"), { 1, 2, kH, kW });
+      setTransfer(*load, true);
+      pInsns.emplace_back((new TLLoad(*load))->addMemOperands(m_Input));
+
+      xNode* loadW = addNode("TLLoad", "w", "w" + tile, { 1, 1, 1, 2 });
+      loadW->i_(xSymbol("src_goffset"), 0);
+      loadW->i_(xSymbol("dst_laddr"), kWeightLAddr);
+      loadW->is_(xSymbol("local_dim"), { 1, 1, 1, 2 });
+      loadW->is_(xSymbol("global_dim"), { 1, 1, 1, 2 });
+      setTransfer(*loadW, false);
+      pInsns.emplace_back((new TLLoad(*loadW))->addMemOperands(m_Weight));
+
+      xNode* conv = addNode("TLConv", "x" + tile, "y" + tile,
+                            { 1, 1, kTileH, kW });
+      conv->is_(xSymbol("input_dim"), { 1, 2, kTileH, kW });
+      conv->is_(xSymbol("weight_dim"), { 2, 1, 1, 1 });
+      conv->is_(xSymbol("output_dim"), { 1, 1, kTileH, kW });
+      conv->i_(xSymbol("result_add"), 0);
+      conv->i_(xSymbol("ifmap_laddr"), kIFmapLAddr);
+      conv->i_(xSymbol("ofmap_laddr"), kOFmapLAddr);
+      conv->i_(xSymbol("weight_laddr"), kWeightLAddr);
+      conv->s_(xSymbol("op_name"), "conv");
+      pInsns.emplace_back((new TLConv(*conv))->addMemOperands(
+          m_Input, m_Weight, m_Output, nullptr));
+
+      xNode* store = addNode("TLStore", "y" + tile, "z" + tile,
+                             { 1, 1, kTileH, kW });
+      store->i_(xSymbol("dst_goffset"), t * kTileH * kW);
+      store->i_(xSymbol("src_laddr"), kOFmapLAddr);
+      store->is_(xSymbol("local_dim"), { 1, 1, kTileH, kW });
+      store->is_(xSymbol("global_dim"), { 1, 1, kH, kW });
+      setTransfer(*store, true);
+      pInsns.emplace_back((new TLStore(*store))->addMemOperands(m_Output));
+    }
+  }
+
+private:
+  MemOperand* addMemOperand(const std::string& pName, xValue* pValue,
+                            MemType pMemType, uint64_t pAddr) {
+    m_MemOperands.emplace_back(new MemOperand(pName, pValue, pMemType));
+    MemOperand* result = m_MemOperands.back().get();
+    result->m_Addr = pAddr;
+    result->m_Size = result->m_Count;
+    return result;
+  }
+
+  xNode* addNode(const std::string& pKind, const std::string& pInput,
+                 const std::string& pOutput,
+                 const std::vector<xDimension>& pSizes) {
+    xNode* node = m_Builder.AddNode(pKind, { pInput });
+    m_Builder.AddOutput(pOutput, pSizes, Value::kInt8);
+    return node;
+  }
+
+  static void setTransfer(xNode& pNode, bool pIsNeuron) {
+    pNode.i_(xSymbol("do_transpose"), 0);
+    pNode.i_(xSymbol("is_aligned"), pIsNeuron);
+    pNode.i_(xSymbol("is_neuron"), pIsNeuron);
+    pNode.s_(xSymbol("op_name"), pIsNeuron ? "neuron" : "weight");
+  }
+
+private:
+  onnc::Module m_Module;
+  IRBuilder m_Builder;
+  std::vector<std::unique_ptr<MemOperand> > m_MemOperands;
+  MemOperand* m_Input;
+  MemOperand* m_Weight;
+  MemOperand* m_Output;
+};
+
+/// Compile the sliced convolution and run it on the simulator.
+/// @param[out] pOutput the output of the convolution.
+/// @return the cycles the command buffer takes; 0 if it fails.
+uint64_t CompileAndRun(bool pPipeline, std::vector<int8_t>& pOutput)
+{
+  TargetOptions options;
+  options.pipelineTiles(pPipeline);
+  TGBackend::Instructions insns;
+  BM1880Backend backend(insns, options);
+  SlicedConv conv;
+  conv.lower(insns);
+
+  std::ostringstream binary;
+  backend.getTargetCodeEmitter()->encodeInstructions(&binary, nullptr);
+  Simulator::CommandBuffer buffer;
+  if (!Simulator::ParseBinary(binary.str(), buffer))
+    return 0;
+
+  Simulator sim;
+  std::vector<int8_t> input(2 * kH * kW);
+  for (unsigned i = 0; i < input.size(); ++i)
+    input[i] = (int8_t)(i % 7) - 3;
+  const int8_t weight[2] = { 2, 1 };
+  sim.write(Simulator::kNeuron, kInputGAddr, input.data(), input.size());
+  sim.write(Simulator::kWeight, 0, weight, 2);
+
+  Simulator::Report report;
+  if (!sim.run(buffer, report))
+    return 0;
+  pOutput.resize(kH * kW);
+  sim.read(Simulator::kNeuron, kOutputGAddr, pOutput.data(), pOutput.size());
+  return report.cycles;
+}
+
+} // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// Pipeline Test
+//===----------------------------------------------------------------------===//
+SKYPAT_F(BM188xPipelineTest, pipeline_keeps_results_and_saves_cycles)
+{
+  std::vector<int8_t> sequential, pipelined;
+  uint64_t sequentialCycles = CompileAndRun(false, sequential);
+  uint64_t pipelinedCycles = CompileAndRun(true, pipelined);
+  ASSERT_TRUE(0 < sequentialCycles);
+  ASSERT_TRUE(0 < pipelinedCycles);
+
+  // out = 2 * in0 + in1, where channel 1 follows channel 0.
+  ASSERT_EQ(sequential.size(), kH * kW);
+  for (int i = 0; i < kH * kW; ++i) {
+    int expected = 2 * ((i % 7) - 3) + (((kH * kW + i) % 7) - 3);
+    EXPECT_EQ(sequential[i], expected);
+  }
+  EXPECT_TRUE(sequential == pipelined);
+
+  // the loads and the stores of the tiles run beside the convolutions.
+  EXPECT_TRUE(pipelinedCycles < sequentialCycles);
+}
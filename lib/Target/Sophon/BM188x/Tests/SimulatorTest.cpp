@@ -0,0 +1,221 @@
+//===- SimulatorTest.cpp --------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <skypat/skypat.h>
+#include "../BM188xSimulator.h"
+
+using namespace onnc;
+using namespace onnc::BM188X;
+
+typedef Simulator::Inst Inst;
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+static void AddLoad(Simulator::CommandBuffer& pBuffer, uint64_t pGAddr,
+                    uint64_t pLAddr, int pN, int pC, int pH, int pW,
+                    bool pIsNeuron)
+{
+  Inst *inst = pBuffer.add_inst();
+  inst->set_type("bmnet_tl_load_stride_bmkernel");
+  Inst::bmnet_tl_load_stride_bmkernel *load =
+      inst->mutable_tl_layer_load_stride();
+  load->set_ga_src(pGAddr);
+  load->set_la_dst(pLAddr);
+  load->set_local_n(pN);
+  load->set_local_c(pC);
+  load->set_local_h(pH);
+  load->set_local_w(pW);
+  load->set_global_c(pC);
+  load->set_global_h(pH);
+  load->set_global_w(pW);
+  load->set_doaligned(pIsNeuron);
+  load->set_isneuron(pIsNeuron);
+}
+
+static void AddStore(Simulator::CommandBuffer& pBuffer, uint64_t pGAddr,
+                     uint64_t pLAddr, int pN, int pC, int pH, int pW)
+{
+  Inst *inst = pBuffer.add_inst();
+  inst->set_type("bmnet_tl_store_stride_bmkernel");
+  Inst::bmnet_tl_store_stride_bmkernel *store =
+      inst->mutable_tl_layer_store_stride();
+  store->set_ga_dst(pGAddr);
+  store->set_la_src(pLAddr);
+  store->set_local_n(pN);
+  store->set_local_c(pC);
+  store->set_local_h(pH);
+  store->set_local_w(pW);
+  store->set_global_c(pC);
+  store->set_global_h(pH);
+  store->set_global_w(pW);
+  store->set_doaligned(true);
+  store->set_isneuron(true);
+}
+
+/// A 1x1 convolution of a 1 x 2 x 2 x 2 input to 1 output channel.
+static void AddConv(Simulator::CommandBuffer& pBuffer, uint64_t pIFmap,
+                    uint64_t pWeight, uint64_t pOFmap)
+{
+  Inst *inst = pBuffer.add_inst();
+  inst->set_type("bmnet_tl_conv_forward_bmkernel");
+  Inst::bmnet_tl_conv_forward_bmkernel *conv = inst->mutable_bm_tl_conv();
+  conv->set_la_ifmap(pIFmap);
+  conv->set_la_ofmap(pOFmap);
+  conv->set_la_weight(pWeight);
+  conv->set_input_n(1);
+  conv->set_input_c(2);
+  conv->set_input_h(2);
+  conv->set_input_w(2);
+  conv->set_group(1);
+  conv->set_output_c(1);
+  conv->set_output_h(2);
+  conv->set_output_w(2);
+  conv->set_kh(1);
+  conv->set_kw(1);
+  conv->set_dh(1);
+  conv->set_dw(1);
+  conv->set_stride_h(1);
+  conv->set_stride_w(1);
+}
+
+static void AddParallel(Simulator::CommandBuffer& pBuffer, bool pEnable)
+{
+  Inst *inst = pBuffer.add_inst();
+  inst->set_type("bmnet_tl_parallel_bmkernel");
+  inst->mutable_tl_parallel()->set_enable(pEnable);
+}
+
+//===----------------------------------------------------------------------===//
+// Simulator Test
+//===----------------------------------------------------------------------===//
+SKYPAT_F(BM188xSimulatorTest, load_store_round_trip)
+{
+  Simulator sim;
+  int8_t input[2 * 3 * 5];
+  for (int i = 0; i < 30; ++i)
+    input[i] = i - 15;
+  sim.write(Simulator::kNeuron, 100, input, 30);
+
+  Simulator::CommandBuffer buffer;
+  AddLoad(buffer, 100, 0, 1, 2, 3, 5, true);
+  AddStore(buffer, 500, 0, 1, 2, 3, 5);
+
+  Simulator::Report report;
+  ASSERT_TRUE(sim.run(buffer, report));
+  int8_t output[30];
+  sim.read(Simulator::kNeuron, 500, output, 30);
+  for (int i = 0; i < 30; ++i)
+    EXPECT_EQ(input[i], output[i]);
+
+  // 30 contiguous bytes take two 16-byte bursts each way.
+  ASSERT_EQ(report.records.size(), 2);
+  EXPECT_EQ(report.records[0].dmaCycles, 2);
+  EXPECT_EQ(report.records[1].start, 2);
+  EXPECT_EQ(report.cycles, 4);
+}
+
+SKYPAT_F(BM188xSimulatorTest, conv_1x1)
+{
+  Simulator sim;
+  // channel 0 is 1 2 3 4, channel 1 is 10 20 30 40.
+  int8_t input[8] = { 1, 2, 3, 4, 10, 20, 30, 40 };
+  // (1, oc, kh*kw, ic): out = 2 * in0 + 1 * in1.
+  int8_t weight[2] = { 2, 1 };
+  sim.write(Simulator::kNeuron, 0, input, 8);
+  sim.write(Simulator::kWeight, 0, weight, 2);
+
+  Simulator::CommandBuffer buffer;
+  AddLoad(buffer, 0, 0, 1, 2, 2, 2, true);
+  AddLoad(buffer, 0, 1024, 1, 1, 1, 2, false);
+  AddConv(buffer, 0, 1024, 2048);
+  AddStore(buffer, 64, 2048, 1, 1, 2, 2);
+
+  Simulator::Report report;
+  ASSERT_TRUE(sim.run(buffer, report));
+  int8_t output[4];
+  sim.read(Simulator::kNeuron, 64, output, 4);
+  EXPECT_EQ(output[0], 12);
+  EXPECT_EQ(output[1], 24);
+  EXPECT_EQ(output[2], 36);
+  EXPECT_EQ(output[3], 48);
+
+  // ConvOpCost: 1 step of (1 * 1 * 2 + 3) cycles.
+  EXPECT_EQ(report.records[2].npuCycles, 5);
+  EXPECT_EQ(report.getNumOfSkipped(), 0);
+}
+
+SKYPAT_F(BM188xSimulatorTest, parallel_sections_overlap)
+{
+  Simulator::CommandBuffer buffer;
+  AddParallel(buffer, true);
+  AddLoad(buffer, 0, 0, 1, 2, 2, 2, true);
+  AddConv(buffer, 32 * 1024, 40 * 1024, 48 * 1024);
+  AddParallel(buffer, false);
+
+  Simulator sim;
+  Simulator::Report report;
+  ASSERT_TRUE(sim.run(buffer, report));
+  // the load and the convolution use different banks and start together.
+  EXPECT_EQ(report.records[1].start, 0);
+  EXPECT_EQ(report.records[2].start, 0);
+  EXPECT_EQ(report.records[2].stall, 0);
+  EXPECT_EQ(report.cycles, 5);
+
+  // the convolution reads the bank the load writes, so it waits.
+  buffer.mutable_inst(2)->mutable_bm_tl_conv()->set_la_ifmap(0);
+  ASSERT_TRUE(sim.run(buffer, report));
+  EXPECT_EQ(report.records[2].start, 1);
+  EXPECT_EQ(report.records[2].stall, 1);
+  EXPECT_EQ(report.cycles, 6);
+}
+
+SKYPAT_F(BM188xSimulatorTest, out_of_local_memory)
+{
+  Simulator::CommandBuffer buffer;
+  AddLoad(buffer, 0, 64 * 1024 - 8, 1, 1, 4, 4, true);
+
+  Simulator sim;
+  Simulator::Report report;
+  EXPECT_FALSE(sim.run(buffer, report));
+}
+
+SKYPAT_F(BM188xSimulatorTest, parse_assembly)
+{
+  std::string text = "inst {\n  type: \"bmnet_tl_parallel_bmkernel\"\n"
+                     "  tl_parallel {\n    enable: true\n  }\n}\n\n"
+                     "inst {\n  type: \"bmnet_relu_fixed_forward_bmkernel\"\n"
+                     "  relu {\n    input_n: 1\n    input_c: 1\n"
+                     "    input_h: 1\n    input_w: 4\n  }\n}\n";
+  Simulator::CommandBuffer buffer;
+  ASSERT_TRUE(Simulator::Parse(text, buffer));
+  EXPECT_EQ(buffer.inst_size(), 2);
+  EXPECT_TRUE(buffer.inst(1).has_relu());
+}
+
+SKYPAT_F(BM188xSimulatorTest, parse_binary)
+{
+  Simulator::CommandBuffer buffer;
+  AddParallel(buffer, true);
+  AddLoad(buffer, 0, 0, 1, 2, 2, 2, true);
+  AddParallel(buffer, false);
+
+  // the emitter writes every instruction as a length-delimited field 1.
+  std::string data;
+  for (const Inst& inst : buffer.inst()) {
+    std::string bytes = inst.SerializeAsString();
+    data.push_back((char)((1 << 3) | 2));
+    data.push_back((char)bytes.size());
+    data += bytes;
+  }
+
+  Simulator::CommandBuffer parsed;
+  ASSERT_TRUE(Simulator::ParseBinary(data, parsed));
+  ASSERT_EQ(parsed.inst_size(), 3);
+  EXPECT_TRUE(parsed.inst(1).has_tl_layer_load_stride());
+  EXPECT_FALSE(Simulator::ParseBinary(data.substr(0, data.size() - 1), parsed));
+}
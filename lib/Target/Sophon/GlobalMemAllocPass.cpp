@@ -15,6 +15,7 @@
 #include "TG.h"
 #include "TGBackend.h"
 #include <onnc/ADT/Color.h>
+#include <onnc/Analysis/MemAllocStrategy.h>
 #include <onnc/Core/ModulePass.h>
 #include <onnc/Core/PassSupport.h>
 #include <onnc/IR/Compute/Initializer.h>
@@ -26,13 +27,31 @@
 
 using namespace onnc;
 
+/// @retval true The runtime reads @ref pValue after the last instruction.
+/// Reshape and Flatten are lowered to no instruction and their outputs share
+/// the MemOperand of their inputs, so a value read through them counts too.
+static bool IsNetworkOutput(const xValue *pValue)
+{
+  for (auto use : pValue->uses()) {
+    const xNode *user = use.user;
+    if (user->kind() == xBuiltinSymbol::kReturn)
+      return true;
+    if ((user->kind() == xSymbol("Reshape") ||
+         user->kind() == xSymbol("Flatten")) &&
+        IsNetworkOutput(user->outputs()[0]))
+      return true;
+  }
+  return false;
+}
+
 //===----------------------------------------------------------------------===//
 // GlobalMemAlloc
 //===----------------------------------------------------------------------===//
 char GlobalMemAlloc::ID = 0;
 
 GlobalMemAlloc::GlobalMemAlloc(TGBackend *pTarget)
-    : ModulePass(ID), m_pTarget(pTarget)
+    : ModulePass(ID), m_pTarget(pTarget), m_LiveRanges(),
+      m_NeuronSize(0), m_NeuronPeak(0)
 {
 }
 
@@ -46,29 +65,34 @@ Pass::ReturnType GlobalMemAlloc::runOnModule(::onnc::Module &pModule)
 void GlobalMemAlloc::allocGlobalMem()
 {
   unsigned int weight_offset = 0;
-  unsigned int neuron_offset = 0;
   std::string tab = "\t";
 
   DEBUG(dbgs() << __func__ << " dump global memory layout:"
                << "\n";);
 
+  computeLiveRanges();
+
   // FIXME memory allocation only need to traverse MemOperands in order
   // but currently CodeEmitter's prepareWeight function can't save the weight
   // on the address of MemOperand. So we need to sync the traverse order
   // between MemAlloc and prepareWeight now.
   std::unordered_map<const xValue *, MemOperand *> allocatedValue;
+  MemAllocRequestList requests;
+  std::vector<MemOperand *> neurons;
+  m_NeuronSize = 0;
   for (auto &inst : m_pTarget->getInsts()) {
     for (auto &mem : inst->getMemOperands()) {
       int tensor_size = 0;
-      if (allocatedValue.count(mem->m_Value)) {
-        mem->m_Addr = allocatedValue[mem->m_Value]->m_Addr;
-        mem->m_Size = allocatedValue[mem->m_Value]->m_Size;
+      if (allocatedValue.count(mem->m_Value))
         continue;
-      }
       if (mem->m_MemType == MemType::NEURON) {
-        mem->m_Addr = neuron_offset;
         tensor_size = m_pTarget->sizeOfTensorType(mem->m_Type) * mem->m_Count;
-        neuron_offset += tensor_size;
+        LiveRange range = m_LiveRanges[mem->m_Value];
+        uint64_t size = m_pTarget->alignNeuronSize(tensor_size);
+        requests.push_back(MemAllocRequest{ range.first, range.second,
+                                            size, 0 });
+        neurons.push_back(mem);
+        m_NeuronSize += size;
       } else if (mem->m_MemType == MemType::WEIGHT) {
         mem->m_Addr = weight_offset;
         tensor_size = m_pTarget->sizeOfTensorType(mem->m_Type) * mem->m_Count;
@@ -76,9 +100,59 @@ void GlobalMemAlloc::allocGlobalMem()
       }
       mem->m_Size = tensor_size;
       allocatedValue.insert({ mem->m_Value, mem });
-      DEBUG(dbgs() << tab << *mem << "\n");
     }
   }
+
+  // neurons dead at the definition of a neuron leave their space to it.
+  m_NeuronPeak = AllocByLiveness(requests);
+  for (unsigned int i = 0; i < neurons.size(); ++i)
+    neurons[i]->m_Addr = requests[i].address;
+
+  // the other operands of a value share its space.
+  for (auto &inst : m_pTarget->getInsts()) {
+    for (auto &mem : inst->getMemOperands()) {
+      MemOperand *allocated = allocatedValue[mem->m_Value];
+      if (allocated == mem) {
+        DEBUG(dbgs() << tab << *mem << "\n");
+        continue;
+      }
+      mem->m_Addr = allocated->m_Addr;
+      mem->m_Size = allocated->m_Size;
+    }
+  }
+  DEBUG(print(dbgs(), nullptr));
+}
+
+void GlobalMemAlloc::computeLiveRanges()
+{
+  m_LiveRanges.clear();
+
+  TGBackend::Instructions &insts = m_pTarget->getInsts();
+  const unsigned int last = insts.size();
+  for (unsigned int i = 0; i < insts.size(); ++i) {
+    for (auto &mem : insts[i]->getMemOperands()) {
+      if (mem->m_MemType != MemType::NEURON)
+        continue;
+      auto range = m_LiveRanges.emplace(mem->m_Value, LiveRange(i, i)).first;
+      range->second.second = i;
+    }
+  }
+
+  for (auto &entry : m_LiveRanges) {
+    const xValue *value = entry.first;
+    // network inputs are written before the first instruction runs and
+    // network outputs are read after the last one. The runtime may touch
+    // both at any time, so they are kept for the whole run.
+    if (value->node()->kind() == xBuiltinSymbol::kParam ||
+        IsNetworkOutput(value))
+      entry.second = LiveRange(0, last);
+  }
+}
+
+void GlobalMemAlloc::print(OStream &pOS, const Module *pModule) const
+{
+  pOS << "neuron footprint: " << m_NeuronSize << " bytes without reuse, "
+      << m_NeuronPeak << " bytes with reuse\n";
 }
 
 ModulePass *onnc::CreateGlobalMemAllocPass(TGBackend *pTarget)
@@ -12,11 +12,18 @@
 #include <onnc/Core/ModulePass.h>
 #include <onnc/Core/PassSupport.h>
 #include <vector>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
 namespace onnc {
 
+/** \class GlobalMemAlloc
+ *  Allocate the global memory of the TG instructions. Weights are laid out
+ *  one after another. A neuron is live from the first to the last
+ *  instruction touching it, and reuses the aligned space of the neurons dead
+ *  by then. Network inputs and outputs are live through all instructions.
+ */
 class GlobalMemAlloc : public ModulePass
 {
 public:
@@ -29,11 +36,27 @@ public:
   
   Pass::ReturnType runOnModule(::onnc::Module &pModule) override;
 
+  /// Print the neuron footprint with and without buffer reuse.
+  void print(OStream &pOS, const Module *pModule) const override;
+
+private:
+  /// [first, last] indices of the instructions touching a neuron.
+  typedef std::pair<unsigned int, unsigned int> LiveRange;
+
+  typedef std::unordered_map<const xValue *, LiveRange> LiveRangeMap;
+
 private:
   void allocGlobalMem();
 
+  void computeLiveRanges();
+
 private:
   TGBackend *m_pTarget; // NOLINT
+  LiveRangeMap m_LiveRanges;
+
+  // neuron footprint without and with reuse.
+  uint64_t m_NeuronSize;
+  uint64_t m_NeuronPeak;
 };
 
 ModulePass *CreateGlobalMemAllocPass(TGBackend *pTarget);
@@ -7,11 +7,21 @@
 //===----------------------------------------------------------------------===//
 #include "LinearScanAllocPass.h"
 #include "TGBackend.h"
+#include <onnc/Analysis/MemAllocStrategy.h>
 #include <onnc/Core/AnalysisResolver.h>
 #include <onnc/Core/AnalysisUsage.h>
 #include <onnc/Core/PassAnalysisSupport.h>
+#include <onnc/IR/Compute/InputOperator.h>
+#include <onnc/IR/Compute/OutputOperator.h>
 #include <onnc/IR/Compute/Tensor.h>
 #include <onnc/IR/Compute/Value.h>
+#include <onnc/Support/Casting.h>
+#include <onnc/Support/Debug.h>
+#include <onnc/Support/IOStream.h>
+#include <algorithm>
+#include <limits>
+
+#define DEBUG_TYPE "linear_scan_alloc"
 
 using namespace onnc;
 
@@ -21,17 +31,59 @@ using namespace onnc;
 char LinearScanAlloc::ID = 0;
 
 LinearScanAlloc::LinearScanAlloc(TGBackend *pTarget)
-    : ModulePass(ID), m_pTarget(pTarget)
+    : ModulePass(ID), m_pTarget(pTarget), m_LiveRanges(),
+      m_NeuronSize(0), m_NeuronPeak(0)
 {
 }
 
 Pass::ReturnType LinearScanAlloc::runOnModule(::onnc::Module &pModule)
 {
+  computeLiveRanges(pModule);
   linearScanAlloMem(getAnalysis<BuildMemOpnd>()->getMemOperandList());
+  DEBUG(print(dbgs(), &pModule));
 
   return Pass::kModuleNoChanged;
 }
 
+void LinearScanAlloc::computeLiveRanges(::onnc::Module &pModule)
+{
+  m_LiveRanges.clear();
+
+  // number the operators in the order they are emitted.
+  std::unordered_map<ComputeOperator *, unsigned int> positions;
+  unsigned int last = 0;
+  Module::cg_iterator cg, cgEnd = pModule.cgEnd();
+  for (cg = pModule.cgBegin(); cg != cgEnd; ++cg) {
+    ComputeGraph::iterator nodeIt, nEnd = cg->value()->end();
+    for (nodeIt = cg->value()->begin(); nodeIt != nEnd; ++nodeIt) {
+      ComputeOperator *node = nodeIt;
+      positions.emplace(node, last++);
+    }
+  }
+
+  for (auto &entry : positions) {
+    ComputeOperator *node = entry.first;
+    for (unsigned int i = 0; i < node->getNumOfOutputs(); ++i) {
+      onnc::Value *value = node->getOutput(i);
+      LiveRange range(entry.second, entry.second);
+      // network inputs are written before the first operator runs and
+      // network outputs are read after the last one. The runtime may touch
+      // both at any time, so they are kept for the whole run.
+      bool boundary = isa<InputOperator>(node);
+      for (onnc::Use &use : value->getUses()) {
+        if (isa<OutputOperator>(use.getUser()))
+          boundary = true;
+        auto user = positions.find(use.getUser());
+        if (positions.end() != user)
+          range.second = std::max(range.second, user->second);
+      }
+      if (boundary)
+        range = LiveRange(0, last);
+      m_LiveRanges.emplace(value, range);
+    }
+  }
+}
+
 int64_t getNumElems(const onnc::Value *pV)
 {
   int64_t n = 1;
@@ -45,29 +97,35 @@ void LinearScanAlloc::linearScanAlloMem(
     const BuildMemOpnd::MemOperandValList &pMemOps)
 {
   unsigned int weight_offset = 0;
-  unsigned int neuron_offset = 0;
 
   // FIXME memory allocation only need to traverse MemOperands in order
   // but currently CodeEmitter's prepareWeight function can't save the weight
   // on the address of MemOperand. So we need to sync the traverse order
   // between MemAlloc and prepareWeight now.
   TGBackend::ValMemOpndMap& allocatedValue = m_pTarget->getValMemOpndMap();
+  MemAllocRequestList requests;
+  std::vector<ComputeMemOperand *> neurons;
+  m_NeuronSize = 0;
   for (auto memOpVal : pMemOps) {
     ComputeMemOperand *memOp = memOpVal.first;
     onnc::Value *memVal = memOpVal.second;
-    if (allocatedValue.count(memVal)) {
-      memOp->setStart(allocatedValue[memVal]->start());
-      memOp->setLength(allocatedValue[memVal]->length());
+    if (allocatedValue.count(memVal))
       continue;
-    }
 
     xTensorProtoDataType ty = (xTensorProtoDataType)memVal->kind();
 
     int tensor_size = m_pTarget->sizeOfTensorType(ty) * getNumElems(memVal);
 
     if (memOp->residence() != ComputeOperand::kWeightResidence) {
-      memOp->setStart(neuron_offset);
-      neuron_offset += tensor_size;
+      // keep a value of unknown liveness through the whole module.
+      LiveRange range(0, std::numeric_limits<unsigned int>::max());
+      LiveRangeMap::iterator live = m_LiveRanges.find(memVal);
+      if (m_LiveRanges.end() != live)
+        range = live->second;
+      uint64_t size = m_pTarget->alignNeuronSize(tensor_size);
+      requests.push_back(MemAllocRequest{ range.first, range.second, size, 0 });
+      neurons.push_back(memOp);
+      m_NeuronSize += size;
     } else {
       memOp->setStart(weight_offset);
       weight_offset += tensor_size;
@@ -75,6 +133,21 @@ void LinearScanAlloc::linearScanAlloMem(
     memOp->setLength(tensor_size);
     allocatedValue.insert({memVal, memOp});
   }
+
+  // neurons dead at the definition of a neuron leave their space to it.
+  m_NeuronPeak = AllocByLiveness(requests);
+  for (unsigned int i = 0; i < neurons.size(); ++i)
+    neurons[i]->setStart(requests[i].address);
+
+  // the other operands of a value share its space.
+  for (auto memOpVal : pMemOps) {
+    ComputeMemOperand *memOp = memOpVal.first;
+    ComputeMemOperand *allocated = allocatedValue[memOpVal.second];
+    if (allocated == memOp)
+      continue;
+    memOp->setStart(allocated->start());
+    memOp->setLength(allocated->length());
+  }
 }
 
 void LinearScanAlloc::getAnalysisUsage(AnalysisUsage& pUsage) const
@@ -82,6 +155,12 @@ void LinearScanAlloc::getAnalysisUsage(AnalysisUsage& pUsage) const
   pUsage.addRequiredID(BuildMemOpnd::ID);
 }
 
+void LinearScanAlloc::print(OStream& pOS, const Module* pModule) const
+{
+  pOS << "neuron footprint: " << m_NeuronSize << " bytes without reuse, "
+      << m_NeuronPeak << " bytes with reuse\n";
+}
+
 ModulePass *onnc::CreateLinearScanAllocPass(TGBackend *pTarget)
 {
   return new LinearScanAlloc(pTarget);
@@ -10,10 +10,18 @@
 #include "BuildMemOpndPass.h"
 #include <onnc/Core/ModulePass.h>
 #include <onnc/Core/PassSupport.h>
+#include <unordered_map>
+#include <utility>
 
 namespace onnc {
 class TGBackend;
 
+/** \class LinearScanAlloc
+ *  Allocate the global memory of the memory operands. Weights are laid out
+ *  one after another. A neuron is live from the operator defining it to its
+ *  last user, and reuses the aligned space of the neurons dead by then.
+ *  Network inputs and outputs are live through the whole module.
+ */
 class LinearScanAlloc : public ModulePass
 {
 public:
@@ -28,7 +36,18 @@ public:
 
   void getAnalysisUsage(AnalysisUsage& pUsage) const override;
 
+  /// Print the neuron footprint with and without buffer reuse.
+  void print(OStream& pOS, const Module* pModule) const override;
+
+private:
+  /// [first, last] positions of the operators touching a value.
+  typedef std::pair<unsigned int, unsigned int> LiveRange;
+
+  typedef std::unordered_map<const onnc::Value*, LiveRange> LiveRangeMap;
+
 private:
+  void computeLiveRanges(::onnc::Module &pModule);
+
   void linearScanAlloMem(const BuildMemOpnd::MemOperandValList &pMemOps);
 
 private:
@@ -36,6 +55,11 @@ private:
   // FIXME: Use DLATargetBackend instead.
   //        sizeofTensorType is used on compute ir with legalized value type
   TGBackend *m_pTarget; // NOLINT
+  LiveRangeMap m_LiveRanges;
+
+  // neuron footprint without and with reuse.
+  uint64_t m_NeuronSize;
+  uint64_t m_NeuronPeak;
 };
 
 ModulePass *CreateLinearScanAllocPass(TGBackend *pTarget);
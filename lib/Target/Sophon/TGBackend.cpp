@@ -71,6 +71,20 @@ void TGBackend::addCodeEmit(PassManager &pPM, const Path &pOutput)
   pPM.add(CreateTGCodeEmitPass(this, pOutput.native()));
 }
 
+void TGBackend::getOutputFiles(const Path &pOutput,
+                               std::vector<Path> &pFiles) const
+{
+  // TGCodeEmit prints to stdout.
+  if (pOutput.native() == "-")
+    return;
+
+  pFiles.push_back(Path(pOutput.native() + ".weight.bin"));
+  pFiles.push_back(Path(pOutput.native() + ".rt.json"));
+  pFiles.push_back(Path(pOutput.native() + ".cmd.bin"));
+  if (options().shouldPrintTextAsm())
+    pFiles.push_back(Path(pOutput.native() + ".s"));
+}
+
 bool TGBackend::isNativeTensorType(xTensorProtoDataType pType)
 {
   return true;
@@ -138,22 +152,43 @@ onnc::ComputeMemOperand* TGBackend::getMemOpndByValue(const onnc::Value* pVal)
 //===----------------------------------------------------------------------===//
 // Non member functions
 //===----------------------------------------------------------------------===//
+namespace {
+
+/// Holds the instructions of an OwningBackend. It's a base class, so the
+/// instructions are constructed before the backend and destroyed after it.
+struct InstructionsHolder
+{
+  TGBackend::Instructions m_OwnInstructions;
+};
+
+/** \class OwningBackend
+ *  \brief A backend created by TargetRegistry owns its instructions, so
+ *  backends compiling different modules at the same time don't share them.
+ */
+template<class BackendType>
+class OwningBackend : private InstructionsHolder, public BackendType
+{
+public:
+  explicit OwningBackend(const TargetOptions &pOptions)
+    : InstructionsHolder(), BackendType(m_OwnInstructions, pOptions) {
+  }
+};
+
+} // anonymous namespace
+
 TargetBackend *CreateTGBM1680Backend(const TargetOptions &pOptions)
 {
-  static TGBackend::Instructions insns;
-  return new BM1680Backend(insns, pOptions);
+  return new OwningBackend<BM1680Backend>(pOptions);
 }
 
 TargetBackend *CreateTGBM1682Backend(const TargetOptions &pOptions)
 {
-  static TGBackend::Instructions insns;
-  return new BM1682Backend(insns, pOptions);
+  return new OwningBackend<BM1682Backend>(pOptions);
 }
 
 TargetBackend *CreateTGBM1880Backend(const TargetOptions &pOptions)
 {
-  static TGBackend::Instructions insns;
-  return new BM1880Backend(insns, pOptions);
+  return new OwningBackend<BM1880Backend>(pOptions);
 }
 
 extern "C" void InitializeSophonONNCBackend()
@@ -55,6 +55,9 @@ public:
 
   void addCodeEmit(PassManager &pPM, const Path &pOutputFile) override;
 
+  void getOutputFiles(const Path &pOutputFile,
+                      std::vector<Path> &pFiles) const override;
+
   void addMemAlloc(PassManager &pPM) override;
 
   std::vector<MemOperand *> &getMemOperands() { return m_MemOperands; }
@@ -76,6 +79,15 @@ public:
   // backend can descript which tensor types are supported
   virtual bool isNativeTensorType(xTensorProtoDataType pType);
 
+  // alignment of neuron buffers in global memory, in bytes
+  virtual unsigned int getNeuronAlignment() const { return 16; }
+
+  // round pSize up to the neuron alignment
+  uint64_t alignNeuronSize(uint64_t pSize) const {
+    const unsigned int alignment = getNeuronAlignment();
+    return (pSize + alignment - 1) / alignment * alignment;
+  }
+
   // calibration table name
   virtual std::string getCtableName() { return std::string(); }
 
@@ -37,7 +37,7 @@ Pass::ReturnType TGCodeEmit::runOnModule(Module &pModule)
   TGCodeEmitter *CE = m_Target->getTargetCodeEmitter();
   if (m_OutputFilename == "-") {
     CE->genRuntimeInfo(graph, onnc::outs());
-    CE->encodeInstructions(onnc::outs());
+    CE->encodeInstructions(nullptr, &onnc::outs());
   } else {
     // If we're printing in files, get weight binary first
     CE->genWeightBin(m_OutputFilename + ".weight.bin");
@@ -45,8 +45,16 @@ Pass::ReturnType TGCodeEmit::runOnModule(Module &pModule)
                        std::ios::out | std::ios::binary);
 
     CE->genRuntimeInfo(graph, rt_fp);
-    std::fstream asm_fp(m_OutputFilename + ".s", std::ios::out);
-    CE->encodeInstructions(asm_fp);
+
+    // the text is for debugging only.
+    std::fstream cmd_fp(m_OutputFilename + ".cmd.bin",
+                        std::ios::out | std::ios::binary);
+    if (m_Target->options().shouldPrintTextAsm()) {
+      std::fstream asm_fp(m_OutputFilename + ".s", std::ios::out);
+      CE->encodeInstructions(&cmd_fp, &asm_fp);
+    }
+    else
+      CE->encodeInstructions(&cmd_fp, nullptr);
   }
   return Pass::kModuleNoChanged;
 }
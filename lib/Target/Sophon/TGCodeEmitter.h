@@ -24,7 +24,10 @@ class TGCodeEmitter
 public:
   virtual ~TGCodeEmitter() = 0; //< pure interface
 
-  virtual void encodeInstructions(::std::ostream &pOS) = 0;
+  /// Write the instructions to @ref pBinary as a serialized CommandBuffer
+  /// and, for debugging, to @ref pText as text. Either may be null.
+  virtual void encodeInstructions(::std::ostream *pBinary,
+                                  ::std::ostream *pText) = 0;
 
   virtual void genWeightBin(const ::std::string &pOutputFilename) { return; }
 
@@ -14,6 +14,8 @@
 #include "PatternMatch.h"
 #include <onnc/IR/ONNXUtils.h>
 #include <onnc/Config/ONNX.h>
+#include <deque>
+#include <unordered_set>
 
 using namespace onnc;
 using namespace PatternMatch;
@@ -33,54 +35,28 @@ static std::vector<float> getTensorData(xGraph *pGraph,
   return tensor.floats();
 }
 
-static inline bool isTensor(xValue *pValue)
+static inline bool isTensor(const InitializerIndex &pInits, xValue *pValue)
 {
-  xGraph *graph = pValue->owningGraph();
-  std::unordered_set<std::string> init_names(graph->initializer_names().begin(),
-                                             graph->initializer_names().end());
-  if (init_names.count(pValue->uniqueName()))
-    return true;
-  return false;
+  return pInits.isInitializer(pValue);
 }
 
-static bool isNeuronInputs(xNode *pAddNode)
+static bool isNeuronInputs(const InitializerIndex &pInits, xNode *pAddNode)
 {
-  xGraph *graph = pAddNode->owningGraph();
-  std::unordered_set<std::string> init_names(graph->initializer_names().begin(),
-                                             graph->initializer_names().end());
-  auto input0 = pAddNode->inputs()[0]->uniqueName();
-  auto input1 = pAddNode->inputs()[1]->uniqueName();
-  if (init_names.count(input0) || init_names.count(input1))
+  if (pInits.isInitializer(pAddNode->inputs()[0]) ||
+      pInits.isInitializer(pAddNode->inputs()[1]))
     return false;
   return true;
 }
 
-bool TGFuseOptimizer::FuseOpset6Nodes(xGraph *pGraph, xNode *pNode)
-{
-  if (match(pNode, mSymbol("BatchNormalization")) and
-      match(next(pNode), mSymbol("Mul"), mAttr("axis", 1),
-            mTrueAttr("broadcast"))) {
-    FuseBNMulV6(pGraph, pNode, next(pNode));
-    return true;
-  }
-  if (match(pNode, mSymbol("BatchNormalization")) and
-      match(next(pNode), mSymbol("Add"), mAttr("axis", 1),
-            mTrueAttr("broadcast"))) {
-    FuseBNAddV6(pGraph, pNode, next(pNode));
-    return true;
-  }
-  return false;
-}
-
 static void replaceInput(xTensor &pTensor, size_t pIndex,
-                         xNode *pNode, xGraph *pGraph)
+                         xNode *pNode, InitializerIndex &pInits)
 {
   assert(pIndex < pNode->inputs().size());
-  xValue *new_value = pGraph->addInitializerAndInput(pTensor);
+  xValue *new_value = pInits.addInitializerAndInput(pTensor);
   xValue *old_value = pNode->inputs()[pIndex];
   pNode->replaceInput(pIndex, new_value);
   if (old_value->uses().size() == 0) {
-    pGraph->eraseInitializerAndInput(old_value);
+    pInits.eraseInitializerAndInput(old_value);
   }
 }
 
@@ -105,13 +81,13 @@ TGFuseOptimizer::FuseBNMulV6(xGraph *pGraph, xNode *pBNNode, xNode *pMulNode)
 
   scale.multiply(mul);
   bias.multiply(mul);
-  replaceInput(scale, 1, pBNNode, pGraph);
-  replaceInput(bias, 2, pBNNode, pGraph);
+  replaceInput(scale, 1, pBNNode, *m_pInitializers);
+  replaceInput(bias, 2, pBNNode, *m_pInitializers);
 
   if (mul_inputs[1]->uses().size() == 1) {
     auto input = mul_inputs[1];
     pMulNode->removeInput(1);
-    pGraph->eraseInitializerAndInput(input);
+    m_pInitializers->eraseInitializerAndInput(input);
   }
 
   pBNNode->output()->copyMetadata(pMulNode->output());
@@ -139,12 +115,12 @@ xNode *TGFuseOptimizer::FuseBNAddV6(xGraph *pGraph,
   xTensor add = *pGraph->getInitializer(add_name);
 
   bias.add(add);
-  replaceInput(bias, 2, pBNNode, pGraph);
+  replaceInput(bias, 2, pBNNode, *m_pInitializers);
 
   if (add_inputs[1]->uses().size() == 1) {
     auto input = add_inputs[1];
     pAddNode->removeInput(1);
-    pGraph->eraseInitializerAndInput(input);
+    m_pInitializers->eraseInitializerAndInput(input);
   }
 
   pBNNode->output()->copyMetadata(pAddNode->output());
@@ -177,13 +153,13 @@ xNode *TGFuseOptimizer::FuseBNMulTensor(xGraph *pGraph,
 
   scale.multiply(mul);
   bias.multiply(mul);
-  replaceInput(scale, 1, pBNNode, pGraph);
-  replaceInput(bias, 2, pBNNode, pGraph);
+  replaceInput(scale, 1, pBNNode, *m_pInitializers);
+  replaceInput(bias, 2, pBNNode, *m_pInitializers);
 
   if (mul_inputs[1]->uses().size() == 1) {
     auto input = mul_inputs[1];
     pMulNode->removeInput(1);
-    pGraph->eraseInitializerAndInput(input);
+    m_pInitializers->eraseInitializerAndInput(input);
   }
 
   pBNNode->output()->copyMetadata(pMulNode->output());
@@ -217,13 +193,13 @@ TGFuseOptimizer::FuseBNMul(xGraph *pGraph, xNode *pBNNode, xNode *pMulNode)
 
   scale.multiply(mul);
   bias.multiply(mul);
-  replaceInput(scale, 1, pBNNode, pGraph);
-  replaceInput(bias, 2, pBNNode, pGraph);
+  replaceInput(scale, 1, pBNNode, *m_pInitializers);
+  replaceInput(bias, 2, pBNNode, *m_pInitializers);
 
   if (unsque_inputs[0]->uses().size() == 1) {
     auto input = unsque_inputs[0];
     unsque_node->removeInput(0);
-    pGraph->eraseInitializerAndInput(input);
+    m_pInitializers->eraseInitializerAndInput(input);
   }
 
   pBNNode->output()->copyMetadata(pMulNode->output());
@@ -255,12 +231,12 @@ xNode *TGFuseOptimizer::FuseBNAddTensor(xGraph *pGraph,
   add.sizes() = bias.sizes();
 
   bias.add(add);
-  replaceInput(bias, 2, pBNNode, pGraph);
+  replaceInput(bias, 2, pBNNode, *m_pInitializers);
 
   if (add_inputs[1]->uses().size() == 1) {
     auto input = add_inputs[1];
     pAddNode->removeInput(1);
-    pGraph->eraseInitializerAndInput(input);
+    m_pInitializers->eraseInitializerAndInput(input);
   }
 
   pBNNode->output()->copyMetadata(pAddNode->output());
@@ -291,12 +267,12 @@ xNode *TGFuseOptimizer::FuseBNAdd(xGraph *pGraph, xNode *pBNNode,
   add.sizes() = bias.sizes();
 
   bias.add(add);
-  replaceInput(bias, 2, pBNNode, pGraph);
+  replaceInput(bias, 2, pBNNode, *m_pInitializers);
 
   if (unsque_inputs[0]->uses().size() == 1) {
     auto input = unsque_inputs[0];
     unsque_node->removeInput(0);
-    pGraph->eraseInitializerAndInput(input);
+    m_pInitializers->eraseInitializerAndInput(input);
   }
 
   pBNNode->output()->copyMetadata(pAddNode->output());
@@ -308,109 +284,172 @@ xNode *TGFuseOptimizer::FuseBNAdd(xGraph *pGraph, xNode *pBNNode,
   return pBNNode;
 }
 
-bool TGFuseOptimizer::FuseOpset7Nodes(xGraph *pGraph, xNode *pNode)
+/// The tensor is of (C, 1, 1).
+static bool isChannelTensor(const InitializerIndex &pInits, xValue *pValue)
 {
-  if (match(pNode, mSymbol("BatchNormalization")) &&
-      match(next(pNode), mSymbol("Mul")) &&
-      isTensor(next(pNode)->inputs()[1])) {
-    auto tensor_dims = next(pNode)->inputs()[1]->sizes();
-    if (tensor_dims.size() != 3 || tensor_dims[1].dim != 1 ||
-        tensor_dims[2].dim != 1) {
-      return false;
-    }
-    // tensor =  (C, 1, 1)
-    FuseBNMulTensor(pGraph, pNode, next(pNode));
-    return true;
-  }
+  if (!isTensor(pInits, pValue))
+    return false;
+  auto dims = pValue->sizes();
+  return dims.size() == 3 && dims[1].dim == 1 && dims[2].dim == 1;
+}
 
-  if (match(pNode, mSymbol("BatchNormalization")) &&
-      match(next(pNode), mSymbol("Add")) &&
-      isTensor(next(pNode)->inputs()[1])) {
-    auto tensor_dims = next(pNode)->inputs()[1]->sizes();
-    if (tensor_dims.size() != 3 || tensor_dims[1].dim != 1 ||
-        tensor_dims[2].dim != 1) {
-      return false;
-    }
-    // tensor =  (C, 1, 1)
-    FuseBNMulTensor(pGraph, pNode, next(pNode));
-    return true;
-  }
+/// The input is an Unsqueeze of (C, 1, 1) used only by @ref pNode.
+static bool isChannelUnsqueeze(xNode *pNode, size_t pIndex)
+{
+  if (!match(input(pNode, pIndex), mSymbol("Unsqueeze")))
+    return false;
+  auto dims = pNode->inputs()[pIndex]->sizes();
+  return dims.size() == 3 && dims[1].dim == 1 && dims[2].dim == 1;
+}
 
-  if (match(pNode, mSymbol("BatchNormalization")) &&
-      match(next(pNode), mSymbol("Mul")) &&
-      match(input(next(pNode), 1), mSymbol("Unsqueeze"))) {
-    auto unsq_dims = next(pNode)->inputs()[1]->sizes();
-    if (unsq_dims.size() != 3 || unsq_dims[1].dim != 1 ||
-        unsq_dims[2].dim != 1) {
-      return false;
-    }
-    // shape(unsqueeze) = (C, 1, 1)
-    FuseBNMul(pGraph, pNode, next(pNode));
-    return true;
-  }
-  if (match(pNode, mSymbol("BatchNormalization")) &&
-      match(next(pNode), mSymbol("Add")) &&
-      match(input(next(pNode), 1), mSymbol("Unsqueeze"))) {
-    auto unsq_dims = next(pNode)->inputs()[1]->sizes();
-    if (unsq_dims.size() != 3 || unsq_dims[1].dim != 1 ||
-        unsq_dims[2].dim != 1) {
-      return false;
-    }
-    // shape(unsqueeze) = (C, 1, 1)
-    FuseBNAdd(pGraph, pNode, next(pNode));
-    return true;
-  }
-  return false;
+/// Nodes other than the graph inputs and outputs.
+static bool isOperator(const xNode *pNode)
+{
+  return pNode->kind() != xBuiltinSymbol::kParam &&
+         pNode->kind() != xBuiltinSymbol::kReturn;
 }
 
-bool TGFuseOptimizer::FuseNodes(xGraph *pGraph,
-                                const int64_t &pOpsetVersion)
+void TGFuseOptimizer::AddPatterns(PatternTable &pTable)
 {
-  // WARNING: change iteration order will impact the optimization result
-  for (auto it = pGraph->begin(); it != pGraph->end(); ++it) {
-    auto *node = *it;
-    if (6 == pOpsetVersion && FuseOpset6Nodes(pGraph, node)) {
-      return true;
-    }
-    if (6 < pOpsetVersion && FuseOpset7Nodes(pGraph, node)) {
-      return true;
-    }
-    if (match(node, mSymbol("Conv")) and match(next(node), mSymbol("Relu"))) {
-      FuseRelu(pGraph, node, next(node));
-      return true;
-    }
-    if (match(node, mSymbol("Gemm")) and match(next(node), mSymbol("Relu"))) {
-      FuseRelu(pGraph, node, next(node));
-      return true;
-    }
-    if (match(node, mSymbol("Sum")) and match(next(node), mSymbol("Relu"))) {
-      FuseRelu(pGraph, node, next(node));
-      return true;
-    }
-    if (match(node, mSymbol("BatchNormalization"))) {
-      FuseBN(pGraph, node);
-      return true;
-    }
-    if (match(node, mSymbol("Add")) && isNeuronInputs(node)) {
-      AliasSumOperator(pGraph, node);
-      return true;
-    }
-    if (match(node, mSymbol("Conv")) and match(next(node), mSymbol("Scale"))) {
-      FuseConvScale(pGraph, node, next(node));
-      return true;
-    }
+  using namespace std::placeholders;
+  auto fuse = [this](xNode *(TGFuseOptimizer::*pRewrite)(xGraph *, xNode *,
+                                                         xNode *)) {
+    return std::bind(pRewrite, this, _1, _2, _3);
+  };
+  auto broadcast = [](xNode *pProducer, xNode *pUser) {
+    return match(pUser, mAttr("axis", 1), mTrueAttr("broadcast"));
+  };
+  auto tensor = [this](xNode *pProducer, xNode *pUser) {
+    return isChannelTensor(*m_pInitializers, pUser->inputs()[1]);
+  };
+  auto unsqueeze = [](xNode *pProducer, xNode *pUser) {
+    return isChannelUnsqueeze(pUser, 1);
+  };
+
+  // BN with Mul and Add of constant scales.
+  const std::string bn("BatchNormalization");
+  pTable.push_back({ bn, "Mul", 0, 6, 6, broadcast,
+                     fuse(&TGFuseOptimizer::FuseBNMulV6) });
+  pTable.push_back({ bn, "Add", 0, 6, 6, broadcast,
+                     fuse(&TGFuseOptimizer::FuseBNAddV6) });
+  pTable.push_back({ bn, "Mul", 0, 7, kAnyOpset, tensor,
+                     fuse(&TGFuseOptimizer::FuseBNMulTensor) });
+  pTable.push_back({ bn, "Add", 0, 7, kAnyOpset, tensor,
+                     fuse(&TGFuseOptimizer::FuseBNAddTensor) });
+  pTable.push_back({ bn, "Mul", 0, 7, kAnyOpset, unsqueeze,
+                     fuse(&TGFuseOptimizer::FuseBNMul) });
+  pTable.push_back({ bn, "Add", 0, 7, kAnyOpset, unsqueeze,
+                     fuse(&TGFuseOptimizer::FuseBNAdd) });
+
+  // activations. Sum+Relu covers Conv+Sum+Relu as well.
+  for (const char *op : { "Conv", "Gemm", "Sum" })
+    pTable.push_back({ op, "Relu", 0, 0, kAnyOpset, nullptr,
+                       fuse(&TGFuseOptimizer::FuseRelu) });
+
+  // BN turns into Scale, which fuses into Conv.
+  pTable.push_back({ bn, "", 0, 0, kAnyOpset, nullptr,
+                     [this](xGraph *pGraph, xNode *pNode, xNode *pUser) {
+                       return FuseBN(pGraph, pNode);
+                     } });
+  pTable.push_back({ "Add", "", 0, 0, kAnyOpset,
+                     [this](xNode *pNode, xNode *pUser) {
+                       return isNeuronInputs(*m_pInitializers, pNode);
+                     },
+                     [this](xGraph *pGraph, xNode *pNode, xNode *pUser) {
+                       return AliasSumOperator(pGraph, pNode);
+                     } });
+  pTable.push_back({ "Conv", "Scale", 0, 0, kAnyOpset, nullptr,
+                     fuse(&TGFuseOptimizer::FuseConvScale) });
+}
+
+bool TGFuseOptimizer::MatchPattern(const FusePattern &pPattern, xNode *pNode,
+                                   xNode *&pUser)
+{
+  pUser = nullptr;
+  if (!match(pNode, mSymbol(pPattern.producer)))
+    return false;
+
+  if (!pPattern.user.empty()) {
+    // the output of the producer has a single use, so the fused node
+    // doesn't have to keep it.
+    if (1 != pNode->outputs().size())
+      return false;
+    const auto &uses = pNode->output()->uses();
+    if (1 != uses.size())
+      return false;
+    if (pPattern.operand != (int)uses[0].offset)
+      return false;
+    if (!match(uses[0].user, mSymbol(pPattern.user)))
+      return false;
+    pUser = uses[0].user;
   }
-  return false;
+  return !pPattern.check || pPattern.check(pNode, pUser);
 }
 
 bool TGFuseOptimizer::FuseOptimization(xGraph *pGraph,
                                        const int64_t &pOpsetVersion)
 {
-  bool is_changed = false, local_changed;
-  do {
-    local_changed = FuseNodes(pGraph, pOpsetVersion);
-    is_changed |= local_changed;
-  } while (local_changed);
+  m_pInitializers.reset(new InitializerIndex(*pGraph));
+
+  PatternTable patterns;
+  AddPatterns(patterns);
+  PatternTable table;
+  for (FusePattern &pattern : patterns) {
+    if (pattern.minOpset <= pOpsetVersion && pOpsetVersion <= pattern.maxOpset)
+      table.push_back(pattern);
+  }
+
+  // visit producers before their users.
+  std::deque<xNode *> worklist;
+  std::unordered_set<xNode *> queued;
+  auto push = [&](xNode *pNode) {
+    if (isOperator(pNode) && queued.insert(pNode).second)
+      worklist.push_back(pNode);
+  };
+  for (xNode *node : pGraph->nodes())
+    push(node);
+
+  bool is_changed = false;
+  while (!worklist.empty()) {
+    xNode *node = worklist.front();
+    worklist.pop_front();
+
+    // erased by a rewrite.
+    if (0 == queued.erase(node))
+      continue;
+
+    for (const FusePattern &pattern : table) {
+      xNode *user = nullptr;
+      if (!MatchPattern(pattern, node, user))
+        continue;
+
+      // a rewrite may erase the matched nodes and the inputs only the user
+      // reads.
+      std::vector<xNode *> matched = { node };
+      if (nullptr != user) {
+        matched.push_back(user);
+        for (xValue *value : user->inputs()) {
+          if (value->uses().size() == 1)
+            matched.push_back(value->node());
+        }
+      }
+
+      xNode *fused = pattern.rewrite(pGraph, node, user);
+      is_changed = true;
+      for (xNode *n : matched)
+        queued.erase(n);
+
+      // the fused node and its neighbors may match again.
+      push(fused);
+      for (xValue *value : fused->inputs())
+        push(value->node());
+      for (xValue *value : fused->outputs()) {
+        for (auto &use : value->uses())
+          push(use.user);
+      }
+      break;
+    }
+  }
   return is_changed;
 }
 
@@ -502,8 +541,9 @@ xNode *TGFuseOptimizer::FuseBN(xGraph *pGraph, xNode *pBNNode)
   }
 
   xValue *new_scalar_value =
-      pGraph->addInitializerAndInput(new_scale_tensor);
-  xValue *new_bias_value = pGraph->addInitializerAndInput(new_bias_tensor);
+      m_pInitializers->addInitializerAndInput(new_scale_tensor);
+  xValue *new_bias_value =
+      m_pInitializers->addInitializerAndInput(new_bias_tensor);
 
   // create Scale node
   xNode *scale_node = pGraph->create(xSymbol("Scale"));
@@ -519,7 +559,7 @@ xNode *TGFuseOptimizer::FuseBN(xGraph *pGraph, xNode *pBNNode)
     if (pBNNode->inputs()[i]->uses().size() == 1) {
       auto input = pBNNode->inputs()[i];
       pBNNode->removeInput(i);
-      pGraph->eraseInitializerAndInput(input);
+      m_pInitializers->eraseInitializerAndInput(input);
     }
   }
   pBNNode->destroy();
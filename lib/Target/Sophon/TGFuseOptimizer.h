@@ -13,14 +13,49 @@
 #ifndef TG_FUSE_OPTIMIZER_H
 #define TG_FUSE_OPTIMIZER_H
 #include <onnc/Config/ONNX.h>
+#include <onnc/IR/InitializerIndex.h>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace onnc {
 
 class Module;
 class TGBackend;
 
+/** \class TGFuseOptimizer
+ *  \brief fuses operators by a table of patterns.
+ *
+ *  A pattern is a producer and, optionally, the only user of its output.
+ *  The patterns match on the use-def edges of the graph. A worklist holds
+ *  the nodes to visit, and a rewrite puts the fused node and its neighbors
+ *  back, so chains like Conv+BN+Scale+Relu fuse step by step until nothing
+ *  matches.
+ */
 class TGFuseOptimizer
 {
+public:
+  struct FusePattern
+  {
+    typedef std::function<bool(xNode *pProducer, xNode *pUser)> CheckFn;
+
+    typedef std::function<xNode *(xGraph *pGraph, xNode *pProducer,
+                                  xNode *pUser)> RewriteFn;
+
+    std::string producer;
+    std::string user;   ///< empty if the pattern is a single node.
+    int operand;        ///< the input of the user reading the producer.
+    int64_t minOpset;
+    int64_t maxOpset;
+    CheckFn check;      ///< extra constraints. Always true if empty.
+    RewriteFn rewrite;  ///< returns the fused node.
+  };
+
+  typedef std::vector<FusePattern> PatternTable;
+
+  static constexpr int64_t kAnyOpset = std::numeric_limits<int64_t>::max();
 
 public:
   TGFuseOptimizer(TGBackend *pBackend) : m_pBackend(pBackend) {}
@@ -34,8 +69,9 @@ public:
   static xNode *Fuse(xNode *pA, xNode *pB);
 
 protected:
-  bool FuseOpset6Nodes(xGraph *pGraph, xNode *pNode);
-  bool FuseOpset7Nodes(xGraph *pGraph, xNode *pNode);
+  /// Append the patterns of the target to @ref pTable. The patterns of a
+  /// node are tried in the order of the table.
+  virtual void AddPatterns(PatternTable &pTable);
 
   virtual xNode *FuseConvScale(xGraph *pGraph, xNode *pConvNode,
                                xNode *pScaleNode);
@@ -60,10 +96,17 @@ protected:
   virtual xNode *AliasSumOperator(xGraph *pGraph, xNode *pAddNode);
 
 private:
-  bool FuseNodes(xGraph *pGraph, const int64_t &pOpsetVersion);
+  /// @retval true @ref pNode is the producer of @ref pPattern. The only user
+  ///              of the pattern is returned in @ref pUser.
+  static bool MatchPattern(const FusePattern &pPattern, xNode *pNode,
+                           xNode *&pUser);
 
 protected:
   TGBackend *m_pBackend; // NOLINT
+
+  /// initializers of the graph being fused. Rewrites add and erase
+  /// initializers through it.
+  std::unique_ptr<InitializerIndex> m_pInitializers;
 };
 
 } // namespace onnc
@@ -13,6 +13,10 @@
 #ifndef BMKERNEL_API_BASH_H
 #define BMKERNEL_API_BASH_H
 
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <google/protobuf/text_format.h>
+#include <memory>
 #include <ostream>
 #include <string>
 
@@ -28,20 +32,59 @@ using u64 = uint64_t;
 
 const gaddr_t GADDR_INVALID = 0x000000FFFFFFFFFFULL;
 
+// Every thread has its own context, so modules can be compiled in parallel
+// as long as each one is compiled by one thread.
+//
+// Instructions go to a binary stream, a serialized CommandBuffer, and to a
+// text stream for debugging. Neither stream is flushed per instruction.
 class asm_context
 {
 private:
   std::ostream *fp{ nullptr };
-  asm_context() = default;
+  std::unique_ptr<google::protobuf::io::OstreamOutputStream> bin_stream;
+  std::unique_ptr<google::protobuf::io::CodedOutputStream> bin_fp;
+  google::protobuf::TextFormat::Printer printer;
+  std::string text;
+  asm_context() { printer.SetInitialIndentLevel(1); }
+
+  // CommandBuffer.inst is field 1 and length-delimited, so the records of
+  // the instructions make up a CommandBuffer.
+  static const uint32_t inst_tag = (1 << 3) | 2;
 
 public:
   std::string name;
-  bool on() { return fp != nullptr; }
+  bool on() { return fp != nullptr || bin_fp != nullptr; }
   std::ostream &get_fp() { return *fp; }
   void set_fp(std::ostream &fp_in) { fp = &fp_in; }
+  void set_binary_fp(std::ostream &fp_in)
+  {
+    bin_fp.reset();
+    bin_stream.reset(new google::protobuf::io::OstreamOutputStream(&fp_in));
+    bin_fp.reset(new google::protobuf::io::CodedOutputStream(bin_stream.get()));
+  }
+  // flushes the binary stream.
+  void reset_fp()
+  {
+    fp = nullptr;
+    bin_fp.reset();
+    bin_stream.reset();
+  }
+  void emit(const google::protobuf::Message &inst)
+  {
+    if (bin_fp != nullptr) {
+      bin_fp->WriteTag(inst_tag);
+      bin_fp->WriteVarint32(inst.ByteSizeLong());
+      inst.SerializeWithCachedSizes(bin_fp.get());
+    }
+    if (fp != nullptr) {
+      // the same text as the DebugString of a CommandBuffer of inst.
+      printer.PrintToString(inst, &text);
+      *fp << "inst {\n" << text << "}\n\n";
+    }
+  }
   static asm_context &get_context()
   {
-    static asm_context actx;
+    static thread_local asm_context actx;
     return actx;
   };
 };
@@ -22,6 +22,14 @@ namespace bmnet {
 namespace bmnet_asm {
 using ActivationMethod = bmnet::bm1880::Inst::ActivationMethod;
 
+// Every call refills the same instruction, so emitting doesn't allocate.
+inline bmnet::bm1880::Inst *get_inst()
+{
+    static thread_local bmnet::bm1880::Inst inst;
+    inst.Clear();
+    return &inst;
+}
+
 // clang-format off
 inline void bmnet_pooling_fixed_forward_bmkernel(
     gaddr_t ifmap_gaddr,
@@ -50,8 +58,7 @@ inline void bmnet_pooling_fixed_forward_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -81,7 +88,7 @@ inline void bmnet_pooling_fixed_forward_bmkernel(
         for (size_t i = 0; i < (size_t)1; i++)
             pooling->add_threshold_x_quantized(threshold_x_quantized[i]);
         pooling->set_ceil_mode(ceil_mode);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_conv_fixed_forward_bmkernel(
@@ -131,8 +138,7 @@ inline void bmnet_conv_fixed_forward_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -182,7 +188,7 @@ inline void bmnet_conv_fixed_forward_bmkernel(
         conv->set_bn_right_shift_width(bn_right_shift_width);
         conv->set_scalar_right_shift_width(scalar_right_shift_width);
         conv->set_use_winograd(use_winograd);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_conv_parallel_fixed_forward_bmkernel(
@@ -232,8 +238,7 @@ inline void bmnet_conv_parallel_fixed_forward_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -283,7 +288,7 @@ inline void bmnet_conv_parallel_fixed_forward_bmkernel(
         conv_p->set_bn_right_shift_width(bn_right_shift_width);
         conv_p->set_scale_right_shift_width(scale_right_shift_width);
         conv_p->set_use_winograd(use_winograd);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_fc_fixed_forward_bmkernel(
@@ -310,8 +315,7 @@ inline void bmnet_fc_fixed_forward_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -337,7 +341,7 @@ inline void bmnet_fc_fixed_forward_bmkernel(
         fc->set_weight_transpose(weight_transpose);
         fc->set_left_shift_width(left_shift_width);
         fc->set_right_shift_width(right_shift_width);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_relu_fixed_forward_bmkernel(
@@ -352,8 +356,7 @@ inline void bmnet_relu_fixed_forward_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -367,7 +370,7 @@ inline void bmnet_relu_fixed_forward_bmkernel(
         relu->set_input_c(input_c);
         relu->set_input_h(input_h);
         relu->set_input_w(input_w);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_leakyrelu_fixed_forward_bmkernel(
@@ -385,8 +388,7 @@ inline void bmnet_leakyrelu_fixed_forward_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -403,7 +405,7 @@ inline void bmnet_leakyrelu_fixed_forward_bmkernel(
         leakyrelu->set_le_right_shift_width(LE_right_shift_width);
         leakyrelu->set_gt_scale(GT_scale);
         leakyrelu->set_le_scale(LE_scale);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_prelu_fixed_forward_bmkernel(
@@ -423,8 +425,7 @@ inline void bmnet_prelu_fixed_forward_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -443,7 +444,7 @@ inline void bmnet_prelu_fixed_forward_bmkernel(
         prelu->set_gt_scale(GT_scale);
         prelu->set_gt_right_shift_width(GT_right_shift_width);
         prelu->set_le_right_shift_width(LE_right_shift_width);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_batchnorm_fixed_forward_inference_bmkernel(
@@ -460,8 +461,7 @@ inline void bmnet_batchnorm_fixed_forward_inference_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -477,7 +477,7 @@ inline void bmnet_batchnorm_fixed_forward_inference_bmkernel(
         batchnorm->set_input_h(input_h);
         batchnorm->set_input_w(input_w);
         batchnorm->set_right_shift_width(right_shift_width);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_scale_fixed_forward_bmkernel(
@@ -496,8 +496,7 @@ inline void bmnet_scale_fixed_forward_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -515,7 +514,7 @@ inline void bmnet_scale_fixed_forward_bmkernel(
         scale->set_scale_dim(scale_dim);
         scale->set_inner_dim(inner_dim);
         scale->set_right_shift_width(right_shift_width);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_reshape_fixed_forward_bmkernel(
@@ -527,8 +526,7 @@ inline void bmnet_reshape_fixed_forward_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -540,7 +538,7 @@ inline void bmnet_reshape_fixed_forward_bmkernel(
         reshape->set_output_dim_len(output_dim_len);
         for (size_t i = 0; i < (size_t)output_dim_len; i++)
             reshape->add_output_dim(output_dim[i]);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_split_fixed_forward_bmkernel(
@@ -555,8 +553,7 @@ inline void bmnet_split_fixed_forward_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -571,7 +568,7 @@ inline void bmnet_split_fixed_forward_bmkernel(
         split->set_input_c(input_c);
         split->set_input_h(input_h);
         split->set_input_w(input_w);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_concat_fixed_forward_bmkernel(
@@ -589,8 +586,7 @@ inline void bmnet_concat_fixed_forward_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -612,7 +608,7 @@ inline void bmnet_concat_fixed_forward_bmkernel(
             concat->add_right_shift_width(right_shift_width[i]);
         for (size_t i = 0; i < (size_t)need_quantize_num; i++)
             concat->add_threshold_x_quantized(threshold_x_quantized[i]);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_eltwise_fixed_forward_bmkernel(
@@ -632,8 +628,7 @@ inline void bmnet_eltwise_fixed_forward_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -654,7 +649,7 @@ inline void bmnet_eltwise_fixed_forward_bmkernel(
         eltwise->set_right_shift_width(right_shift_width);
         for (size_t i = 0; i < (size_t)input_size; i++)
             eltwise->add_threshold_x_quantized(threshold_x_quantized[i]);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_permute_fixed_forward_bmkernel(
@@ -677,8 +672,7 @@ inline void bmnet_permute_fixed_forward_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -700,7 +694,7 @@ inline void bmnet_permute_fixed_forward_bmkernel(
         permute->set_order_h(order_h);
         permute->set_order_w(order_w);
         permute->set_need_permute(need_permute);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_priorbox_fixed_forward_bmkernel(
@@ -713,8 +707,7 @@ inline void bmnet_priorbox_fixed_forward_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -726,7 +719,7 @@ inline void bmnet_priorbox_fixed_forward_bmkernel(
         priorbox->set_output_c(output_c);
         priorbox->set_output_h(output_h);
         priorbox->set_output_w(output_w);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_lrn_fixed_forward_bmkernel(
@@ -746,8 +739,7 @@ inline void bmnet_lrn_fixed_forward_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -767,7 +759,7 @@ inline void bmnet_lrn_fixed_forward_bmkernel(
         lrn->set_lrn_right_shift_width(lrn_right_shift_width);
         for (size_t i = 0; i < (size_t)2; i++)
             lrn->add_threshold_x_quantized(threshold_x_quantized[i]);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_upsample_fixed_bmkernel(
@@ -782,8 +774,7 @@ inline void bmnet_upsample_fixed_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -797,7 +788,7 @@ inline void bmnet_upsample_fixed_bmkernel(
         upsample->set_input_h(input_h);
         upsample->set_input_w(input_w);
         upsample->set_size(size);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_normalize_fixed_forward_bmkernel(
@@ -822,8 +813,7 @@ inline void bmnet_normalize_fixed_forward_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -849,7 +839,7 @@ inline void bmnet_normalize_fixed_forward_bmkernel(
         normalize->set_scale_right_shift_width(scale_right_shift_width);
         for (size_t i = 0; i < (size_t)2; i++)
             normalize->add_threshold_x_quantized(threshold_x_quantized[i]);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_tl_conv_forward_bmkernel(
@@ -887,8 +877,7 @@ inline void bmnet_tl_conv_forward_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -927,7 +916,7 @@ inline void bmnet_tl_conv_forward_bmkernel(
         bm_tl_conv->set_do_bias(do_bias);
         bm_tl_conv->set_use_winograd(use_winograd);
         bm_tl_conv->set_do_relu(do_relu);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_tl_activation_forward_bmkernel(
@@ -952,8 +941,7 @@ inline void bmnet_tl_activation_forward_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -978,7 +966,7 @@ inline void bmnet_tl_activation_forward_bmkernel(
             tl_activation->add_activation_arg(activation_arg[i]);
         tl_activation->set_channel_shared(channel_shared);
         tl_activation->set_activation_type((bmnet::bm1880::Inst::ActivationMethod)activation_type);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_tl_scale_forward_bmkernel(
@@ -999,8 +987,7 @@ inline void bmnet_tl_scale_forward_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -1020,7 +1007,7 @@ inline void bmnet_tl_scale_forward_bmkernel(
         tl_csale->set_do_bias(do_bias);
         tl_csale->set_do_relu(do_relu);
         tl_csale->set_relu_slope(relu_slope);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_tl_batchnorm_forward_bmkernel(
@@ -1038,8 +1025,7 @@ inline void bmnet_tl_batchnorm_forward_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -1056,7 +1042,7 @@ inline void bmnet_tl_batchnorm_forward_bmkernel(
         tl_bn->set_input_w(input_w);
         tl_bn->set_right_shift_width(right_shift_width);
         tl_bn->set_do_relu(do_relu);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_tl_eltwise_forward_bmkernel(
@@ -1078,8 +1064,7 @@ inline void bmnet_tl_eltwise_forward_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -1102,7 +1087,7 @@ inline void bmnet_tl_eltwise_forward_bmkernel(
         tl_eltwise->set_use_default_coeff(use_default_coeff);
         tl_eltwise->set_do_relu(do_relu);
         tl_eltwise->set_relu_slope(relu_slope);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_tl_lrn_forward_bmkernel(
@@ -1123,8 +1108,7 @@ inline void bmnet_tl_lrn_forward_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -1145,7 +1129,7 @@ inline void bmnet_tl_lrn_forward_bmkernel(
         tl_lrn->set_lrn_right_shift_width(lrn_right_shift_width);
         for (size_t i = 0; i < (size_t)2; i++)
             tl_lrn->add_threshold_x_quantized(threshold_x_quantized[i]);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_tl_pooling_forward_bmkernel(
@@ -1174,8 +1158,7 @@ inline void bmnet_tl_pooling_forward_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -1203,7 +1186,7 @@ inline void bmnet_tl_pooling_forward_bmkernel(
         tl_pool->set_is_avg_pooling(is_avg_pooling);
         tl_pool->set_right_shift_width(right_shift_width);
         tl_pool->set_threshold_x_quantized(threshold_x_quantized);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_tl_upsample_forward_bmkernel(
@@ -1220,8 +1203,7 @@ inline void bmnet_tl_upsample_forward_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -1237,7 +1219,7 @@ inline void bmnet_tl_upsample_forward_bmkernel(
         tl_upsample->set_output_h(output_h);
         tl_upsample->set_output_w(output_w);
         tl_upsample->set_size(size);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_tl_load_stride_bmkernel(
@@ -1257,8 +1239,7 @@ inline void bmnet_tl_load_stride_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -1277,7 +1258,7 @@ inline void bmnet_tl_load_stride_bmkernel(
         tl_layer_load_stride->set_dotranspose(DoTranspose);
         tl_layer_load_stride->set_doaligned(DoAligned);
         tl_layer_load_stride->set_isneuron(isNeuron);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_tl_load_bmkernel(
@@ -1297,8 +1278,7 @@ inline void bmnet_tl_load_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -1317,7 +1297,7 @@ inline void bmnet_tl_load_bmkernel(
         tl_layer_load->set_dotranspose(DoTranspose);
         tl_layer_load->set_doaligned(DoAligned);
         tl_layer_load->set_isneuron(isNeuron);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_tl_store_stride_bmkernel(
@@ -1337,8 +1317,7 @@ inline void bmnet_tl_store_stride_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -1357,7 +1336,7 @@ inline void bmnet_tl_store_stride_bmkernel(
         tl_layer_store_stride->set_dotranspose(DoTranspose);
         tl_layer_store_stride->set_doaligned(DoAligned);
         tl_layer_store_stride->set_isneuron(isNeuron);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 inline void bmnet_tl_store_bmkernel(
@@ -1377,8 +1356,7 @@ inline void bmnet_tl_store_bmkernel(
     // gen asm
     if (asm_context::get_context().on())
     {
-        bmnet::bm1880::CommandBuffer buf;
-        auto *inst = buf.add_inst();
+        auto *inst = get_inst();
         auto &name = asm_context::get_context().name;
         if (not name.empty())
             inst->set_name(name);
@@ -1397,11 +1375,28 @@ inline void bmnet_tl_store_bmkernel(
         tl_layer_store->set_dotranspose(DoTranspose);
         tl_layer_store->set_doaligned(DoAligned);
         tl_layer_store->set_isneuron(isNeuron);
-        asm_context::get_context().get_fp() << buf.DebugString() << std::endl;
+        asm_context::get_context().emit(*inst);
     }
 }
 // clang-format on
 
+// Not a bmkernel API, so it isn't generated. The engines run in parallel
+// from tl_parallel(true) until tl_parallel(false).
+inline void bmnet_tl_parallel_bmkernel(bool enable)
+{
+    if (asm_context::get_context().on())
+    {
+        auto *inst = get_inst();
+        auto &name = asm_context::get_context().name;
+        if (not name.empty())
+            inst->set_name(name);
+        name.clear();
+        inst->set_type("bmnet_tl_parallel_bmkernel");
+        inst->mutable_tl_parallel()->set_enable(enable);
+        asm_context::get_context().emit(*inst);
+    }
+}
+
 } // namespace bmnet_asm
 } // namespace bmnet
 #endif /* BM188X_BMKERNEL_API_H */
@@ -14,14 +14,18 @@ using namespace onnc;
 //===----------------------------------------------------------------------===//
 TargetOptions::TargetOptions()
   : m_PrintModuleBeforeSel(false), m_IgnoreCalibrationStep(false),
-    m_AddDummyCTable(false), m_AddDummyWeight(false) {
+    m_AddDummyCTable(false), m_AddDummyWeight(false),
+    m_PrintTextAsm(false), m_PipelineTiles(true), m_NumOfThreads(0) {
 }
 
 TargetOptions::TargetOptions(const TargetOptions& pCopy)
   : m_PrintModuleBeforeSel(pCopy.shouldPrintBeforeTensorSel()),
     m_IgnoreCalibrationStep(pCopy.shouldIgnoreCalibrationStep()),
     m_AddDummyCTable(pCopy.shouldUseDummyCTable()),
-    m_AddDummyWeight(pCopy.shouldUseDummyWeight()) {
+    m_AddDummyWeight(pCopy.shouldUseDummyWeight()),
+    m_PrintTextAsm(pCopy.shouldPrintTextAsm()),
+    m_PipelineTiles(pCopy.shouldPipelineTiles()),
+    m_NumOfThreads(pCopy.getNumOfThreads()) {
 }
 
 TargetOptions& TargetOptions::operator=(const TargetOptions& pCopy)
@@ -30,5 +34,8 @@ TargetOptions& TargetOptions::operator=(const TargetOptions& pCopy)
   m_IgnoreCalibrationStep = pCopy.shouldIgnoreCalibrationStep();
   m_AddDummyCTable = pCopy.shouldUseDummyCTable();
   m_AddDummyWeight = pCopy.shouldUseDummyWeight();
+  m_PrintTextAsm = pCopy.shouldPrintTextAsm();
+  m_PipelineTiles = pCopy.shouldPipelineTiles();
+  m_NumOfThreads = pCopy.getNumOfThreads();
   return *this;
 }
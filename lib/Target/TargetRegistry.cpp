@@ -10,11 +10,15 @@
 #include <onnc/IR/Quadruple.h>
 #include <onnc/ADT/Rope.h>
 #include <algorithm>
+#include <mutex>
 
 using namespace onnc;
 
 static onnc::ManagedStatic<onnc::TargetRegistry::TargetList> s_TargetList;
 
+/// Guards s_TargetList and the registered targets.
+static onnc::ManagedStatic<std::mutex> s_TargetListMutex;
+
 //===----------------------------------------------------------------------===//
 // onnc::TargetRegistry
 //===----------------------------------------------------------------------===//
@@ -30,11 +34,13 @@ onnc::TargetRegistry::iterator TargetRegistry::End()
 
 size_t onnc::TargetRegistry::Size()
 {
+  std::lock_guard<std::mutex> guard(*s_TargetListMutex);
   return s_TargetList->size();
 }
 
 bool onnc::TargetRegistry::IsEmpty()
 {
+  std::lock_guard<std::mutex> guard(*s_TargetListMutex);
   return s_TargetList->empty();
 }
 
@@ -43,6 +49,7 @@ void onnc::TargetRegistry::RegisterTarget(Target& pTarget,
                                     const char* pShortDesc,
                                     Target::QuadrupleMatchFnTy pArchMatchFn)
 {
+  std::lock_guard<std::mutex> guard(*s_TargetListMutex);
   pTarget.m_Name = pName;
   pTarget.m_ShortDesc = pShortDesc;
   pTarget.m_ArchMatchFn = pArchMatchFn;
@@ -52,16 +59,19 @@ void onnc::TargetRegistry::RegisterTarget(Target& pTarget,
 const onnc::Target*
 onnc::TargetRegistry::Lookup(const std::string& pQuadruple, std::string& pError)
 {
+  std::lock_guard<std::mutex> guard(*s_TargetListMutex);
+
   // Provide special warning when no targets are initialized.
-  if (IsEmpty()) {
+  if (s_TargetList->empty()) {
     pError = "Unable to find target for this quadruple (no targets are registered)";
     return nullptr;
   }
 
   Quadruple input(pQuadruple);
   unsigned int candidateScore = 0;
-  onnc::TargetRegistry::iterator candidate = End();
-  for (auto cb = Begin(), ce = End(); cb != ce; ++cb) {
+  onnc::TargetRegistry::iterator candidate = s_TargetList->end();
+  auto cb = s_TargetList->begin(), ce = s_TargetList->end();
+  for (; cb != ce; ++cb) {
     auto curScore = (*cb)->matchArch(input);
     if (0 != curScore && curScore > candidateScore) {
       candidate = cb;
@@ -69,7 +79,7 @@ onnc::TargetRegistry::Lookup(const std::string& pQuadruple, std::string& pError)
     }
   }
 
-  if (End() == candidate) {
+  if (s_TargetList->end() == candidate) {
     pError = "No available targets are compatible with this quadruple.";
     return nullptr;
   }
@@ -0,0 +1,269 @@
+//===- InterpreterTest.cpp ------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <skypat/skypat.h>
+#include <onnc/Target/X86/X86Interpreter.h>
+#include <onnc/IR/Compute/Abs.h>
+#include <onnc/IR/Compute/Add.h>
+#include <onnc/IR/Compute/Initializer.h>
+#include <onnc/IR/Compute/InputOperator.h>
+#include <onnc/IR/Compute/OutputOperator.h>
+#include <onnc/IR/Compute/Relu.h>
+#include <onnc/IR/Compute/Sigmoid.h>
+#include <onnc/IR/Compute/Sum.h>
+#include <onnc/IR/ComputeMemOperand.h>
+#include <onnc/IR/Module.h>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace onnc;
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+namespace {
+
+const int kLength = 4;
+const uint32_t kBytes = kLength * sizeof(float);
+
+/// A compute graph of float vectors, placed by hand in the neuron space as
+/// the memory allocation pass does.
+class TestGraph
+{
+public:
+  TestGraph() : m_Module(), m_pCG(m_Module.createComputeGraph("main")) { }
+
+  FloatTensor* input(const std::string& pName) {
+    InputOperator* op = m_pCG->addOperator<InputOperator>();
+    FloatTensor* value = tensor(pName, *op);
+    op->addOutput(*value);
+    return value;
+  }
+
+  FloatTensor* initializer(const std::string& pName, const float* pData) {
+    Initializer* op = m_pCG->addOperator<Initializer>();
+    FloatTensor* value = tensor(pName, *op);
+    value->getValues().assign(pData, pData + kLength);
+    op->addOutput(*value);
+    return value;
+  }
+
+  /// Add an operator computing @ref pName from @ref pInputs.
+  template<typename OpType>
+  FloatTensor* add(const std::string& pName,
+                   const std::vector<FloatTensor*>& pInputs) {
+    OpType* op = m_pCG->addOperator<OpType>();
+    for (FloatTensor* input : pInputs)
+      op->addInput(*input);
+    FloatTensor* value = tensor(pName, *op);
+    op->addOutput(*value);
+    return value;
+  }
+
+  void output(FloatTensor& pValue) {
+    m_pCG->addOperator<OutputOperator>()->addInput(pValue);
+  }
+
+  /// Place @ref pValue at @ref pStart of the neuron or the weight space on
+  /// all its uses.
+  void place(FloatTensor& pValue, uint32_t pStart,
+             ComputeOperand::Residence pResidence =
+                 ComputeOperand::kInternalResidence) {
+    ComputeOperator* define = m_Defines[&pValue];
+    for (onnc::Use& use : pValue.getUses()) {
+      ComputeMemOperand* opnd = m_pCG->addOperand<ComputeMemOperand>(
+          *define, *use.getUser(), pValue, pResidence);
+      opnd->setStart(pStart);
+      opnd->setLength(kBytes);
+    }
+  }
+
+  ComputeGraph& graph() { return *m_pCG; }
+
+private:
+  FloatTensor* tensor(const std::string& pName, ComputeOperator& pDefine) {
+    FloatTensor* value = m_pCG->addValue<FloatTensor>(pName);
+    value->setDimensions({ 1, kLength });
+    m_Defines[value] = &pDefine;
+    return value;
+  }
+
+private:
+  onnc::Module m_Module;
+  ComputeGraph* m_pCG;
+  std::unordered_map<const onnc::Value*, ComputeOperator*> m_Defines;
+};
+
+/// @return the index of the step writing @ref pValue in the plan.
+unsigned int StepOf(const X86Interpreter& pInterp, const onnc::Value& pValue)
+{
+  const X86Interpreter::Plan& plan = pInterp.plan();
+  for (unsigned int i = 0; i < plan.size(); ++i)
+    if (plan[i].op->getOutput(0) == &pValue)
+      return i;
+  return plan.size();
+}
+
+bool Waits(const X86Interpreter& pInterp, unsigned int pLater,
+           unsigned int pEarlier)
+{
+  const std::vector<unsigned int>& succ = pInterp.plan()[pEarlier].successors;
+  return succ.end() != std::find(succ.begin(), succ.end(), pLater);
+}
+
+void Write(X86Interpreter& pInterp, const onnc::Value& pValue,
+           const float* pData)
+{
+  float* memory = static_cast<float*>(pInterp.getMemory(pValue));
+  std::copy(pData, pData + kLength, memory);
+}
+
+std::vector<float> Read(X86Interpreter& pInterp, const onnc::Value& pValue)
+{
+  const float* memory = static_cast<float*>(pInterp.getMemory(pValue));
+  return std::vector<float>(memory, memory + kLength);
+}
+
+} // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// X86InterpreterTest
+//===----------------------------------------------------------------------===//
+SKYPAT_F(X86InterpreterTest, run_graph)
+{
+  // y = relu(x) + w
+  const float weight[kLength] = { 1, 2, 3, 4 };
+  TestGraph graph;
+  FloatTensor* x = graph.input("x");
+  FloatTensor* w = graph.initializer("w", weight);
+  FloatTensor* r = graph.add<Relu>("r", { x });
+  FloatTensor* y = graph.add<Add>("y", { r, w });
+  graph.output(*y);
+  graph.place(*x, 0);
+  graph.place(*w, 0, ComputeOperand::kWeightResidence);
+  graph.place(*r, kBytes);
+  graph.place(*y, 2 * kBytes);
+
+  X86Interpreter interp;
+  ASSERT_TRUE(interp.prepare(graph.graph()));
+  EXPECT_EQ(interp.plan().size(), 2);
+  EXPECT_EQ(interp.getWeightMemSize(), kBytes);
+  EXPECT_EQ(interp.getNeuronMemSize(), 3 * kBytes);
+  ASSERT_EQ(interp.inputs().size(), 1);
+  ASSERT_EQ(interp.outputs().size(), 1);
+  EXPECT_TRUE(x == interp.inputs()[0]);
+  EXPECT_TRUE(y == interp.outputs()[0]);
+
+  // the graph runs again on new inputs.
+  const float data[2][kLength] = { { -1, 2, -3, 4 }, { 5, -6, 7, -8 } };
+  const std::vector<float> expected[2] = { { 1, 4, 3, 8 }, { 6, 2, 10, 4 } };
+  for (int run = 0; run < 2; ++run) {
+    Write(interp, *x, data[run]);
+    interp.run();
+    EXPECT_TRUE(expected[run] == Read(interp, *y));
+  }
+}
+
+SKYPAT_F(X86InterpreterTest, missing_kernel)
+{
+  TestGraph graph;
+  FloatTensor* x = graph.input("x");
+  FloatTensor* y = graph.add<Abs>("y", { x });
+  graph.output(*y);
+  graph.place(*x, 0);
+  graph.place(*y, kBytes);
+
+  X86Interpreter interp;
+  EXPECT_FALSE(interp.prepare(graph.graph()));
+}
+
+SKYPAT_F(X86InterpreterTest, plan_follows_region_reuse)
+{
+  // a = relu(x), b = relu(a), c = relu(x) reusing the region of a, and
+  // d = relu(x) in a region of its own.
+  TestGraph graph;
+  FloatTensor* x = graph.input("x");
+  FloatTensor* a = graph.add<Relu>("a", { x });
+  FloatTensor* b = graph.add<Relu>("b", { a });
+  FloatTensor* c = graph.add<Relu>("c", { x });
+  FloatTensor* d = graph.add<Relu>("d", { x });
+  graph.output(*b);
+  graph.output(*c);
+  graph.output(*d);
+  graph.place(*x, 0);
+  graph.place(*a, kBytes);
+  graph.place(*b, 2 * kBytes);
+  graph.place(*c, kBytes);
+  graph.place(*d, 3 * kBytes);
+
+  X86Interpreter interp;
+  ASSERT_TRUE(interp.prepare(graph.graph()));
+  ASSERT_EQ(interp.plan().size(), 4);
+
+  const X86Interpreter::Plan& plan = interp.plan();
+  unsigned int sa = StepOf(interp, *a), sb = StepOf(interp, *b),
+               sc = StepOf(interp, *c), sd = StepOf(interp, *d);
+  EXPECT_EQ(plan[sa].degree, 0);
+  EXPECT_EQ(plan[sd].degree, 0);
+
+  // b reads a, and c overwrites a only after b read it.
+  EXPECT_EQ(plan[sb].degree, 1);
+  EXPECT_TRUE(Waits(interp, sb, sa));
+  EXPECT_TRUE(Waits(interp, sc, sb));
+  EXPECT_TRUE(plan[sd].successors.empty());
+}
+
+SKYPAT_F(X86InterpreterTest, threads_match_serial_run)
+{
+  // y = the sum of relu(sigmoid(x)) over independent branches.
+  const int kBranches = 8;
+  TestGraph graph;
+  FloatTensor* x = graph.input("x");
+  graph.place(*x, 0);
+  std::vector<FloatTensor*> values, branches;
+  for (int k = 0; k < kBranches; ++k) {
+    std::string name = std::to_string(k);
+    values.push_back(graph.add<Sigmoid>("h" + name, { x }));
+    branches.push_back(graph.add<Relu>("r" + name, { values.back() }));
+    values.push_back(branches.back());
+  }
+  values.push_back(graph.add<Sum>("y", branches));
+  FloatTensor* y = values.back();
+  graph.output(*y);
+
+  uint32_t start = kBytes;
+  for (FloatTensor* value : values) {
+    graph.place(*value, start);
+    start += kBytes;
+  }
+
+  X86Interpreter serial, parallel;
+  ASSERT_TRUE(serial.prepare(graph.graph()));
+  ASSERT_TRUE(parallel.prepare(graph.graph()));
+  parallel.setNumOfThreads(4);
+  ASSERT_EQ(parallel.getNumOfThreads(), 4);
+
+  // run often to let the workers sleep and wake up between the steps.
+  for (int run = 0; run < 100; ++run) {
+    const float data[kLength] = { -2.f + run, -0.5f, 0.f, 1.5f * run };
+    Write(serial, *x, data);
+    Write(parallel, *x, data);
+    std::vector<uint64_t> times;
+    serial.run();
+    parallel.run(&times);
+    ASSERT_EQ(times.size(), parallel.plan().size());
+
+    std::vector<float> expected = Read(serial, *y);
+    for (int i = 0; i < kLength; ++i)
+      EXPECT_TRUE(std::fabs(kBranches / (1.f + std::exp(-data[i])) -
+                            expected[i]) < 1e-4f);
+    EXPECT_TRUE(expected == Read(parallel, *y));
+  }
+}
@@ -0,0 +1,244 @@
+//===- KernelsTest.cpp ----------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <skypat/skypat.h>
+#include "../X86Kernels.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace onnc;
+using namespace onnc::x86;
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+namespace {
+
+typedef std::vector<float> Floats;
+
+bool Near(const Floats& pActual, const Floats& pExpected)
+{
+  if (pActual.size() != pExpected.size())
+    return false;
+  for (size_t i = 0; i < pActual.size(); ++i) {
+    float tolerance = 1e-4f * (1.f + std::fabs(pExpected[i]));
+    if (std::fabs(pActual[i] - pExpected[i]) > tolerance)
+      return false;
+  }
+  return true;
+}
+
+/// The instruction sets the host supports, so every kernel is checked on
+/// each of its paths.
+std::vector<KernelISA> SupportedISAs()
+{
+  std::vector<KernelISA> result;
+  const KernelISA isas[] = { kScalar, kAVX2, kAVX512 };
+  for (KernelISA isa : isas)
+    if (isa == SetKernelISA(isa))
+      result.push_back(isa);
+  return result;
+}
+
+/// Values 0.5 * (i % 7) - 1 large enough to fill the vector paths and
+/// their tails.
+Floats Ramp(size_t pSize)
+{
+  Floats result(pSize);
+  for (size_t i = 0; i < pSize; ++i)
+    result[i] = 0.5f * (i % 7) - 1.f;
+  return result;
+}
+
+} // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// X86KernelsTest
+//===----------------------------------------------------------------------===//
+SKYPAT_F(X86KernelsTest, gemm)
+{
+  // A = [[1, 2, 3], [4, 5, 6]], B = [[1, 0], [0, 1], [1, 1]]
+  const Floats a = { 1, 2, 3, 4, 5, 6 };
+  const Floats b = { 1, 0, 0, 1, 1, 1 };
+  const Floats at = { 1, 4, 2, 5, 3, 6 };
+  const Floats bt = { 1, 0, 1, 0, 1, 1 };
+  for (KernelISA isa : SupportedISAs()) {
+    SetKernelISA(isa);
+    Floats c(4, 0.f);
+    Gemm(false, false, 2, 2, 3, 1.f, a.data(), b.data(), 0.f, c.data());
+    EXPECT_TRUE(Near(c, { 4, 5, 10, 11 }));
+
+    Floats ct = { 1, 1, 1, 1 };
+    Gemm(true, true, 2, 2, 3, 2.f, at.data(), bt.data(), 0.5f, ct.data());
+    EXPECT_TRUE(Near(ct, { 8.5f, 10.5f, 20.5f, 22.5f }));
+  }
+}
+
+SKYPAT_F(X86KernelsTest, gemm_large)
+{
+  // a size with tails on every vector width against a naive product.
+  const int m = 5, n = 37, k = 19;
+  const Floats a = Ramp(m * k), b = Ramp(k * n);
+  Floats expected(m * n, 0.f);
+  for (int i = 0; i < m; ++i)
+    for (int j = 0; j < n; ++j)
+      for (int l = 0; l < k; ++l)
+        expected[i * n + j] += a[i * k + l] * b[l * n + j];
+
+  for (KernelISA isa : SupportedISAs()) {
+    SetKernelISA(isa);
+    Floats c(m * n, 0.f);
+    Gemm(false, false, m, n, k, 1.f, a.data(), b.data(), 0.f, c.data());
+    EXPECT_TRUE(Near(c, expected));
+  }
+}
+
+SKYPAT_F(X86KernelsTest, conv2d)
+{
+  // X = 1x1x3x3 of 1..9, W = 1x1x2x2 of ones, B = 1, pad 1, stride 2.
+  const Floats x = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+  const Floats w = { 1, 1, 1, 1 };
+  const float bias = 1.f;
+  ConvParam param = { 1, 1, 3, 3, 1, 2, 2, 2, 2, 1, 1, 2, 2, 1, 1, 1 };
+  for (KernelISA isa : SupportedISAs()) {
+    SetKernelISA(isa);
+    Floats y(4, 0.f);
+    Conv2D(param, x.data(), w.data(), &bias, y.data());
+    EXPECT_TRUE(Near(y, { 2, 6, 12, 29 }));
+  }
+}
+
+SKYPAT_F(X86KernelsTest, conv2d_group_dilation)
+{
+  // two groups of a channel each, 2x2 kernel dilated by 2 over 3x3 inputs.
+  const Floats x = { 1, 2, 3, 4, 5, 6, 7, 8, 9,
+                     9, 8, 7, 6, 5, 4, 3, 2, 1 };
+  const Floats w = { 1, 0, 0, 1,
+                     0, 1, 1, 0 };
+  ConvParam param = { 1, 2, 3, 3, 2, 2, 2, 1, 1, 0, 0, 1, 1, 2, 2, 2 };
+  for (KernelISA isa : SupportedISAs()) {
+    SetKernelISA(isa);
+    Floats y(2, 0.f);
+    Conv2D(param, x.data(), w.data(), nullptr, y.data());
+    EXPECT_TRUE(Near(y, { 1 + 9, 7 + 3 }));
+  }
+}
+
+SKYPAT_F(X86KernelsTest, pooling)
+{
+  // X = 1x1x3x3 of 1..9, 2x2 window, pad 1, stride 2.
+  const Floats x = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+  PoolParam param = { 1, 1, 3, 3, 2, 2, 2, 2, 1, 1, 2, 2, false };
+  for (KernelISA isa : SupportedISAs()) {
+    SetKernelISA(isa);
+    Floats y(4, 0.f);
+    MaxPool2D(param, x.data(), y.data());
+    EXPECT_TRUE(Near(y, { 1, 3, 7, 9 }));
+
+    AveragePool2D(param, x.data(), y.data());
+    EXPECT_TRUE(Near(y, { 1, 2.5f, 5.5f, 7 }));
+
+    param.countIncludePad = true;
+    AveragePool2D(param, x.data(), y.data());
+    EXPECT_TRUE(Near(y, { 0.25f, 1.25f, 2.75f, 7 }));
+    param.countIncludePad = false;
+
+    Floats g(1, 0.f);
+    GlobalMaxPool(1, 1, 9, x.data(), g.data());
+    EXPECT_TRUE(Near(g, { 9 }));
+    GlobalAveragePool(1, 1, 9, x.data(), g.data());
+    EXPECT_TRUE(Near(g, { 5 }));
+  }
+}
+
+SKYPAT_F(X86KernelsTest, batch_normalization)
+{
+  // y = scale * (x - mean) / sqrt(var + eps) + bias per channel.
+  const Floats x = { 1, 2, 3, 4 };
+  const Floats scale = { 2, 1 }, bias = { 0, 1 };
+  const Floats mean = { 1, 3 }, var = { 4, 1 };
+  for (KernelISA isa : SupportedISAs()) {
+    SetKernelISA(isa);
+    Floats y(4, 0.f);
+    BatchNormalization(1, 2, 2, 0.f, x.data(), scale.data(), bias.data(),
+                       mean.data(), var.data(), y.data());
+    EXPECT_TRUE(Near(y, { 0, 1, 1, 2 }));
+  }
+}
+
+SKYPAT_F(X86KernelsTest, activations)
+{
+  const Floats x = Ramp(35);
+  Floats relu(x.size()), leaky(x.size()), sigmoid(x.size()), tanh(x.size());
+  for (size_t i = 0; i < x.size(); ++i) {
+    relu[i] = std::max(x[i], 0.f);
+    leaky[i] = (x[i] < 0.f) ? 0.1f * x[i] : x[i];
+    sigmoid[i] = 1.f / (1.f + std::exp(-x[i]));
+    tanh[i] = std::tanh(x[i]);
+  }
+
+  for (KernelISA isa : SupportedISAs()) {
+    SetKernelISA(isa);
+    Floats y(x.size(), 0.f);
+    Relu(x.size(), x.data(), y.data());
+    EXPECT_TRUE(Near(y, relu));
+    LeakyRelu(x.size(), 0.1f, x.data(), y.data());
+    EXPECT_TRUE(Near(y, leaky));
+    Sigmoid(x.size(), x.data(), y.data());
+    EXPECT_TRUE(Near(y, sigmoid));
+    Tanh(x.size(), x.data(), y.data());
+    EXPECT_TRUE(Near(y, tanh));
+  }
+}
+
+SKYPAT_F(X86KernelsTest, softmax)
+{
+  const Floats x = { 0, 1, 2, 3, 3, 3 };
+  const float e = std::exp(1.f);
+  const float sum = 1.f + e + e * e;
+  for (KernelISA isa : SupportedISAs()) {
+    SetKernelISA(isa);
+    Floats y(6, 0.f);
+    Softmax(2, 3, x.data(), y.data());
+    EXPECT_TRUE(Near(y, { 1.f / sum, e / sum, e * e / sum,
+                          1.f / 3, 1.f / 3, 1.f / 3 }));
+  }
+}
+
+SKYPAT_F(X86KernelsTest, binary_broadcast)
+{
+  // [2, 3] op [3] and [2, 1] op [1, 3]
+  const Floats a = { 1, 2, 3, 4, 5, 6 };
+  const Floats row = { 10, 20, 30 };
+  const Floats col = { 1, 2 };
+  for (KernelISA isa : SupportedISAs()) {
+    SetKernelISA(isa);
+    Floats c(6, 0.f);
+    Binary(kAddOp, { 2, 3 }, a.data(), { 3 }, row.data(), { 2, 3 }, c.data());
+    EXPECT_TRUE(Near(c, { 11, 22, 33, 14, 25, 36 }));
+    Binary(kSubOp, { 2, 3 }, a.data(), { 3 }, row.data(), { 2, 3 }, c.data());
+    EXPECT_TRUE(Near(c, { -9, -18, -27, -6, -15, -24 }));
+    Binary(kMulOp, { 2, 1 }, col.data(), { 1, 3 }, row.data(), { 2, 3 },
+           c.data());
+    EXPECT_TRUE(Near(c, { 10, 20, 30, 20, 40, 60 }));
+    Binary(kMaxOp, { 2, 3 }, a.data(), { 2, 1 }, col.data(), { 2, 3 },
+           c.data());
+    EXPECT_TRUE(Near(c, { 1, 2, 3, 4, 5, 6 }));
+  }
+}
+
+SKYPAT_F(X86KernelsTest, concat)
+{
+  // [2, 1] and [2, 2] along axis 1.
+  const Floats a = { 1, 2 };
+  const Floats b = { 3, 4, 5, 6 };
+  Floats y(6, 0.f);
+  Concat(1, { { 2, 1 }, { 2, 2 } }, { a.data(), b.data() }, { 2, 3 },
+         y.data());
+  EXPECT_TRUE(Near(y, { 1, 3, 4, 2, 5, 6 }));
+}
@@ -6,11 +6,41 @@
 //
 //===----------------------------------------------------------------------===//
 #include "X86Backend.h"
+#include "X86CodeEmitPass.h"
+#include "X86MemAllocPass.h"
 #include "TargetInfo/X86TargetInfo.h"
 #include <onnc/Target/TargetRegistry.h>
+#include <onnc/Transforms/BookONNXGraphs.h>
+#include <onnc/Transforms/BuildInitializers.h>
+#include <onnc/Transforms/BuildInputOperators.h>
+#include <onnc/Transforms/BuildOutputOperators.h>
 #include <onnc/Transforms/RemoveTrainingNodes.h>
 #include <onnc/Analysis/UpdateGraphOutputSize.h>
 #include <onnc/Transforms/TensorSel.h>
+#include <onnc/Transforms/TensorSel/LowerRegistry.h>
+#include <onnc/Transforms/TensorSel/Standards/AddLower.h>
+#include <onnc/Transforms/TensorSel/Standards/AveragePoolLower.h>
+#include <onnc/Transforms/TensorSel/Standards/BatchNormalizationLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ConcatLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ConvLower.h>
+#include <onnc/Transforms/TensorSel/Standards/DropoutLower.h>
+#include <onnc/Transforms/TensorSel/Standards/FlattenLower.h>
+#include <onnc/Transforms/TensorSel/Standards/GemmLower.h>
+#include <onnc/Transforms/TensorSel/Standards/GlobalAveragePoolLower.h>
+#include <onnc/Transforms/TensorSel/Standards/GlobalMaxPoolLower.h>
+#include <onnc/Transforms/TensorSel/Standards/IdentityLower.h>
+#include <onnc/Transforms/TensorSel/Standards/LeakyReluLower.h>
+#include <onnc/Transforms/TensorSel/Standards/MatMulLower.h>
+#include <onnc/Transforms/TensorSel/Standards/MaxLower.h>
+#include <onnc/Transforms/TensorSel/Standards/MaxPoolLower.h>
+#include <onnc/Transforms/TensorSel/Standards/MulLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ReluLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ReshapeLower.h>
+#include <onnc/Transforms/TensorSel/Standards/SigmoidLower.h>
+#include <onnc/Transforms/TensorSel/Standards/SoftmaxLower.h>
+#include <onnc/Transforms/TensorSel/Standards/SubLower.h>
+#include <onnc/Transforms/TensorSel/Standards/SumLower.h>
+#include <onnc/Transforms/TensorSel/Standards/TanhLower.h>
 
 using namespace onnc;
 
@@ -18,7 +48,8 @@ using namespace onnc;
 // X86Backend
 //===----------------------------------------------------------------------===//
 X86Backend::X86Backend(const TargetOptions& pOptions)
-  : NPUTargetBackend(pOptions) {
+  : NPUTargetBackend(pOptions), m_ValMemOpndMap(),
+    m_WeightMemSize(0), m_NeuronMemSize(0) {
 }
 
 X86Backend::~X86Backend()
@@ -30,17 +61,64 @@ void X86Backend::addTensorSel(PassManager& pPM)
   // target independent pass
   pPM.add(CreateRemoveTrainingNodesPass());
   pPM.add(CreateUpdateGraphOutputSizePass());
+
+  // build compute graphs
+  pPM.add(CreateBookONNXGraphs());
+  pPM.add(CreateBuildInitializers());
+  pPM.add(CreateBuildInputOperators());
   pPM.add(CreateTensorSel(this));
+  pPM.add(CreateBuildOutputOperators());
 }
 
 void X86Backend::addMemAlloc(PassManager& pPM)
 {
-  // TODO
+  pPM.add(CreateX86MemAllocPass(this));
 }
 
 void X86Backend::addCodeEmit(PassManager& pPM, const Path& pOutput)
 {
-  // TODO
+  pPM.add(CreateX86CodeEmitPass(this, pOutput));
+}
+
+void X86Backend::getOutputFiles(const Path& pOutput,
+                                std::vector<Path>& pFiles) const
+{
+  pFiles.push_back(pOutput);
+  pFiles.push_back(Path(pOutput.native() + ".weight"));
+}
+
+void X86Backend::RegisterLowers(LowerRegistry& pRegistry) const
+{
+  pRegistry.emplace<AddLower>();
+  pRegistry.emplace<AveragePoolLower>();
+  pRegistry.emplace<BatchNormalizationLower>();
+  pRegistry.emplace<ConcatLower>();
+  pRegistry.emplace<ConvLower>();
+  pRegistry.emplace<DropoutLower>();
+  pRegistry.emplace<FlattenLower>();
+  pRegistry.emplace<GemmLower>();
+  pRegistry.emplace<GlobalAveragePoolLower>();
+  pRegistry.emplace<GlobalMaxPoolLower>();
+  pRegistry.emplace<IdentityLower>();
+  pRegistry.emplace<LeakyReluLower>();
+  pRegistry.emplace<MatMulLower>();
+  pRegistry.emplace<MaxLower>();
+  pRegistry.emplace<MaxPoolLower>();
+  pRegistry.emplace<MulLower>();
+  pRegistry.emplace<ReluLower>();
+  pRegistry.emplace<ReshapeLower>();
+  pRegistry.emplace<SigmoidLower>();
+  pRegistry.emplace<SoftmaxLower>();
+  pRegistry.emplace<SubLower>();
+  pRegistry.emplace<SumLower>();
+  pRegistry.emplace<TanhLower>();
+}
+
+onnc::ComputeMemOperand*
+X86Backend::getMemOpndByValue(const onnc::Value* pVal) const
+{
+  auto it = m_ValMemOpndMap.find(pVal);
+  return it != m_ValMemOpndMap.end() ? it->second : nullptr;
 }
 
 //===----------------------------------------------------------------------===//
@@ -56,7 +134,7 @@ X86_32Backend::~X86_32Backend()
 
 void X86_32Backend::RegisterLowers(LowerRegistry& pRegistry) const
 {
-  // TODO
+  X86Backend::RegisterLowers(pRegistry);
 }
 
 //===----------------------------------------------------------------------===//
@@ -72,7 +150,7 @@ X86_64Backend::~X86_64Backend()
 
 void X86_64Backend::RegisterLowers(LowerRegistry& pRegistry) const
 {
-  // TODO
+  X86Backend::RegisterLowers(pRegistry);
 }
 
 //===----------------------------------------------------------------------===//
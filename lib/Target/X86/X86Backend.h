@@ -8,12 +8,28 @@
 #ifndef TARGET_X86_X86_BACKEND_H
 #define TARGET_X86_X86_BACKEND_H
 #include <string>
+#include <unordered_map>
+#include <onnc/IR/ComputeMemOperand.h>
+#include <onnc/IR/Compute/Value.h>
 #include <onnc/Target/NPUTargetBackend.h>
 
 namespace onnc {
 
+/** \class X86Backend
+ *  \brief X86Backend lowers the compute graph into calls to the X86 kernel
+ *  library.
+ *
+ *  The memory allocation pass assigns every value a region in one of the two
+ *  memory spaces: the weight space holds initializers, and the neuron space
+ *  holds inputs, outputs and intermediate values. The code emitter writes the
+ *  resulting plan and the weight image.
+ */
 class X86Backend : public NPUTargetBackend
 {
+public:
+  typedef std::unordered_map<const onnc::Value*, onnc::ComputeMemOperand*>
+    ValMemOpndMap;
+
 public:
   X86Backend(const TargetOptions& pOptions);
 
@@ -24,6 +40,33 @@ public:
   void addMemAlloc(PassManager& pPM) override;
 
   void addCodeEmit(PassManager& pPM, const Path& pOutput) override;
+
+  /// The plan @ref pOutput and its weight image.
+  void getOutputFiles(const Path& pOutput,
+                      std::vector<Path>& pFiles) const override;
+
+  /// Register the lowers of the operators the kernel library supports.
+  void RegisterLowers(LowerRegistry& pRegistry) const override;
+
+  ValMemOpndMap& getValMemOpndMap() { return m_ValMemOpndMap; }
+
+  const ValMemOpndMap& getValMemOpndMap() const { return m_ValMemOpndMap; }
+
+  /// @retval nullptr The value is not allocated.
+  onnc::ComputeMemOperand* getMemOpndByValue(const onnc::Value* pVal) const;
+
+  uint64_t getWeightMemSize() const { return m_WeightMemSize; }
+
+  void setWeightMemSize(uint64_t pSize) { m_WeightMemSize = pSize; }
+
+  uint64_t getNeuronMemSize() const { return m_NeuronMemSize; }
+
+  void setNeuronMemSize(uint64_t pSize) { m_NeuronMemSize = pSize; }
+
+private:
+  ValMemOpndMap m_ValMemOpndMap;
+  uint64_t m_WeightMemSize;
+  uint64_t m_NeuronMemSize;
 };
 
 class X86_32Backend : public X86Backend
@@ -0,0 +1,165 @@
+//===- X86CodeEmitPass.cpp ------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "X86CodeEmitPass.h"
+#include "X86Backend.h"
+#include "X86Kernels.h"
+#include "X86Tensor.h"
+#include <onnc/IR/Compute/Initializer.h>
+#include <onnc/JSON/Array.h>
+#include <onnc/JSON/Value.h>
+#include <onnc/Support/Casting.h>
+#include <onnc/Support/IndentOStream.h>
+#include <onnc/Support/IOStream.h>
+#include <onnc/Support/OFStream.h>
+#include <sstream>
+
+using namespace onnc;
+
+char X86CodeEmit::ID = 0;
+
+//===----------------------------------------------------------------------===//
+// Non-member functions
+//===----------------------------------------------------------------------===//
+static const char* ResidenceName(ComputeOperand::Residence pResidence)
+{
+  switch (pResidence) {
+  case ComputeOperand::kInputResidence:    return "input";
+  case ComputeOperand::kWeightResidence:   return "weight";
+  case ComputeOperand::kOutputResidence:   return "output";
+  case ComputeOperand::kInternalResidence: return "internal";
+  default:                                 return "unknown";
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// X86CodeEmit
+//===----------------------------------------------------------------------===//
+X86CodeEmit::X86CodeEmit(X86Backend* pBackend, const Path& pOutput)
+  : ModulePass(ID), m_pBackend(pBackend), m_Output(pOutput) {
+}
+
+Pass::ReturnType X86CodeEmit::runOnModule(::onnc::Module& pModule)
+{
+  Path weight_file(m_Output.native() + ".weight");
+
+  json::Object graphs;
+  std::vector<char> image(m_pBackend->getWeightMemSize(), 0);
+  Module::cg_iterator cg, cgEnd = pModule.cgEnd();
+  for (cg = pModule.cgBegin(); cg != cgEnd; ++cg) {
+    graphs.insert(cg->value()->name(), emitComputeGraph(*cg->value()));
+    if (!emitWeight(*cg->value(), image))
+      return Pass::kPassFailure;
+  }
+
+  json::Object document;
+  document.insert("isa", x86::GetKernelISAName(x86::GetKernelISA()));
+  document.insert("weight file", weight_file.filename().native());
+  document.insert("weight size", json::Value(
+      (unsigned long long int)m_pBackend->getWeightMemSize()));
+  document.insert("neuron size", json::Value(
+      (unsigned long long int)m_pBackend->getNeuronMemSize()));
+  document.insert("graphs", graphs);
+
+  OFStream plan(m_Output, std::ios::out | std::ios::binary);
+  if (!plan.is_open()) {
+    errs() << "X86CodeEmit: can not open " << m_Output << "\n";
+    return Pass::kPassFailure;
+  }
+  IndentOStream oss(plan);
+  document.print(oss);
+
+  OFStream weight(weight_file, std::ios::out | std::ios::binary);
+  if (!weight.is_open()) {
+    errs() << "X86CodeEmit: can not open " << weight_file << "\n";
+    return Pass::kPassFailure;
+  }
+  weight.write(image.data(), image.size());
+  return Pass::kModuleNoChanged;
+}
+
+json::Array X86CodeEmit::emitComputeGraph(const ComputeGraph& pCG)
+{
+  json::Array operators;
+  ComputeGraph::const_iterator nodeIt, nEnd = pCG.end();
+  for (nodeIt = pCG.begin(); nodeIt != nEnd; ++nodeIt) {
+    const ComputeOperator* node = nodeIt;
+
+    std::ostringstream attributes;
+    node->print(attributes);
+
+    json::Object op;
+    op.insert("type", node->name());
+    op.insert("operator", attributes.str());
+
+    json::Array inputs;
+    for (unsigned int i = 0; i < node->getNumOfInputs(); ++i)
+      inputs.push_back(json::Value(emitValue(*node->getInput(i))));
+    op.insert("inputs", inputs);
+
+    json::Array outputs;
+    for (unsigned int i = 0; i < node->getNumOfOutputs(); ++i)
+      outputs.push_back(json::Value(emitValue(*node->getOutput(i))));
+    op.insert("outputs", outputs);
+
+    operators.push_back(json::Value(op));
+  }
+  return operators;
+}
+
+json::Object X86CodeEmit::emitValue(const onnc::Value& pValue)
+{
+  json::Object value;
+  value.insert("name", pValue.getName());
+  value.insert("type", json::Value((int)pValue.kind()));
+
+  json::Array dims;
+  for (int64_t dim : x86::GetShape(pValue))
+    dims.push_back(json::Value((long long int)dim));
+  value.insert("dims", dims);
+
+  // values without users are not allocated.
+  const ComputeMemOperand* opnd = m_pBackend->getMemOpndByValue(&pValue);
+  if (nullptr != opnd) {
+    value.insert("residence", ResidenceName(opnd->residence()));
+    value.insert("offset", json::Value(opnd->start()));
+    value.insert("length", json::Value(opnd->length()));
+  }
+  return value;
+}
+
+bool X86CodeEmit::emitWeight(const ComputeGraph& pCG, std::vector<char>& pImage)
+{
+  ComputeGraph::const_iterator nodeIt, nEnd = pCG.end();
+  for (nodeIt = pCG.begin(); nodeIt != nEnd; ++nodeIt) {
+    const ComputeOperator* node = nodeIt;
+    if (!isa<Initializer>(node))
+      continue;
+
+    const onnc::Value* value = node->getOutput(0);
+    const ComputeMemOperand* opnd = m_pBackend->getMemOpndByValue(value);
+    if (nullptr == opnd)
+      continue;
+
+    if (opnd->start() + opnd->length() > pImage.size()) {
+      errs() << "X86CodeEmit: weight " << value->getName()
+             << " is out of the weight space\n";
+      return false;
+    }
+    x86::CopyTensorData(*value, pImage.data() + opnd->start(), opnd->length());
+  }
+  return true;
+}
+
+//===----------------------------------------------------------------------===//
+// Factory method
+//===----------------------------------------------------------------------===//
+ModulePass* onnc::CreateX86CodeEmitPass(X86Backend* pBackend,
+                                        const Path& pOutput)
+{
+  return new X86CodeEmit(pBackend, pOutput);
+}
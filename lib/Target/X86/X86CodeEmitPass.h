@@ -0,0 +1,56 @@
+//===- X86CodeEmitPass.h --------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef TARGET_X86_X86_CODE_EMIT_PASS_H
+#define TARGET_X86_X86_CODE_EMIT_PASS_H
+#include <onnc/Core/ModulePass.h>
+#include <onnc/Core/PassSupport.h>
+#include <onnc/IR/ComputeGraph.h>
+#include <onnc/JSON/Object.h>
+#include <onnc/Support/Path.h>
+
+namespace onnc {
+
+class X86Backend;
+
+/** \class X86CodeEmit
+ *  \brief Emit the execution plan of the compute graphs.
+ *
+ *  The plan is a JSON document listing, for every compute graph, the
+ *  operators in execution order together with the memory region of each
+ *  input and output. The initializers are written into a weight image at
+ *  `<output>.weight`, laid out as X86MemAlloc placed them.
+ */
+class X86CodeEmit : public ModulePass
+{
+public:
+  static char ID;
+
+public:
+  X86CodeEmit(X86Backend* pBackend, const Path& pOutput);
+
+  StringRef getPassName() const override { return "X86CodeEmit"; }
+
+  Pass::ReturnType runOnModule(::onnc::Module& pModule) override;
+
+private:
+  json::Array emitComputeGraph(const ComputeGraph& pCG);
+
+  json::Object emitValue(const onnc::Value& pValue);
+
+  bool emitWeight(const ComputeGraph& pCG, std::vector<char>& pImage);
+
+private:
+  X86Backend* m_pBackend;
+  Path m_Output;
+};
+
+ModulePass* CreateX86CodeEmitPass(X86Backend* pBackend, const Path& pOutput);
+
+} // namespace onnc
+
+#endif
@@ -0,0 +1,697 @@
+//===- X86Interpreter.cpp -------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <onnc/Target/X86/X86Interpreter.h>
+#include "X86Kernels.h"
+#include "X86Scheduler.h"
+#include "X86Tensor.h"
+#include <onnc/IR/Compute/Add.h>
+#include <onnc/IR/Compute/AveragePool.h>
+#include <onnc/IR/Compute/BatchNormalization.h>
+#include <onnc/IR/Compute/Concat.h>
+#include <onnc/IR/Compute/Conv.h>
+#include <onnc/IR/Compute/Dropout.h>
+#include <onnc/IR/Compute/Flatten.h>
+#include <onnc/IR/Compute/Gemm.h>
+#include <onnc/IR/Compute/GlobalAveragePool.h>
+#include <onnc/IR/Compute/GlobalMaxPool.h>
+#include <onnc/IR/Compute/Identity.h>
+#include <onnc/IR/Compute/Initializer.h>
+#include <onnc/IR/Compute/InputOperator.h>
+#include <onnc/IR/Compute/LeakyRelu.h>
+#include <onnc/IR/Compute/MatMul.h>
+#include <onnc/IR/Compute/Max.h>
+#include <onnc/IR/Compute/MaxPool.h>
+#include <onnc/IR/Compute/Mul.h>
+#include <onnc/IR/Compute/OutputOperator.h>
+#include <onnc/IR/Compute/Relu.h>
+#include <onnc/IR/Compute/Reshape.h>
+#include <onnc/IR/Compute/Sigmoid.h>
+#include <onnc/IR/Compute/Softmax.h>
+#include <onnc/IR/Compute/Sub.h>
+#include <onnc/IR/Compute/Sum.h>
+#include <onnc/IR/Compute/Tanh.h>
+#include <onnc/IR/ComputeMemOperand.h>
+#include <onnc/Support/Casting.h>
+#include <onnc/Support/IOStream.h>
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <map>
+
+using namespace onnc;
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+namespace {
+
+typedef std::unordered_map<const onnc::Value*,
+                           const ComputeMemOperand*> RegionMap;
+
+/// A range of the neuron space read or written by a step.
+struct Access
+{
+  uint64_t begin;
+  uint64_t end;
+  bool write;
+};
+
+typedef std::vector<Access> AccessList;
+
+/// The last step writing a range of the neuron space, and the steps reading
+/// it since then.
+struct Segment
+{
+  int writer;
+  std::vector<unsigned int> readers;
+};
+
+/// Disjoint segments covering the neuron space, keyed by their begin. A
+/// segment ends where the next one begins.
+typedef std::map<uint64_t, Segment> SegmentMap;
+
+/// The 2D sliding window of a convolution or a pooling.
+struct Window
+{
+  int kernel[2];
+  int pad[2];
+  int stride[2];
+  int dilation[2];
+};
+
+} // anonymous namespace
+
+static char* AlignPointer(char* pPtr, uint64_t pAlign)
+{
+  uintptr_t addr = reinterpret_cast<uintptr_t>(pPtr);
+  return pPtr + ((pAlign - addr % pAlign) % pAlign);
+}
+
+static void AddAccess(AccessList& pList, const RegionMap& pRegions,
+                      const onnc::Value* pValue, bool pWrite)
+{
+  RegionMap::const_iterator region = pRegions.find(pValue);
+  // weights are never written.
+  if (pRegions.end() == region || region->second->isWeight())
+    return;
+  uint64_t begin = region->second->start();
+  pList.push_back(Access{ begin, begin + region->second->length(), pWrite });
+}
+
+/// Split the segment holding @ref pPos so that a segment begins at it.
+static SegmentMap::iterator Split(SegmentMap& pSegments, uint64_t pPos)
+{
+  SegmentMap::iterator next = pSegments.upper_bound(pPos);
+  SegmentMap::iterator seg = std::prev(next);
+  if (seg->first == pPos)
+    return seg;
+  return pSegments.emplace_hint(next, pPos, seg->second);
+}
+
+static const float* In(X86Interpreter& pInterp, const ComputeOperator& pOp,
+                       unsigned int pIdx)
+{
+  return static_cast<const float*>(pInterp.getMemory(*pOp.getInput(pIdx)));
+}
+
+static float* Out(X86Interpreter& pInterp, const ComputeOperator& pOp,
+                  unsigned int pIdx)
+{
+  return static_cast<float*>(pInterp.getMemory(*pOp.getOutput(pIdx)));
+}
+
+static x86::Shape InShape(const ComputeOperator& pOp, unsigned int pIdx)
+{
+  return x86::GetShape(*pOp.getInput(pIdx));
+}
+
+static x86::Shape OutShape(const ComputeOperator& pOp, unsigned int pIdx)
+{
+  return x86::GetShape(*pOp.getOutput(pIdx));
+}
+
+/// Normalize a negative axis of a tensor of rank @ref pRank.
+static int GetAxis(int64_t pAxis, size_t pRank)
+{
+  return (pAxis < 0) ? pAxis + pRank : pAxis;
+}
+
+static int64_t Product(const x86::Shape& pShape, size_t pBegin, size_t pEnd)
+{
+  int64_t result = 1;
+  for (size_t i = pBegin; i < pEnd && i < pShape.size(); ++i)
+    result *= pShape[i];
+  return result;
+}
+
+/// The spatial dimension @ref pDim (0 for H, 1 for W) of an NCHW or NCW
+/// shape. 1-D tensors have unit height.
+static int Spatial(const x86::Shape& pShape, int pDim)
+{
+  if (pShape.size() >= 4)
+    return pShape[2 + pDim];
+  if (3 == pShape.size())
+    return (0 == pDim) ? 1 : pShape[2];
+  return 1;
+}
+
+/// The element of an attribute that holds one value per spatial dimension.
+/// The begin pads are laid out the same way.
+static int SpatialAttr(const IntsAttr& pAttr, size_t pNumOfSpatial, int pDim,
+                       int pDefault)
+{
+  int idx = (1 == pNumOfSpatial) ? pDim - 1 : pDim;
+  if (idx < 0 || idx >= (int)pAttr.vector().size())
+    return pDefault;
+  return pAttr.vector()[idx];
+}
+
+static Window GetWindow(const x86::Shape& pX, const x86::Shape& pY,
+                        const int pKernel[2], const IntsAttr& pPads,
+                        const IntsAttr& pStrides, const IntsAttr* pDilations,
+                        const StringAttr& pAutoPad)
+{
+  const size_t spatial = pX.size() - 2;
+  const std::string& auto_pad = pAutoPad.value();
+
+  Window win;
+  for (int d = 0; d < 2; ++d) {
+    win.kernel[d] = pKernel[d];
+    win.stride[d] = SpatialAttr(pStrides, spatial, d, 1);
+    win.dilation[d] = (nullptr == pDilations) ? 1 :
+                                  SpatialAttr(*pDilations, spatial, d, 1);
+    win.pad[d] = SpatialAttr(pPads, spatial, d, 0);
+
+    if ("VALID" == auto_pad)
+      win.pad[d] = 0;
+    else if ("SAME_UPPER" == auto_pad || "SAME_LOWER" == auto_pad) {
+      int total = (Spatial(pY, d) - 1) * win.stride[d] +
+                  (win.kernel[d] - 1) * win.dilation[d] + 1 - Spatial(pX, d);
+      total = std::max(total, 0);
+      // SAME_UPPER puts the extra padding at the end.
+      win.pad[d] = ("SAME_UPPER" == auto_pad) ? total / 2 : total - total / 2;
+    }
+  }
+  return win;
+}
+
+static x86::PoolParam GetPoolParam(const ComputeOperator& pOp,
+                                   const IntsAttr& pKernelShape,
+                                   const IntsAttr& pPads,
+                                   const IntsAttr& pStrides,
+                                   const StringAttr& pAutoPad)
+{
+  x86::Shape x = InShape(pOp, 0);
+  x86::Shape y = OutShape(pOp, 0);
+  const int kernel[2] = { SpatialAttr(pKernelShape, x.size() - 2, 0, 1),
+                          SpatialAttr(pKernelShape, x.size() - 2, 1, 1) };
+  Window win = GetWindow(x, y, kernel, pPads, pStrides, nullptr, pAutoPad);
+
+  x86::PoolParam param;
+  param.N = x[0];
+  param.C = x[1];
+  param.H = Spatial(x, 0);
+  param.W = Spatial(x, 1);
+  param.KH = win.kernel[0];
+  param.KW = win.kernel[1];
+  param.OH = Spatial(y, 0);
+  param.OW = Spatial(y, 1);
+  param.padT = win.pad[0];
+  param.padL = win.pad[1];
+  param.strideH = win.stride[0];
+  param.strideW = win.stride[1];
+  param.countIncludePad = false;
+  return param;
+}
+
+//===----------------------------------------------------------------------===//
+// Kernel adapters
+//===----------------------------------------------------------------------===//
+static void RunConv(X86Interpreter& pInterp, const ComputeOperator& pOp)
+{
+  const Conv& conv = static_cast<const Conv&>(pOp);
+  x86::Shape x = InShape(pOp, Conv::kX);
+  x86::Shape w = InShape(pOp, Conv::kW);
+  x86::Shape y = OutShape(pOp, Conv::kY);
+
+  const size_t spatial = x.size() - 2;
+  const int kernel[2] = {
+    SpatialAttr(conv.getKernelShape(), spatial, 0, Spatial(w, 0)),
+    SpatialAttr(conv.getKernelShape(), spatial, 1, Spatial(w, 1))
+  };
+  Window win = GetWindow(x, y, kernel, conv.getPads(), conv.getStrides(),
+                         &conv.getDilations(), conv.getAutoPad());
+
+  x86::ConvParam param;
+  param.N = x[0];
+  param.C = x[1];
+  param.H = Spatial(x, 0);
+  param.W = Spatial(x, 1);
+  param.M = w[0];
+  param.KH = win.kernel[0];
+  param.KW = win.kernel[1];
+  param.OH = Spatial(y, 0);
+  param.OW = Spatial(y, 1);
+  param.padT = win.pad[0];
+  param.padL = win.pad[1];
+  param.strideH = win.stride[0];
+  param.strideW = win.stride[1];
+  param.dilationH = win.dilation[0];
+  param.dilationW = win.dilation[1];
+  param.group = conv.getGroup().value();
+
+  const float* bias = nullptr;
+  if (pOp.getNumOfInputs() > Conv::kB)
+    bias = In(pInterp, pOp, Conv::kB);
+
+  x86::Conv2D(param, In(pInterp, pOp, Conv::kX), In(pInterp, pOp, Conv::kW),
+              bias, Out(pInterp, pOp, Conv::kY));
+}
+
+static void RunGemm(X86Interpreter& pInterp, const ComputeOperator& pOp)
+{
+  const Gemm& gemm = static_cast<const Gemm&>(pOp);
+  const bool trans_a = (0 != gemm.getTransA().value());
+  const bool trans_b = (0 != gemm.getTransB().value());
+  x86::Shape a = InShape(pOp, Gemm::kA);
+  const int m = trans_a ? a[1] : a[0];
+  const int k = trans_a ? a[0] : a[1];
+  const int n = Product(OutShape(pOp, Gemm::kY), 1, 2);
+  float* y = Out(pInterp, pOp, Gemm::kY);
+
+  // broadcast C into Y, then accumulate the product on it.
+  float beta = gemm.getBeta().value();
+  if (pOp.getNumOfInputs() > Gemm::kC && 0.f != beta) {
+    x86::Shape c = InShape(pOp, Gemm::kC);
+    const int c_rows = (c.size() >= 2) ? c[c.size() - 2] : 1;
+    const int c_cols = c.empty() ? 1 : c.back();
+    const float* data = In(pInterp, pOp, Gemm::kC);
+    for (int i = 0; i < m; ++i)
+      for (int j = 0; j < n; ++j)
+        y[i * n + j] = data[(1 == c_rows ? 0 : i) * c_cols +
+                            (1 == c_cols ? 0 : j)];
+  }
+  else
+    beta = 0.f;
+
+  x86::Gemm(trans_a, trans_b, m, n, k, gemm.getAlpha().value(),
+            In(pInterp, pOp, Gemm::kA), In(pInterp, pOp, Gemm::kB), beta, y);
+}
+
+static void RunMatMul(X86Interpreter& pInterp, const ComputeOperator& pOp)
+{
+  x86::Shape a = InShape(pOp, MatMul::kA);
+  x86::Shape b = InShape(pOp, MatMul::kB);
+  const int m = (a.size() >= 2) ? a[a.size() - 2] : 1;
+  const int k = a.back();
+  const int n = (b.size() >= 2) ? b.back() : 1;
+
+  const int64_t batch = x86::GetNumOfElements(OutShape(pOp, MatMul::kY)) /
+                        ((int64_t)m * n);
+  // an operand either has all the batches or is shared by them.
+  const int64_t stride_a = (x86::GetNumOfElements(a) == (size_t)(batch * m * k))
+                           ? m * k : 0;
+  const int64_t stride_b = (x86::GetNumOfElements(b) == (size_t)(batch * k * n))
+                           ? k * n : 0;
+
+  const float* pa = In(pInterp, pOp, MatMul::kA);
+  const float* pb = In(pInterp, pOp, MatMul::kB);
+  float* py = Out(pInterp, pOp, MatMul::kY);
+  for (int64_t i = 0; i < batch; ++i)
+    x86::Gemm(false, false, m, n, k, 1.f, pa + i * stride_a, pb + i * stride_b,
+              0.f, py + i * m * n);
+}
+
+static void RunMaxPool(X86Interpreter& pInterp, const ComputeOperator& pOp)
+{
+  const MaxPool& pool = static_cast<const MaxPool&>(pOp);
+  x86::PoolParam param = GetPoolParam(pOp, pool.getKernelShape(),
+                                      pool.getPads(), pool.getStrides(),
+                                      pool.getAutoPad());
+  x86::MaxPool2D(param, In(pInterp, pOp, 0), Out(pInterp, pOp, 0));
+}
+
+static void RunAveragePool(X86Interpreter& pInterp, const ComputeOperator& pOp)
+{
+  const AveragePool& pool = static_cast<const AveragePool&>(pOp);
+  x86::PoolParam param = GetPoolParam(pOp, pool.getKernelShape(),
+                                      pool.getPads(), pool.getStrides(),
+                                      pool.getAutoPad());
+  param.countIncludePad = (0 != pool.getCountIncludePad().value());
+  x86::AveragePool2D(param, In(pInterp, pOp, 0), Out(pInterp, pOp, 0));
+}
+
+static void RunGlobalMaxPool(X86Interpreter& pInterp,
+                             const ComputeOperator& pOp)
+{
+  x86::Shape x = InShape(pOp, 0);
+  x86::GlobalMaxPool(x[0], x[1], Product(x, 2, x.size()),
+                     In(pInterp, pOp, 0), Out(pInterp, pOp, 0));
+}
+
+static void RunGlobalAveragePool(X86Interpreter& pInterp,
+                                 const ComputeOperator& pOp)
+{
+  x86::Shape x = InShape(pOp, 0);
+  x86::GlobalAveragePool(x[0], x[1], Product(x, 2, x.size()),
+                         In(pInterp, pOp, 0), Out(pInterp, pOp, 0));
+}
+
+static void RunBatchNormalization(X86Interpreter& pInterp,
+                                  const ComputeOperator& pOp)
+{
+  typedef BatchNormalization BN;
+  const BN& bn = static_cast<const BN&>(pOp);
+  x86::Shape x = InShape(pOp, BN::kX);
+  x86::BatchNormalization(x[0], x[1], Product(x, 2, x.size()),
+                          bn.getEpsilon().value(),
+                          In(pInterp, pOp, BN::kX),
+                          In(pInterp, pOp, BN::kScale),
+                          In(pInterp, pOp, BN::kB),
+                          In(pInterp, pOp, BN::kInMean),
+                          In(pInterp, pOp, BN::kInVar),
+                          Out(pInterp, pOp, BN::kY));
+}
+
+static void RunRelu(X86Interpreter& pInterp, const ComputeOperator& pOp)
+{
+  x86::Relu(x86::GetNumOfElements(OutShape(pOp, 0)),
+            In(pInterp, pOp, 0), Out(pInterp, pOp, 0));
+}
+
+static void RunLeakyRelu(X86Interpreter& pInterp, const ComputeOperator& pOp)
+{
+  const LeakyRelu& relu = static_cast<const LeakyRelu&>(pOp);
+  x86::LeakyRelu(x86::GetNumOfElements(OutShape(pOp, 0)),
+                 relu.getAlpha().value(),
+                 In(pInterp, pOp, 0), Out(pInterp, pOp, 0));
+}
+
+static void RunSigmoid(X86Interpreter& pInterp, const ComputeOperator& pOp)
+{
+  x86::Sigmoid(x86::GetNumOfElements(OutShape(pOp, 0)),
+               In(pInterp, pOp, 0), Out(pInterp, pOp, 0));
+}
+
+static void RunTanh(X86Interpreter& pInterp, const ComputeOperator& pOp)
+{
+  x86::Tanh(x86::GetNumOfElements(OutShape(pOp, 0)),
+            In(pInterp, pOp, 0), Out(pInterp, pOp, 0));
+}
+
+static void RunSoftmax(X86Interpreter& pInterp, const ComputeOperator& pOp)
+{
+  const Softmax& softmax = static_cast<const Softmax&>(pOp);
+  x86::Shape x = InShape(pOp, 0);
+  const int axis = GetAxis(softmax.getAxis().value(), x.size());
+  x86::Softmax(Product(x, 0, axis), Product(x, axis, x.size()),
+               In(pInterp, pOp, 0), Out(pInterp, pOp, 0));
+}
+
+/// Element-wise binary operators and their variadic forms. Later inputs are
+/// folded into the output in place.
+template<x86::BinaryOp Op>
+static void RunBinary(X86Interpreter& pInterp, const ComputeOperator& pOp)
+{
+  x86::Shape y = OutShape(pOp, 0);
+  float* out = Out(pInterp, pOp, 0);
+  if (1 == pOp.getNumOfInputs()) {
+    x86::Copy(x86::SizeOfTensor(*pOp.getOutput(0)), In(pInterp, pOp, 0), out);
+    return;
+  }
+
+  x86::Binary(Op, InShape(pOp, 0), In(pInterp, pOp, 0),
+              InShape(pOp, 1), In(pInterp, pOp, 1), y, out);
+  for (unsigned int i = 2; i < pOp.getNumOfInputs(); ++i)
+    x86::Binary(Op, y, out, InShape(pOp, i), In(pInterp, pOp, i), y, out);
+}
+
+static void RunConcat(X86Interpreter& pInterp, const ComputeOperator& pOp)
+{
+  const Concat& concat = static_cast<const Concat&>(pOp);
+  x86::Shape y = OutShape(pOp, 0);
+
+  std::vector<x86::Shape> shapes;
+  std::vector<const float*> inputs;
+  for (unsigned int i = 0; i < pOp.getNumOfInputs(); ++i) {
+    shapes.push_back(InShape(pOp, i));
+    inputs.push_back(In(pInterp, pOp, i));
+  }
+  x86::Concat(GetAxis(concat.getAxis().value(), y.size()), shapes, inputs, y,
+              Out(pInterp, pOp, 0));
+}
+
+/// Reshape, Flatten, Identity and Dropout in inference only move data.
+static void RunCopy(X86Interpreter& pInterp, const ComputeOperator& pOp)
+{
+  x86::Copy(x86::SizeOfTensor(*pOp.getOutput(0)),
+            pInterp.getMemory(*pOp.getInput(0)),
+            pInterp.getMemory(*pOp.getOutput(0)));
+}
+
+//===----------------------------------------------------------------------===//
+// X86Interpreter
+//===----------------------------------------------------------------------===//
+X86Interpreter::X86Interpreter()
+  : m_WeightSpace(), m_NeuronSpace(), m_WeightSize(0), m_NeuronSize(0),
+    m_Memory(), m_Plan(), m_Inputs(), m_Outputs(), m_pScheduler() {
+}
+
+X86Interpreter::~X86Interpreter()
+{
+}
+
+void X86Interpreter::clear()
+{
+  m_WeightSpace.clear();
+  m_NeuronSpace.clear();
+  m_WeightSize = 0;
+  m_NeuronSize = 0;
+  m_Memory.clear();
+  m_Plan.clear();
+  m_Inputs.clear();
+  m_Outputs.clear();
+}
+
+bool X86Interpreter::prepare(const ComputeGraph& pCG)
+{
+  clear();
+
+  // collect the regions placed by the memory allocation pass.
+  RegionMap regions;
+  ComputeGraph::const_iterator nodeIt, nEnd = pCG.end();
+  for (nodeIt = pCG.begin(); nodeIt != nEnd; ++nodeIt) {
+    const ComputeOperator* node = nodeIt;
+    const ComputeOperand* opnd = node->getFirstOutArc();
+    for (; nullptr != opnd; opnd = opnd->getNextOut()) {
+      const ComputeMemOperand* mem = dyn_cast<ComputeMemOperand>(opnd);
+      if (nullptr == mem || !mem->hasValue())
+        continue;
+      regions[mem->getValue()] = mem;
+      uint64_t end = (uint64_t)mem->start() + mem->length();
+      if (mem->isWeight())
+        m_WeightSize = std::max(m_WeightSize, end);
+      else
+        m_NeuronSize = std::max(m_NeuronSize, end);
+    }
+  }
+
+  m_WeightSpace.resize(m_WeightSize + kAlignment, 0);
+  m_NeuronSpace.resize(m_NeuronSize + kAlignment, 0);
+  char* weight = AlignPointer(m_WeightSpace.data(), kAlignment);
+  char* neuron = AlignPointer(m_NeuronSpace.data(), kAlignment);
+  for (auto& region : regions) {
+    const ComputeMemOperand* mem = region.second;
+    m_Memory[region.first] = (mem->isWeight() ? weight : neuron) + mem->start();
+  }
+
+  // bind the constants and the graph boundary, then plan the operators.
+  for (nodeIt = pCG.begin(); nodeIt != nEnd; ++nodeIt) {
+    const ComputeOperator* node = nodeIt;
+    if (isa<Initializer>(node)) {
+      const onnc::Value* value = node->getOutput(0);
+      if (void* memory = getMemory(*value))
+        x86::CopyTensorData(*value, memory, regions[value]->length());
+      continue;
+    }
+    if (isa<InputOperator>(node)) {
+      for (unsigned int i = 0; i < node->getNumOfOutputs(); ++i)
+        if (nullptr != getMemory(*node->getOutput(i)))
+          m_Inputs.push_back(node->getOutput(i));
+      continue;
+    }
+    if (isa<OutputOperator>(node)) {
+      for (unsigned int i = 0; i < node->getNumOfInputs(); ++i)
+        m_Outputs.push_back(node->getInput(i));
+      continue;
+    }
+
+    // nobody reads the result.
+    if (nullptr == getMemory(*node->getOutput(0)))
+      continue;
+
+    Kernel kernel = Lookup(node->getID());
+    if (nullptr == kernel) {
+      errs() << "X86Interpreter: no kernel for operator " << node->name()
+             << "\n";
+      return false;
+    }
+    for (unsigned int i = 0; i < node->getNumOfInputs(); ++i) {
+      if (nullptr == getMemory(*node->getInput(i))) {
+        errs() << "X86Interpreter: value " << node->getInput(i)->getName()
+               << " of operator " << node->name() << " has no memory\n";
+        return false;
+      }
+    }
+    m_Plan.push_back(Step{ node, kernel, {}, 0 });
+  }
+
+  // build the dependencies between steps, including the reuse of regions.
+  // A read waits for the last writer of its segments, and a write also
+  // waits for the readers since then. Earlier accesses are ordered before
+  // those steps already.
+  SegmentMap segments;
+  segments[0] = Segment{ -1, {} };
+  segments[m_NeuronSize] = Segment{ -1, {} };
+  std::vector<int> dependent(m_Plan.size(), -1);
+  for (unsigned int j = 0; j < m_Plan.size(); ++j) {
+    const ComputeOperator* node = m_Plan[j].op;
+    AccessList accesses;
+    for (unsigned int i = 0; i < node->getNumOfInputs(); ++i)
+      AddAccess(accesses, regions, node->getInput(i), false);
+    for (unsigned int i = 0; i < node->getNumOfOutputs(); ++i)
+      AddAccess(accesses, regions, node->getOutput(i), true);
+
+    auto depend = [this, j, &dependent](int pStep) {
+      if (pStep < 0 || (unsigned int)pStep == j || (int)j == dependent[pStep])
+        return;
+      dependent[pStep] = j;
+      m_Plan[pStep].successors.push_back(j);
+      ++m_Plan[j].degree;
+    };
+
+    for (const Access& access : accesses) {
+      if (access.begin == access.end)
+        continue;
+      SegmentMap::iterator seg = Split(segments, access.begin);
+      SegmentMap::iterator end = Split(segments, access.end);
+      for (; seg != end; ++seg) {
+        depend(seg->second.writer);
+        if (access.write)
+          for (unsigned int reader : seg->second.readers)
+            depend(reader);
+      }
+    }
+
+    // record the reads before the writes, so a step updating a region in
+    // place ends up as its writer.
+    for (int write = 0; write < 2; ++write) {
+      for (const Access& access : accesses) {
+        if (access.write != (1 == write) || access.begin == access.end)
+          continue;
+        SegmentMap::iterator seg = segments.find(access.begin);
+        SegmentMap::iterator end = segments.find(access.end);
+        for (; seg != end; ++seg) {
+          if (access.write) {
+            seg->second.writer = j;
+            seg->second.readers.clear();
+          }
+          else
+            seg->second.readers.push_back(j);
+        }
+      }
+    }
+  }
+  return true;
+}
+
+void X86Interpreter::run(std::vector<uint64_t>* pStepTimes)
+{
+  if (m_pScheduler)
+    m_pScheduler->run(*this, pStepTimes);
+  else
+    runSerially(pStepTimes);
+}
+
+void X86Interpreter::runSerially(std::vector<uint64_t>* pStepTimes)
+{
+  if (nullptr == pStepTimes) {
+    for (Step& step : m_Plan)
+      step.kernel(*this, *step.op);
+    return;
+  }
+
+  typedef std::chrono::steady_clock Clock;
+  pStepTimes->resize(m_Plan.size(), 0);
+  for (size_t i = 0; i < m_Plan.size(); ++i) {
+    Clock::time_point start = Clock::now();
+    m_Plan[i].kernel(*this, *m_Plan[i].op);
+    (*pStepTimes)[i] += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            Clock::now() - start).count();
+  }
+}
+
+void X86Interpreter::setNumOfThreads(unsigned int pNumOfThreads)
+{
+  if (pNumOfThreads == getNumOfThreads())
+    return;
+
+  if (pNumOfThreads <= 1)
+    m_pScheduler.reset();
+  else
+    m_pScheduler.reset(new X86Scheduler(pNumOfThreads));
+}
+
+unsigned int X86Interpreter::getNumOfThreads() const
+{
+  return m_pScheduler ? m_pScheduler->getNumOfThreads() : 1;
+}
+
+void* X86Interpreter::getMemory(const onnc::Value& pValue) const
+{
+  MemoryMap::const_iterator entry = m_Memory.find(&pValue);
+  if (m_Memory.end() == entry)
+    return nullptr;
+  return entry->second;
+}
+
+X86Interpreter::Kernel
+X86Interpreter::Lookup(ComputeOperator::OperatorTypeID pID)
+{
+  static const std::unordered_map<ComputeOperator::OperatorTypeID, Kernel>
+  table = {
+    { &Add::ID,                RunBinary<x86::kAddOp> },
+    { &AveragePool::ID,        RunAveragePool },
+    { &BatchNormalization::ID, RunBatchNormalization },
+    { &Concat::ID,             RunConcat },
+    { &Conv::ID,               RunConv },
+    { &Dropout::ID,            RunCopy },
+    { &Flatten::ID,            RunCopy },
+    { &Gemm::ID,               RunGemm },
+    { &GlobalAveragePool::ID,  RunGlobalAveragePool },
+    { &GlobalMaxPool::ID,      RunGlobalMaxPool },
+    { &Identity::ID,           RunCopy },
+    { &LeakyRelu::ID,          RunLeakyRelu },
+    { &MatMul::ID,             RunMatMul },
+    { &Max::ID,                RunBinary<x86::kMaxOp> },
+    { &MaxPool::ID,            RunMaxPool },
+    { &Mul::ID,                RunBinary<x86::kMulOp> },
+    { &Relu::ID,               RunRelu },
+    { &Reshape::ID,            RunCopy },
+    { &Sigmoid::ID,            RunSigmoid },
+    { &Softmax::ID,            RunSoftmax },
+    { &Sub::ID,                RunBinary<x86::kSubOp> },
+    { &Sum::ID,                RunBinary<x86::kAddOp> },
+    { &Tanh::ID,               RunTanh }
+  };
+
+  auto entry = table.find(pID);
+  if (table.end() == entry)
+    return nullptr;
+  return entry->second;
+}
@@ -0,0 +1,797 @@
+//===- X86Kernels.cpp -----------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "X86Kernels.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ONNC_X86_KERNEL_SIMD 1
+#include <immintrin.h>
+#define ONNC_TARGET_AVX2   __attribute__((target("avx2,fma")))
+#define ONNC_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+using namespace onnc;
+using namespace onnc::x86;
+
+namespace {
+
+//===----------------------------------------------------------------------===//
+// Primitives
+//===----------------------------------------------------------------------===//
+typedef void (*BinaryFn)(size_t, const float*, const float*, float*);
+
+/** \struct Primitives
+ *  \brief The vectorized building blocks of all kernels.
+ *
+ *  There is one table per KernelISA. Kernels never call an ISA-specific
+ *  function directly; they go through the table of the active ISA.
+ */
+struct Primitives
+{
+  /// y += a * x
+  void (*axpy)(size_t, float, const float*, float*);
+
+  /// y = a * x + b
+  void (*affine)(size_t, float, float, const float*, float*);
+
+  float (*dot)(size_t, const float*, const float*);
+
+  float (*sum)(size_t, const float*);
+
+  float (*max)(size_t, const float*);
+
+  void (*leaky_relu)(size_t, float, const float*, float*);
+
+  /// indexed by BinaryOp
+  BinaryFn binary[4];
+};
+
+//===----------------------------------------------------------------------===//
+// Scalar primitives
+//===----------------------------------------------------------------------===//
+void AxpyScalar(size_t pN, float pA, const float* pX, float* pY)
+{
+  for (size_t i = 0; i < pN; ++i)
+    pY[i] += pA * pX[i];
+}
+
+void AffineScalar(size_t pN, float pA, float pB, const float* pX, float* pY)
+{
+  for (size_t i = 0; i < pN; ++i)
+    pY[i] = pA * pX[i] + pB;
+}
+
+float DotScalar(size_t pN, const float* pX, const float* pY)
+{
+  float result = 0.f;
+  for (size_t i = 0; i < pN; ++i)
+    result += pX[i] * pY[i];
+  return result;
+}
+
+float SumScalar(size_t pN, const float* pX)
+{
+  float result = 0.f;
+  for (size_t i = 0; i < pN; ++i)
+    result += pX[i];
+  return result;
+}
+
+float MaxScalar(size_t pN, const float* pX)
+{
+  float result = -std::numeric_limits<float>::infinity();
+  for (size_t i = 0; i < pN; ++i)
+    result = std::max(result, pX[i]);
+  return result;
+}
+
+void LeakyReluScalar(size_t pN, float pAlpha, const float* pX, float* pY)
+{
+  for (size_t i = 0; i < pN; ++i)
+    pY[i] = (pX[i] > 0.f) ? pX[i] : pAlpha * pX[i];
+}
+
+#define DEFINE_SCALAR_BINARY(NAME, EXPR) \
+void NAME##Scalar(size_t pN, const float* pA, const float* pB, float* pC) \
+{ \
+  for (size_t i = 0; i < pN; ++i) { \
+    const float a = pA[i], b = pB[i]; \
+    pC[i] = (EXPR); \
+  } \
+}
+
+DEFINE_SCALAR_BINARY(Add, a + b)
+DEFINE_SCALAR_BINARY(Sub, a - b)
+DEFINE_SCALAR_BINARY(Mul, a * b)
+DEFINE_SCALAR_BINARY(Max, std::max(a, b))
+
+#undef DEFINE_SCALAR_BINARY
+
+const Primitives g_ScalarPrimitives = {
+  AxpyScalar, AffineScalar, DotScalar, SumScalar, MaxScalar, LeakyReluScalar,
+  { AddScalar, SubScalar, MulScalar, MaxScalar }
+};
+
+#ifdef ONNC_X86_KERNEL_SIMD
+//===----------------------------------------------------------------------===//
+// AVX2 primitives
+//===----------------------------------------------------------------------===//
+ONNC_TARGET_AVX2 inline float HorizontalSum(__m256 pV)
+{
+  __m128 r = _mm_add_ps(_mm256_castps256_ps128(pV),
+                        _mm256_extractf128_ps(pV, 1));
+  r = _mm_add_ps(r, _mm_movehl_ps(r, r));
+  r = _mm_add_ss(r, _mm_movehdup_ps(r));
+  return _mm_cvtss_f32(r);
+}
+
+ONNC_TARGET_AVX2 inline float HorizontalMax(__m256 pV)
+{
+  __m128 r = _mm_max_ps(_mm256_castps256_ps128(pV),
+                        _mm256_extractf128_ps(pV, 1));
+  r = _mm_max_ps(r, _mm_movehl_ps(r, r));
+  r = _mm_max_ss(r, _mm_movehdup_ps(r));
+  return _mm_cvtss_f32(r);
+}
+
+ONNC_TARGET_AVX2 void AxpyAVX2(size_t pN, float pA, const float* pX, float* pY)
+{
+  const __m256 a = _mm256_set1_ps(pA);
+  size_t i = 0;
+  for (; i + 8 <= pN; i += 8) {
+    __m256 y = _mm256_fmadd_ps(a, _mm256_loadu_ps(pX + i),
+                               _mm256_loadu_ps(pY + i));
+    _mm256_storeu_ps(pY + i, y);
+  }
+  for (; i < pN; ++i)
+    pY[i] += pA * pX[i];
+}
+
+ONNC_TARGET_AVX2
+void AffineAVX2(size_t pN, float pA, float pB, const float* pX, float* pY)
+{
+  const __m256 a = _mm256_set1_ps(pA);
+  const __m256 b = _mm256_set1_ps(pB);
+  size_t i = 0;
+  for (; i + 8 <= pN; i += 8)
+    _mm256_storeu_ps(pY + i, _mm256_fmadd_ps(a, _mm256_loadu_ps(pX + i), b));
+  for (; i < pN; ++i)
+    pY[i] = pA * pX[i] + pB;
+}
+
+ONNC_TARGET_AVX2 float DotAVX2(size_t pN, const float* pX, const float* pY)
+{
+  __m256 acc0 = _mm256_setzero_ps();
+  __m256 acc1 = _mm256_setzero_ps();
+  size_t i = 0;
+  for (; i + 16 <= pN; i += 16) {
+    acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(pX + i),
+                           _mm256_loadu_ps(pY + i), acc0);
+    acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(pX + i + 8),
+                           _mm256_loadu_ps(pY + i + 8), acc1);
+  }
+  for (; i + 8 <= pN; i += 8)
+    acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(pX + i),
+                           _mm256_loadu_ps(pY + i), acc0);
+  float result = HorizontalSum(_mm256_add_ps(acc0, acc1));
+  for (; i < pN; ++i)
+    result += pX[i] * pY[i];
+  return result;
+}
+
+ONNC_TARGET_AVX2 float SumAVX2(size_t pN, const float* pX)
+{
+  __m256 acc = _mm256_setzero_ps();
+  size_t i = 0;
+  for (; i + 8 <= pN; i += 8)
+    acc = _mm256_add_ps(acc, _mm256_loadu_ps(pX + i));
+  float result = HorizontalSum(acc);
+  for (; i < pN; ++i)
+    result += pX[i];
+  return result;
+}
+
+ONNC_TARGET_AVX2 float MaxAVX2(size_t pN, const float* pX)
+{
+  __m256 acc = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+  size_t i = 0;
+  for (; i + 8 <= pN; i += 8)
+    acc = _mm256_max_ps(acc, _mm256_loadu_ps(pX + i));
+  float result = HorizontalMax(acc);
+  for (; i < pN; ++i)
+    result = std::max(result, pX[i]);
+  return result;
+}
+
+ONNC_TARGET_AVX2
+void LeakyReluAVX2(size_t pN, float pAlpha, const float* pX, float* pY)
+{
+  const __m256 zero = _mm256_setzero_ps();
+  const __m256 alpha = _mm256_set1_ps(pAlpha);
+  size_t i = 0;
+  for (; i + 8 <= pN; i += 8) {
+    __m256 x = _mm256_loadu_ps(pX + i);
+    __m256 y = _mm256_fmadd_ps(alpha, _mm256_min_ps(x, zero),
+                               _mm256_max_ps(x, zero));
+    _mm256_storeu_ps(pY + i, y);
+  }
+  for (; i < pN; ++i)
+    pY[i] = (pX[i] > 0.f) ? pX[i] : pAlpha * pX[i];
+}
+
+#define DEFINE_AVX2_BINARY(NAME, INTRINSIC, EXPR) \
+ONNC_TARGET_AVX2 \
+void NAME##AVX2(size_t pN, const float* pA, const float* pB, float* pC) \
+{ \
+  size_t i = 0; \
+  for (; i + 8 <= pN; i += 8) \
+    _mm256_storeu_ps(pC + i, INTRINSIC(_mm256_loadu_ps(pA + i), \
+                                       _mm256_loadu_ps(pB + i))); \
+  for (; i < pN; ++i) { \
+    const float a = pA[i], b = pB[i]; \
+    pC[i] = (EXPR); \
+  } \
+}
+
+DEFINE_AVX2_BINARY(Add, _mm256_add_ps, a + b)
+DEFINE_AVX2_BINARY(Sub, _mm256_sub_ps, a - b)
+DEFINE_AVX2_BINARY(Mul, _mm256_mul_ps, a * b)
+DEFINE_AVX2_BINARY(Max, _mm256_max_ps, std::max(a, b))
+
+#undef DEFINE_AVX2_BINARY
+
+const Primitives g_AVX2Primitives = {
+  AxpyAVX2, AffineAVX2, DotAVX2, SumAVX2, MaxAVX2, LeakyReluAVX2,
+  { AddAVX2, SubAVX2, MulAVX2, MaxAVX2 }
+};
+
+//===----------------------------------------------------------------------===//
+// AVX-512 primitives
+//===----------------------------------------------------------------------===//
+ONNC_TARGET_AVX512
+void AxpyAVX512(size_t pN, float pA, const float* pX, float* pY)
+{
+  const __m512 a = _mm512_set1_ps(pA);
+  size_t i = 0;
+  for (; i + 16 <= pN; i += 16) {
+    __m512 y = _mm512_fmadd_ps(a, _mm512_loadu_ps(pX + i),
+                               _mm512_loadu_ps(pY + i));
+    _mm512_storeu_ps(pY + i, y);
+  }
+  for (; i < pN; ++i)
+    pY[i] += pA * pX[i];
+}
+
+ONNC_TARGET_AVX512
+void AffineAVX512(size_t pN, float pA, float pB, const float* pX, float* pY)
+{
+  const __m512 a = _mm512_set1_ps(pA);
+  const __m512 b = _mm512_set1_ps(pB);
+  size_t i = 0;
+  for (; i + 16 <= pN; i += 16)
+    _mm512_storeu_ps(pY + i, _mm512_fmadd_ps(a, _mm512_loadu_ps(pX + i), b));
+  for (; i < pN; ++i)
+    pY[i] = pA * pX[i] + pB;
+}
+
+ONNC_TARGET_AVX512 float DotAVX512(size_t pN, const float* pX, const float* pY)
+{
+  __m512 acc0 = _mm512_setzero_ps();
+  __m512 acc1 = _mm512_setzero_ps();
+  size_t i = 0;
+  for (; i + 32 <= pN; i += 32) {
+    acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(pX + i),
+                           _mm512_loadu_ps(pY + i), acc0);
+    acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(pX + i + 16),
+                           _mm512_loadu_ps(pY + i + 16), acc1);
+  }
+  for (; i + 16 <= pN; i += 16)
+    acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(pX + i),
+                           _mm512_loadu_ps(pY + i), acc0);
+  float result = _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+  for (; i < pN; ++i)
+    result += pX[i] * pY[i];
+  return result;
+}
+
+ONNC_TARGET_AVX512 float SumAVX512(size_t pN, const float* pX)
+{
+  __m512 acc = _mm512_setzero_ps();
+  size_t i = 0;
+  for (; i + 16 <= pN; i += 16)
+    acc = _mm512_add_ps(acc, _mm512_loadu_ps(pX + i));
+  float result = _mm512_reduce_add_ps(acc);
+  for (; i < pN; ++i)
+    result += pX[i];
+  return result;
+}
+
+ONNC_TARGET_AVX512 float MaxAVX512(size_t pN, const float* pX)
+{
+  __m512 acc = _mm512_set1_ps(-std::numeric_limits<float>::infinity());
+  size_t i = 0;
+  for (; i + 16 <= pN; i += 16)
+    acc = _mm512_max_ps(acc, _mm512_loadu_ps(pX + i));
+  float result = _mm512_reduce_max_ps(acc);
+  for (; i < pN; ++i)
+    result = std::max(result, pX[i]);
+  return result;
+}
+
+ONNC_TARGET_AVX512
+void LeakyReluAVX512(size_t pN, float pAlpha, const float* pX, float* pY)
+{
+  const __m512 zero = _mm512_setzero_ps();
+  const __m512 alpha = _mm512_set1_ps(pAlpha);
+  size_t i = 0;
+  for (; i + 16 <= pN; i += 16) {
+    __m512 x = _mm512_loadu_ps(pX + i);
+    __m512 y = _mm512_fmadd_ps(alpha, _mm512_min_ps(x, zero),
+                               _mm512_max_ps(x, zero));
+    _mm512_storeu_ps(pY + i, y);
+  }
+  for (; i < pN; ++i)
+    pY[i] = (pX[i] > 0.f) ? pX[i] : pAlpha * pX[i];
+}
+
+#define DEFINE_AVX512_BINARY(NAME, INTRINSIC, EXPR) \
+ONNC_TARGET_AVX512 \
+void NAME##AVX512(size_t pN, const float* pA, const float* pB, float* pC) \
+{ \
+  size_t i = 0; \
+  for (; i + 16 <= pN; i += 16) \
+    _mm512_storeu_ps(pC + i, INTRINSIC(_mm512_loadu_ps(pA + i), \
+                                       _mm512_loadu_ps(pB + i))); \
+  for (; i < pN; ++i) { \
+    const float a = pA[i], b = pB[i]; \
+    pC[i] = (EXPR); \
+  } \
+}
+
+DEFINE_AVX512_BINARY(Add, _mm512_add_ps, a + b)
+DEFINE_AVX512_BINARY(Sub, _mm512_sub_ps, a - b)
+DEFINE_AVX512_BINARY(Mul, _mm512_mul_ps, a * b)
+DEFINE_AVX512_BINARY(Max, _mm512_max_ps, std::max(a, b))
+
+#undef DEFINE_AVX512_BINARY
+
+const Primitives g_AVX512Primitives = {
+  AxpyAVX512, AffineAVX512, DotAVX512, SumAVX512, MaxAVX512, LeakyReluAVX512,
+  { AddAVX512, SubAVX512, MulAVX512, MaxAVX512 }
+};
+#endif // ONNC_X86_KERNEL_SIMD
+
+//===----------------------------------------------------------------------===//
+// Dispatching
+//===----------------------------------------------------------------------===//
+KernelISA DetectKernelISA()
+{
+#ifdef ONNC_X86_KERNEL_SIMD
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f"))
+    return kAVX512;
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    return kAVX2;
+#endif
+  return kScalar;
+}
+
+KernelISA HostKernelISA()
+{
+  static const KernelISA host = DetectKernelISA();
+  return host;
+}
+
+std::atomic<int> g_KernelISA(-1);
+
+const Primitives& GetPrimitives()
+{
+  switch (GetKernelISA()) {
+#ifdef ONNC_X86_KERNEL_SIMD
+  case kAVX512:
+    return g_AVX512Primitives;
+  case kAVX2:
+    return g_AVX2Primitives;
+#endif
+  default:
+    return g_ScalarPrimitives;
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+void Im2Col(const ConvParam& pParam, const float* pX, float* pCol)
+{
+  const int channels = pParam.C / pParam.group;
+  const int spatial = pParam.OH * pParam.OW;
+  for (int c = 0; c < channels; ++c) {
+    for (int kh = 0; kh < pParam.KH; ++kh) {
+      for (int kw = 0; kw < pParam.KW; ++kw) {
+        float* row = pCol + ((c * pParam.KH + kh) * pParam.KW + kw) * spatial;
+        for (int oh = 0; oh < pParam.OH; ++oh) {
+          float* out = row + oh * pParam.OW;
+          const int ih = oh * pParam.strideH - pParam.padT +
+                         kh * pParam.dilationH;
+          if (ih < 0 || ih >= pParam.H) {
+            std::fill(out, out + pParam.OW, 0.f);
+            continue;
+          }
+          const float* in = pX + (c * pParam.H + ih) * pParam.W;
+          for (int ow = 0; ow < pParam.OW; ++ow) {
+            const int iw = ow * pParam.strideW - pParam.padL +
+                           kw * pParam.dilationW;
+            out[ow] = (iw < 0 || iw >= pParam.W) ? 0.f : in[iw];
+          }
+        }
+      }
+    }
+  }
+}
+
+/// Align @ref pShape to @ref pRank by prepending ones.
+Shape Align(const Shape& pShape, size_t pRank)
+{
+  Shape result(pRank - pShape.size(), 1);
+  result.insert(result.end(), pShape.begin(), pShape.end());
+  return result;
+}
+
+inline float ApplyBinary(BinaryOp pOp, float pA, float pB)
+{
+  switch (pOp) {
+  case kAddOp: return pA + pB;
+  case kSubOp: return pA - pB;
+  case kMulOp: return pA * pB;
+  case kMaxOp: return std::max(pA, pB);
+  }
+  return 0.f;
+}
+
+} // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// Non-member functions
+//===----------------------------------------------------------------------===//
+KernelISA onnc::x86::GetKernelISA()
+{
+  int isa = g_KernelISA.load(std::memory_order_relaxed);
+  if (isa < 0) {
+    isa = HostKernelISA();
+    g_KernelISA.store(isa, std::memory_order_relaxed);
+  }
+  return static_cast<KernelISA>(isa);
+}
+
+KernelISA onnc::x86::SetKernelISA(KernelISA pISA)
+{
+  KernelISA isa = std::min(pISA, HostKernelISA());
+  g_KernelISA.store(isa, std::memory_order_relaxed);
+  return isa;
+}
+
+const char* onnc::x86::GetKernelISAName(KernelISA pISA)
+{
+  switch (pISA) {
+  case kAVX512: return "avx512";
+  case kAVX2:   return "avx2";
+  default:      return "scalar";
+  }
+}
+
+size_t onnc::x86::GetNumOfElements(const Shape& pShape)
+{
+  size_t result = 1;
+  for (int64_t dim : pShape)
+    result *= dim;
+  return result;
+}
+
+void onnc::x86::Gemm(bool pTransA, bool pTransB, int pM, int pN, int pK,
+                     float pAlpha, const float* pA, const float* pB,
+                     float pBeta, float* pC)
+{
+  const Primitives& prim = GetPrimitives();
+
+  // C = beta * C
+  for (int i = 0; i < pM; ++i) {
+    float* c = pC + (size_t)i * pN;
+    if (0.f == pBeta)
+      std::fill(c, c + pN, 0.f);
+    else if (1.f != pBeta)
+      prim.affine(pN, pBeta, 0.f, c, c);
+  }
+
+  if (!pTransB) {
+    // C[i,:] += alpha * op(A)[i,k] * B[k,:]. Block on N and K so that the
+    // rows of B touched by one block stay in cache across all rows of C.
+    const int kBlockN = 1024;
+    const int kBlockK = 128;
+    for (int n0 = 0; n0 < pN; n0 += kBlockN) {
+      const int nb = std::min(kBlockN, pN - n0);
+      for (int k0 = 0; k0 < pK; k0 += kBlockK) {
+        const int kEnd = std::min(k0 + kBlockK, pK);
+        for (int i = 0; i < pM; ++i) {
+          float* c = pC + (size_t)i * pN + n0;
+          for (int k = k0; k < kEnd; ++k) {
+            float a = pTransA ? pA[(size_t)k * pM + i] : pA[(size_t)i * pK + k];
+            prim.axpy(nb, pAlpha * a, pB + (size_t)k * pN + n0, c);
+          }
+        }
+      }
+    }
+    return;
+  }
+
+  // op(B) = B^T, B is [N, K]. Both rows are contiguous, use dot products.
+  std::vector<float> column(pTransA ? pK : 0);
+  for (int i = 0; i < pM; ++i) {
+    const float* a = pA + (size_t)i * pK;
+    if (pTransA) {
+      for (int k = 0; k < pK; ++k)
+        column[k] = pA[(size_t)k * pM + i];
+      a = column.data();
+    }
+    float* c = pC + (size_t)i * pN;
+    for (int j = 0; j < pN; ++j)
+      c[j] += pAlpha * prim.dot(pK, a, pB + (size_t)j * pK);
+  }
+}
+
+void onnc::x86::Conv2D(const ConvParam& pParam, const float* pX,
+                       const float* pW, const float* pB, float* pY)
+{
+  const int channels = pParam.C / pParam.group;
+  const int filters = pParam.M / pParam.group;
+  const int rows = channels * pParam.KH * pParam.KW;
+  const int spatial = pParam.OH * pParam.OW;
+
+  // 1x1 convolutions without padding and striding read the input directly.
+  const bool pointwise = (1 == pParam.KH && 1 == pParam.KW &&
+                          1 == pParam.strideH && 1 == pParam.strideW &&
+                          0 == pParam.padT && 0 == pParam.padL);
+
+  // One scratch buffer per thread, kept across calls.
+  static thread_local std::vector<float> col;
+  if (!pointwise)
+    col.resize((size_t)rows * spatial);
+
+  for (int n = 0; n < pParam.N; ++n) {
+    for (int g = 0; g < pParam.group; ++g) {
+      const float* x = pX + ((size_t)n * pParam.C + g * channels) *
+                            pParam.H * pParam.W;
+      float* y = pY + ((size_t)n * pParam.M + g * filters) * spatial;
+      const float* w = pW + (size_t)g * filters * rows;
+
+      const float* matrix = x;
+      if (!pointwise) {
+        Im2Col(pParam, x, col.data());
+        matrix = col.data();
+      }
+
+      float beta = 0.f;
+      if (nullptr != pB) {
+        for (int m = 0; m < filters; ++m) {
+          float* out = y + (size_t)m * spatial;
+          std::fill(out, out + spatial, pB[g * filters + m]);
+        }
+        beta = 1.f;
+      }
+      Gemm(false, false, filters, spatial, rows, 1.f, w, matrix, beta, y);
+    }
+  }
+}
+
+void onnc::x86::MaxPool2D(const PoolParam& pParam, const float* pX, float* pY)
+{
+  for (int nc = 0; nc < pParam.N * pParam.C; ++nc) {
+    const float* x = pX + (size_t)nc * pParam.H * pParam.W;
+    float* y = pY + (size_t)nc * pParam.OH * pParam.OW;
+    for (int oh = 0; oh < pParam.OH; ++oh) {
+      const int hBegin = std::max(oh * pParam.strideH - pParam.padT, 0);
+      const int hEnd = std::min(oh * pParam.strideH - pParam.padT + pParam.KH,
+                                pParam.H);
+      for (int ow = 0; ow < pParam.OW; ++ow) {
+        const int wBegin = std::max(ow * pParam.strideW - pParam.padL, 0);
+        const int wEnd = std::min(ow * pParam.strideW - pParam.padL + pParam.KW,
+                                  pParam.W);
+        float result = -std::numeric_limits<float>::infinity();
+        for (int h = hBegin; h < hEnd; ++h)
+          for (int w = wBegin; w < wEnd; ++w)
+            result = std::max(result, x[h * pParam.W + w]);
+        y[oh * pParam.OW + ow] = result;
+      }
+    }
+  }
+}
+
+void onnc::x86::AveragePool2D(const PoolParam& pParam,
+                              const float* pX, float* pY)
+{
+  for (int nc = 0; nc < pParam.N * pParam.C; ++nc) {
+    const float* x = pX + (size_t)nc * pParam.H * pParam.W;
+    float* y = pY + (size_t)nc * pParam.OH * pParam.OW;
+    for (int oh = 0; oh < pParam.OH; ++oh) {
+      const int hBegin = std::max(oh * pParam.strideH - pParam.padT, 0);
+      const int hEnd = std::min(oh * pParam.strideH - pParam.padT + pParam.KH,
+                                pParam.H);
+      for (int ow = 0; ow < pParam.OW; ++ow) {
+        const int wBegin = std::max(ow * pParam.strideW - pParam.padL, 0);
+        const int wEnd = std::min(ow * pParam.strideW - pParam.padL + pParam.KW,
+                                  pParam.W);
+        float sum = 0.f;
+        for (int h = hBegin; h < hEnd; ++h)
+          for (int w = wBegin; w < wEnd; ++w)
+            sum += x[h * pParam.W + w];
+        int count = pParam.countIncludePad ? pParam.KH * pParam.KW
+                                           : (hEnd - hBegin) * (wEnd - wBegin);
+        y[oh * pParam.OW + ow] = (count > 0) ? sum / count : 0.f;
+      }
+    }
+  }
+}
+
+void onnc::x86::GlobalMaxPool(int pN, int pC, int pSpatial,
+                              const float* pX, float* pY)
+{
+  const Primitives& prim = GetPrimitives();
+  for (int nc = 0; nc < pN * pC; ++nc)
+    pY[nc] = prim.max(pSpatial, pX + (size_t)nc * pSpatial);
+}
+
+void onnc::x86::GlobalAveragePool(int pN, int pC, int pSpatial,
+                                  const float* pX, float* pY)
+{
+  const Primitives& prim = GetPrimitives();
+  for (int nc = 0; nc < pN * pC; ++nc)
+    pY[nc] = prim.sum(pSpatial, pX + (size_t)nc * pSpatial) / pSpatial;
+}
+
+void onnc::x86::BatchNormalization(int pN, int pC, int pSpatial,
+                                   float pEpsilon, const float* pX,
+                                   const float* pScale, const float* pBias,
+                                   const float* pMean, const float* pVar,
+                                   float* pY)
+{
+  const Primitives& prim = GetPrimitives();
+  for (int c = 0; c < pC; ++c) {
+    const float a = pScale[c] / std::sqrt(pVar[c] + pEpsilon);
+    const float b = pBias[c] - pMean[c] * a;
+    for (int n = 0; n < pN; ++n) {
+      size_t offset = ((size_t)n * pC + c) * pSpatial;
+      prim.affine(pSpatial, a, b, pX + offset, pY + offset);
+    }
+  }
+}
+
+void onnc::x86::Relu(size_t pSize, const float* pX, float* pY)
+{
+  GetPrimitives().leaky_relu(pSize, 0.f, pX, pY);
+}
+
+void onnc::x86::LeakyRelu(size_t pSize, float pAlpha,
+                          const float* pX, float* pY)
+{
+  GetPrimitives().leaky_relu(pSize, pAlpha, pX, pY);
+}
+
+void onnc::x86::Sigmoid(size_t pSize, const float* pX, float* pY)
+{
+  for (size_t i = 0; i < pSize; ++i)
+    pY[i] = 1.f / (1.f + std::exp(-pX[i]));
+}
+
+void onnc::x86::Tanh(size_t pSize, const float* pX, float* pY)
+{
+  for (size_t i = 0; i < pSize; ++i)
+    pY[i] = std::tanh(pX[i]);
+}
+
+void onnc::x86::Softmax(int pOuter, int pInner, const float* pX, float* pY)
+{
+  const Primitives& prim = GetPrimitives();
+  for (int i = 0; i < pOuter; ++i) {
+    const float* x = pX + (size_t)i * pInner;
+    float* y = pY + (size_t)i * pInner;
+    const float max = prim.max(pInner, x);
+    for (int j = 0; j < pInner; ++j)
+      y[j] = std::exp(x[j] - max);
+    const float sum = prim.sum(pInner, y);
+    prim.affine(pInner, 1.f / sum, 0.f, y, y);
+  }
+}
+
+void onnc::x86::Binary(BinaryOp pOp,
+                       const Shape& pShapeA, const float* pA,
+                       const Shape& pShapeB, const float* pB,
+                       const Shape& pShapeC, float* pC)
+{
+  BinaryFn binary = GetPrimitives().binary[pOp];
+  const size_t size = GetNumOfElements(pShapeC);
+  if (GetNumOfElements(pShapeA) == size && GetNumOfElements(pShapeB) == size) {
+    binary(size, pA, pB, pC);
+    return;
+  }
+
+  const size_t rank = pShapeC.size();
+  const Shape a = Align(pShapeA, rank);
+  const Shape b = Align(pShapeB, rank);
+
+  // The innermost dimensions on which A and B agree form a contiguous block
+  // that the vectorized primitive handles in one call.
+  size_t inner = 1;
+  size_t split = rank;
+  while (split > 0 && a[split - 1] == b[split - 1]) {
+    inner *= pShapeC[split - 1];
+    --split;
+  }
+
+  // element strides of the outer dimensions. Broadcast dimensions have zero
+  // stride.
+  std::vector<size_t> strideA(rank, 0), strideB(rank, 0);
+  size_t sa = inner, sb = inner;
+  for (size_t d = split; d-- > 0; ) {
+    strideA[d] = (1 == a[d]) ? 0 : sa;
+    strideB[d] = (1 == b[d]) ? 0 : sb;
+    sa *= a[d];
+    sb *= b[d];
+  }
+
+  std::vector<int64_t> index(split, 0);
+  const size_t outer = size / inner;
+  for (size_t o = 0; o < outer; ++o) {
+    size_t offA = 0, offB = 0;
+    for (size_t d = 0; d < split; ++d) {
+      offA += index[d] * strideA[d];
+      offB += index[d] * strideB[d];
+    }
+
+    float* c = pC + o * inner;
+    if (1 < inner)
+      binary(inner, pA + offA, pB + offB, c);
+    else
+      *c = ApplyBinary(pOp, pA[offA], pB[offB]);
+
+    // increase the multi-dimensional index
+    for (size_t d = split; d-- > 0; ) {
+      if (++index[d] < pShapeC[d])
+        break;
+      index[d] = 0;
+    }
+  }
+}
+
+void onnc::x86::Concat(int pAxis, const std::vector<Shape>& pShapes,
+                       const std::vector<const float*>& pInputs,
+                       const Shape& pShapeY, float* pY)
+{
+  assert(pShapes.size() == pInputs.size() && "mismatched inputs of Concat");
+  size_t outer = 1;
+  for (int d = 0; d < pAxis; ++d)
+    outer *= pShapeY[d];
+
+  float* y = pY;
+  for (size_t o = 0; o < outer; ++o) {
+    for (size_t i = 0; i < pInputs.size(); ++i) {
+      const size_t block = GetNumOfElements(pShapes[i]) / outer;
+      std::memcpy(y, pInputs[i] + o * block, block * sizeof(float));
+      y += block;
+    }
+  }
+}
+
+void onnc::x86::Copy(size_t pBytes, const void* pX, void* pY)
+{
+  if (pX != pY)
+    std::memmove(pY, pX, pBytes);
+}
@@ -0,0 +1,131 @@
+//===- X86Kernels.h -------------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef TARGET_X86_X86_KERNELS_H
+#define TARGET_X86_X86_KERNELS_H
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace onnc {
+namespace x86 {
+
+/// The instruction set extension used by the vectorized primitives. The
+/// kernel library detects the best one at the first call and every kernel
+/// dispatches through it. kScalar is always available.
+enum KernelISA {
+  kScalar,
+  kAVX2,
+  kAVX512
+};
+
+/// The instruction set the kernels are dispatched to.
+KernelISA GetKernelISA();
+
+/// Force the kernels to use @ref pISA. The request is ignored if the host
+/// doesn't support @ref pISA.
+/// @return the instruction set in use after the request.
+KernelISA SetKernelISA(KernelISA pISA);
+
+const char* GetKernelISAName(KernelISA pISA);
+
+typedef std::vector<int64_t> Shape;
+
+/// @return the number of elements of a tensor of shape @ref pShape.
+size_t GetNumOfElements(const Shape& pShape);
+
+/** \struct ConvParam
+ *  \brief The geometry of a 2D convolution in NCHW layout.
+ */
+struct ConvParam
+{
+  int N, C, H, W;          ///< input
+  int M, KH, KW;           ///< weight [M, C/group, KH, KW]
+  int OH, OW;              ///< output [N, M, OH, OW]
+  int padT, padL;
+  int strideH, strideW;
+  int dilationH, dilationW;
+  int group;
+};
+
+/** \struct PoolParam
+ *  \brief The geometry of a 2D pooling in NCHW layout.
+ */
+struct PoolParam
+{
+  int N, C, H, W;
+  int KH, KW;
+  int OH, OW;
+  int padT, padL;
+  int strideH, strideW;
+  bool countIncludePad;
+};
+
+//===----------------------------------------------------------------------===//
+// Kernels. All tensors are dense float32 in row-major order.
+//===----------------------------------------------------------------------===//
+/// C = alpha * op(A) * op(B) + beta * C, where op(A) is [M, K] and op(B) is
+/// [K, N]. If @ref pBeta is zero, C is not read.
+void Gemm(bool pTransA, bool pTransB, int pM, int pN, int pK,
+          float pAlpha, const float* pA, const float* pB,
+          float pBeta, float* pC);
+
+/// Y = X (*) W + B. @ref pB may be nullptr.
+void Conv2D(const ConvParam& pParam, const float* pX, const float* pW,
+            const float* pB, float* pY);
+
+void MaxPool2D(const PoolParam& pParam, const float* pX, float* pY);
+
+void AveragePool2D(const PoolParam& pParam, const float* pX, float* pY);
+
+void GlobalMaxPool(int pN, int pC, int pSpatial, const float* pX, float* pY);
+
+void GlobalAveragePool(int pN, int pC, int pSpatial,
+                       const float* pX, float* pY);
+
+/// Inference-mode batch normalization over [N, C, spatial].
+void BatchNormalization(int pN, int pC, int pSpatial, float pEpsilon,
+                        const float* pX, const float* pScale,
+                        const float* pBias, const float* pMean,
+                        const float* pVar, float* pY);
+
+void Relu(size_t pSize, const float* pX, float* pY);
+
+void LeakyRelu(size_t pSize, float pAlpha, const float* pX, float* pY);
+
+void Sigmoid(size_t pSize, const float* pX, float* pY);
+
+void Tanh(size_t pSize, const float* pX, float* pY);
+
+/// Softmax along the inner dimension of a [pOuter, pInner] matrix.
+void Softmax(int pOuter, int pInner, const float* pX, float* pY);
+
+enum BinaryOp {
+  kAddOp,
+  kSubOp,
+  kMulOp,
+  kMaxOp
+};
+
+/// C = A op B with ONNX multidirectional broadcasting.
+void Binary(BinaryOp pOp,
+            const Shape& pShapeA, const float* pA,
+            const Shape& pShapeB, const float* pB,
+            const Shape& pShapeC, float* pC);
+
+/// Concatenate @ref pInputs along @ref pAxis of @ref pShapeY.
+void Concat(int pAxis, const std::vector<Shape>& pShapes,
+            const std::vector<const float*>& pInputs,
+            const Shape& pShapeY, float* pY);
+
+/// Copy @ref pBytes bytes. Used by the shape-only operators.
+void Copy(size_t pBytes, const void* pX, void* pY);
+
+} // namespace x86
+} // namespace onnc
+
+#endif
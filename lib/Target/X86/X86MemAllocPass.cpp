@@ -0,0 +1,177 @@
+//===- X86MemAllocPass.cpp ------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "X86MemAllocPass.h"
+#include "X86Backend.h"
+#include "X86Tensor.h"
+#include <onnc/IR/Compute/Initializer.h>
+#include <onnc/IR/Compute/InputOperator.h>
+#include <onnc/IR/Compute/OutputOperator.h>
+#include <onnc/Support/Casting.h>
+#include <onnc/Support/Debug.h>
+#include <onnc/Support/IOStream.h>
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#define DEBUG_TYPE "x86_mem_alloc"
+
+using namespace onnc;
+
+char X86MemAlloc::ID = 0;
+
+//===----------------------------------------------------------------------===//
+// Non-member functions
+//===----------------------------------------------------------------------===//
+static uint64_t AlignTo(uint64_t pValue, uint64_t pAlign)
+{
+  return (pValue + pAlign - 1) / pAlign * pAlign;
+}
+
+namespace {
+
+/// A value to be placed and the range of operator indices it lives in.
+struct LiveRange
+{
+  onnc::Value* value;
+  ComputeOperator* define;
+  ComputeOperand::Residence residence;
+  unsigned int start;
+  unsigned int end;
+  uint64_t size;
+  uint64_t offset;
+};
+
+/// A placed live range, kept in the active list ordered by offset.
+struct Region
+{
+  uint64_t offset;
+  uint64_t size;
+  unsigned int end;
+};
+
+} // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// X86MemAlloc
+//===----------------------------------------------------------------------===//
+X86MemAlloc::X86MemAlloc(X86Backend* pBackend)
+  : ModulePass(ID), m_pBackend(pBackend) {
+}
+
+Pass::ReturnType X86MemAlloc::runOnModule(::onnc::Module& pModule)
+{
+  m_pBackend->getValMemOpndMap().clear();
+
+  uint64_t weight_size = 0;
+  uint64_t neuron_size = 0;
+  Module::cg_iterator cg, cgEnd = pModule.cgEnd();
+  for (cg = pModule.cgBegin(); cg != cgEnd; ++cg)
+    neuron_size = allocComputeGraph(*cg->value(), weight_size, neuron_size);
+
+  m_pBackend->setWeightMemSize(weight_size);
+  m_pBackend->setNeuronMemSize(neuron_size);
+
+  DEBUG(dbgs() << "X86MemAlloc: weight " << weight_size << " bytes, neuron "
+               << neuron_size << " bytes\n");
+  return Pass::kModuleChanged;
+}
+
+uint64_t X86MemAlloc::allocComputeGraph(ComputeGraph& pCG,
+                                        uint64_t& pWeightSize,
+                                        uint64_t pNeuronBase)
+{
+  // number operators in execution order.
+  std::unordered_map<const ComputeOperator*, unsigned int> order;
+  unsigned int idx = 0;
+  ComputeGraph::iterator nodeIt, nEnd = pCG.end();
+  for (nodeIt = pCG.begin(); nodeIt != nEnd; ++nodeIt) {
+    ComputeOperator* node = nodeIt;
+    order[node] = idx++;
+  }
+
+  // collect live ranges. Values without users are never read, the kernels
+  // skip writing them.
+  std::vector<LiveRange> ranges;
+  for (nodeIt = pCG.begin(); nodeIt != nEnd; ++nodeIt) {
+    ComputeOperator* node = nodeIt;
+    ComputeOperand::Residence resd = ComputeOperand::kInternalResidence;
+    if (isa<Initializer>(node))
+      resd = ComputeOperand::kWeightResidence;
+    else if (isa<InputOperator>(node))
+      resd = ComputeOperand::kInputResidence;
+
+    for (unsigned int i = 0; i < node->getNumOfOutputs(); ++i) {
+      onnc::Value* value = node->getOutput(i);
+      if (value->getUses().empty())
+        continue;
+
+      LiveRange range = { value, node, resd, order[node], order[node],
+                          x86::SizeOfTensor(*value), 0 };
+      for (onnc::Use& use : value->getUses()) {
+        range.end = std::max(range.end, order[use.getUser()]);
+        if (isa<OutputOperator>(use.getUser()) &&
+            ComputeOperand::kInternalResidence == range.residence)
+          range.residence = ComputeOperand::kOutputResidence;
+      }
+      ranges.push_back(range);
+    }
+  }
+
+  // place ranges in order of their start. A region is released after its
+  // last user, so the output of an operator never overlaps its inputs.
+  std::vector<Region> active;
+  uint64_t neuron_end = pNeuronBase;
+  for (LiveRange& range : ranges) {
+    const uint64_t size = AlignTo(range.size, kAlignment);
+    if (ComputeOperand::kWeightResidence == range.residence) {
+      range.offset = pWeightSize;
+      pWeightSize += size;
+      continue;
+    }
+
+    active.erase(std::remove_if(active.begin(), active.end(),
+                                [&range](const Region& pRegion) {
+                                  return pRegion.end < range.start;
+                                }),
+                 active.end());
+
+    // first fit
+    uint64_t cursor = pNeuronBase;
+    std::vector<Region>::iterator pos = active.begin();
+    for (; pos != active.end(); ++pos) {
+      if (pos->offset >= cursor + size)
+        break;
+      cursor = std::max(cursor, pos->offset + pos->size);
+    }
+    active.insert(pos, Region{ cursor, size, range.end });
+    range.offset = cursor;
+    neuron_end = std::max(neuron_end, cursor + size);
+  }
+
+  // record the placement on every use of the values.
+  X86Backend::ValMemOpndMap& allocated = m_pBackend->getValMemOpndMap();
+  for (LiveRange& range : ranges) {
+    for (onnc::Use& use : range.value->getUses()) {
+      ComputeMemOperand* opnd =
+          pCG.addOperand<ComputeMemOperand>(*range.define, *use.getUser(),
+                                            *range.value, range.residence);
+      opnd->setStart(range.offset);
+      opnd->setLength(range.size);
+      allocated.insert({range.value, opnd});
+    }
+  }
+  return neuron_end;
+}
+
+//===----------------------------------------------------------------------===//
+// Factory method
+//===----------------------------------------------------------------------===//
+ModulePass* onnc::CreateX86MemAllocPass(X86Backend* pBackend)
+{
+  return new X86MemAlloc(pBackend);
+}
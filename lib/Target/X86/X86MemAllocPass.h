@@ -0,0 +1,59 @@
+//===- X86MemAllocPass.h --------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef TARGET_X86_X86_MEM_ALLOC_PASS_H
+#define TARGET_X86_X86_MEM_ALLOC_PASS_H
+#include <onnc/Core/ModulePass.h>
+#include <onnc/Core/PassSupport.h>
+#include <onnc/IR/ComputeGraph.h>
+
+namespace onnc {
+
+class X86Backend;
+
+/** \class X86MemAlloc
+ *  \brief Assign every value of the compute graphs a memory region.
+ *
+ *  Initializers are packed into the weight space. The other values share the
+ *  neuron space: a value lives from its defining operator to its last user,
+ *  and values whose live ranges don't overlap may occupy the same bytes.
+ *  Regions are placed first-fit and aligned to the widest vector register.
+ *
+ *  The pass creates one ComputeMemOperand per use, as BuildMemOpnd does for
+ *  Sophon, and records the regions in X86Backend::getValMemOpndMap().
+ */
+class X86MemAlloc : public ModulePass
+{
+public:
+  static char ID;
+
+  /// Alignment of every region, in bytes.
+  static const uint64_t kAlignment = 64;
+
+public:
+  X86MemAlloc(X86Backend* pBackend);
+
+  StringRef getPassName() const override { return "X86MemAlloc"; }
+
+  Pass::ReturnType runOnModule(::onnc::Module& pModule) override;
+
+private:
+  /// Allocate values of @ref pCG. Weights are appended to @ref pWeightSize
+  /// and neurons are placed above @ref pNeuronBase.
+  /// @return the end of the neuron space used by @ref pCG.
+  uint64_t allocComputeGraph(ComputeGraph& pCG, uint64_t& pWeightSize,
+                             uint64_t pNeuronBase);
+
+private:
+  X86Backend* m_pBackend;
+};
+
+ModulePass* CreateX86MemAllocPass(X86Backend* pBackend);
+
+} // namespace onnc
+
+#endif
@@ -0,0 +1,196 @@
+//===- X86Scheduler.cpp ---------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "X86Scheduler.h"
+#include <chrono>
+
+using namespace onnc;
+
+//===----------------------------------------------------------------------===//
+// X86Scheduler
+//===----------------------------------------------------------------------===//
+X86Scheduler::X86Scheduler(unsigned int pNumOfThreads)
+  : m_Queues(), m_Threads(),
+    m_pInterpreter(nullptr), m_pStepTimes(nullptr),
+    m_Degrees(), m_NumOfSteps(0), m_Remaining(0), m_Active(0),
+    m_Queued(0), m_Idle(0), m_IdleLock(), m_Ready(),
+    m_Lock(), m_Start(), m_Done(), m_Generation(0), m_Stop(false) {
+  if (0 == pNumOfThreads)
+    pNumOfThreads = 1;
+
+  for (unsigned int i = 0; i < pNumOfThreads; ++i)
+    m_Queues.emplace_back(new Queue());
+
+  for (unsigned int i = 1; i < pNumOfThreads; ++i)
+    m_Threads.emplace_back(&X86Scheduler::work, this, i);
+}
+
+X86Scheduler::~X86Scheduler()
+{
+  {
+    std::lock_guard<std::mutex> guard(m_Lock);
+    m_Stop = true;
+  }
+  m_Start.notify_all();
+  for (std::thread& thread : m_Threads)
+    thread.join();
+}
+
+void X86Scheduler::run(X86Interpreter& pInterpreter,
+                       std::vector<uint64_t>* pStepTimes)
+{
+  const X86Interpreter::Plan& plan = pInterpreter.plan();
+  if (plan.empty())
+    return;
+
+  if (nullptr != pStepTimes)
+    pStepTimes->resize(plan.size(), 0);
+
+  // the workers are asleep, reset the state of the run.
+  m_pInterpreter = &pInterpreter;
+  m_pStepTimes = pStepTimes;
+  if (m_NumOfSteps != plan.size()) {
+    m_Degrees.reset(new std::atomic<unsigned int>[plan.size()]);
+    m_NumOfSteps = plan.size();
+  }
+
+  unsigned int worker = 0;
+  for (unsigned int i = 0; i < plan.size(); ++i) {
+    m_Degrees[i].store(plan[i].degree, std::memory_order_relaxed);
+    if (0 == plan[i].degree) {
+      push(worker, i);
+      worker = (worker + 1) % m_Queues.size();
+    }
+  }
+  m_Remaining.store(plan.size(), std::memory_order_relaxed);
+  m_Active.store(m_Queues.size(), std::memory_order_relaxed);
+
+  {
+    std::lock_guard<std::mutex> guard(m_Lock);
+    ++m_Generation;
+  }
+  m_Start.notify_all();
+
+  execute(0);
+
+  // wait until no worker touches the state of this run.
+  std::unique_lock<std::mutex> lock(m_Lock);
+  if (1 != m_Active.fetch_sub(1, std::memory_order_acq_rel))
+    m_Done.wait(lock, [this] {
+      return 0 == m_Active.load(std::memory_order_acquire);
+    });
+}
+
+void X86Scheduler::work(unsigned int pWorker)
+{
+  uint64_t generation = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(m_Lock);
+      m_Start.wait(lock, [this, generation] {
+        return m_Stop || generation != m_Generation;
+      });
+      if (m_Stop)
+        return;
+      generation = m_Generation;
+    }
+
+    execute(pWorker);
+
+    std::lock_guard<std::mutex> guard(m_Lock);
+    if (1 == m_Active.fetch_sub(1, std::memory_order_acq_rel))
+      m_Done.notify_all();
+  }
+}
+
+void X86Scheduler::execute(unsigned int pWorker)
+{
+  typedef std::chrono::steady_clock Clock;
+  const X86Interpreter::Plan& plan = m_pInterpreter->plan();
+
+  while (0 != m_Remaining.load(std::memory_order_acquire)) {
+    unsigned int step;
+    if (!pop(pWorker, step) && !steal(pWorker, step)) {
+      idle();
+      continue;
+    }
+
+    Clock::time_point start = Clock::now();
+    plan[step].kernel(*m_pInterpreter, *plan[step].op);
+    if (nullptr != m_pStepTimes)
+      (*m_pStepTimes)[step] +=
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              Clock::now() - start).count();
+
+    // release the successors before the step is counted as done, so the
+    // run never looks finished while a step is still queued.
+    for (unsigned int succ : plan[step].successors)
+      if (1 == m_Degrees[succ].fetch_sub(1, std::memory_order_acq_rel))
+        push(pWorker, succ);
+
+    // wake up the sleeping workers to leave the run.
+    if (1 == m_Remaining.fetch_sub(1, std::memory_order_acq_rel)) {
+      std::lock_guard<std::mutex> guard(m_IdleLock);
+      m_Ready.notify_all();
+    }
+  }
+}
+
+void X86Scheduler::idle()
+{
+  std::unique_lock<std::mutex> lock(m_IdleLock);
+  m_Idle.fetch_add(1);
+  m_Ready.wait(lock, [this] {
+    return 0 != m_Queued.load() || 0 == m_Remaining.load();
+  });
+  m_Idle.fetch_sub(1);
+}
+
+void X86Scheduler::push(unsigned int pWorker, unsigned int pStep)
+{
+  {
+    Queue& queue = *m_Queues[pWorker];
+    std::lock_guard<std::mutex> guard(queue.lock);
+    queue.steps.push_back(pStep);
+  }
+
+  // a worker going to sleep either sees the step or is counted as idle
+  // before the step is counted. Taking the lock waits until it sleeps.
+  m_Queued.fetch_add(1);
+  if (0 != m_Idle.load()) {
+    std::lock_guard<std::mutex> guard(m_IdleLock);
+    m_Ready.notify_one();
+  }
+}
+
+bool X86Scheduler::pop(unsigned int pWorker, unsigned int& pStep)
+{
+  Queue& queue = *m_Queues[pWorker];
+  std::lock_guard<std::mutex> guard(queue.lock);
+  if (queue.steps.empty())
+    return false;
+  pStep = queue.steps.back();
+  queue.steps.pop_back();
+  m_Queued.fetch_sub(1);
+  return true;
+}
+
+bool X86Scheduler::steal(unsigned int pWorker, unsigned int& pStep)
+{
+  const unsigned int size = m_Queues.size();
+  for (unsigned int i = 1; i < size; ++i) {
+    Queue& victim = *m_Queues[(pWorker + i) % size];
+    std::lock_guard<std::mutex> guard(victim.lock);
+    if (victim.steps.empty())
+      continue;
+    pStep = victim.steps.front();
+    victim.steps.pop_front();
+    m_Queued.fetch_sub(1);
+    return true;
+  }
+  return false;
+}
@@ -0,0 +1,101 @@
+//===- X86Scheduler.h -----------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef TARGET_X86_X86_SCHEDULER_H
+#define TARGET_X86_X86_SCHEDULER_H
+#include <onnc/Target/X86/X86Interpreter.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace onnc {
+
+/** \class X86Scheduler
+ *  \brief Run the steps of an X86Interpreter plan on a pool of threads.
+ *
+ *  Every step keeps a counter of the steps it still waits for. A worker that
+ *  finishes a step decrements the counters of its successors and pushes the
+ *  ones reaching zero onto its own deque. A worker takes work from the back
+ *  of its deque and, when it is empty, steals from the front of the others.
+ *  A worker finding nothing to steal sleeps until a step is pushed or the
+ *  run is done.
+ *
+ *  The calling thread of run() is worker 0, so a pool of N threads spawns
+ *  N - 1 threads. They sleep between runs.
+ */
+class X86Scheduler
+{
+public:
+  explicit X86Scheduler(unsigned int pNumOfThreads);
+
+  ~X86Scheduler();
+
+  unsigned int getNumOfThreads() const { return m_Queues.size(); }
+
+  /// Run the plan of @ref pInterpreter once.
+  /// @param pStepTimes If not null, the time of step i in nanoseconds is
+  ///                   added to the i-th element.
+  void run(X86Interpreter& pInterpreter, std::vector<uint64_t>* pStepTimes);
+
+private:
+  /// A deque of ready steps. The owner works on the back, thieves on the
+  /// front.
+  struct Queue
+  {
+    std::mutex lock;
+    std::deque<unsigned int> steps;
+  };
+
+private:
+  /// The main loop of the spawned threads.
+  void work(unsigned int pWorker);
+
+  /// Run ready steps until the whole plan is done.
+  void execute(unsigned int pWorker);
+
+  void push(unsigned int pWorker, unsigned int pStep);
+
+  bool pop(unsigned int pWorker, unsigned int& pStep);
+
+  bool steal(unsigned int pWorker, unsigned int& pStep);
+
+  /// Sleep until a step is queued or the run is done.
+  void idle();
+
+private:
+  std::vector<std::unique_ptr<Queue> > m_Queues;
+  std::vector<std::thread> m_Threads;
+
+  // state of the current run
+  X86Interpreter* m_pInterpreter;
+  std::vector<uint64_t>* m_pStepTimes;
+  std::unique_ptr<std::atomic<unsigned int>[]> m_Degrees;
+  size_t m_NumOfSteps;
+  std::atomic<unsigned int> m_Remaining;
+  std::atomic<unsigned int> m_Active;
+
+  // the steps in the deques, and the workers sleeping for them
+  std::atomic<unsigned int> m_Queued;
+  std::atomic<unsigned int> m_Idle;
+  std::mutex m_IdleLock;
+  std::condition_variable m_Ready;
+
+  // wakes up the workers and waits for them
+  std::mutex m_Lock;
+  std::condition_variable m_Start;
+  std::condition_variable m_Done;
+  uint64_t m_Generation;
+  bool m_Stop;
+};
+
+} // namespace onnc
+
+#endif
@@ -0,0 +1,108 @@
+//===- X86Tensor.cpp ------------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "X86Tensor.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace onnc;
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+template<typename TensorType>
+static uint64_t CopyValues(const onnc::Value& pValue, void* pDest,
+                           uint64_t pLength)
+{
+  typedef typename TensorType::ValueList::value_type ElementType;
+  // read in place, borrowed values are not copied.
+  const TensorType& tensor = static_cast<const TensorType&>(pValue);
+
+  uint64_t count = std::min<uint64_t>(tensor.getNumOfValues(),
+                                      pLength / sizeof(ElementType));
+  char* dest = static_cast<char*>(pDest);
+  for (uint64_t i = 0; i < count; ++i) {
+    // element-wise copy, std::vector<bool> has no contiguous storage.
+    ElementType element = tensor.getValue(i);
+    std::memcpy(dest + i * sizeof(ElementType), &element, sizeof(ElementType));
+  }
+  return count * sizeof(ElementType);
+}
+
+//===----------------------------------------------------------------------===//
+// Non-member functions
+//===----------------------------------------------------------------------===//
+uint64_t onnc::x86::SizeOfElement(onnc::Value::Type pKind)
+{
+  switch (pKind) {
+  case onnc::Value::kBoolean:
+  case onnc::Value::kInt8:
+  case onnc::Value::kUint8:
+    return 1;
+  case onnc::Value::kInt16:
+  case onnc::Value::kUint16:
+    return 2;
+  case onnc::Value::kFloat:
+  case onnc::Value::kFloat16:
+  case onnc::Value::kInt32:
+  case onnc::Value::kUint32:
+    return 4;
+  case onnc::Value::kDouble:
+  case onnc::Value::kInt64:
+  case onnc::Value::kUint64:
+    return 8;
+  default:
+    return 0;
+  }
+}
+
+uint64_t onnc::x86::SizeOfTensor(const onnc::Value& pValue)
+{
+  return SizeOfElement(pValue.kind()) * GetNumOfElements(GetShape(pValue));
+}
+
+x86::Shape onnc::x86::GetShape(const onnc::Value& pValue)
+{
+  const onnc::Tensor& tensor = static_cast<const onnc::Tensor&>(pValue);
+  Shape shape(tensor.getNumOfDimensions());
+  for (unsigned int i = 0; i < tensor.getNumOfDimensions(); ++i)
+    shape[i] = tensor.dimension(i);
+  return shape;
+}
+
+uint64_t onnc::x86::CopyTensorData(const onnc::Value& pValue, void* pDest,
+                                   uint64_t pLength)
+{
+  switch (pValue.kind()) {
+  case onnc::Value::kFloat:
+    return CopyValues<FloatTensor>(pValue, pDest, pLength);
+  case onnc::Value::kFloat16:
+    return CopyValues<Float16Tensor>(pValue, pDest, pLength);
+  case onnc::Value::kBoolean:
+    return CopyValues<BooleanTensor>(pValue, pDest, pLength);
+  case onnc::Value::kInt8:
+    return CopyValues<Int8Tensor>(pValue, pDest, pLength);
+  case onnc::Value::kInt16:
+    return CopyValues<Int16Tensor>(pValue, pDest, pLength);
+  case onnc::Value::kInt32:
+    return CopyValues<Int32Tensor>(pValue, pDest, pLength);
+  case onnc::Value::kInt64:
+    return CopyValues<Int64Tensor>(pValue, pDest, pLength);
+  case onnc::Value::kUint8:
+    return CopyValues<Uint8Tensor>(pValue, pDest, pLength);
+  case onnc::Value::kUint16:
+    return CopyValues<Uint16Tensor>(pValue, pDest, pLength);
+  case onnc::Value::kUint32:
+    return CopyValues<Uint32Tensor>(pValue, pDest, pLength);
+  case onnc::Value::kUint64:
+    return CopyValues<Uint64Tensor>(pValue, pDest, pLength);
+  case onnc::Value::kDouble:
+    return CopyValues<DoubleTensor>(pValue, pDest, pLength);
+  default:
+    return 0;
+  }
+}
@@ -0,0 +1,36 @@
+//===- X86Tensor.h --------------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef TARGET_X86_X86_TENSOR_H
+#define TARGET_X86_X86_TENSOR_H
+#include "X86Kernels.h"
+#include <onnc/IR/Compute/Tensor.h>
+
+namespace onnc {
+namespace x86 {
+
+/// The size in bytes of one element of @ref pKind in X86 memory.
+/// Half-precision floats are kept in single precision, the same way the
+/// compute IR holds them.
+uint64_t SizeOfElement(onnc::Value::Type pKind);
+
+/// The size in bytes of the tensor @ref pValue in X86 memory.
+uint64_t SizeOfTensor(const onnc::Value& pValue);
+
+/// The dimensions of the tensor @ref pValue.
+Shape GetShape(const onnc::Value& pValue);
+
+/// Copy the constant data held by @ref pValue into @ref pDest.
+/// @param pLength The capacity of @ref pDest in bytes.
+/// @return the number of bytes written.
+uint64_t CopyTensorData(const onnc::Value& pValue, void* pDest,
+                        uint64_t pLength);
+
+} // namespace x86
+} // namespace onnc
+
+#endif
@@ -12,8 +12,13 @@
 #include <onnc/Support/IOStream.h>
 #include <onnc/Config/ONNX.h>
 #include <onnc/IR/Dump.h>
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
 #include <tuple>
 #include <stack>
+#include <unordered_map>
 
 using namespace onnc;
 
@@ -23,9 +28,12 @@ char TensorSel::ID = 0;
 // TensorSel
 //===----------------------------------------------------------------------===//
 TensorSel::TensorSel(const TargetBackend* pBackend)
-  : GraphBuildingPass(ID), m_pBackend(pBackend), m_LowerRegistry() {
+  : GraphBuildingPass(ID), m_pBackend(pBackend), m_LowerRegistry(),
+    m_NumOfThreads(std::max(std::thread::hardware_concurrency(), 1u)) {
   if (nullptr != m_pBackend) {
     m_pBackend->RegisterLowers(m_LowerRegistry);
+    if (0 != m_pBackend->options().getNumOfThreads())
+      setNumOfThreads(m_pBackend->options().getNumOfThreads());
   }
 }
 
@@ -34,6 +42,105 @@ TensorSel::~TensorSel()
   m_LowerRegistry.clear();
 }
 
+void TensorSel::setNumOfThreads(unsigned int pNumOfThreads)
+{
+  m_NumOfThreads = std::max(pNumOfThreads, 1u);
+}
+
+Pass::ReturnType TensorSel::runOnModule(::onnc::Module& pModule)
+{
+  if (!pModule.hasRootTensorGraph())
+    return Pass::kModuleNoChanged;
+
+  // the sequential path reports failures at the same graph and node.
+  GraphJobList jobs;
+  Module::tg_iterator tg, tEnd = pModule.tgEnd();
+  for (tg = pModule.tgBegin(); tg != tEnd; ++tg) {
+    ComputeGraph* cg = pModule.getComputeGraph(tg->value()->name());
+    if (nullptr == cg)
+      return GraphBuildingPass::runOnModule(pModule);
+    jobs.emplace_back(*tg->value(), *cg);
+  }
+
+  if (m_NumOfThreads <= 1 || jobs.size() <= 1 || !prepare(jobs))
+    return GraphBuildingPass::runOnModule(pModule);
+
+  std::vector<GraphJob*> parallel;
+  for (GraphJob& job : jobs) {
+    if (job.independent)
+      parallel.push_back(&job);
+  }
+  if (parallel.size() <= 1)
+    return GraphBuildingPass::runOnModule(pModule);
+
+  // lower the independent graphs without touching the module.
+  for (GraphJob* job : parallel)
+    job->cg->stage();
+
+  std::atomic<unsigned int> next(0);
+  auto work = [&parallel, &next] () {
+    for (unsigned int i = next++; i < parallel.size(); i = next++)
+      activate(*parallel[i]);
+  };
+
+  unsigned int numOfThreads = std::min<size_t>(m_NumOfThreads, parallel.size());
+  std::vector<std::thread> threads;
+  for (unsigned int i = 1; i < numOfThreads; ++i)
+    threads.emplace_back(work);
+  work();
+  for (std::thread& thread : threads)
+    thread.join();
+
+  // merge in the order of the sequential path. Graphs sharing value names
+  // see the values of the preceding graphs.
+  for (GraphJob& job : jobs) {
+    if (job.independent)
+      job.cg->commit();
+    else
+      activate(job);
+  }
+  return Pass::kModuleChanged;
+}
+
+bool TensorSel::prepare(GraphJobList& pJobs)
+{
+  // the first graph naming a value.
+  std::unordered_map<std::string, unsigned int> owners;
+  for (unsigned int i = 0; i < pJobs.size(); ++i) {
+    GraphJob& job = pJobs[i];
+    auto own = [&pJobs, &owners, &job, i] (const xValue* pValue) {
+      auto result = owners.emplace(pValue->uniqueName(), i);
+      if (!result.second && i != result.first->second) {
+        pJobs[result.first->second].independent = false;
+        job.independent = false;
+      }
+    };
+
+    xGraphNodeListIterator tg_node, tg_end = job.tg->end();
+    for (tg_node = job.tg->begin(); tg_node != tg_end; ++tg_node) {
+      Lower* lower = m_LowerRegistry.lookup(**tg_node);
+      if (nullptr == lower)
+        return false;
+      job.lowers.push_back(lower);
+
+      for (const xValue* xv : tg_node->inputs())
+        own(xv);
+      for (const xValue* xv : tg_node->outputs())
+        own(xv);
+    }
+  }
+  return true;
+}
+
+void TensorSel::activate(GraphJob& pJob)
+{
+  xGraphNodeListIterator tg_node = pJob.tg->begin();
+  for (Lower* lower : pJob.lowers) {
+    lower->activate(*pJob.cg, **tg_node);
+    ++tg_node;
+  }
+}
+
 Pass::ReturnType TensorSel::runOnGraphs(xGraph& pTG, ComputeGraph& pCG)
 {
   xGraphNodeListIterator tg_node, tg_end = pTG.end();
@@ -17,7 +17,7 @@ using namespace onnc;
 // ATenLower
 //===----------------------------------------------------------------------===//
 ATenLower::ATenLower()
-{
+  : Lower(xSymbol("ATen")) {
 }
 
 ATenLower::~ATenLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // AbsLower
 //===----------------------------------------------------------------------===//
 AbsLower::AbsLower()
-{
+  : Lower(xSymbol("Abs")) {
 }
 
 AbsLower::~AbsLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // AcosLower
 //===----------------------------------------------------------------------===//
 AcosLower::AcosLower()
-{
+  : Lower(xSymbol("Acos")) {
 }
 
 AcosLower::~AcosLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // AddLower
 //===----------------------------------------------------------------------===//
 AddLower::AddLower()
-{
+  : Lower(xSymbol("Add")) {
 }
 
 AddLower::~AddLower()
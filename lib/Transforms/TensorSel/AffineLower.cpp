@@ -17,7 +17,7 @@ using namespace onnc;
 // AffineLower
 //===----------------------------------------------------------------------===//
 AffineLower::AffineLower()
-{
+  : Lower(xSymbol("Affine")) {
 }
 
 AffineLower::~AffineLower()
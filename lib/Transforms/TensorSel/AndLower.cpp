@@ -17,7 +17,7 @@ using namespace onnc;
 // AndLower
 //===----------------------------------------------------------------------===//
 AndLower::AndLower()
-{
+  : Lower(xSymbol("And")) {
 }
 
 AndLower::~AndLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // ArgMaxLower
 //===----------------------------------------------------------------------===//
 ArgMaxLower::ArgMaxLower()
-{
+  : Lower(xSymbol("ArgMax")) {
 }
 
 ArgMaxLower::~ArgMaxLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // ArgMinLower
 //===----------------------------------------------------------------------===//
 ArgMinLower::ArgMinLower()
-{
+  : Lower(xSymbol("ArgMin")) {
 }
 
 ArgMinLower::~ArgMinLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // AsinLower
 //===----------------------------------------------------------------------===//
 AsinLower::AsinLower()
-{
+  : Lower(xSymbol("Asin")) {
 }
 
 AsinLower::~AsinLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // AtanLower
 //===----------------------------------------------------------------------===//
 AtanLower::AtanLower()
-{
+  : Lower(xSymbol("Atan")) {
 }
 
 AtanLower::~AtanLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // AveragePoolLower
 //===----------------------------------------------------------------------===//
 AveragePoolLower::AveragePoolLower()
-{
+  : Lower(xSymbol("AveragePool")) {
 }
 
 AveragePoolLower::~AveragePoolLower()
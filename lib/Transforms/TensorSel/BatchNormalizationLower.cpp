@@ -17,7 +17,7 @@ using namespace onnc;
 // BatchNormalizationLower
 //===----------------------------------------------------------------------===//
 BatchNormalizationLower::BatchNormalizationLower()
-{
+  : Lower(xSymbol("BatchNormalization")) {
 }
 
 BatchNormalizationLower::~BatchNormalizationLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // CastLower
 //===----------------------------------------------------------------------===//
 CastLower::CastLower()
-{
+  : Lower(xSymbol("Cast")) {
 }
 
 CastLower::~CastLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // CeilLower
 //===----------------------------------------------------------------------===//
 CeilLower::CeilLower()
-{
+  : Lower(xSymbol("Ceil")) {
 }
 
 CeilLower::~CeilLower()
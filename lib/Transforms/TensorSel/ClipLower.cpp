@@ -17,7 +17,7 @@ using namespace onnc;
 // ClipLower
 //===----------------------------------------------------------------------===//
 ClipLower::ClipLower()
-{
+  : Lower(xSymbol("Clip")) {
 }
 
 ClipLower::~ClipLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // ConcatLower
 //===----------------------------------------------------------------------===//
 ConcatLower::ConcatLower()
-{
+  : Lower(xSymbol("Concat")) {
 }
 
 ConcatLower::~ConcatLower()
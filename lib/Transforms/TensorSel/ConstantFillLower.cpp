@@ -17,7 +17,7 @@ using namespace onnc;
 // ConstantFillLower
 //===----------------------------------------------------------------------===//
 ConstantFillLower::ConstantFillLower()
-{
+  : Lower(xSymbol("ConstantFill")) {
 }
 
 ConstantFillLower::~ConstantFillLower()
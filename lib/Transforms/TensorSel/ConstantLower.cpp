@@ -17,7 +17,7 @@ using namespace onnc;
 // ConstantLower
 //===----------------------------------------------------------------------===//
 ConstantLower::ConstantLower()
-{
+  : Lower(xSymbol("Constant")) {
 }
 
 ConstantLower::~ConstantLower()
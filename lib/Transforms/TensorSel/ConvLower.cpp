@@ -17,7 +17,7 @@ using namespace onnc;
 // ConvLower
 //===----------------------------------------------------------------------===//
 ConvLower::ConvLower()
-{
+  : Lower(xSymbol("Conv")) {
 }
 
 ConvLower::~ConvLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // ConvTransposeLower
 //===----------------------------------------------------------------------===//
 ConvTransposeLower::ConvTransposeLower()
-{
+  : Lower(xSymbol("ConvTranspose")) {
 }
 
 ConvTransposeLower::~ConvTransposeLower()
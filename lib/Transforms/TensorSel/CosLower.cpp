@@ -17,7 +17,7 @@ using namespace onnc;
 // CosLower
 //===----------------------------------------------------------------------===//
 CosLower::CosLower()
-{
+  : Lower(xSymbol("Cos")) {
 }
 
 CosLower::~CosLower()
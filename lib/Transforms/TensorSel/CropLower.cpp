@@ -17,7 +17,7 @@ using namespace onnc;
 // CropLower
 //===----------------------------------------------------------------------===//
 CropLower::CropLower()
-{
+  : Lower(xSymbol("Crop")) {
 }
 
 CropLower::~CropLower()
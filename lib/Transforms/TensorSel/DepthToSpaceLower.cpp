@@ -17,7 +17,7 @@ using namespace onnc;
 // DepthToSpaceLower
 //===----------------------------------------------------------------------===//
 DepthToSpaceLower::DepthToSpaceLower()
-{
+  : Lower(xSymbol("DepthToSpace")) {
 }
 
 DepthToSpaceLower::~DepthToSpaceLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // DivLower
 //===----------------------------------------------------------------------===//
 DivLower::DivLower()
-{
+  : Lower(xSymbol("Div")) {
 }
 
 DivLower::~DivLower()
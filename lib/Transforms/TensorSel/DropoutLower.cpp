@@ -17,7 +17,7 @@ using namespace onnc;
 // DropoutLower
 //===----------------------------------------------------------------------===//
 DropoutLower::DropoutLower()
-{
+  : Lower(xSymbol("Dropout")) {
 }
 
 DropoutLower::~DropoutLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // EluLower
 //===----------------------------------------------------------------------===//
 EluLower::EluLower()
-{
+  : Lower(xSymbol("Elu")) {
 }
 
 EluLower::~EluLower()
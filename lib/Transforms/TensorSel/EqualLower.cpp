@@ -17,7 +17,7 @@ using namespace onnc;
 // EqualLower
 //===----------------------------------------------------------------------===//
 EqualLower::EqualLower()
-{
+  : Lower(xSymbol("Equal")) {
 }
 
 EqualLower::~EqualLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // ExpLower
 //===----------------------------------------------------------------------===//
 ExpLower::ExpLower()
-{
+  : Lower(xSymbol("Exp")) {
 }
 
 ExpLower::~ExpLower()
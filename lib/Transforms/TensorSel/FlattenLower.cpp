@@ -17,7 +17,7 @@ using namespace onnc;
 // FlattenLower
 //===----------------------------------------------------------------------===//
 FlattenLower::FlattenLower()
-{
+  : Lower(xSymbol("Flatten")) {
 }
 
 FlattenLower::~FlattenLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // FloorLower
 //===----------------------------------------------------------------------===//
 FloorLower::FloorLower()
-{
+  : Lower(xSymbol("Floor")) {
 }
 
 FloorLower::~FloorLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // GRULower
 //===----------------------------------------------------------------------===//
 GRULower::GRULower()
-{
+  : Lower(xSymbol("GRU")) {
 }
 
 GRULower::~GRULower()
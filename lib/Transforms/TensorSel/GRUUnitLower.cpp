@@ -17,7 +17,7 @@ using namespace onnc;
 // GRUUnitLower
 //===----------------------------------------------------------------------===//
 GRUUnitLower::GRUUnitLower()
-{
+  : Lower(xSymbol("GRUUnit")) {
 }
 
 GRUUnitLower::~GRUUnitLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // GatherLower
 //===----------------------------------------------------------------------===//
 GatherLower::GatherLower()
-{
+  : Lower(xSymbol("Gather")) {
 }
 
 GatherLower::~GatherLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // GemmLower
 //===----------------------------------------------------------------------===//
 GemmLower::GemmLower()
-{
+  : Lower(xSymbol("Gemm")) {
 }
 
 GemmLower::~GemmLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // GivenTensorFillLower
 //===----------------------------------------------------------------------===//
 GivenTensorFillLower::GivenTensorFillLower()
-{
+  : Lower(xSymbol("GivenTensorFill")) {
 }
 
 GivenTensorFillLower::~GivenTensorFillLower()
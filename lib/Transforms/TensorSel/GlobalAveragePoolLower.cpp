@@ -17,7 +17,7 @@ using namespace onnc;
 // GlobalAveragePoolLower
 //===----------------------------------------------------------------------===//
 GlobalAveragePoolLower::GlobalAveragePoolLower()
-{
+  : Lower(xSymbol("GlobalAveragePool")) {
 }
 
 GlobalAveragePoolLower::~GlobalAveragePoolLower()
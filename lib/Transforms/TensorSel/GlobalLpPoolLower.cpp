@@ -17,7 +17,7 @@ using namespace onnc;
 // GlobalLpPoolLower
 //===----------------------------------------------------------------------===//
 GlobalLpPoolLower::GlobalLpPoolLower()
-{
+  : Lower(xSymbol("GlobalLpPool")) {
 }
 
 GlobalLpPoolLower::~GlobalLpPoolLower()
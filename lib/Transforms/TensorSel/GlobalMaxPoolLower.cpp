@@ -17,7 +17,7 @@ using namespace onnc;
 // GlobalMaxPoolLower
 //===----------------------------------------------------------------------===//
 GlobalMaxPoolLower::GlobalMaxPoolLower()
-{
+  : Lower(xSymbol("GlobalMaxPool")) {
 }
 
 GlobalMaxPoolLower::~GlobalMaxPoolLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // GreaterLower
 //===----------------------------------------------------------------------===//
 GreaterLower::GreaterLower()
-{
+  : Lower(xSymbol("Greater")) {
 }
 
 GreaterLower::~GreaterLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // HardSigmoidLower
 //===----------------------------------------------------------------------===//
 HardSigmoidLower::HardSigmoidLower()
-{
+  : Lower(xSymbol("HardSigmoid")) {
 }
 
 HardSigmoidLower::~HardSigmoidLower()
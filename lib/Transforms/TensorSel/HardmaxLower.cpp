@@ -17,7 +17,7 @@ using namespace onnc;
 // HardmaxLower
 //===----------------------------------------------------------------------===//
 HardmaxLower::HardmaxLower()
-{
+  : Lower(xSymbol("Hardmax")) {
 }
 
 HardmaxLower::~HardmaxLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // IdentityLower
 //===----------------------------------------------------------------------===//
 IdentityLower::IdentityLower()
-{
+  : Lower(xSymbol("Identity")) {
 }
 
 IdentityLower::~IdentityLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // IfLower
 //===----------------------------------------------------------------------===//
 IfLower::IfLower()
-{
+  : Lower(xSymbol("If")) {
 }
 
 IfLower::~IfLower()
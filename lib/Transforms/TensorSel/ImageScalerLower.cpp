@@ -17,7 +17,7 @@ using namespace onnc;
 // ImageScalerLower
 //===----------------------------------------------------------------------===//
 ImageScalerLower::ImageScalerLower()
-{
+  : Lower(xSymbol("ImageScaler")) {
 }
 
 ImageScalerLower::~ImageScalerLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // InstanceNormalizationLower
 //===----------------------------------------------------------------------===//
 InstanceNormalizationLower::InstanceNormalizationLower()
-{
+  : Lower(xSymbol("InstanceNormalization")) {
 }
 
 InstanceNormalizationLower::~InstanceNormalizationLower()
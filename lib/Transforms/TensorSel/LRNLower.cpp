@@ -17,7 +17,7 @@ using namespace onnc;
 // LRNLower
 //===----------------------------------------------------------------------===//
 LRNLower::LRNLower()
-{
+  : Lower(xSymbol("LRN")) {
 }
 
 LRNLower::~LRNLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // LSTMLower
 //===----------------------------------------------------------------------===//
 LSTMLower::LSTMLower()
-{
+  : Lower(xSymbol("LSTM")) {
 }
 
 LSTMLower::~LSTMLower()
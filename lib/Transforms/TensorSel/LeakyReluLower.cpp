@@ -17,7 +17,7 @@ using namespace onnc;
 // LeakyReluLower
 //===----------------------------------------------------------------------===//
 LeakyReluLower::LeakyReluLower()
-{
+  : Lower(xSymbol("LeakyRelu")) {
 }
 
 LeakyReluLower::~LeakyReluLower()
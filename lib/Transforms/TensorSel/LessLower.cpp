@@ -17,7 +17,7 @@ using namespace onnc;
 // LessLower
 //===----------------------------------------------------------------------===//
 LessLower::LessLower()
-{
+  : Lower(xSymbol("Less")) {
 }
 
 LessLower::~LessLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // LogLower
 //===----------------------------------------------------------------------===//
 LogLower::LogLower()
-{
+  : Lower(xSymbol("Log")) {
 }
 
 LogLower::~LogLower()
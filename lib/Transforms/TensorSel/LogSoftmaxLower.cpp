@@ -17,7 +17,7 @@ using namespace onnc;
 // LogSoftmaxLower
 //===----------------------------------------------------------------------===//
 LogSoftmaxLower::LogSoftmaxLower()
-{
+  : Lower(xSymbol("LogSoftmax")) {
 }
 
 LogSoftmaxLower::~LogSoftmaxLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // LoopIndexTensorLower
 //===----------------------------------------------------------------------===//
 LoopIndexTensorLower::LoopIndexTensorLower()
-{
+  : Lower(xSymbol("LoopIndexTensor")) {
 }
 
 LoopIndexTensorLower::~LoopIndexTensorLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // LoopLower
 //===----------------------------------------------------------------------===//
 LoopLower::LoopLower()
-{
+  : Lower(xSymbol("Loop")) {
 }
 
 LoopLower::~LoopLower()
@@ -12,6 +12,14 @@ using namespace onnc;
 //===----------------------------------------------------------------------===//
 // Lower
 //===----------------------------------------------------------------------===//
+Lower::Lower()
+  : m_Name(), m_MatchFn(nullptr), m_Kinds() {
+}
+
+Lower::Lower(xNodeKind pKind)
+  : m_Name(), m_MatchFn(nullptr), m_Kinds(1, pKind) {
+}
+
 Lower::~Lower()
 {
   // do nothing.
@@ -13,7 +13,7 @@ using namespace onnc;
 // LowerRegistry
 //===----------------------------------------------------------------------===//
 LowerRegistry::LowerRegistry()
-  : m_LowerList() {
+  : m_LowerList(), m_KindLowers(), m_AnyKindLowers() {
 }
 
 LowerRegistry::~LowerRegistry()
@@ -58,28 +58,57 @@ void LowerRegistry::clear()
     delete *lower;
   }
   m_LowerList.clear();
+  m_KindLowers.clear();
+  m_AnyKindLowers.clear();
 }
 
 Lower* LowerRegistry::lookup(const xNode& pNode)
 {
-  int max = 0;
-  Lower* target = nullptr;
-  for (Lower* lower : m_LowerList) {
-    int score = lower->isMe(pNode);
-    if (score > max)
-      target = lower;
-  }
-  return target;
+  int target = select(pNode);
+  return (target < 0) ? nullptr : m_LowerList[target];
 }
 
 const Lower* LowerRegistry::lookup(const xNode& pNode) const
 {
-  int max = 0;
-  const Lower* target = nullptr;
-  for (const Lower* lower : m_LowerList) {
-    int score = lower->isMe(pNode);
-    if (score > max)
-      target = lower;
+  int target = select(pNode);
+  return (target < 0) ? nullptr : m_LowerList[target];
+}
+
+void LowerRegistry::add(Lower* pLower)
+{
+  unsigned int index = m_LowerList.size();
+  m_LowerList.push_back(pLower);
+
+  if (pLower->getKinds().empty()) {
+    m_AnyKindLowers.push_back(index);
+    return;
   }
+
+  for (const xNodeKind& kind : pLower->getKinds()) {
+    IndexList& bucket = m_KindLowers[kind];
+    if (bucket.empty() || bucket.back() != index)
+      bucket.push_back(index);
+  }
+}
+
+int LowerRegistry::select(const xNode& pNode) const
+{
+  int max = 0;
+  int target = -1;
+  auto score = [&] (const IndexList& pCandidates) {
+    for (unsigned int index : pCandidates) {
+      int s = m_LowerList[index]->isMe(pNode);
+      // the later registered lower wins a tie.
+      if (s > max || (s == max && 0 < s && (int)index > target)) {
+        max = s;
+        target = index;
+      }
+    }
+  };
+
+  KindLowerMap::const_iterator bucket = m_KindLowers.find(pNode.kind());
+  if (bucket != m_KindLowers.end())
+    score(bucket->second);
+  score(m_AnyKindLowers);
   return target;
 }
@@ -17,7 +17,7 @@ using namespace onnc;
 // LpNormalizationLower
 //===----------------------------------------------------------------------===//
 LpNormalizationLower::LpNormalizationLower()
-{
+  : Lower(xSymbol("LpNormalization")) {
 }
 
 LpNormalizationLower::~LpNormalizationLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // LpPoolLower
 //===----------------------------------------------------------------------===//
 LpPoolLower::LpPoolLower()
-{
+  : Lower(xSymbol("LpPool")) {
 }
 
 LpPoolLower::~LpPoolLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // MatMulLower
 //===----------------------------------------------------------------------===//
 MatMulLower::MatMulLower()
-{
+  : Lower(xSymbol("MatMul")) {
 }
 
 MatMulLower::~MatMulLower()
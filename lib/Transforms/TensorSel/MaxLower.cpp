@@ -17,7 +17,7 @@ using namespace onnc;
 // MaxLower
 //===----------------------------------------------------------------------===//
 MaxLower::MaxLower()
-{
+  : Lower(xSymbol("Max")) {
 }
 
 MaxLower::~MaxLower()
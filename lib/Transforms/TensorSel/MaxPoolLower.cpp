@@ -17,7 +17,7 @@ using namespace onnc;
 // MaxPoolLower
 //===----------------------------------------------------------------------===//
 MaxPoolLower::MaxPoolLower()
-{
+  : Lower(xSymbol("MaxPool")) {
 }
 
 MaxPoolLower::~MaxPoolLower()
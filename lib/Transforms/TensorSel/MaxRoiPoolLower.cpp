@@ -17,7 +17,7 @@ using namespace onnc;
 // MaxRoiPoolLower
 //===----------------------------------------------------------------------===//
 MaxRoiPoolLower::MaxRoiPoolLower()
-{
+  : Lower(xSymbol("MaxRoiPool")) {
 }
 
 MaxRoiPoolLower::~MaxRoiPoolLower()
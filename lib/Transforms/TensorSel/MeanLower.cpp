@@ -17,7 +17,7 @@ using namespace onnc;
 // MeanLower
 //===----------------------------------------------------------------------===//
 MeanLower::MeanLower()
-{
+  : Lower(xSymbol("Mean")) {
 }
 
 MeanLower::~MeanLower()
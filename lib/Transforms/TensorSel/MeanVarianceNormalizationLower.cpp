@@ -17,7 +17,7 @@ using namespace onnc;
 // MeanVarianceNormalizationLower
 //===----------------------------------------------------------------------===//
 MeanVarianceNormalizationLower::MeanVarianceNormalizationLower()
-{
+  : Lower(xSymbol("MeanVarianceNormalization")) {
 }
 
 MeanVarianceNormalizationLower::~MeanVarianceNormalizationLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // MinLower
 //===----------------------------------------------------------------------===//
 MinLower::MinLower()
-{
+  : Lower(xSymbol("Min")) {
 }
 
 MinLower::~MinLower()
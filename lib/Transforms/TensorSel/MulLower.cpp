@@ -17,7 +17,7 @@ using namespace onnc;
 // MulLower
 //===----------------------------------------------------------------------===//
 MulLower::MulLower()
-{
+  : Lower(xSymbol("Mul")) {
 }
 
 MulLower::~MulLower()
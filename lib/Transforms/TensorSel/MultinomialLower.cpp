@@ -17,7 +17,7 @@ using namespace onnc;
 // MultinomialLower
 //===----------------------------------------------------------------------===//
 MultinomialLower::MultinomialLower()
-{
+  : Lower(xSymbol("Multinomial")) {
 }
 
 MultinomialLower::~MultinomialLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // NegLower
 //===----------------------------------------------------------------------===//
 NegLower::NegLower()
-{
+  : Lower(xSymbol("Neg")) {
 }
 
 NegLower::~NegLower()
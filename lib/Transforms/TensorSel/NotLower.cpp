@@ -17,7 +17,7 @@ using namespace onnc;
 // NotLower
 //===----------------------------------------------------------------------===//
 NotLower::NotLower()
-{
+  : Lower(xSymbol("Not")) {
 }
 
 NotLower::~NotLower()
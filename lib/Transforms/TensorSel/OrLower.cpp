@@ -17,7 +17,7 @@ using namespace onnc;
 // OrLower
 //===----------------------------------------------------------------------===//
 OrLower::OrLower()
-{
+  : Lower(xSymbol("Or")) {
 }
 
 OrLower::~OrLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // PReluLower
 //===----------------------------------------------------------------------===//
 PReluLower::PReluLower()
-{
+  : Lower(xSymbol("PRelu")) {
 }
 
 PReluLower::~PReluLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // PadLower
 //===----------------------------------------------------------------------===//
 PadLower::PadLower()
-{
+  : Lower(xSymbol("Pad")) {
 }
 
 PadLower::~PadLower()
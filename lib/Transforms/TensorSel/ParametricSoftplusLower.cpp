@@ -17,7 +17,7 @@ using namespace onnc;
 // ParametricSoftplusLower
 //===----------------------------------------------------------------------===//
 ParametricSoftplusLower::ParametricSoftplusLower()
-{
+  : Lower(xSymbol("ParametricSoftplus")) {
 }
 
 ParametricSoftplusLower::~ParametricSoftplusLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // PowLower
 //===----------------------------------------------------------------------===//
 PowLower::PowLower()
-{
+  : Lower(xSymbol("Pow")) {
 }
 
 PowLower::~PowLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // RNNLower
 //===----------------------------------------------------------------------===//
 RNNLower::RNNLower()
-{
+  : Lower(xSymbol("RNN")) {
 }
 
 RNNLower::~RNNLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // RandomNormalLikeLower
 //===----------------------------------------------------------------------===//
 RandomNormalLikeLower::RandomNormalLikeLower()
-{
+  : Lower(xSymbol("RandomNormalLike")) {
 }
 
 RandomNormalLikeLower::~RandomNormalLikeLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // RandomNormalLower
 //===----------------------------------------------------------------------===//
 RandomNormalLower::RandomNormalLower()
-{
+  : Lower(xSymbol("RandomNormal")) {
 }
 
 RandomNormalLower::~RandomNormalLower()
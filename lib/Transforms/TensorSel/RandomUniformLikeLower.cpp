@@ -17,7 +17,7 @@ using namespace onnc;
 // RandomUniformLikeLower
 //===----------------------------------------------------------------------===//
 RandomUniformLikeLower::RandomUniformLikeLower()
-{
+  : Lower(xSymbol("RandomUniformLike")) {
 }
 
 RandomUniformLikeLower::~RandomUniformLikeLower()
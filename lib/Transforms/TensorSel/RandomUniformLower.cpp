@@ -17,7 +17,7 @@ using namespace onnc;
 // RandomUniformLower
 //===----------------------------------------------------------------------===//
 RandomUniformLower::RandomUniformLower()
-{
+  : Lower(xSymbol("RandomUniform")) {
 }
 
 RandomUniformLower::~RandomUniformLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // ReciprocalLower
 //===----------------------------------------------------------------------===//
 ReciprocalLower::ReciprocalLower()
-{
+  : Lower(xSymbol("Reciprocal")) {
 }
 
 ReciprocalLower::~ReciprocalLower()
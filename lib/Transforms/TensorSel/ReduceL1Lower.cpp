@@ -17,7 +17,7 @@ using namespace onnc;
 // ReduceL1Lower
 //===----------------------------------------------------------------------===//
 ReduceL1Lower::ReduceL1Lower()
-{
+  : Lower(xSymbol("ReduceL1")) {
 }
 
 ReduceL1Lower::~ReduceL1Lower()
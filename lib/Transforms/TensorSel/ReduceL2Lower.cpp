@@ -17,7 +17,7 @@ using namespace onnc;
 // ReduceL2Lower
 //===----------------------------------------------------------------------===//
 ReduceL2Lower::ReduceL2Lower()
-{
+  : Lower(xSymbol("ReduceL2")) {
 }
 
 ReduceL2Lower::~ReduceL2Lower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // ReduceLogSumExpLower
 //===----------------------------------------------------------------------===//
 ReduceLogSumExpLower::ReduceLogSumExpLower()
-{
+  : Lower(xSymbol("ReduceLogSumExp")) {
 }
 
 ReduceLogSumExpLower::~ReduceLogSumExpLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // ReduceLogSumLower
 //===----------------------------------------------------------------------===//
 ReduceLogSumLower::ReduceLogSumLower()
-{
+  : Lower(xSymbol("ReduceLogSum")) {
 }
 
 ReduceLogSumLower::~ReduceLogSumLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // ReduceMaxLower
 //===----------------------------------------------------------------------===//
 ReduceMaxLower::ReduceMaxLower()
-{
+  : Lower(xSymbol("ReduceMax")) {
 }
 
 ReduceMaxLower::~ReduceMaxLower()
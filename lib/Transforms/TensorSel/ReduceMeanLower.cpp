@@ -17,7 +17,7 @@ using namespace onnc;
 // ReduceMeanLower
 //===----------------------------------------------------------------------===//
 ReduceMeanLower::ReduceMeanLower()
-{
+  : Lower(xSymbol("ReduceMean")) {
 }
 
 ReduceMeanLower::~ReduceMeanLower()
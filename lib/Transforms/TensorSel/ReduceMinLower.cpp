@@ -17,7 +17,7 @@ using namespace onnc;
 // ReduceMinLower
 //===----------------------------------------------------------------------===//
 ReduceMinLower::ReduceMinLower()
-{
+  : Lower(xSymbol("ReduceMin")) {
 }
 
 ReduceMinLower::~ReduceMinLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // ReduceProdLower
 //===----------------------------------------------------------------------===//
 ReduceProdLower::ReduceProdLower()
-{
+  : Lower(xSymbol("ReduceProd")) {
 }
 
 ReduceProdLower::~ReduceProdLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // ReduceSumLower
 //===----------------------------------------------------------------------===//
 ReduceSumLower::ReduceSumLower()
-{
+  : Lower(xSymbol("ReduceSum")) {
 }
 
 ReduceSumLower::~ReduceSumLower()
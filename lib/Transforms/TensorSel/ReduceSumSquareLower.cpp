@@ -17,7 +17,7 @@ using namespace onnc;
 // ReduceSumSquareLower
 //===----------------------------------------------------------------------===//
 ReduceSumSquareLower::ReduceSumSquareLower()
-{
+  : Lower(xSymbol("ReduceSumSquare")) {
 }
 
 ReduceSumSquareLower::~ReduceSumSquareLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // ReluLower
 //===----------------------------------------------------------------------===//
 ReluLower::ReluLower()
-{
+  : Lower(xSymbol("Relu")) {
 }
 
 ReluLower::~ReluLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // ReshapeLower
 //===----------------------------------------------------------------------===//
 ReshapeLower::ReshapeLower()
-{
+  : Lower(xSymbol("Reshape")) {
 }
 
 ReshapeLower::~ReshapeLower()
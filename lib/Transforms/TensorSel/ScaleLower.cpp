@@ -17,7 +17,7 @@ using namespace onnc;
 // ScaleLower
 //===----------------------------------------------------------------------===//
 ScaleLower::ScaleLower()
-{
+  : Lower(xSymbol("Scale")) {
 }
 
 ScaleLower::~ScaleLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // ScaledTanhLower
 //===----------------------------------------------------------------------===//
 ScaledTanhLower::ScaledTanhLower()
-{
+  : Lower(xSymbol("ScaledTanh")) {
 }
 
 ScaledTanhLower::~ScaledTanhLower()
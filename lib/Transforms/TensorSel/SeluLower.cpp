@@ -17,7 +17,7 @@ using namespace onnc;
 // SeluLower
 //===----------------------------------------------------------------------===//
 SeluLower::SeluLower()
-{
+  : Lower(xSymbol("Selu")) {
 }
 
 SeluLower::~SeluLower()
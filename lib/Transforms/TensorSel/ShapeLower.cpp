@@ -17,7 +17,7 @@ using namespace onnc;
 // ShapeLower
 //===----------------------------------------------------------------------===//
 ShapeLower::ShapeLower()
-{
+  : Lower(xSymbol("Shape")) {
 }
 
 ShapeLower::~ShapeLower()
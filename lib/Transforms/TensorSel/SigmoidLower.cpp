@@ -17,7 +17,7 @@ using namespace onnc;
 // SigmoidLower
 //===----------------------------------------------------------------------===//
 SigmoidLower::SigmoidLower()
-{
+  : Lower(xSymbol("Sigmoid")) {
 }
 
 SigmoidLower::~SigmoidLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // SinLower
 //===----------------------------------------------------------------------===//
 SinLower::SinLower()
-{
+  : Lower(xSymbol("Sin")) {
 }
 
 SinLower::~SinLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // SizeLower
 //===----------------------------------------------------------------------===//
 SizeLower::SizeLower()
-{
+  : Lower(xSymbol("Size")) {
 }
 
 SizeLower::~SizeLower()
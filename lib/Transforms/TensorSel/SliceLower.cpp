@@ -17,7 +17,7 @@ using namespace onnc;
 // SliceLower
 //===----------------------------------------------------------------------===//
 SliceLower::SliceLower()
-{
+  : Lower(xSymbol("Slice")) {
 }
 
 SliceLower::~SliceLower()
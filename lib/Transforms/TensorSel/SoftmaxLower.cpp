@@ -17,7 +17,7 @@ using namespace onnc;
 // SoftmaxLower
 //===----------------------------------------------------------------------===//
 SoftmaxLower::SoftmaxLower()
-{
+  : Lower(xSymbol("Softmax")) {
 }
 
 SoftmaxLower::~SoftmaxLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // SoftplusLower
 //===----------------------------------------------------------------------===//
 SoftplusLower::SoftplusLower()
-{
+  : Lower(xSymbol("Softplus")) {
 }
 
 SoftplusLower::~SoftplusLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // SoftsignLower
 //===----------------------------------------------------------------------===//
 SoftsignLower::SoftsignLower()
-{
+  : Lower(xSymbol("Softsign")) {
 }
 
 SoftsignLower::~SoftsignLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // SpaceToDepthLower
 //===----------------------------------------------------------------------===//
 SpaceToDepthLower::SpaceToDepthLower()
-{
+  : Lower(xSymbol("SpaceToDepth")) {
 }
 
 SpaceToDepthLower::~SpaceToDepthLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // SplitLower
 //===----------------------------------------------------------------------===//
 SplitLower::SplitLower()
-{
+  : Lower(xSymbol("Split")) {
 }
 
 SplitLower::~SplitLower()
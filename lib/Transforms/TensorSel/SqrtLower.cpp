@@ -17,7 +17,7 @@ using namespace onnc;
 // SqrtLower
 //===----------------------------------------------------------------------===//
 SqrtLower::SqrtLower()
-{
+  : Lower(xSymbol("Sqrt")) {
 }
 
 SqrtLower::~SqrtLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // SqueezeLower
 //===----------------------------------------------------------------------===//
 SqueezeLower::SqueezeLower()
-{
+  : Lower(xSymbol("Squeeze")) {
 }
 
 SqueezeLower::~SqueezeLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // SubLower
 //===----------------------------------------------------------------------===//
 SubLower::SubLower()
-{
+  : Lower(xSymbol("Sub")) {
 }
 
 SubLower::~SubLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // SumLower
 //===----------------------------------------------------------------------===//
 SumLower::SumLower()
-{
+  : Lower(xSymbol("Sum")) {
 }
 
 SumLower::~SumLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // TanLower
 //===----------------------------------------------------------------------===//
 TanLower::TanLower()
-{
+  : Lower(xSymbol("Tan")) {
 }
 
 TanLower::~TanLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // TanhLower
 //===----------------------------------------------------------------------===//
 TanhLower::TanhLower()
-{
+  : Lower(xSymbol("Tanh")) {
 }
 
 TanhLower::~TanhLower()
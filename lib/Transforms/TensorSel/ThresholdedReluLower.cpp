@@ -17,7 +17,7 @@ using namespace onnc;
 // ThresholdedReluLower
 //===----------------------------------------------------------------------===//
 ThresholdedReluLower::ThresholdedReluLower()
-{
+  : Lower(xSymbol("ThresholdedRelu")) {
 }
 
 ThresholdedReluLower::~ThresholdedReluLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // TileLower
 //===----------------------------------------------------------------------===//
 TileLower::TileLower()
-{
+  : Lower(xSymbol("Tile")) {
 }
 
 TileLower::~TileLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // TopKLower
 //===----------------------------------------------------------------------===//
 TopKLower::TopKLower()
-{
+  : Lower(xSymbol("TopK")) {
 }
 
 TopKLower::~TopKLower()
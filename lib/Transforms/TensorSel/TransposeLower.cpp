@@ -17,7 +17,7 @@ using namespace onnc;
 // TransposeLower
 //===----------------------------------------------------------------------===//
 TransposeLower::TransposeLower()
-{
+  : Lower(xSymbol("Transpose")) {
 }
 
 TransposeLower::~TransposeLower()
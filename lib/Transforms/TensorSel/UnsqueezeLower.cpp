@@ -17,7 +17,7 @@ using namespace onnc;
 // UnsqueezeLower
 //===----------------------------------------------------------------------===//
 UnsqueezeLower::UnsqueezeLower()
-{
+  : Lower(xSymbol("Unsqueeze")) {
 }
 
 UnsqueezeLower::~UnsqueezeLower()
@@ -17,7 +17,7 @@ using namespace onnc;
 // UpsampleLower
 //===----------------------------------------------------------------------===//
 UpsampleLower::UpsampleLower()
-{
+  : Lower(xSymbol("Upsample")) {
 }
 
 UpsampleLower::~UpsampleLower()
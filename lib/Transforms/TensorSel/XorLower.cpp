@@ -17,7 +17,7 @@ using namespace onnc;
 // XorLower
 //===----------------------------------------------------------------------===//
 XorLower::XorLower()
-{
+  : Lower(xSymbol("Xor")) {
 }
 
 XorLower::~XorLower()
@@ -0,0 +1,154 @@
+//===- main.cpp -----------------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+// bm188x-sim runs the .cmd.bin or the .s file of the BM1880 backend on the
+// host, and reports the cycles and the DMA bandwidth of every instruction.
+#include "BM188xSimulator.h"
+#include <onnc/ADT/Color.h>
+#include <onnc/Config/AboutData.h>
+#include <onnc/Option/CommandLine.h>
+#include <onnc/Support/IOStream.h>
+#include <onnc/Support/Path.h>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace onnc;
+
+//===----------------------------------------------------------------------===//
+// Command Line Options
+//===----------------------------------------------------------------------===//
+static AboutData g_About("bm188x-sim",
+                         "bm188x-sim",
+                         "0.1.0",
+                         AboutLicense::kUnknown,
+                         "BM188x command buffer simulator");
+
+static cl::opt<Path> OptInput("input", cl::kPositional, cl::kOptional,
+    cl::kValueRequired,
+    cl::desc("The .cmd.bin file, or the .s file in text"),
+    cl::about(g_About));
+
+static cl::opt<Path> OptWeight("weight", cl::kLong, cl::kOptional,
+    cl::kValueRequired,
+    cl::desc("The .weight.bin file, at address 0 of the weights."),
+    cl::about(g_About));
+
+static cl::opt<Path> OptNeuron("neuron", cl::kLong, cl::kOptional,
+    cl::kValueRequired,
+    cl::desc("Raw int8 data at -neuron-addr of the neurons."),
+    cl::about(g_About));
+
+static cl::opt<unsigned int> OptNeuronAddr("neuron-addr", cl::kLong,
+    cl::kOptional, cl::kValueRequired, cl::init(0),
+    cl::desc("The address of the -neuron data (default is 0)."),
+    cl::about(g_About));
+
+static cl::opt<Path> OptDump("dump", cl::kLong, cl::kOptional,
+    cl::kValueRequired,
+    cl::desc("Write the neurons to <file> after the run."),
+    cl::about(g_About));
+
+static cl::opt<unsigned int> OptBanks("banks", cl::kLong, cl::kOptional,
+    cl::kValueRequired, cl::init(8),
+    cl::desc("Banks of a lane of the local memory (default is 8)."),
+    cl::about(g_About));
+
+static cl::opt<unsigned int> OptDMALatency("dma-latency", cl::kLong,
+    cl::kOptional, cl::kValueRequired, cl::init(0),
+    cl::desc("Cycles before a transfer starts (default is 0)."),
+    cl::about(g_About));
+
+static cl::opt<bool> OptHelp("help", cl::kLong, cl::kOptional,
+    cl::kValueDisallowed, cl::init(false),
+    cl::desc("Show this manual."),
+    cl::about(g_About));
+
+static cl::alias HelpAliasH("h", cl::kShort, cl::trueopt(OptHelp));
+static cl::alias HelpAliasQ("?", cl::kShort, cl::trueopt(OptHelp));
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+static bool ReadFile(const Path& pPath, std::string& pResult)
+{
+  std::ifstream input(pPath.native(), std::ifstream::binary);
+  if (!input.good())
+    return false;
+  pResult.assign(std::istreambuf_iterator<char>(input),
+                 std::istreambuf_iterator<char>());
+  return true;
+}
+
+static int Fatal(const std::string& pMessage, const Path& pPath)
+{
+  errs() << Color::MAGENTA << "Fatal" << Color::RESET << ": " << pMessage
+         << ": " << pPath << std::endl;
+  return EXIT_FAILURE;
+}
+
+//===----------------------------------------------------------------------===//
+// Main Procedure
+//===----------------------------------------------------------------------===//
+int main(int pArgc, char* pArgv[])
+{
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+  cl::ParseCommandLine(pArgc, pArgv);
+  if (OptHelp) {
+    g_About.print(outs());
+    return EXIT_SUCCESS;
+  }
+
+  BM188X::Simulator::Config config;
+  config.numOfBanks = std::max(std::min(OptBanks.getValue(), 64u), 1u);
+  config.dmaLatency = OptDMALatency;
+  BM188X::Simulator sim(config);
+
+  std::string text;
+  if (!ReadFile(OptInput, text))
+    return Fatal("input file not found", OptInput);
+  BM188X::Simulator::CommandBuffer buffer;
+  bool parsed = (OptInput.getValue().extension().native() == "s")
+                    ? BM188X::Simulator::Parse(text, buffer)
+                    : BM188X::Simulator::ParseBinary(text, buffer);
+  if (!parsed)
+    return Fatal("failed to parse the command buffer", OptInput);
+
+  std::string data;
+  if (OptWeight.hasOccurrence()) {
+    if (!ReadFile(OptWeight, data))
+      return Fatal("weight file not found", OptWeight);
+    sim.write(BM188X::Simulator::kWeight, 0, (const int8_t*)data.data(),
+              data.size());
+  }
+  if (OptNeuron.hasOccurrence()) {
+    if (!ReadFile(OptNeuron, data))
+      return Fatal("neuron file not found", OptNeuron);
+    sim.write(BM188X::Simulator::kNeuron, OptNeuronAddr,
+              (const int8_t*)data.data(), data.size());
+  }
+
+  BM188X::Simulator::Report report;
+  if (!sim.run(buffer, report))
+    return EXIT_FAILURE;
+  report.print(outs(), config.busBitWidth);
+
+  if (OptDump.hasOccurrence()) {
+    std::vector<int8_t> neurons(sim.size(BM188X::Simulator::kNeuron));
+    sim.read(BM188X::Simulator::kNeuron, 0, neurons.data(), neurons.size());
+    std::ofstream output(OptDump.getValue().native(), std::ofstream::binary);
+    output.write((const char*)neurons.data(), neurons.size());
+    if (!output.good())
+      return Fatal("can't write the neurons", OptDump);
+  }
+
+  google::protobuf::ShutdownProtobufLibrary();
+  return EXIT_SUCCESS;
+}
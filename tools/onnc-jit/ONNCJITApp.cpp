@@ -6,6 +6,7 @@
 //
 //===----------------------------------------------------------------------===//
 #include "ONNCJITApp.h"
+#include <onnc/Config/Config.h>
 #include <cstdlib>
 #include <onnc/Target/TargetSelect.h>
 #include <onnc/Target/TargetRegistry.h>
@@ -17,10 +18,36 @@
 #include <onnc/Core/PassManager.h>
 #include <onnc/ADT/Color.h>
 #include <onnc/Support/IOStream.h>
+#ifdef ENABLE_X86_TARGET
+#include <onnc/Target/X86/X86Interpreter.h>
+#endif
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <map>
 #include <string>
+#include <vector>
 
 using namespace onnc;
 
+//===----------------------------------------------------------------------===//
+// Non-member functions
+//===----------------------------------------------------------------------===//
+#ifdef ENABLE_X86_TARGET
+/// The nearest-rank percentile @ref pPercent of the sorted @ref pSamples.
+static uint64_t Percentile(const std::vector<uint64_t>& pSamples,
+                           unsigned int pPercent)
+{
+  size_t rank = (pSamples.size() * pPercent + 99) / 100;
+  return pSamples[std::max<size_t>(rank, 1) - 1];
+}
+
+static double ToMilliSeconds(uint64_t pNanoSeconds)
+{
+  return pNanoSeconds / 1e6;
+}
+#endif
+
 //===----------------------------------------------------------------------===//
 // ONNCJITApp
 //===----------------------------------------------------------------------===//
@@ -62,8 +89,107 @@ int ONNCJITApp::run()
   backend->addMemAlloc(pm);
   backend->addCodeEmit(pm, options().output());
 
-  pm.run(module);
+  if (!pm.run(module)) {
+    errs() << Color::RED << "Error" << Color::RESET
+           << ": failed to compile " << options().input() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return interpret(module);
+}
+
+int ONNCJITApp::interpret(Module& pModule)
+{
+#ifdef ENABLE_X86_TARGET
+  X86Interpreter interpreter;
+  const ComputeGraph* graph = pModule.getRootComputeGraph();
+  if (nullptr == graph || !interpreter.prepare(*graph)) {
+    errs() << Color::RED << "Error" << Color::RESET
+           << ": can not execute " << options().input() << std::endl;
+    return EXIT_FAILURE;
+  }
+  interpreter.setNumOfThreads(options().numOfThreads());
+
+  // the inputs are left zero-filled. The first run warms up the caches and
+  // the kernel scratch buffers and is not counted.
+  interpreter.run();
+
+  typedef std::chrono::steady_clock Clock;
+  const unsigned int repeat = options().repeat();
+  const X86Interpreter::Plan& plan = interpreter.plan();
+  std::vector<uint64_t> latency(repeat, 0);
+  std::vector<uint64_t> step_times(plan.size(), 0);
+  for (unsigned int i = 0; i < repeat; ++i) {
+    Clock::time_point start = Clock::now();
+    interpreter.run(&step_times);
+    latency[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     Clock::now() - start).count();
+  }
 
-  // TODO: just-in-time interpreter starts from here
+  uint64_t total = 0;
+  for (uint64_t time : latency)
+    total += time;
+  std::sort(latency.begin(), latency.end());
+
+  OStream& os = outs();
+  std::ios::fmtflags flags = os.flags();
+  os << std::fixed << std::setprecision(3);
+  os << "Executed " << plan.size() << " operators " << repeat
+     << " times on " << interpreter.getNumOfThreads() << " threads\n";
+  os << "Latency (ms): min " << ToMilliSeconds(latency.front())
+     << ", mean " << ToMilliSeconds(total / repeat)
+     << ", p50 " << ToMilliSeconds(Percentile(latency, 50))
+     << ", p90 " << ToMilliSeconds(Percentile(latency, 90))
+     << ", p99 " << ToMilliSeconds(Percentile(latency, 99))
+     << ", max " << ToMilliSeconds(latency.back()) << "\n";
+  if (0 != total)
+    os << "Throughput: " << (repeat * 1e9 / total) << " inferences/s\n";
+
+  // aggregate the steps by operator type.
+  std::map<std::string, std::pair<uint64_t, unsigned int> > by_type;
+  uint64_t step_total = 0;
+  for (size_t i = 0; i < plan.size(); ++i) {
+    std::pair<uint64_t, unsigned int>& entry = by_type[plan[i].op->name()];
+    entry.first += step_times[i];
+    entry.second += 1;
+    step_total += step_times[i];
+  }
+  std::vector<std::pair<std::string, std::pair<uint64_t, unsigned int> > >
+      rows(by_type.begin(), by_type.end());
+  std::sort(rows.begin(), rows.end(),
+            [](const decltype(rows)::value_type& pA,
+               const decltype(rows)::value_type& pB) {
+              return pA.second.first > pB.second.first;
+            });
+
+  // with several threads, the steps overlap and the sum exceeds latency.
+  os << "Per-operator time (ms per run):\n";
+  for (auto& row : rows) {
+    double percent = (0 == step_total) ? 0.0 :
+                                         100.0 * row.second.first / step_total;
+    os << "  " << std::left << std::setw(24) << row.first << std::right
+       << std::setw(6) << row.second.second << " ops "
+       << std::setw(12) << ToMilliSeconds(row.second.first) / repeat
+       << std::setw(8) << std::setprecision(1) << percent << "%\n"
+       << std::setprecision(3);
+  }
+
+  // every single operator in execution order.
+  if (ONNCJITConfig::kNormal <= options().verbose()) {
+    os << "Per-step time (ms per run):\n";
+    for (size_t i = 0; i < plan.size(); ++i) {
+      const onnc::Value* output = plan[i].op->getOutput(0);
+      os << "  " << std::setw(5) << i << " " << std::left << std::setw(24)
+         << plan[i].op->name() << std::setw(32) << output->getName()
+         << std::right << std::setw(12)
+         << ToMilliSeconds(step_times[i]) / repeat << "\n";
+    }
+  }
+  os.flags(flags);
   return EXIT_SUCCESS;
+#else
+  errs() << Color::RED << "Error" << Color::RESET
+         << ": onnc-jit requires the X86 target" << std::endl;
+  return EXIT_FAILURE;
+#endif
 }
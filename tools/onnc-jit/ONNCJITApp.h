@@ -8,6 +8,7 @@
 #ifndef ONNC_JUST_IN_TIME_INTERPRETER_APPLICATION_H
 #define ONNC_JUST_IN_TIME_INTERPRETER_APPLICATION_H
 #include <onnc/Core/Application.h>
+#include <onnc/IR/Module.h>
 #include "ONNCJITConfig.h"
 
 class ONNCJITApp : public onnc::CoreApplication
@@ -23,6 +24,10 @@ public:
 
   int run();
 
+private:
+  /// Execute the root compute graph of @ref pModule and report the time.
+  int interpret(onnc::Module& pModule);
+
 private:
   ONNCJITConfig m_Options;
 };
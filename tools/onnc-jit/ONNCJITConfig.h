@@ -59,6 +59,18 @@ public:
 
   unsigned int verbose() const { return m_Verbose; }
 
+  /// The number of timed runs of the interpreter.
+  void setRepeat(unsigned int pRepeat) { m_Repeat = pRepeat; }
+
+  unsigned int repeat() const { return m_Repeat; }
+
+  /// The number of threads running the operators.
+  void setNumOfThreads(unsigned int pNumOfThreads) {
+    m_NumOfThreads = pNumOfThreads;
+  }
+
+  unsigned int numOfThreads() const { return m_NumOfThreads; }
+
 private:
   onnc::Path m_Input;
   onnc::Path m_Output;
@@ -66,6 +78,8 @@ private:
   std::string m_Arch;
   onnc::TargetOptions m_TargetOptions;
   unsigned int m_Verbose;
+  unsigned int m_Repeat;
+  unsigned int m_NumOfThreads;
 };
 
 #endif
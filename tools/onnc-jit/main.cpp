@@ -11,6 +11,8 @@
 #include <onnc/Support/IOStream.h>
 #include <onnc/Option/CommandLine.h>
 #include <onnc/Config/AboutData.h>
+#include <algorithm>
+#include <thread>
 
 using namespace onnc;
 
@@ -58,6 +60,26 @@ OptQuiet("quiet", cl::kLong, cl::kOptional, cl::kValueDisallowed,
     cl::desc("Set verbose level to 0."),
     cl::about(g_About));
 
+static cl::opt<unsigned int>
+OptRepeat("repeat",
+    cl::kLong,
+    cl::kOptional,
+    cl::kValueRequired,
+    cl::kEqualSeparated,
+    cl::desc("Run the model <number> times and report latency (default is 1)."),
+    cl::init(1),
+    cl::about(g_About));
+
+static cl::opt<unsigned int>
+OptThreads("threads",
+    cl::kLong,
+    cl::kOptional,
+    cl::kValueRequired,
+    cl::kEqualSeparated,
+    cl::desc("Run operators on <number> threads, 0 for all cores (default is 1)."),
+    cl::init(1),
+    cl::about(g_About));
+
 static cl::opt<std::string> OptQuadruple("mquadruple", cl::kShort, cl::kOptional,
     cl::kValueRequired, cl::desc("target quadruple"), cl::about(g_About));
     
@@ -83,6 +105,24 @@ int main(int pArgc, char* pArgv[])
   if (OptQuiet)
     jit.options().setVerbose(0);
 
+  // --repeat=N
+  if (OptRepeat.hasOccurrence()) {
+    if (0 == OptRepeat) {
+      errs() << Color::MAGENTA << "Fatal" << Color::RESET
+             << ": --repeat must be at least 1" << std::endl;
+      return EXIT_FAILURE;
+    }
+    jit.options().setRepeat(OptRepeat);
+  }
+
+  // --threads=N
+  if (OptThreads.hasOccurrence()) {
+    unsigned int threads = OptThreads;
+    if (0 == threads)
+      threads = std::max(std::thread::hardware_concurrency(), 1u);
+    jit.options().setNumOfThreads(threads);
+  }
+
   // --help
   if (OptHelp) {
     g_About.print(outs(), ONNCJITConfig::kNormal < jit.options().verbose());
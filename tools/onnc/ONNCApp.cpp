@@ -14,13 +14,94 @@
 #include <onnc/IRReader/ONNXReader.h>
 #include <onnc/IR/Module.h>
 #include <onnc/IR/ONNXUtils.h>
+#include <onnc/Core/CompileCache.h>
 #include <onnc/Core/PassManager.h>
+#include <onnc/Core/PassTimingInfo.h>
 #include <onnc/ADT/Color.h>
 #include <onnc/Support/IOStream.h>
+#include <onnc/Support/IFStream.h>
+#include <onnc/Support/OFStream.h>
+#include <onnc/Support/SHA256.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <thread>
 
 using namespace onnc;
 
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+/// Read the manifest of --batch. Every line is
+///   <input> <output> [<quadruple>]
+/// Empty lines and lines starting with '#' are skipped. Models without a
+/// quadruple use @ref pQuadruple.
+static bool ReadManifest(const Path& pFile, const std::string& pQuadruple,
+                         ONNCApp::TaskList& pTasks, std::string& pError)
+{
+  IFStream manifest(pFile);
+  if (!manifest.is_open()) {
+    pError = "can not open " + pFile.native();
+    return false;
+  }
+
+  std::string line;
+  unsigned int line_no = 0;
+  while (std::getline(manifest, line)) {
+    ++line_no;
+    std::istringstream fields(line);
+    std::string input, output, quadruple;
+    if (!(fields >> input) || '#' == input[0])
+      continue;
+
+    if (!(fields >> output)) {
+      std::ostringstream message;
+      message << pFile.native() << ":" << line_no << ": no output file";
+      pError = message.str();
+      return false;
+    }
+
+    if (!(fields >> quadruple))
+      quadruple = pQuadruple;
+
+    pTasks.push_back(ONNCApp::Task{ Path(input), Path(output), quadruple });
+  }
+  return true;
+}
+
+/// The key of @ref pTask in the compile cache: the digest of the model, the
+/// target, the options and the name of the output, which the outputs refer
+/// to each other by.
+/// @retval false The model can not be read.
+static bool GetCacheKey(const ONNCApp::Task& pTask, const ONNCConfig& pConfig,
+                        std::string& pKey)
+{
+  SHA256 sha;
+  if (!sha.updateFile(pTask.input))
+    return false;
+
+  const TargetOptions& target = pConfig.target();
+  std::string flags;
+  flags.push_back(target.shouldPrintBeforeTensorSel() ? '1' : '0');
+  flags.push_back(target.shouldIgnoreCalibrationStep() ? '1' : '0');
+  flags.push_back(target.shouldUseDummyCTable() ? '1' : '0');
+  flags.push_back(target.shouldUseDummyWeight() ? '1' : '0');
+  flags.push_back(target.shouldPrintTextAsm() ? '1' : '0');
+  flags.push_back(target.shouldPipelineTiles() ? '1' : '0');
+
+  // separate the fields by NUL, which none of them has.
+  sha.update(StringRef("", 1));
+  sha.update(pTask.quadruple).update(StringRef("", 1));
+  sha.update(flags).update(StringRef("", 1));
+  sha.update(pTask.output.filename().native()).update(StringRef("", 1));
+  sha.update(pConfig.cacheArguments());
+  pKey = sha.final();
+  return true;
+}
+
 //===----------------------------------------------------------------------===//
 // ONNCApp
 //===----------------------------------------------------------------------===//
@@ -37,32 +118,162 @@ ONNCApp::~ONNCApp()
 
 int ONNCApp::compile()
 {
-  onnc::onnx::Reader reader;
-  Module module;
-  SystemError err = reader.parse(options().input(), module);
-  if (!err.isGood()) {
-    // TODO: show error message
+  if (!options().batch().empty())
+    return compileBatch();
+
+  Task task;
+  task.input = options().input();
+  task.output = options().output();
+  options().quadruple().canonical(task.quadruple);
+
+  PassTimingInfo timing;
+  bool timed = options().timePasses() || !options().timeTrace().empty();
+
+  std::string error;
+  if (!compile(task, timed ? &timing : nullptr, error)) {
+    errs() << Color::RED << "Error" << Color::RESET << ": " << error
+           << std::endl;
     return EXIT_FAILURE;
   }
 
-  std::string error;
+  if (options().timePasses())
+    timing.print(errs());
+
+  if (!options().timeTrace().empty()) {
+    OFStream trace(options().timeTrace(), std::ios::out | std::ios::binary);
+    if (!trace.is_open()) {
+      errs() << Color::RED << "Error" << Color::RESET
+             << ": can not open " << options().timeTrace() << std::endl;
+      return EXIT_FAILURE;
+    }
+    timing.printTrace(trace);
+  }
+  return EXIT_SUCCESS;
+}
+
+int ONNCApp::compileBatch()
+{
   std::string quadruple;
   options().quadruple().canonical(quadruple);
-  const onnc::Target* target = TargetRegistry::Lookup(quadruple, error);
-  if (nullptr == target) {
-    errs() << Color::RED << "Error" << Color::RESET
-           << ": can not found target `" << quadruple << "`: " << error
+
+  TaskList tasks;
+  std::string error;
+  if (!ReadManifest(options().batch(), quadruple, tasks, error)) {
+    errs() << Color::RED << "Error" << Color::RESET << ": " << error
            << std::endl;
     return EXIT_FAILURE;
   }
 
+  if (!options().timeTrace().empty()) {
+    errs() << Color::YELLOW << "Warning" << Color::RESET
+           << ": --time-trace is ignored in batch mode" << std::endl;
+  }
+
+  // reports of the tasks don't interleave.
+  std::mutex report_lock;
+  unsigned int done = 0, failures = 0;
+
+  std::atomic<unsigned int> next(0);
+  auto work = [this, &tasks, &next, &report_lock, &done, &failures] () {
+    for (unsigned int i = next++; i < tasks.size(); i = next++) {
+      PassTimingInfo timing;
+      std::string error;
+      bool success = compile(tasks[i],
+                             options().timePasses() ? &timing : nullptr,
+                             error);
+
+      std::lock_guard<std::mutex> guard(report_lock);
+      ++done;
+      if (!success) {
+        ++failures;
+        errs() << "[" << done << "/" << tasks.size() << "] "
+               << Color::RED << "Error" << Color::RESET << ": "
+               << tasks[i].input << ": " << error << std::endl;
+        continue;
+      }
+
+      if (ONNCConfig::kNotice <= options().verbose()) {
+        outs() << "[" << done << "/" << tasks.size() << "] "
+               << tasks[i].input << " -> " << tasks[i].output << std::endl;
+      }
+
+      // the reports of the jobs are told apart by their models.
+      if (options().timePasses())
+        timing.print(errs(), tasks[i].input.native());
+    }
+  };
+
+  unsigned int numOfThreads = std::min<size_t>(options().numOfJobs(),
+                                               tasks.size());
+
+  // the jobs share the hardware threads, so the passes of a job don't
+  // oversubscribe them.
+  if (0 == options().target().getNumOfThreads()) {
+    unsigned int hardware = std::max(std::thread::hardware_concurrency(), 1u);
+    options().target().setNumOfThreads(
+        std::max(hardware / std::max(numOfThreads, 1u), 1u));
+  }
+
+  std::vector<std::thread> threads;
+  for (unsigned int i = 1; i < numOfThreads; ++i)
+    threads.emplace_back(work);
+  work();
+  for (std::thread& thread : threads)
+    thread.join();
+
+  return (0 == failures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+bool ONNCApp::compile(const Task& pTask, PassTimingInfo* pTiming,
+                      std::string& pError) const
+{
+  std::string error;
+  const onnc::Target* target = TargetRegistry::Lookup(pTask.quadruple, error);
+  if (nullptr == target) {
+    pError = "can not found target `" + pTask.quadruple + "`: " + error;
+    return false;
+  }
+
+  // passes refer to the backend, so the backend outlives the PassManager.
+  std::unique_ptr<TargetBackend> backend(
+      target->createBackend(options().target()));
+
+  // --cache-dir. A hit skips parsing and all passes.
+  CompileCache cache(options().cacheDir());
+  CompileCache::FileList outputs;
+  std::string key;
+  if (!options().cacheDir().empty()) {
+    backend->getOutputFiles(pTask.output, outputs);
+    if (!outputs.empty() && !GetCacheKey(pTask, options(), key)) {
+      pError = "can not read " + pTask.input.native();
+      return false;
+    }
+    if (!key.empty() && cache.retrieve(key, outputs))
+      return true;
+  }
+
+  onnc::onnx::Reader reader;
+  Module module;
+  SystemError err = reader.parse(pTask.input, module);
+  if (!err.isGood()) {
+    pError = "can not read " + pTask.input.native();
+    return false;
+  }
+
   PassManager pm;
-  TargetBackend* backend = target->createBackend(options().target());
   backend->addTensorSel(pm);
   backend->addTensorSched(pm);
   backend->addMemAlloc(pm);
-  backend->addCodeEmit(pm, options().output());
+  backend->addCodeEmit(pm, pTask.output);
 
-  pm.run(module);
-  return EXIT_SUCCESS;
+  pm.setTimingInfo(pTiming);
+  if (!pm.run(module)) {
+    pError = "fail to compile " + pTask.input.native();
+    return false;
+  }
+
+  // failing to store only costs the next compilation.
+  if (!key.empty())
+    cache.store(key, outputs);
+  return true;
 }
@@ -8,10 +8,28 @@
 #ifndef ONNC_COMPILER_APPLICATION_H
 #define ONNC_COMPILER_APPLICATION_H
 #include <onnc/Core/Application.h>
+#include <onnc/Support/Path.h>
 #include "ONNCConfig.h"
+#include <string>
+#include <vector>
+
+namespace onnc {
+class PassTimingInfo;
+} // namespace onnc
 
 class ONNCApp : public onnc::CoreApplication
 {
+public:
+  /// A model to compile.
+  struct Task
+  {
+    onnc::Path input;
+    onnc::Path output;
+    std::string quadruple;
+  };
+
+  typedef std::vector<Task> TaskList;
+
 public:
   ONNCApp(int pArgc, char* pArgv[]);
 
@@ -21,8 +39,20 @@ public:
 
   const ONNCConfig& options() const { return m_Options; }
 
+  /// Compile the input, or every model in the manifest of --batch.
   int compile();
 
+private:
+  /// Compile the models of the manifest on a pool of options().numOfJobs()
+  /// threads. Every model has its own Module, backend and PassManager.
+  int compileBatch();
+
+  /// Compile one model. Thread-safe.
+  /// @param pTiming If not null, measure the passes in it.
+  /// @param[out] pError The reason of the failure.
+  bool compile(const Task& pTask, onnc::PassTimingInfo* pTiming,
+               std::string& pError) const;
+
 private:
   ONNCConfig m_Options;
 };
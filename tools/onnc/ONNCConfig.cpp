@@ -6,6 +6,8 @@
 //
 //===----------------------------------------------------------------------===//
 #include "ONNCConfig.h"
+#include <algorithm>
+#include <thread>
 
 using namespace onnc;
 
@@ -13,7 +15,10 @@ using namespace onnc;
 // ONNCConfig
 //===----------------------------------------------------------------------===//
 ONNCConfig::ONNCConfig()
-  : m_Input(), m_Output(), m_Quadruple(), m_Arch(), m_TargetOptions() {
+  : m_Input(), m_Output(), m_Quadruple(), m_Arch(), m_TargetOptions(),
+    m_Verbose(kNotice), m_bTimePasses(false), m_TimeTrace(), m_Batch(),
+    m_NumOfJobs(std::max(std::thread::hardware_concurrency(), 1u)),
+    m_CacheDir(), m_CacheArguments() {
 }
 
 ONNCConfig::~ONNCConfig()
@@ -11,6 +11,7 @@
 #include <onnc/Support/Path.h>
 #include <onnc/IR/Quadruple.h>
 #include <onnc/Target/TargetOptions.h>
+#include <string>
 #include <vector>
 
 /** \class ONNCConfig
@@ -59,6 +60,39 @@ public:
 
   unsigned int verbose() const { return m_Verbose; }
 
+  /// --time-passes
+  void setTimePasses(bool pEnable) { m_bTimePasses = pEnable; }
+
+  bool timePasses() const { return m_bTimePasses; }
+
+  /// The file of the Chrome trace of the passes. Empty for no trace.
+  void setTimeTrace(const onnc::Path& pFileName) { m_TimeTrace = pFileName; }
+
+  const onnc::Path& timeTrace() const { return m_TimeTrace; }
+
+  /// --batch. The manifest of the models to compile. Empty for one model.
+  void setBatch(const onnc::Path& pFileName) { m_Batch = pFileName; }
+
+  const onnc::Path& batch() const { return m_Batch; }
+
+  /// -j. The number of models compiled at the same time in batch mode.
+  void setNumOfJobs(unsigned int pNumOfJobs) { m_NumOfJobs = pNumOfJobs; }
+
+  unsigned int numOfJobs() const { return m_NumOfJobs; }
+
+  /// --cache-dir. The directory of the compile cache. Empty for no cache.
+  void setCacheDir(const onnc::Path& pDir) { m_CacheDir = pDir; }
+
+  const onnc::Path& cacheDir() const { return m_CacheDir; }
+
+  /// The compiler and the arguments changing the outputs. Part of the key of
+  /// the compile cache.
+  void setCacheArguments(const std::string& pArgs) {
+    m_CacheArguments = pArgs;
+  }
+
+  const std::string& cacheArguments() const { return m_CacheArguments; }
+
 private:
   onnc::Path m_Input;
   onnc::Path m_Output;
@@ -66,6 +100,12 @@ private:
   std::string m_Arch;
   onnc::TargetOptions m_TargetOptions;
   unsigned int m_Verbose;
+  bool m_bTimePasses;
+  onnc::Path m_TimeTrace;
+  onnc::Path m_Batch;
+  unsigned int m_NumOfJobs;
+  onnc::Path m_CacheDir;
+  std::string m_CacheArguments;
 };
 
 #endif
@@ -7,10 +7,14 @@
 //===----------------------------------------------------------------------===//
 #include "ONNCApp.h"
 #include <onnc/ADT/Color.h>
+#include <onnc/Support/FileSystem.h>
 #include <onnc/Support/Host.h>
 #include <onnc/Support/IOStream.h>
 #include <onnc/Option/CommandLine.h>
 #include <onnc/Config/AboutData.h>
+#include <onnc/Core/InitializePasses.h>
+#include <algorithm>
+#include <sys/stat.h>
 
 using namespace onnc;
 
@@ -64,11 +68,101 @@ static cl::opt<std::string> OptQuadruple("mquadruple", cl::kShort, cl::kOptional
 static cl::opt<std::string> OptMArch("march", cl::kShort, cl::kOptional,
     cl::kValueRequired, cl::desc("target architecture"), cl::about(g_About));
 
+static cl::opt<bool> OptTimePasses("time-passes", cl::kLong, cl::kOptional,
+    cl::kValueDisallowed, cl::init(false),
+    cl::desc("Report the time and the memory every pass takes."),
+    cl::about(g_About));
+
+static cl::opt<std::string> OptTimeTrace("time-trace", cl::kLong,
+    cl::kOptional, cl::kValueRequired,
+    cl::desc("Write the passes to <file> in the Chrome trace event format."),
+    cl::about(g_About));
+
+static cl::opt<Path> OptBatch("batch", cl::kLong, cl::kOptional,
+    cl::kValueRequired,
+    cl::desc("Compile the models listed in <file>. Every line is "
+             "`<input> <output> [<quadruple>]`."),
+    cl::about(g_About));
+
+static cl::opt<unsigned int> OptJobs("j", cl::kShort, cl::kOptional,
+    cl::kValueRequired,
+    cl::desc("Compile <number> models at the same time in batch mode "
+             "(default is the number of cores)."),
+    cl::about(g_About));
+
+static cl::opt<Path> OptCacheDir("cache-dir", cl::kLong, cl::kOptional,
+    cl::kValueRequired,
+    cl::desc("Keep the outputs in <dir> and reuse them when the model, the "
+             "target and the options are the same."),
+    cl::about(g_About));
+
+static cl::opt<bool> OptPrintTextAsm("print-text-asm", cl::kShort,
+    cl::kOptional, cl::kValueDisallowed, cl::init(false),
+    cl::desc("Also write the instructions as text to .s for debugging."),
+    cl::about(g_About));
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+/// @return The compiler and the arguments which change the outputs, i.e., the
+/// command line without the input, the output and the options of the driver
+/// itself.
+static std::string GetCacheArguments(int pArgc, char* pArgv[])
+{
+  // driver options. The ones in the first row take a value.
+  static const char* driver_options[] = {
+    "o", "batch", "j", "cache-dir", "time-trace", "verbose",
+    "time-passes", "v", "quiet", nullptr
+  };
+  static const unsigned int num_with_value = 6;
+
+  std::string result = g_About.version();
+
+  // a rebuilt compiler is another compiler.
+  Path exe;
+  struct stat st;
+  if (realexe(exe, Path(pArgv[0])) && 0 == ::stat(exe.c_str(), &st)) {
+    result += " " + std::to_string(st.st_size) +
+              " " + std::to_string(st.st_mtime);
+  }
+
+  for (int i = 1; i < pArgc; ++i) {
+    StringRef arg(pArgv[i]);
+    if ('-' != arg[0]) {
+      if (OptInput.hasOccurrence() && arg.equals(OptInput.getValue().native()))
+        continue;
+      result += " " + arg.str();
+      continue;
+    }
+
+    StringRef name = arg;
+    while (!name.empty() && '-' == name[0])
+      name = name.substr(1);
+    bool embedded = (StringRef::npos != name.find('='));
+    name = name.substr(0, name.find('='));
+
+    unsigned int idx = 0;
+    while (nullptr != driver_options[idx] && !name.equals(driver_options[idx]))
+      ++idx;
+
+    if (nullptr == driver_options[idx]) {
+      result += " " + arg.str();
+      continue;
+    }
+
+    // skip the value, too.
+    if (idx < num_with_value && !embedded)
+      ++i;
+  }
+  return result;
+}
+
 //===----------------------------------------------------------------------===//
 // Main Procedure
 //===----------------------------------------------------------------------===//
 int main(int pArgc, char* pArgv[])
 {
+  InitializeAnalysisPassOptions();
   ONNCApp onnc(pArgc, pArgv);
 
   // -verbose=level
@@ -89,18 +183,32 @@ int main(int pArgc, char* pArgv[])
     return EXIT_SUCCESS;
   }
 
-  // check inputs
-  if (!exists(OptInput)) {
-    errs() << Color::MAGENTA << "Fatal" << Color::RESET
-           << ": input file not found: " << OptInput << std::endl;
-    return EXIT_FAILURE;
+  // --batch, -j
+  if (OptBatch.hasOccurrence()) {
+    if (!exists(OptBatch)) {
+      errs() << Color::MAGENTA << "Fatal" << Color::RESET
+             << ": manifest not found: " << OptBatch << std::endl;
+      return EXIT_FAILURE;
+    }
+    onnc.options().setBatch(OptBatch);
+
+    if (OptJobs.hasOccurrence())
+      onnc.options().setNumOfJobs(std::max(OptJobs.getValue(), 1u));
   }
-  if (!is_regular(OptInput)) {
-    errs() << Color::MAGENTA << "Fatal" << Color::RESET
-           << ": input file is not a regular file: " << OptInput << std::endl;
-    return EXIT_FAILURE;
+  else {
+    // check inputs
+    if (!exists(OptInput)) {
+      errs() << Color::MAGENTA << "Fatal" << Color::RESET
+             << ": input file not found: " << OptInput << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (!is_regular(OptInput)) {
+      errs() << Color::MAGENTA << "Fatal" << Color::RESET
+             << ": input file is not a regular file: " << OptInput << std::endl;
+      return EXIT_FAILURE;
+    }
+    onnc.options().setInput(OptInput);
   }
-  onnc.options().setInput(OptInput);
 
   // check output
   if (OptOutput.hasOccurrence())
@@ -108,6 +216,23 @@ int main(int pArgc, char* pArgv[])
   else
     onnc.options().setOutput(ONNCConfig::DefaultOutputName);
 
+  // --time-passes, --time-trace
+  if (OptTimePasses)
+    onnc.options().setTimePasses(true);
+
+  if (OptTimeTrace.hasOccurrence())
+    onnc.options().setTimeTrace(OptTimeTrace);
+
+  // --cache-dir
+  if (OptCacheDir.hasOccurrence()) {
+    onnc.options().setCacheDir(OptCacheDir);
+    onnc.options().setCacheArguments(GetCacheArguments(pArgc, pArgv));
+  }
+
+  // -print-text-asm
+  if (OptPrintTextAsm)
+    onnc.options().target().printTextAsm(true);
+
   // Set quadruple. We shall check target instance at compilation time.
   if (!OptQuadruple.hasOccurrence() && ! OptMArch.hasOccurrence()) {
     onnc.options().setQuadruple(sys::GetHostQuadruple());
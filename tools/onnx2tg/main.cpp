@@ -38,7 +38,8 @@ using namespace onnc;
 static AboutData
     g_About("onnx2tg", "onnc2tg", "0.1.0", AboutLicense::kPrivate,
             "The onnx2tg command compiles ONNX models into "
-            "assembly(.s), weight(.weight.bin) and runtime files(.rt.json)");
+            "instructions(.cmd.bin), weight(.weight.bin) and runtime "
+            "files(.rt.json)");
 
 static cl::opt<std::string> InputFilename("input", cl::kPositional,
                                           cl::kOptional, cl::kValueRequired,
@@ -47,7 +48,7 @@ static cl::opt<std::string> InputFilename("input", cl::kPositional,
 
 static cl::opt<std::string> OutputFilename(
     "o", cl::kShort, cl::kOptional, cl::kValueRequired,
-    cl::desc("output file basename for .s, .weight.bin and .rt.json"),
+    cl::desc("output file basename for .cmd.bin, .weight.bin and .rt.json"),
     cl::about(g_About));
 
 static cl::opt<std::string>
@@ -76,6 +77,21 @@ static cl::opt<bool> AddDummyWeight("add-dummy-weight", cl::kShort,
                                     cl::desc("add dummy weight if not found"),
                                     cl::about(g_About));
 
+static cl::opt<bool> PrintTextAsm("print-text-asm", cl::kShort,
+                                  cl::kOptional, cl::kValueDisallowed,
+                                  cl::init(false),
+                                  cl::desc("also write the instructions as "
+                                           "text to .s for debugging"),
+                                  cl::about(g_About));
+
+static cl::opt<bool> NoPipeline("bm188x-no-pipeline", cl::kLong,
+                                cl::kOptional, cl::kValueDisallowed,
+                                cl::init(false),
+                                cl::desc("don't overlap the loads and the "
+                                         "stores of sliced convolutions "
+                                         "with compute on BM188x"),
+                                cl::about(g_About));
+
 static cl::opt<bool> OptHelp("help", cl::kLong, cl::kOptional,
                              cl::kValueDisallowed, cl::init(false),
                              cl::desc("Show this manual."), cl::about(g_About));
@@ -115,6 +131,8 @@ int main(int pArgc, char *pArgv[])
   onnx2tg.options().target().ignoreCalibrationStep(IgnoreCalibrationStep);
   onnx2tg.options().target().useDummyCTable(AddDummyCTable);
   onnx2tg.options().target().useDummyWeight(AddDummyWeight);
+  onnx2tg.options().target().printTextAsm(PrintTextAsm);
+  onnx2tg.options().target().pipelineTiles(!NoPipeline);
 
 #ifdef BMONNC_EXIST
   foo();
@@ -0,0 +1,94 @@
+//===- CompileCacheTest.cpp -----------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <skypat/skypat.h>
+#include <onnc/Core/CompileCache.h>
+#include <onnc/Support/FileSystem.h>
+#include <onnc/Support/IFStream.h>
+#include <onnc/Support/OFStream.h>
+#include <string>
+
+using namespace skypat;
+using namespace onnc;
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+static Path GetTestDir()
+{
+  Path dir(BUILDDIR);
+  dir.append("CompileCacheTest");
+  clean(dir);
+  mkdir(dir, 0755);
+  return dir;
+}
+
+static void WriteFile(const Path& pFile, const std::string& pContent)
+{
+  OFStream file(pFile, std::ios::out | std::ios::binary);
+  file << pContent;
+}
+
+static std::string ReadFile(const Path& pFile)
+{
+  IFStream file(pFile, std::ios::in | std::ios::binary);
+  std::string content;
+  std::getline(file, content, '\0');
+  return content;
+}
+
+//===----------------------------------------------------------------------===//
+// CompileCacheTest
+//===----------------------------------------------------------------------===//
+SKYPAT_F(CompileCacheTest, store_and_retrieve)
+{
+  Path dir = GetTestDir();
+  Path plan(dir), weight(dir), cache_dir(dir);
+  plan.append("a.out");
+  weight.append("a.out.weight");
+  cache_dir.append("cache");
+
+  CompileCache::FileList outputs = { plan, weight };
+  CompileCache cache(cache_dir);
+  EXPECT_FALSE(cache.retrieve("0123abcd", outputs));
+
+  WriteFile(plan, "plan");
+  WriteFile(weight, "weight");
+  ASSERT_TRUE(cache.store("0123abcd", outputs));
+  EXPECT_TRUE(cache.contains("0123abcd", outputs));
+  EXPECT_TRUE(is_directory(cache.entry("0123abcd")));
+
+  // storing the entry again keeps the first one.
+  WriteFile(plan, "another plan");
+  EXPECT_TRUE(cache.store("0123abcd", outputs));
+
+  remove(plan);
+  remove(weight);
+  ASSERT_TRUE(cache.retrieve("0123abcd", outputs));
+  EXPECT_TRUE(ReadFile(plan) == "plan");
+  EXPECT_TRUE(ReadFile(weight) == "weight");
+
+  EXPECT_FALSE(cache.retrieve("4567abcd", outputs));
+  clean(dir);
+}
+
+SKYPAT_F(CompileCacheTest, missing_output)
+{
+  Path dir = GetTestDir();
+  Path plan(dir), weight(dir), cache_dir(dir);
+  plan.append("a.out");
+  weight.append("a.out.weight");
+  cache_dir.append("cache");
+
+  // a failed store leaves no entry.
+  WriteFile(plan, "plan");
+  CompileCache cache(cache_dir);
+  CompileCache::FileList outputs = { plan, weight };
+  EXPECT_FALSE(cache.store("0123abcd", outputs));
+  EXPECT_FALSE(exists(cache.entry("0123abcd")));
+  clean(dir);
+}
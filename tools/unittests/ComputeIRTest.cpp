@@ -68,6 +68,23 @@ SKYPAT_F(ComputeIRTest, tensor_test)
   ASSERT_EQ(b.getValues().size(), 0);
 }
 
+SKYPAT_F(ComputeIRTest, tensor_view)
+{
+  std::vector<float> data = { 1.0, 2.0, 3.0 };
+  FloatTensor a;
+  a.setValues(data.data(), data.size());
+  ASSERT_TRUE(a.isView());
+  ASSERT_EQ(a.getNumOfValues(), 3);
+  EXPECT_EQ(a.getValue(1), 2.0);
+
+  // copy on write
+  a.getValues()[1] = 5.0;
+  ASSERT_FALSE(a.isView());
+  ASSERT_EQ(a.getNumOfValues(), 3);
+  EXPECT_EQ(a.getValue(1), 5.0);
+  EXPECT_EQ(data[1], 2.0);
+}
+
 SKYPAT_F(ComputeIRTest, add_compute_op)
 {
   onnc::Module module;
@@ -127,6 +144,36 @@ SKYPAT_F(ComputeIRTest, add_compute_opnd)
   ASSERT_EQ(module.getComputeGraph("top-level")->getNodeSize(), 0);
 }
 
+SKYPAT_F(ComputeIRTest, stage_values)
+{
+  onnc::Module module;
+  ComputeGraph* main = module.createComputeGraph("main");
+  ComputeGraph* body = module.createComputeGraph("body");
+
+  Tensor* x = main->addValue<Int32Tensor>("x");
+  ASSERT_TRUE(x == module.getValueList().find("x")->value());
+
+  body->stage();
+  ASSERT_TRUE(body->isStaging());
+  Tensor* y = body->addValue<Int32Tensor>("y");
+  Tensor* z = body->addValue<Int32Tensor>("z");
+
+  // the first value of a name wins, as in the module.
+  Tensor* dup = body->addValue<Int32Tensor>("x");
+  EXPECT_TRUE(x == body->getValue<Tensor>("x"));
+  delete dup;
+
+  // staged values are only visible in the staging graph.
+  EXPECT_TRUE(y == body->getValue<Tensor>("y"));
+  EXPECT_TRUE(nullptr == main->getValue<Tensor>("y"));
+  EXPECT_TRUE(module.getValueList().end() == module.getValueList().find("y"));
+
+  body->commit();
+  ASSERT_FALSE(body->isStaging());
+  EXPECT_TRUE(y == main->getValue<Tensor>("y"));
+  EXPECT_TRUE(z == main->getValue<Tensor>("z"));
+}
+
 SKYPAT_F(ComputeIRTest, bfs_search)
 {
   onnc::Module module;
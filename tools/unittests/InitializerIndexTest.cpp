@@ -0,0 +1,46 @@
+//===- InitializerIndexTest.cpp -------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <skypat/skypat.h>
+#include <onnc/IR/IRBuilder.h>
+#include <onnc/IR/InitializerIndex.h>
+
+using namespace skypat;
+using namespace onnc;
+
+//===----------------------------------------------------------------------===//
+// InitializerIndexTest
+//===----------------------------------------------------------------------===//
+SKYPAT_F(InitializerIndexTest, add_and_erase)
+{
+  onnc::Module module;
+  IRBuilder builder(module);
+
+  builder.CreateTensorGraph();
+  xValue* data = builder.AddInput("data", {1, 3, 8, 8});
+  xValue* weight = builder.AddInput("conv_w", {4, 3, 3, 3});
+  builder.AddInitializer("conv_w");
+
+  InitializerIndex index(*builder.getTensorGraph());
+  EXPECT_FALSE(index.isInitializer(data));
+  EXPECT_TRUE(index.isInitializer(weight));
+
+  xTensor bias;
+  bias.elem_type() = (xTensorProtoDataType)onnc::Value::kFloat;
+  bias.sizes().push_back(4);
+  xValue* value = index.addInitializerAndInput(bias, "conv_b");
+  EXPECT_TRUE(index.isInitializer(value));
+  ASSERT_EQ(builder.getTensorGraph()->initializer_names().size(), 2);
+
+  index.eraseInitializerAndInput(weight);
+  ASSERT_EQ(builder.getTensorGraph()->initializer_names().size(), 1);
+
+  // the index agrees with the graph.
+  index.rebuild();
+  EXPECT_TRUE(index.isInitializer(value));
+  EXPECT_FALSE(index.isInitializer(data));
+}
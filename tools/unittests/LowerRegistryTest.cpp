@@ -0,0 +1,389 @@
+//===- LowerRegistryTest.cpp ----------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <skypat/skypat.h>
+#include <onnc/Transforms/TensorSel/LowerRegistry.h>
+#include <onnc/Transforms/TensorSel/Standards/ATenLower.h>
+#include <onnc/Transforms/TensorSel/Standards/AbsLower.h>
+#include <onnc/Transforms/TensorSel/Standards/AcosLower.h>
+#include <onnc/Transforms/TensorSel/Standards/AddLower.h>
+#include <onnc/Transforms/TensorSel/Standards/AffineLower.h>
+#include <onnc/Transforms/TensorSel/Standards/AndLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ArgMaxLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ArgMinLower.h>
+#include <onnc/Transforms/TensorSel/Standards/AsinLower.h>
+#include <onnc/Transforms/TensorSel/Standards/AtanLower.h>
+#include <onnc/Transforms/TensorSel/Standards/AveragePoolLower.h>
+#include <onnc/Transforms/TensorSel/Standards/BatchNormalizationLower.h>
+#include <onnc/Transforms/TensorSel/Standards/CastLower.h>
+#include <onnc/Transforms/TensorSel/Standards/CeilLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ClipLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ConcatLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ConstantFillLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ConstantLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ConvLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ConvTransposeLower.h>
+#include <onnc/Transforms/TensorSel/Standards/CosLower.h>
+#include <onnc/Transforms/TensorSel/Standards/CropLower.h>
+#include <onnc/Transforms/TensorSel/Standards/DepthToSpaceLower.h>
+#include <onnc/Transforms/TensorSel/Standards/DivLower.h>
+#include <onnc/Transforms/TensorSel/Standards/DropoutLower.h>
+#include <onnc/Transforms/TensorSel/Standards/EluLower.h>
+#include <onnc/Transforms/TensorSel/Standards/EqualLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ExpLower.h>
+#include <onnc/Transforms/TensorSel/Standards/FlattenLower.h>
+#include <onnc/Transforms/TensorSel/Standards/FloorLower.h>
+#include <onnc/Transforms/TensorSel/Standards/GRULower.h>
+#include <onnc/Transforms/TensorSel/Standards/GRUUnitLower.h>
+#include <onnc/Transforms/TensorSel/Standards/GatherLower.h>
+#include <onnc/Transforms/TensorSel/Standards/GemmLower.h>
+#include <onnc/Transforms/TensorSel/Standards/GivenTensorFillLower.h>
+#include <onnc/Transforms/TensorSel/Standards/GlobalAveragePoolLower.h>
+#include <onnc/Transforms/TensorSel/Standards/GlobalLpPoolLower.h>
+#include <onnc/Transforms/TensorSel/Standards/GlobalMaxPoolLower.h>
+#include <onnc/Transforms/TensorSel/Standards/GreaterLower.h>
+#include <onnc/Transforms/TensorSel/Standards/HardSigmoidLower.h>
+#include <onnc/Transforms/TensorSel/Standards/HardmaxLower.h>
+#include <onnc/Transforms/TensorSel/Standards/IdentityLower.h>
+#include <onnc/Transforms/TensorSel/Standards/IfLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ImageScalerLower.h>
+#include <onnc/Transforms/TensorSel/Standards/InstanceNormalizationLower.h>
+#include <onnc/Transforms/TensorSel/Standards/LRNLower.h>
+#include <onnc/Transforms/TensorSel/Standards/LSTMLower.h>
+#include <onnc/Transforms/TensorSel/Standards/LeakyReluLower.h>
+#include <onnc/Transforms/TensorSel/Standards/LessLower.h>
+#include <onnc/Transforms/TensorSel/Standards/LogLower.h>
+#include <onnc/Transforms/TensorSel/Standards/LogSoftmaxLower.h>
+#include <onnc/Transforms/TensorSel/Standards/LoopIndexTensorLower.h>
+#include <onnc/Transforms/TensorSel/Standards/LoopLower.h>
+#include <onnc/Transforms/TensorSel/Standards/LpNormalizationLower.h>
+#include <onnc/Transforms/TensorSel/Standards/LpPoolLower.h>
+#include <onnc/Transforms/TensorSel/Standards/MatMulLower.h>
+#include <onnc/Transforms/TensorSel/Standards/MaxLower.h>
+#include <onnc/Transforms/TensorSel/Standards/MaxPoolLower.h>
+#include <onnc/Transforms/TensorSel/Standards/MaxRoiPoolLower.h>
+#include <onnc/Transforms/TensorSel/Standards/MeanLower.h>
+#include <onnc/Transforms/TensorSel/Standards/MeanVarianceNormalizationLower.h>
+#include <onnc/Transforms/TensorSel/Standards/MinLower.h>
+#include <onnc/Transforms/TensorSel/Standards/MulLower.h>
+#include <onnc/Transforms/TensorSel/Standards/MultinomialLower.h>
+#include <onnc/Transforms/TensorSel/Standards/NegLower.h>
+#include <onnc/Transforms/TensorSel/Standards/NotLower.h>
+#include <onnc/Transforms/TensorSel/Standards/OrLower.h>
+#include <onnc/Transforms/TensorSel/Standards/PReluLower.h>
+#include <onnc/Transforms/TensorSel/Standards/PadLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ParametricSoftplusLower.h>
+#include <onnc/Transforms/TensorSel/Standards/PowLower.h>
+#include <onnc/Transforms/TensorSel/Standards/RNNLower.h>
+#include <onnc/Transforms/TensorSel/Standards/RandomNormalLikeLower.h>
+#include <onnc/Transforms/TensorSel/Standards/RandomNormalLower.h>
+#include <onnc/Transforms/TensorSel/Standards/RandomUniformLikeLower.h>
+#include <onnc/Transforms/TensorSel/Standards/RandomUniformLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ReciprocalLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ReduceL1Lower.h>
+#include <onnc/Transforms/TensorSel/Standards/ReduceL2Lower.h>
+#include <onnc/Transforms/TensorSel/Standards/ReduceLogSumExpLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ReduceLogSumLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ReduceMaxLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ReduceMeanLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ReduceMinLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ReduceProdLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ReduceSumLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ReduceSumSquareLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ReluLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ReshapeLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ScaleLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ScaledTanhLower.h>
+#include <onnc/Transforms/TensorSel/Standards/SeluLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ShapeLower.h>
+#include <onnc/Transforms/TensorSel/Standards/SigmoidLower.h>
+#include <onnc/Transforms/TensorSel/Standards/SinLower.h>
+#include <onnc/Transforms/TensorSel/Standards/SizeLower.h>
+#include <onnc/Transforms/TensorSel/Standards/SliceLower.h>
+#include <onnc/Transforms/TensorSel/Standards/SoftmaxLower.h>
+#include <onnc/Transforms/TensorSel/Standards/SoftplusLower.h>
+#include <onnc/Transforms/TensorSel/Standards/SoftsignLower.h>
+#include <onnc/Transforms/TensorSel/Standards/SpaceToDepthLower.h>
+#include <onnc/Transforms/TensorSel/Standards/SplitLower.h>
+#include <onnc/Transforms/TensorSel/Standards/SqrtLower.h>
+#include <onnc/Transforms/TensorSel/Standards/SqueezeLower.h>
+#include <onnc/Transforms/TensorSel/Standards/SubLower.h>
+#include <onnc/Transforms/TensorSel/Standards/SumLower.h>
+#include <onnc/Transforms/TensorSel/Standards/TanLower.h>
+#include <onnc/Transforms/TensorSel/Standards/TanhLower.h>
+#include <onnc/Transforms/TensorSel/Standards/ThresholdedReluLower.h>
+#include <onnc/Transforms/TensorSel/Standards/TileLower.h>
+#include <onnc/Transforms/TensorSel/Standards/TopKLower.h>
+#include <onnc/Transforms/TensorSel/Standards/TransposeLower.h>
+#include <onnc/Transforms/TensorSel/Standards/UnsqueezeLower.h>
+#include <onnc/Transforms/TensorSel/Standards/UpsampleLower.h>
+#include <onnc/Transforms/TensorSel/Standards/XorLower.h>
+#include <onnc/Config/ONNX.h>
+#include <vector>
+
+using namespace skypat;
+using namespace onnc;
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+namespace {
+
+/// A lower scoring @ref m_Score for every node of its kinds. A lower of no
+/// kind scores every node.
+class FakeLower : public Lower
+{
+public:
+  explicit FakeLower(int pScore) : Lower(), m_Score(pScore) { }
+
+  FakeLower(xNodeKind pKind, int pScore) : Lower(pKind), m_Score(pScore) { }
+
+  int isMe(const xNode& pNode) const override {
+    if (getKinds().empty() || pNode.kind() == getKinds().front())
+      return m_Score;
+    return kNotMe;
+  }
+
+  ComputeOperator* activate(ComputeGraph& pCG, xNode& pNode) const override {
+    return nullptr;
+  }
+
+private:
+  int m_Score;
+};
+
+void RegisterStandardLowers(LowerRegistry& pRegistry)
+{
+  pRegistry.emplace<ATenLower>();
+  pRegistry.emplace<AbsLower>();
+  pRegistry.emplace<AcosLower>();
+  pRegistry.emplace<AddLower>();
+  pRegistry.emplace<AffineLower>();
+  pRegistry.emplace<AndLower>();
+  pRegistry.emplace<ArgMaxLower>();
+  pRegistry.emplace<ArgMinLower>();
+  pRegistry.emplace<AsinLower>();
+  pRegistry.emplace<AtanLower>();
+  pRegistry.emplace<AveragePoolLower>();
+  pRegistry.emplace<BatchNormalizationLower>();
+  pRegistry.emplace<CastLower>();
+  pRegistry.emplace<CeilLower>();
+  pRegistry.emplace<ClipLower>();
+  pRegistry.emplace<ConcatLower>();
+  pRegistry.emplace<ConstantFillLower>();
+  pRegistry.emplace<ConstantLower>();
+  pRegistry.emplace<ConvLower>();
+  pRegistry.emplace<ConvTransposeLower>();
+  pRegistry.emplace<CosLower>();
+  pRegistry.emplace<CropLower>();
+  pRegistry.emplace<DepthToSpaceLower>();
+  pRegistry.emplace<DivLower>();
+  pRegistry.emplace<DropoutLower>();
+  pRegistry.emplace<EluLower>();
+  pRegistry.emplace<EqualLower>();
+  pRegistry.emplace<ExpLower>();
+  pRegistry.emplace<FlattenLower>();
+  pRegistry.emplace<FloorLower>();
+  pRegistry.emplace<GRULower>();
+  pRegistry.emplace<GRUUnitLower>();
+  pRegistry.emplace<GatherLower>();
+  pRegistry.emplace<GemmLower>();
+  pRegistry.emplace<GivenTensorFillLower>();
+  pRegistry.emplace<GlobalAveragePoolLower>();
+  pRegistry.emplace<GlobalLpPoolLower>();
+  pRegistry.emplace<GlobalMaxPoolLower>();
+  pRegistry.emplace<GreaterLower>();
+  pRegistry.emplace<HardSigmoidLower>();
+  pRegistry.emplace<HardmaxLower>();
+  pRegistry.emplace<IdentityLower>();
+  pRegistry.emplace<IfLower>();
+  pRegistry.emplace<ImageScalerLower>();
+  pRegistry.emplace<InstanceNormalizationLower>();
+  pRegistry.emplace<LRNLower>();
+  pRegistry.emplace<LSTMLower>();
+  pRegistry.emplace<LeakyReluLower>();
+  pRegistry.emplace<LessLower>();
+  pRegistry.emplace<LogLower>();
+  pRegistry.emplace<LogSoftmaxLower>();
+  pRegistry.emplace<LoopIndexTensorLower>();
+  pRegistry.emplace<LoopLower>();
+  pRegistry.emplace<LpNormalizationLower>();
+  pRegistry.emplace<LpPoolLower>();
+  pRegistry.emplace<MatMulLower>();
+  pRegistry.emplace<MaxLower>();
+  pRegistry.emplace<MaxPoolLower>();
+  pRegistry.emplace<MaxRoiPoolLower>();
+  pRegistry.emplace<MeanLower>();
+  pRegistry.emplace<MeanVarianceNormalizationLower>();
+  pRegistry.emplace<MinLower>();
+  pRegistry.emplace<MulLower>();
+  pRegistry.emplace<MultinomialLower>();
+  pRegistry.emplace<NegLower>();
+  pRegistry.emplace<NotLower>();
+  pRegistry.emplace<OrLower>();
+  pRegistry.emplace<PReluLower>();
+  pRegistry.emplace<PadLower>();
+  pRegistry.emplace<ParametricSoftplusLower>();
+  pRegistry.emplace<PowLower>();
+  pRegistry.emplace<RNNLower>();
+  pRegistry.emplace<RandomNormalLikeLower>();
+  pRegistry.emplace<RandomNormalLower>();
+  pRegistry.emplace<RandomUniformLikeLower>();
+  pRegistry.emplace<RandomUniformLower>();
+  pRegistry.emplace<ReciprocalLower>();
+  pRegistry.emplace<ReduceL1Lower>();
+  pRegistry.emplace<ReduceL2Lower>();
+  pRegistry.emplace<ReduceLogSumExpLower>();
+  pRegistry.emplace<ReduceLogSumLower>();
+  pRegistry.emplace<ReduceMaxLower>();
+  pRegistry.emplace<ReduceMeanLower>();
+  pRegistry.emplace<ReduceMinLower>();
+  pRegistry.emplace<ReduceProdLower>();
+  pRegistry.emplace<ReduceSumLower>();
+  pRegistry.emplace<ReduceSumSquareLower>();
+  pRegistry.emplace<ReluLower>();
+  pRegistry.emplace<ReshapeLower>();
+  pRegistry.emplace<ScaleLower>();
+  pRegistry.emplace<ScaledTanhLower>();
+  pRegistry.emplace<SeluLower>();
+  pRegistry.emplace<ShapeLower>();
+  pRegistry.emplace<SigmoidLower>();
+  pRegistry.emplace<SinLower>();
+  pRegistry.emplace<SizeLower>();
+  pRegistry.emplace<SliceLower>();
+  pRegistry.emplace<SoftmaxLower>();
+  pRegistry.emplace<SoftplusLower>();
+  pRegistry.emplace<SoftsignLower>();
+  pRegistry.emplace<SpaceToDepthLower>();
+  pRegistry.emplace<SplitLower>();
+  pRegistry.emplace<SqrtLower>();
+  pRegistry.emplace<SqueezeLower>();
+  pRegistry.emplace<SubLower>();
+  pRegistry.emplace<SumLower>();
+  pRegistry.emplace<TanLower>();
+  pRegistry.emplace<TanhLower>();
+  pRegistry.emplace<ThresholdedReluLower>();
+  pRegistry.emplace<TileLower>();
+  pRegistry.emplace<TopKLower>();
+  pRegistry.emplace<TransposeLower>();
+  pRegistry.emplace<UnsqueezeLower>();
+  pRegistry.emplace<UpsampleLower>();
+  pRegistry.emplace<XorLower>();
+}
+
+/// The linear scan LowerRegistry::lookup replaces.
+const Lower* LookupByScan(const LowerRegistry& pRegistry, const xNode& pNode)
+{
+  int max = 0;
+  const Lower* target = nullptr;
+  for (const Lower* lower : pRegistry) {
+    int score = lower->isMe(pNode);
+    if (score > 0 && score >= max) {
+      max = score;
+      target = lower;
+    }
+  }
+  return target;
+}
+
+/// A graph of @ref pNumOfNodes nodes of common CNN kinds.
+void CreateNodes(xGraph& pGraph, unsigned pNumOfNodes)
+{
+  const char* kinds[] = {
+    "Conv", "BatchNormalization", "Relu", "MaxPool", "Add", "Concat",
+    "Gemm", "Softmax", "Reshape", "Unknown"
+  };
+  const unsigned numOfKinds = sizeof(kinds) / sizeof(kinds[0]);
+  for (unsigned i = 0; i < pNumOfNodes; ++i)
+    pGraph.appendNode(pGraph.create(xSymbol(kinds[i % numOfKinds])));
+}
+
+} // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// LowerRegistryTest
+//===----------------------------------------------------------------------===//
+SKYPAT_F(LowerRegistryTest, lookup_by_kind)
+{
+  LowerRegistry registry;
+  Lower* conv = registry.emplace<FakeLower>(xSymbol("Conv"), Lower::kStdLower);
+  Lower* relu = registry.emplace<FakeLower>(xSymbol("Relu"), Lower::kStdLower);
+  ASSERT_EQ(registry.size(), 2);
+
+  xGraph graph;
+  xNode* node = graph.create(xSymbol("Conv"));
+  EXPECT_TRUE(registry.lookup(*node) == conv);
+
+  node = graph.create(xSymbol("Relu"));
+  EXPECT_TRUE(registry.lookup(*node) == relu);
+
+  node = graph.create(xSymbol("Gemm"));
+  EXPECT_TRUE(registry.lookup(*node) == nullptr);
+}
+
+SKYPAT_F(LowerRegistryTest, highest_score)
+{
+  LowerRegistry registry;
+  registry.emplace<FakeLower>(xSymbol("Conv"), Lower::kStdLower);
+  Lower* target = registry.emplace<FakeLower>(xSymbol("Conv"),
+                                              Lower::kTargetNormal);
+  registry.emplace<FakeLower>(xSymbol("Conv"), Lower::kStdLower);
+
+  xGraph graph;
+  xNode* node = graph.create(xSymbol("Conv"));
+  EXPECT_TRUE(registry.lookup(*node) == target);
+
+  // lowers of no kind compete with every node.
+  Lower* any = registry.emplace<FakeLower>(Lower::kTargetHigh);
+  EXPECT_TRUE(registry.lookup(*node) == any);
+
+  // the later one wins a tie.
+  Lower* last = registry.emplace<FakeLower>(xSymbol("Conv"),
+                                            Lower::kTargetHigh);
+  EXPECT_TRUE(registry.lookup(*node) == last);
+}
+
+SKYPAT_F(LowerRegistryTest, same_as_linear_scan)
+{
+  LowerRegistry registry;
+  RegisterStandardLowers(registry);
+
+  xGraph graph;
+  CreateNodes(graph, 1000);
+  for (xNode* node : graph.nodes())
+    ASSERT_TRUE(registry.lookup(*node) == LookupByScan(registry, *node));
+}
+
+SKYPAT_F(LowerRegistryTest, lookup_10k_nodes)
+{
+  LowerRegistry registry;
+  RegisterStandardLowers(registry);
+
+  xGraph graph;
+  CreateNodes(graph, 10000);
+  unsigned matched = 0;
+  PERFORM(skypat::CPU_CLOCK) {
+    for (xNode* node : graph.nodes())
+      matched += (nullptr != registry.lookup(*node));
+  }
+  EXPECT_TRUE(0 < matched);
+}
+
+SKYPAT_F(LowerRegistryTest, scan_10k_nodes)
+{
+  LowerRegistry registry;
+  RegisterStandardLowers(registry);
+
+  xGraph graph;
+  CreateNodes(graph, 10000);
+  unsigned matched = 0;
+  PERFORM(skypat::CPU_CLOCK) {
+    for (xNode* node : graph.nodes())
+      matched += (nullptr != LookupByScan(registry, *node));
+  }
+  EXPECT_TRUE(0 < matched);
+}
@@ -0,0 +1,228 @@
+//===- MemoryAllocationTest.cpp -------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <skypat/skypat.h>
+#include <onnc/Analysis/MemAllocStrategy.h>
+#include <onnc/Analysis/MemoryAllocation.h>
+#include <onnc/Analysis/MemRegionTree.h>
+#include <algorithm>
+#include <random>
+
+using namespace skypat;
+using namespace onnc;
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+namespace {
+
+/// A synthetic graph of @ref pNumOfValues values. Most values die within a
+/// few layers, a few (skip connections) live long.
+MemAllocRequestList CreateRequests(unsigned pNumOfValues, unsigned pSeed)
+{
+  std::mt19937 rng(pSeed);
+  MemAllocRequestList requests;
+  for (unsigned i = 0; i < pNumOfValues; ++i) {
+    unsigned start = i / 2;
+    unsigned length = (0 == rng() % 16) ? rng() % 256 : rng() % 8;
+    size_t size = (rng() % 64 + 1) * 1024;
+    requests.push_back(MemAllocRequest{ start, start + length, size, 0 });
+  }
+  return requests;
+}
+
+/// The quadratic first fit AllocByLiveness replaces.
+size_t AllocByScan(MemAllocRequestList& pRequests)
+{
+  size_t peak = 0;
+  for (size_t i = 0; i < pRequests.size(); ++i) {
+    MemAllocRequest& cur = pRequests[i];
+    std::vector<std::pair<size_t, size_t> > used;
+    for (size_t j = 0; j < i; ++j) {
+      const MemAllocRequest& prev = pRequests[j];
+      if (prev.end < cur.start || cur.end < prev.start)
+        continue;
+      used.emplace_back(prev.address, prev.size);
+    }
+    std::sort(used.begin(), used.end());
+
+    cur.address = 0;
+    for (auto& region : used) {
+      if (region.first + region.second <= cur.address ||
+          cur.address + cur.size <= region.first)
+        break;
+      cur.address = region.first + region.second;
+    }
+    peak = std::max(peak, cur.address + cur.size);
+  }
+  return peak;
+}
+
+/// No two requests live at the same time share an address.
+bool IsValidPlacement(const MemAllocRequestList& pRequests, size_t pPeak)
+{
+  size_t peak = 0;
+  for (size_t i = 0; i < pRequests.size(); ++i) {
+    const MemAllocRequest& cur = pRequests[i];
+    peak = std::max(peak, cur.address + cur.size);
+    for (size_t j = 0; j < i; ++j) {
+      const MemAllocRequest& prev = pRequests[j];
+      if (prev.end < cur.start || cur.end < prev.start)
+        continue;
+      if (0 != cur.size && 0 != prev.size &&
+          cur.address < prev.address + prev.size &&
+          prev.address < cur.address + cur.size)
+        return false;
+    }
+  }
+  return (peak == pPeak);
+}
+
+} // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// MemRegionTreeTest
+//===----------------------------------------------------------------------===//
+SKYPAT_F(MemRegionTreeTest, first_fit)
+{
+  MemRegionTree tree;
+  EXPECT_EQ(tree.findFirstFit(100), 0);
+
+  MemRegionTree::Handle a = tree.insert(0, 100);
+  MemRegionTree::Handle b = tree.insert(100, 50);
+  tree.insert(300, 10);
+  EXPECT_EQ(tree.size(), 3);
+  EXPECT_EQ(tree.getEnd(), 310);
+
+  EXPECT_EQ(tree.findFirstFit(150), 150);
+  EXPECT_EQ(tree.findFirstFit(151), 310);
+
+  tree.erase(a);
+  EXPECT_EQ(tree.findFirstFit(100), 0);
+  EXPECT_EQ(tree.findFirstFit(101), 150);
+
+  tree.erase(b);
+  EXPECT_EQ(tree.findFirstFit(300), 0);
+  EXPECT_EQ(tree.findFirstFit(301), 310);
+}
+
+//===----------------------------------------------------------------------===//
+// MemoryAllocationTest
+//===----------------------------------------------------------------------===//
+SKYPAT_F(MemoryAllocationTest, reuse_dead_values)
+{
+  // a -> b -> c, a chain only needs two buffers.
+  MemAllocRequestList requests = {
+    { 0, 1, 100, 0 },
+    { 1, 2, 100, 0 },
+    { 2, 3, 100, 0 }
+  };
+  EXPECT_EQ(AllocByLiveness(requests), 200);
+  EXPECT_EQ(requests[0].address, 0);
+  EXPECT_EQ(requests[1].address, 100);
+  EXPECT_EQ(requests[2].address, 0);
+}
+
+SKYPAT_F(MemoryAllocationTest, same_as_linear_scan)
+{
+  MemAllocRequestList requests = CreateRequests(2000, 1);
+  MemAllocRequestList expected = requests;
+
+  EXPECT_EQ(AllocByLiveness(requests), AllocByScan(expected));
+  for (size_t i = 0; i < requests.size(); ++i)
+    ASSERT_EQ(requests[i].address, expected[i].address);
+}
+
+SKYPAT_F(MemoryAllocationTest, alloc_1k_values)
+{
+  MemAllocRequestList requests = CreateRequests(1000, 2);
+  PERFORM(skypat::CPU_CLOCK) {
+    AllocByLiveness(requests);
+  }
+}
+
+SKYPAT_F(MemoryAllocationTest, alloc_10k_values)
+{
+  MemAllocRequestList requests = CreateRequests(10000, 3);
+  PERFORM(skypat::CPU_CLOCK) {
+    AllocByLiveness(requests);
+  }
+}
+
+SKYPAT_F(MemoryAllocationTest, alloc_100k_values)
+{
+  MemAllocRequestList requests = CreateRequests(100000, 4);
+  PERFORM(skypat::CPU_CLOCK) {
+    AllocByLiveness(requests);
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// MemAllocStrategyTest
+//===----------------------------------------------------------------------===//
+SKYPAT_F(MemAllocStrategyTest, lookup)
+{
+  ASSERT_TRUE(nullptr != MemAllocStrategy::Lookup("first-fit"));
+  ASSERT_TRUE(nullptr != MemAllocStrategy::Lookup("best-fit-by-size"));
+  ASSERT_TRUE(nullptr != MemAllocStrategy::Lookup("greedy-by-breadth"));
+  ASSERT_TRUE(nullptr != MemAllocStrategy::Lookup("min-peak"));
+  EXPECT_TRUE(nullptr == MemAllocStrategy::Lookup("next-fit"));
+  EXPECT_EQ(MemAllocStrategy::GetPlacements().size(), 3);
+}
+
+SKYPAT_F(MemAllocStrategyTest, place_large_values_first)
+{
+  // first fit puts the short value at the bottom and the last value can't
+  // reuse the space of the first one.
+  MemAllocRequestList requests = {
+    { 0, 1, 200, 0 },
+    { 0, 2, 300, 0 },
+    { 2, 2, 300, 0 }
+  };
+
+  MemAllocRequestList first_fit = requests;
+  EXPECT_EQ(FirstFitStrategy().allocate(first_fit), 800);
+
+  MemAllocRequestList best_fit = requests;
+  EXPECT_EQ(BestFitBySizeStrategy().allocate(best_fit), 600);
+  EXPECT_EQ(best_fit[1].address, 0);
+  EXPECT_EQ(best_fit[0].address, 300);
+  EXPECT_EQ(best_fit[2].address, 300);
+
+  MemAllocRequestList breadth = requests;
+  EXPECT_EQ(GreedyByBreadthStrategy().allocate(breadth), 600);
+
+  MemAllocRequestList min_peak = requests;
+  EXPECT_EQ(MinPeakStrategy().allocate(min_peak), 600);
+  EXPECT_TRUE(IsValidPlacement(min_peak, 600));
+}
+
+SKYPAT_F(MemAllocStrategyTest, valid_placements)
+{
+  MemAllocRequestList requests = CreateRequests(2000, 5);
+  for (const MemAllocStrategy* strategy : MemAllocStrategy::GetPlacements()) {
+    MemAllocRequestList placed = requests;
+    size_t peak = strategy->allocate(placed);
+    EXPECT_TRUE(IsValidPlacement(placed, peak));
+  }
+}
+
+SKYPAT_F(MemAllocStrategyTest, best_fit_by_size_10k_values)
+{
+  MemAllocRequestList requests = CreateRequests(10000, 3);
+  PERFORM(skypat::CPU_CLOCK) {
+    BestFitBySizeStrategy().allocate(requests);
+  }
+}
+
+SKYPAT_F(MemAllocStrategyTest, greedy_by_breadth_10k_values)
+{
+  MemAllocRequestList requests = CreateRequests(10000, 3);
+  PERFORM(skypat::CPU_CLOCK) {
+    GreedyByBreadthStrategy().allocate(requests);
+  }
+}
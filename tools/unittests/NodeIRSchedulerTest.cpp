@@ -0,0 +1,200 @@
+//===- NodeIRSchedulerTest.cpp --------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <skypat/skypat.h>
+#include <onnc/Analysis/NodeIRScheduler.h>
+#include <onnc/IR/IRBuilder.h>
+#include <onnc/Target/DLATargetBackend.h>
+#include <onnc/Target/TargetMemInfo.h>
+#include <onnc/Target/TargetOptions.h>
+#include <algorithm>
+#include <unordered_map>
+
+using namespace skypat;
+using namespace onnc;
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+namespace {
+
+/// Every node costs the cycles given to it, and runs on one unit.
+class StubTTI : public TargetTransformInfo
+{
+public:
+  StubTTI() : m_Resource{ 1, "unit" } { }
+
+  uint64_t getOperatorCost(const xNode *pNode, unsigned pKind) const override {
+    auto cost = m_Cycles.find(pNode);
+    return (m_Cycles.end() == cost) ? 0 : cost->second;
+  }
+
+  const ExeResource *queryExeResType(const xNode *pNode) const override {
+    return &m_Resource;
+  }
+
+  void setCycles(const xNode *pNode, uint64_t pCycles) {
+    m_Cycles[pNode] = pCycles;
+  }
+
+private:
+  ExeResource m_Resource;
+  std::unordered_map<const xNode *, uint64_t> m_Cycles;
+};
+
+/// A value takes a byte per element.
+class StubMemInfo : public TargetMemInfo
+{
+public:
+  MemSize getValueMemorySize(xValue *pValue) override {
+    uint64_t size = 1;
+    for (const xDimension &dim : pValue->sizes())
+      size *= dim.dim;
+    return MemSize(1, size);
+  }
+};
+
+class StubBackend : public DLATargetBackend
+{
+public:
+  StubBackend(const TargetOptions &pOptions)
+    : DLATargetBackend(pOptions) {
+    m_pMemInfo = &m_MemInfo;
+  }
+
+  const TargetTransformInfo *getTTI() const override { return &m_TTI; }
+
+  StubTTI &tti() { return m_TTI; }
+
+private:
+  StubTTI m_TTI;
+  StubMemInfo m_MemInfo;
+};
+
+unsigned Position(xGraph &pGraph, const xNode *pNode)
+{
+  unsigned idx = 0;
+  for (xNode *node : pGraph.nodes()) {
+    if (node == pNode)
+      return idx;
+    ++idx;
+  }
+  return idx;
+}
+
+/// The most bytes live at once in the order of the graph. A value lives
+/// from its producer to its last user.
+uint64_t PeakBytes(xGraph &pGraph, StubMemInfo &pMemInfo)
+{
+  std::unordered_map<const xNode *, unsigned> pos;
+  std::vector<xNode *> order;
+  for (xNode *node : pGraph.nodes()) {
+    pos[node] = order.size();
+    order.push_back(node);
+  }
+
+  std::vector<int64_t> delta(order.size() + 1, 0);
+  for (xNode *node : order) {
+    for (xValue *v : node->outputs()) {
+      unsigned last = pos[node];
+      for (auto u : v->uses()) {
+        auto user = pos.find(u.user);
+        if (pos.end() != user)
+          last = std::max(last, user->second);
+      }
+      int64_t bytes = pMemInfo.getValueMemorySize(v).size;
+      delta[pos[node]] += bytes;
+      delta[last + 1] -= bytes;
+    }
+  }
+
+  int64_t live = 0, peak = 0;
+  for (int64_t d : delta) {
+    live += d;
+    peak = std::max(peak, live);
+  }
+  return peak;
+}
+
+/// Two producers of 100 bytes, each reduced to a byte, and joined:
+/// A1 (10 cycles) -> A2 (1), B1 (10) -> B2 (1), and Sum (1) of A2 and B2.
+void BuildTwoReductions(IRBuilder &pBuilder, StubTTI &pTTI)
+{
+  pBuilder.CreateTensorGraph();
+  pBuilder.AddInput("x", {1});
+  pTTI.setCycles(pBuilder.AddNode("Relu", {"x"}), 10);
+  pBuilder.AddOutput("a1", {100});
+  pTTI.setCycles(pBuilder.AddNode("Relu", {"x"}), 10);
+  pBuilder.AddOutput("b1", {100});
+  pTTI.setCycles(pBuilder.AddNode("Relu", {"a1"}), 1);
+  pBuilder.AddOutput("a2", {1});
+  pTTI.setCycles(pBuilder.AddNode("Relu", {"b1"}), 1);
+  pBuilder.AddOutput("b2", {1});
+  pTTI.setCycles(pBuilder.AddNode("Sum", {"a2", "b2"}), 1);
+  pBuilder.AddOutput("y", {1});
+  pBuilder.FinalizeTensorGraph({"y"});
+}
+
+} // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// NodeIRSchedulerTest
+//===----------------------------------------------------------------------===//
+SKYPAT_F(NodeIRSchedulerTest, critical_path_first)
+{
+  TargetOptions options;
+  StubBackend backend(options);
+  onnc::Module module;
+  IRBuilder builder(module);
+
+  // the short node comes first in the graph.
+  builder.CreateTensorGraph();
+  builder.AddInput("x", {1});
+  xNode *shortN = builder.AddNode("Relu", {"x"});
+  builder.AddOutput("s", {1});
+  xNode *long1 = builder.AddNode("Relu", {"x"});
+  builder.AddOutput("l1", {1});
+  xNode *long2 = builder.AddNode("Relu", {"l1"});
+  builder.AddOutput("l2", {1});
+  builder.FinalizeTensorGraph({"s", "l2"});
+  backend.tti().setCycles(shortN, 1);
+  backend.tti().setCycles(long1, 10);
+  backend.tti().setCycles(long2, 10);
+
+  xGraph &graph = *builder.getTensorGraph();
+  NodeIRScheduler scheduler(&backend, NodeIRScheduler::kMinLatency);
+  ASSERT_EQ(scheduler.runOnGraph(graph), Pass::kModuleChanged);
+  EXPECT_TRUE(Position(graph, long1) < Position(graph, shortN));
+  EXPECT_TRUE(Position(graph, long1) < Position(graph, long2));
+}
+
+SKYPAT_F(NodeIRSchedulerTest, memory_policy_lowers_peak)
+{
+  TargetOptions options;
+  StubMemInfo memInfo;
+
+  StubBackend latencyBackend(options);
+  onnc::Module latencyModule;
+  IRBuilder latencyBuilder(latencyModule);
+  BuildTwoReductions(latencyBuilder, latencyBackend.tti());
+  xGraph &latencyGraph = *latencyBuilder.getTensorGraph();
+  NodeIRScheduler latency(&latencyBackend, NodeIRScheduler::kMinLatency);
+  ASSERT_EQ(latency.runOnGraph(latencyGraph), Pass::kModuleChanged);
+
+  StubBackend memoryBackend(options);
+  onnc::Module memoryModule;
+  IRBuilder memoryBuilder(memoryModule);
+  BuildTwoReductions(memoryBuilder, memoryBackend.tti());
+  xGraph &memoryGraph = *memoryBuilder.getTensorGraph();
+  NodeIRScheduler memory(&memoryBackend, NodeIRScheduler::kMinMemory);
+  ASSERT_EQ(memory.runOnGraph(memoryGraph), Pass::kModuleChanged);
+
+  // the latency policy runs both producers before the reductions, the
+  // memory policy reduces the first producer before the second.
+  EXPECT_TRUE(PeakBytes(latencyGraph, memInfo) >= 200);
+  EXPECT_TRUE(PeakBytes(memoryGraph, memInfo) < 200);
+}
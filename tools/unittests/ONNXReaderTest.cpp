@@ -7,9 +7,160 @@
 //===----------------------------------------------------------------------===//
 #include <skypat/skypat.h>
 #include <onnc/IRReader/ONNXReader.h>
+#include <onnc/Config/ONNX.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/wire_format_lite.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
 
 using namespace onnc;
 
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+namespace {
+
+typedef ::google::protobuf::internal::WireFormatLite WireFormat;
+
+/// A scratch directory removed with the files written into it.
+class ScratchDir
+{
+public:
+  ScratchDir() {
+    char name[] = "/tmp/onnc-reader-XXXXXX";
+    if (nullptr != ::mkdtemp(name))
+      m_Dir = Path(name);
+  }
+
+  ~ScratchDir() {
+    for (const Path& file : m_Files)
+      ::unlink(file.c_str());
+    ::rmdir(m_Dir.c_str());
+  }
+
+  /// Write @ref pContent to the file @ref pName in the directory.
+  Path write(const std::string& pName, const std::string& pContent) {
+    Path path(m_Dir);
+    path.append(pName);
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (nullptr != file) {
+      std::fwrite(pContent.data(), 1, pContent.size(), file);
+      std::fclose(file);
+    }
+    m_Files.push_back(path);
+    return path;
+  }
+
+private:
+  Path m_Dir;
+  std::vector<Path> m_Files;
+};
+
+/// The external_data entries and the data_location of a TensorProto in
+/// the wire format, so the test doesn't depend on the version of onnx.pb.
+std::string ExternalData(const std::string& pLocation, uint64_t pOffset,
+                         uint64_t pLength)
+{
+  std::string bytes;
+  {
+    ::google::protobuf::io::StringOutputStream stream(&bytes);
+    ::google::protobuf::io::CodedOutputStream output(&stream);
+    const std::pair<std::string, std::string> entries[] = {
+      { "location", pLocation },
+      { "offset", std::to_string(pOffset) },
+      { "length", std::to_string(pLength) }
+    };
+    for (const auto& entry : entries) {
+      std::string entryBytes;
+      {
+        ::google::protobuf::io::StringOutputStream entryStream(&entryBytes);
+        ::google::protobuf::io::CodedOutputStream entryOutput(&entryStream);
+        WireFormat::WriteString(1, entry.first, &entryOutput);
+        WireFormat::WriteString(2, entry.second, &entryOutput);
+      }
+      WireFormat::WriteBytes(13, entryBytes, &output);
+    }
+    // TensorProto::EXTERNAL
+    WireFormat::WriteEnum(14, 1, &output);
+  }
+  return bytes;
+}
+
+/// A model passing the float initializer "w" of @ref pSize elements to its
+/// output "y".
+/// @param pTensorBytes the wire format of the fields appended to "w".
+xProto MakeModel(int pSize, const std::string& pRawData,
+                 const std::string& pTensorBytes = std::string())
+{
+  xProto model;
+  model.set_ir_version(3);
+  model.add_opset_import()->set_version(8);
+
+  xGraphProto* graph = model.mutable_graph();
+  graph->set_name("reader");
+
+  xTensorProto tensor;
+  tensor.set_name("w");
+  tensor.set_data_type(xTensorProto::FLOAT);
+  tensor.add_dims(pSize);
+  if (!pRawData.empty())
+    tensor.set_raw_data(pRawData);
+  std::string tensorBytes;
+  tensor.SerializeToString(&tensorBytes);
+  graph->add_initializer()->ParseFromString(tensorBytes + pTensorBytes);
+
+  const char* names[] = { "w", "y" };
+  for (const char* name : names) {
+    auto* value = ('w' == name[0]) ? graph->add_input()
+                                   : graph->add_output();
+    value->set_name(name);
+    auto* type = value->mutable_type()->mutable_tensor_type();
+    type->set_elem_type(xTensorProto::FLOAT);
+    type->mutable_shape()->add_dim()->set_dim_value(pSize);
+  }
+
+  auto* node = graph->add_node();
+  node->set_op_type("Identity");
+  node->add_input("w");
+  node->add_output("y");
+  return model;
+}
+
+std::string Serialize(const xProto& pModel)
+{
+  std::string bytes;
+  pModel.SerializeToString(&bytes);
+  return bytes;
+}
+
+/// @return the raw data of the initializer "w", or "<none>".
+std::string RawDataOfW(Module& pModule)
+{
+  if (!pModule.hasRootTensorGraph())
+    return "<none>";
+  xGraph* graph = pModule.getRootTensorGraph();
+  for (unsigned i = 0; i < graph->initializer_names().size(); ++i) {
+    if ("w" == graph->initializer_names()[i])
+      return graph->initializers()[i].raw();
+  }
+  return "<none>";
+}
+
+/// The raw data of @ref pSize distinct floats.
+std::string Floats(int pSize)
+{
+  std::string data(pSize * sizeof(float), '\0');
+  float* values = reinterpret_cast<float*>(&data[0]);
+  for (int i = 0; i < pSize; ++i)
+    values[i] = 0.5f * i;
+  return data;
+}
+
+} // anonymous namespace
+
 //===----------------------------------------------------------------------===//
 // ONNXReader test
 //===----------------------------------------------------------------------===//
@@ -26,3 +177,82 @@ SKYPAT_F(ONNXReaderTest, parse_file)
   SystemError err = reader.parse(path, module);
   ASSERT_TRUE(err.isGood());
 }
+
+SKYPAT_F(ONNXReaderTest, inline_raw_data)
+{
+  ScratchDir dir;
+  const std::string data = Floats(16);
+  Path path = dir.write("model.onnx", Serialize(MakeModel(16, data)));
+
+  onnc::Module module;
+  onnc::onnx::Reader reader;
+  ASSERT_TRUE(reader.parse(path, module).isGood());
+  EXPECT_TRUE(data == RawDataOfW(module));
+}
+
+SKYPAT_F(ONNXReaderTest, external_data_at_offset)
+{
+  ScratchDir dir;
+  const std::string data = Floats(4);
+  dir.write("w.bin", std::string(16, 'x') + data + std::string(8, 'x'));
+  Path path = dir.write("model.onnx",
+      Serialize(MakeModel(4, "", ExternalData("w.bin", 16, data.size()))));
+
+  onnc::Module module;
+  onnc::onnx::Reader reader;
+  ASSERT_TRUE(reader.parse(path, module).isGood());
+  EXPECT_TRUE(data == RawDataOfW(module));
+}
+
+SKYPAT_F(ONNXReaderTest, external_data_outside_model_dir)
+{
+  ScratchDir dir;
+  const char* locations[] = { "/etc/passwd", "../w.bin", "sub/../../w.bin" };
+  for (const char* location : locations) {
+    Path path = dir.write("model.onnx",
+        Serialize(MakeModel(4, "", ExternalData(location, 0, 16))));
+    onnc::Module module;
+    onnc::onnx::Reader reader;
+    EXPECT_FALSE(reader.parse(path, module).isGood());
+  }
+}
+
+SKYPAT_F(ONNXReaderTest, limit_per_field)
+{
+  // the raw data is skipped by the stream, so it may exceed the limit.
+  ScratchDir dir;
+  const std::string data = Floats(1024);
+  Path path = dir.write("model.onnx", Serialize(MakeModel(1024, data)));
+  onnc::Module module;
+  onnc::onnx::Reader reader;
+  reader.setTotalBytesLimit(512, 256);
+  ASSERT_TRUE(reader.parse(path, module).isGood());
+  EXPECT_TRUE(data == RawDataOfW(module));
+
+  // any other field must fit in the limit.
+  xProto model = MakeModel(4, Floats(4));
+  model.set_doc_string(std::string(4096, 'd'));
+  path = dir.write("large_doc.onnx", Serialize(model));
+  onnc::Module failed;
+  EXPECT_FALSE(reader.parse(path, failed).isGood());
+}
+
+SKYPAT_F(ONNXReaderTest, file_descriptor_at_offset)
+{
+  // the model starts after a header, and so do the offsets of raw data.
+  ScratchDir dir;
+  const std::string header(32, 'h');
+  const std::string data = Floats(8);
+  Path path = dir.write("packed.bin",
+                        header + Serialize(MakeModel(8, data)));
+
+  int fd = ::open(path.c_str(), O_RDONLY);
+  ASSERT_TRUE(-1 != fd);
+  ASSERT_TRUE(off_t(header.size()) == ::lseek(fd, header.size(), SEEK_SET));
+
+  onnc::Module module;
+  onnc::onnx::Reader reader;
+  EXPECT_TRUE(reader.parse(fd, module).isGood());
+  EXPECT_TRUE(data == RawDataOfW(module));
+  ::close(fd);
+}
@@ -12,7 +12,10 @@
 #include <onnc/Core/PassSupport.h>
 #include <onnc/Core/AnalysisUsage.h>
 #include <onnc/Core/PassManager.h>
+#include <onnc/Core/PassAnalysisSupport.h>
+#include <onnc/Core/PassTimingInfo.h>
 #include <onnc/IR/Module.h>
+#include <onnc/Support/OStrStream.h>
 
 using namespace skypat;
 using namespace onnc;
@@ -349,3 +352,183 @@ SKYPAT_F(PassManagerTest, run_test_1)
   ASSERT_TRUE(process == "ZXYZXYZYZXYZXYZ");
   ASSERT_TRUE(pm.run(module, state));
 }
+
+SKYPAT_F(PassManagerTest, time_passes)
+{
+  PassRegistry registry;
+  InitializeXPass(registry);
+  InitializeYPass(registry);
+  InitializeZPass(registry);
+
+  PassTimingInfo timing;
+  PassManager pm(registry);
+  pm.setTimingInfo(&timing);
+  pm.add(new Z());
+
+  // Z retries twice: ZXYZXYZ
+  Module module;
+  ASSERT_TRUE(pm.run(module));
+  ASSERT_EQ(timing.records().size(), 3);
+
+  const PassTimingInfo::Record& z = timing.records()[0];
+  EXPECT_TRUE(z.name == "Z");
+  EXPECT_EQ(z.runs, 3);
+  EXPECT_EQ(z.retries, 2);
+
+  const PassTimingInfo::Record& x = timing.records()[1];
+  EXPECT_TRUE(x.name == "X");
+  EXPECT_EQ(x.runs, 2);
+  EXPECT_EQ(x.retries, 0);
+
+  // --batch names the model of each report.
+  std::string report;
+  OStrStream oss(report);
+  timing.print(oss, "model.onnx");
+  oss.flush();
+  EXPECT_TRUE(std::string::npos != report.find("  model.onnx\n"));
+}
+
+class L : public ModulePass
+{
+public:
+  static char ID;
+
+  L() : ModulePass(ID), runs(0) { }
+
+  ReturnType runOnModule(Module &pModule) override {
+    ++runs;
+    return kModuleNoChanged;
+  }
+
+  bool isAnalysis() const override { return true; }
+
+  StringRef getPassName() const override { return "L"; }
+
+  unsigned int runs;
+};
+
+char L::ID = 0;
+INITIALIZE_PASS(L, "L")
+
+class P : public ModulePass
+{
+public:
+  static char ID;
+
+  P() : ModulePass(ID) { }
+
+  ReturnType runOnModule(Module &pModule) override { return kModuleChanged; }
+
+  void getAnalysisUsage(AnalysisUsage& pUsage) const override {
+    pUsage.addRequired<L>();
+    pUsage.addPreserved<L>();
+  }
+
+  StringRef getPassName() const override { return "P"; }
+};
+
+char P::ID = 0;
+INITIALIZE_PASS(P, "P")
+
+class Q : public ModulePass
+{
+public:
+  static char ID;
+
+  Q() : ModulePass(ID) { }
+
+  ReturnType runOnModule(Module &pModule) override { return kModuleChanged; }
+
+  void getAnalysisUsage(AnalysisUsage& pUsage) const override {
+    pUsage.addRequired<L>();
+  }
+
+  StringRef getPassName() const override { return "Q"; }
+};
+
+char Q::ID = 0;
+INITIALIZE_PASS(Q, "Q")
+
+SKYPAT_F(PassManagerTest, preserve_analyses)
+{
+  PassRegistry registry;
+  InitializeLPass(registry);
+  InitializePPass(registry);
+  InitializeQPass(registry);
+
+  PassManager::State state;
+  PassManager pm(registry);
+  pm.add(new L(), state);
+  pm.add(new P(), state);
+  pm.add(new Q(), state);
+  pm.add(new P(), state);
+  ASSERT_EQ(state.execution.size(), 4); // LPQP
+
+  L* analysis = static_cast<L*>(pm.lookup(&L::ID));
+  ASSERT_TRUE(nullptr != analysis);
+
+  Module module;
+  std::string process;
+  while (!state.execution.empty()) {
+    ASSERT_TRUE(pm.step(module, state));
+    process += state.pass->getPassName();
+  }
+
+  // P preserves L, Q doesn't.
+  EXPECT_TRUE(process == "LPQLP");
+  EXPECT_EQ(analysis->runs, 2);
+  EXPECT_TRUE(pm.isValid(&L::ID));
+
+  pm.invalidate(&L::ID);
+  EXPECT_FALSE(pm.isValid(&L::ID));
+}
+
+class R : public ModulePass
+{
+public:
+  static char ID;
+
+  R() : ModulePass(ID), validL(false) { }
+
+  ReturnType runOnModule(Module &pModule) override {
+    validL = isValidAnalysis<L>();
+    return kModuleNoChanged;
+  }
+
+  void getAnalysisUsage(AnalysisUsage& pUsage) const override {
+    pUsage.addRequired<L>();
+  }
+
+  StringRef getPassName() const override { return "R"; }
+
+  bool validL;
+};
+
+char R::ID = 0;
+INITIALIZE_PASS(R, "R")
+
+SKYPAT_F(PassManagerTest, valid_analysis_in_pass)
+{
+  PassRegistry registry;
+  InitializeLPass(registry);
+  InitializeQPass(registry);
+  InitializeRPass(registry);
+
+  PassManager::State state;
+  PassManager pm(registry);
+  pm.add(new L(), state);
+  pm.add(new Q(), state);
+  R* user = new R();
+  pm.add(user, state);
+
+  Module module;
+  std::string process;
+  while (!state.execution.empty()) {
+    ASSERT_TRUE(pm.step(module, state));
+    process += state.pass->getPassName();
+  }
+
+  // Q invalidates L, so L reruns and R can reuse its result.
+  EXPECT_TRUE(process == "LQLR");
+  EXPECT_TRUE(user->validL);
+}
@@ -0,0 +1,56 @@
+//===- SHA256Test.cpp -----------------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <skypat/skypat.h>
+#include <onnc/Support/SHA256.h>
+#include <algorithm>
+#include <string>
+
+using namespace skypat;
+using namespace onnc;
+
+//===----------------------------------------------------------------------===//
+// SHA256Test
+//===----------------------------------------------------------------------===//
+SKYPAT_F(SHA256Test, fips_vectors)
+{
+  EXPECT_TRUE(SHA256::Hash("") ==
+      "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+  EXPECT_TRUE(SHA256::Hash("abc") ==
+      "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+
+  // two blocks after padding.
+  EXPECT_TRUE(SHA256::Hash(
+      "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq") ==
+      "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+}
+
+SKYPAT_F(SHA256Test, split_updates)
+{
+  // one million 'a's in pieces across block boundaries.
+  std::string message(1000000, 'a');
+  SHA256 sha;
+  for (size_t i = 0; i < message.size(); i += 7)
+    sha.update(message.data() + i, std::min<size_t>(7, message.size() - i));
+
+  EXPECT_TRUE(sha.final() ==
+      "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+SKYPAT_F(SHA256Test, update_file)
+{
+  Path path(TOPDIR);
+  path.append("tools").append("unittests").append("data").append("test.txt");
+
+  SHA256 sha;
+  ASSERT_TRUE(sha.updateFile(path));
+  EXPECT_TRUE(sha.final() ==
+      "26a9daa11e6382b2faa18fb7090cdec9f9010626478c0c29e9664fcb83b22d6e");
+
+  SHA256 missing;
+  EXPECT_FALSE(missing.updateFile(Path("no/such/file")));
+}
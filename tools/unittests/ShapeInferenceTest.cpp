@@ -0,0 +1,157 @@
+//===- ShapeInferenceTest.cpp ---------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <skypat/skypat.h>
+#include <onnc/Analysis/ShapeInference.h>
+#include <onnc/IR/IRBuilder.h>
+#include <onnc/IR/ONNXUtils.h>
+
+using namespace skypat;
+using namespace onnc;
+
+//===----------------------------------------------------------------------===//
+// ShapeInferenceTest
+//===----------------------------------------------------------------------===//
+SKYPAT_F(ShapeInferenceTest, conv_pool_gemm)
+{
+  onnc::Module module;
+  IRBuilder builder(module);
+
+  builder.CreateTensorGraph();
+  builder.AddInput("data", {1, 3, 224, 224});
+  builder.AddInput("conv_w", {64, 3, 7, 7});
+  builder.AddInput("fc_w", {1000, 64});
+  builder.AddInitializer("conv_w");
+  builder.AddInitializer("fc_w");
+
+  xNode* conv = builder.AddNode("Conv", {"data", "conv_w"});
+  conv->is_(xSymbol("strides"), { 2, 2 });
+  conv->is_(xSymbol("pads"), { 3, 3, 3, 3 });
+  xValue* conv_out = builder.AddOutput("conv", { });
+
+  builder.AddNode("Relu", {"conv"});
+  builder.AddOutput("relu", { });
+
+  xNode* pool = builder.AddNode("MaxPool", {"relu"});
+  pool->is_(xSymbol("kernel_shape"), { 3, 3 });
+  pool->is_(xSymbol("strides"), { 2, 2 });
+  pool->is_(xSymbol("pads"), { 1, 1, 1, 1 });
+  xValue* pool_out = builder.AddOutput("pool", { });
+
+  builder.AddNode("GlobalAveragePool", {"pool"});
+  builder.AddOutput("gap", { });
+
+  builder.AddNode("Flatten", {"gap"});
+  builder.AddOutput("flatten", { });
+
+  xNode* gemm = builder.AddNode("Gemm", {"flatten", "fc_w"});
+  gemm->i_(xSymbol("transB"), 1);
+  xValue* gemm_out = builder.AddOutput("fc", { });
+
+  builder.FinalizeTensorGraph({"fc"});
+
+  ShapeInference shape_inference;
+  ASSERT_TRUE(shape_inference.infer(*builder.getTensorGraph()));
+
+  EXPECT_TRUE(LongInts({ 1, 64, 112, 112 }) == GetValueSizes(*conv_out));
+  EXPECT_TRUE(LongInts({ 1, 64, 56, 56 }) == GetValueSizes(*pool_out));
+  EXPECT_TRUE(LongInts({ 1, 1000 }) == GetValueSizes(*gemm_out));
+  EXPECT_EQ(gemm_out->elemType(), (xTensorProtoDataType)onnc::Value::kFloat);
+}
+
+SKYPAT_F(ShapeInferenceTest, keep_known_sizes)
+{
+  onnc::Module module;
+  IRBuilder builder(module);
+
+  builder.CreateTensorGraph();
+  builder.AddInput("a", {8, 1, 5});
+  builder.AddInput("b", {3, 1});
+
+  builder.AddNode("Add", {"a", "b"});
+  xValue* sum = builder.AddOutput("sum", { });
+
+  builder.AddNode("Relu", {"sum"});
+  xValue* relu = builder.AddOutput("relu", {7});
+
+  builder.FinalizeTensorGraph({"relu"});
+
+  ShapeInference shape_inference;
+  ASSERT_TRUE(shape_inference.infer(*builder.getTensorGraph()));
+  EXPECT_TRUE(LongInts({ 8, 3, 5 }) == GetValueSizes(*sum));
+  EXPECT_TRUE(LongInts({ 7 }) == GetValueSizes(*relu));
+}
+
+SKYPAT_F(ShapeInferenceTest, unknown_operator)
+{
+  onnc::Module module;
+  IRBuilder builder(module);
+
+  builder.CreateTensorGraph();
+  builder.AddInput("x", {1, 3, 8, 8});
+
+  builder.AddNode("NoSuchOp", {"x"});
+  builder.AddOutput("y", { });
+
+  builder.AddNode("Relu", {"y"});
+  builder.AddOutput("z", { });
+
+  builder.FinalizeTensorGraph({"z"});
+
+  // the caller falls back to onnx shape inference.
+  ShapeInference shape_inference;
+  EXPECT_FALSE(shape_inference.hasShapeFunction(xSymbol("NoSuchOp")));
+  EXPECT_FALSE(shape_inference.infer(*builder.getTensorGraph()));
+}
+
+SKYPAT_F(ShapeInferenceTest, legacy_broadcast_comparison)
+{
+  onnc::Module module;
+  IRBuilder builder(module);
+
+  builder.CreateTensorGraph();
+  builder.AddInput("a", {2, 3});
+  builder.AddInput("b", {3});
+
+  // opset 6 broadcasts b to the shape of a.
+  xNode* greater = builder.AddNode("Greater", {"a", "b"});
+  greater->i_(xSymbol("broadcast"), 1);
+  xValue* out = builder.AddOutput("greater", { }, onnc::Value::kUndefined);
+
+  builder.FinalizeTensorGraph({"greater"});
+
+  ShapeInference shape_inference(6);
+  ASSERT_TRUE(shape_inference.infer(*builder.getTensorGraph()));
+  EXPECT_TRUE(LongInts({ 2, 3 }) == GetValueSizes(*out));
+  EXPECT_EQ(out->elemType(), (xTensorProtoDataType)onnc::Value::kBoolean);
+}
+
+SKYPAT_F(ShapeInferenceTest, dropout_mask_by_opset)
+{
+  const int64_t versions[] = { 7, 10 };
+  for (int64_t version : versions) {
+    onnc::Module module;
+    IRBuilder builder(module);
+
+    builder.CreateTensorGraph();
+    builder.AddInput("x", {1, 4});
+
+    builder.AddNode("Dropout", {"x"});
+    builder.AddOutput("y", { }, onnc::Value::kUndefined);
+    xValue* mask = builder.AddOutput("mask", { }, onnc::Value::kUndefined);
+
+    builder.FinalizeTensorGraph({"y", "mask"});
+
+    // the mask is boolean since opset 10.
+    ShapeInference shape_inference(version);
+    ASSERT_TRUE(shape_inference.infer(*builder.getTensorGraph()));
+    EXPECT_TRUE(LongInts({ 1, 4 }) == GetValueSizes(*mask));
+    onnc::Value::Type type = (10 <= version) ? onnc::Value::kBoolean
+                                             : onnc::Value::kFloat;
+    EXPECT_EQ(mask->elemType(), (xTensorProtoDataType)type);
+  }
+}
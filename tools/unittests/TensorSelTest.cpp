@@ -39,9 +39,104 @@
 #include <onnc/Transforms/TensorSel/Standards/AndLower.h>
 #include <onnc/Transforms/TensorSel/Standards/LRNLower.h>
 #include <onnc/Transforms/TensorSel/Standards/SoftmaxLower.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
 
 using namespace onnc;
 
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+namespace {
+
+typedef std::vector<std::unique_ptr<onnc::Module> > ModuleList;
+
+/// Add the graph @ref pName of two Relus, from @ref pInput to @ref pOutput.
+/// A graph other than the root is owned by a module of @ref pOwners.
+void AddReluGraph(onnc::Module& pModule, ModuleList& pOwners,
+                  const std::string& pName, const std::string& pInput,
+                  const std::string& pOutput)
+{
+  onnc::Module* owner = &pModule;
+  if (pModule.hasRootTensorGraph()) {
+    pOwners.emplace_back(new onnc::Module());
+    owner = pOwners.back().get();
+  }
+
+  IRBuilder builder(*owner);
+  xGraph* graph = builder.CreateTensorGraph(pName);
+  builder.AddInput(pInput, {1, 4});
+  builder.AddNode("Relu", {pInput});
+  builder.AddOutput(pName + "_mid", {1, 4});
+  builder.AddNode("Relu", {pName + "_mid"});
+  builder.AddOutput(pOutput, {1, 4});
+  builder.FinalizeTensorGraph({pOutput});
+
+  if (owner != &pModule)
+    pModule.recordSubgraph(*graph);
+  pModule.createComputeGraph(pName);
+}
+
+/// Build graphs of which one reads a value of the root graph, and lower
+/// them with @ref pNumOfThreads threads.
+void LowerGraphs(onnc::Module& pModule, ModuleList& pOwners,
+                 unsigned int pNumOfThreads)
+{
+  AddReluGraph(pModule, pOwners, "main", "x", "y");
+  for (int i = 0; i < 4; ++i) {
+    std::string name = "body" + std::to_string(i);
+    AddReluGraph(pModule, pOwners, name, name + "_in", name + "_out");
+  }
+  AddReluGraph(pModule, pOwners, "capture", "main_mid", "capture_out");
+
+  std::unique_ptr<ModulePass> inputs(CreateBuildInputOperators());
+  inputs->runOnModule(pModule);
+
+  TensorSel tensorSel;
+  tensorSel.getLowerRegistry().emplace<onnc::ReluLower>();
+  tensorSel.setNumOfThreads(pNumOfThreads);
+  tensorSel.runOnModule(pModule);
+}
+
+/// The operators of every compute graph in order with their operands, and
+/// the values of the module.
+std::string Describe(onnc::Module& pModule)
+{
+  std::string result;
+  Module::tg_iterator tg, tEnd = pModule.tgEnd();
+  for (tg = pModule.tgBegin(); tg != tEnd; ++tg) {
+    ComputeGraph* cg = pModule.getComputeGraph(tg->value()->name());
+    result += tg->value()->name() + ":";
+    ComputeGraph::iterator op, opEnd = cg->end();
+    for (op = cg->begin(); op != opEnd; ++op) {
+      result += " " + op->name().str() + "(";
+      for (unsigned int i = 0; i < op->getNumOfInputs(); ++i)
+        result += op->getInput(i)->getName() + ",";
+      result += ")->(";
+      for (unsigned int i = 0; i < op->getNumOfOutputs(); ++i)
+        result += op->getOutput(i)->getName() + ",";
+      result += ")";
+    }
+    result += "\n";
+  }
+
+  // the value list is a hash table, so its order is the order of the keys.
+  std::vector<std::string> values;
+  Module::ValueList::iterator value, vEnd = pModule.getValueList().end();
+  for (value = pModule.getValueList().begin(); value != vEnd; ++value)
+    values.push_back(value->key().str() + "=" + value->value()->getName());
+  std::sort(values.begin(), values.end());
+
+  result += "values:";
+  for (const std::string& value : values)
+    result += " " + value;
+  return result;
+}
+
+} // anonymous namespace
+
 //===----------------------------------------------------------------------===//
 // Any Test
 //===----------------------------------------------------------------------===//
@@ -173,3 +268,15 @@ SKYPAT_F(TensorSelTest, alexnet)
   //int run_result = pm.run(module);
   //ASSERT_TRUE(EXIT_SUCCESS == run_result);
 }
+
+SKYPAT_F(TensorSelTest, threads_lower_the_same_module)
+{
+  ModuleList sequentialOwners, parallelOwners;
+  onnc::Module sequential, parallel;
+  LowerGraphs(sequential, sequentialOwners, 1);
+  LowerGraphs(parallel, parallelOwners, 4);
+
+  std::string expected = Describe(sequential);
+  EXPECT_TRUE(std::string::npos != expected.find("capture_out"));
+  EXPECT_TRUE(expected == Describe(parallel));
+}
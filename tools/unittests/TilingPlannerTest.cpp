@@ -0,0 +1,176 @@
+//===- TilingPlannerTest.cpp ----------------------------------------------===//
+//
+//                             The ONNC Project
+//
+// See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <skypat/skypat.h>
+#include <onnc/Analysis/TilingPlanner.h>
+#include <onnc/Analysis/SplitNode.h>
+#include <onnc/IR/IRBuilder.h>
+#include <onnc/IR/Module.h>
+#include <onnc/Target/DLATargetBackend.h>
+#include <onnc/Target/TargetOptions.h>
+
+using namespace skypat;
+using namespace onnc;
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+namespace {
+
+uint64_t Volume(const LongInts& pSizes)
+{
+  uint64_t volume = 1;
+  for (int64_t dim : pSizes)
+    volume *= dim;
+  return volume;
+}
+
+/// A Relu of 6400 cycles on 64 processing units, and a byte per element. A
+/// transfer moves 8 bytes a cycle.
+class StubTTI : public TargetTransformInfo
+{
+public:
+  uint64_t getOperatorCost(const xNode *pNode, unsigned pKind) const override {
+    return (pNode->kind() == xSymbol("Relu")) ? 6400 : 0;
+  }
+
+  MemSize getOperatorInputMemUsage(const xNode *pNode, unsigned pIdx,
+                                   const LongInts &pNewInputSize) const override {
+    return MemSize(1, Volume(pNewInputSize));
+  }
+
+  MemSize getOperatorOutputMemUsage(const xNode *pNode, unsigned pIdx,
+                                    const LongInts &pNewOutputSize) const override {
+    return MemSize(1, Volume(pNewOutputSize));
+  }
+
+  uint64_t getTransferCost(uint64_t pSize) const override { return pSize / 8; }
+
+  int getProcessingUnitCount() const override { return 64; }
+};
+
+class StubBackend : public DLATargetBackend
+{
+public:
+  StubBackend(const TargetOptions &pOptions) : DLATargetBackend(pOptions) { }
+
+  const TargetTransformInfo *getTTI() const override { return &m_TTI; }
+
+private:
+  StubTTI m_TTI;
+};
+
+/// Load -> Relu -> Store of a 1x4x64x8 tensor.
+xNode* BuildGroup(IRBuilder &pBuilder)
+{
+  pBuilder.CreateTensorGraph();
+  pBuilder.AddInput("x", {1, 4, 64, 8}, Value::kInt8);
+  pBuilder.AddNode("Load", {"x"});
+  pBuilder.AddOutput("lx", {1, 4, 64, 8}, Value::kInt8);
+  xNode *relu = pBuilder.AddNode("Relu", {"lx"});
+  pBuilder.AddOutput("r", {1, 4, 64, 8}, Value::kInt8);
+  pBuilder.AddNode("Store", {"r"});
+  pBuilder.AddOutput("y", {1, 4, 64, 8}, Value::kInt8);
+  pBuilder.FinalizeTensorGraph({"y"});
+  return relu;
+}
+
+} // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// TilingPlannerTest
+//===----------------------------------------------------------------------===//
+SKYPAT_F(TilingPlannerTest, candidate_factors)
+{
+  // tiles of 10, 5, 4, 3, 2 and 1 elements.
+  std::vector<unsigned> expected = { 1, 2, 3, 4, 5, 10 };
+  EXPECT_TRUE(expected == TilingPlanner::GetCandidateFactors(10));
+
+  EXPECT_TRUE(std::vector<unsigned>{ 1 } ==
+              TilingPlanner::GetCandidateFactors(1));
+
+  // every tile size shows up once.
+  std::vector<unsigned> factors = TilingPlanner::GetCandidateFactors(224);
+  int64_t last = 225;
+  for (unsigned factor : factors) {
+    int64_t tile = (224 + factor - 1) / factor;
+    ASSERT_TRUE(tile < last);
+    last = tile;
+  }
+  EXPECT_EQ(last, 1);
+  EXPECT_TRUE(factors.size() < 32);
+}
+
+SKYPAT_F(TilingPlannerTest, plan_cycles)
+{
+  TilingPlanner::Plan plan;
+  plan.factors = { 1, 2, 4 };
+  plan.numOfTiles = 8;
+  plan.footprint = 60 * 1024;
+  plan.computeCycles = 1000;
+  plan.transferCycles = 250;
+
+  EXPECT_EQ(plan.getTileCycles(), 1250);
+  EXPECT_EQ(plan.getTotalCycles(), 10000);
+}
+
+SKYPAT_F(TilingPlannerTest, plan_by_cost)
+{
+  TargetOptions options;
+  StubBackend backend(options);
+  onnc::Module module;
+  IRBuilder builder(module);
+  xNode *relu = BuildGroup(builder);
+  SplitGraphManager manager(*builder.getTensorGraph(), backend);
+  SplitGraph &group = *manager.getSplitGraphs().front();
+
+  // a tile holds the input and the output of the Relu.
+  unsigned calls = 0;
+  auto footprint = [&calls, relu] (SplitGraph& pGroup) -> uint64_t {
+    ++calls;
+    return 2 * Volume(pGroup.getSplitNode(relu)->getNewOutputSize(0));
+  };
+
+  // the fewest H pieces fitting 1 KB are 5 (C whole), 3 (C halved) and 2
+  // (C in 4). Only C in 4 keeps all 64 units busy, so it wins even though
+  // it has the most tiles.
+  TilingPlanner planner(*backend.getTTI(), 1024);
+  TilingPlanner::Plan plan;
+  ASSERT_TRUE(planner.plan(group, footprint, plan));
+  EXPECT_TRUE((TilingPlanner::Factors{ 1, 4, 2 }) == plan.factors);
+  EXPECT_EQ(plan.numOfTiles, 8);
+  EXPECT_EQ(plan.footprint, 512);
+  EXPECT_EQ(plan.computeCycles, 800);
+  EXPECT_EQ(plan.transferCycles, 64);
+
+  // the graph is left split by the plan.
+  EXPECT_TRUE(plan.factors == group.getSplitFactors());
+
+  // H is binary searched: far fewer tries than the H factors of every C.
+  const unsigned numOfH = TilingPlanner::GetCandidateFactors(64).size();
+  const unsigned numOfC = TilingPlanner::GetCandidateFactors(4).size();
+  EXPECT_TRUE(calls < numOfC * numOfH / 2);
+}
+
+SKYPAT_F(TilingPlannerTest, plan_nothing_fits)
+{
+  TargetOptions options;
+  StubBackend backend(options);
+  onnc::Module module;
+  IRBuilder builder(module);
+  xNode *relu = BuildGroup(builder);
+  SplitGraphManager manager(*builder.getTensorGraph(), backend);
+
+  // the smallest tile is a row of 8 bytes in and out.
+  auto footprint = [relu] (SplitGraph& pGroup) -> uint64_t {
+    return 2 * Volume(pGroup.getSplitNode(relu)->getNewOutputSize(0));
+  };
+  TilingPlanner planner(*backend.getTTI(), 16);
+  TilingPlanner::Plan plan;
+  EXPECT_FALSE(planner.plan(*manager.getSplitGraphs().front(), footprint,
+                            plan));
+}